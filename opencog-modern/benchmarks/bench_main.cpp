@@ -8,16 +8,44 @@
 #include <opencog/pattern/matcher.hpp>
 #include <opencog/pln/formulas.hpp>
 #include <opencog/pln/inference.hpp>
+#include <opencog/pln/static_rules.hpp>
+#include <opencog/ure/engine.hpp>
+#include <opencog/ure/frontier.hpp>
+#include <opencog/ure/rule.hpp>
+#include <opencog/ure/rule_set.hpp>
 
+#include <atomic>
 #include <chrono>
+#include <cstdlib>
 #include <iostream>
+#include <new>
+#include <optional>
 #include <random>
+#include <stop_token>
+#include <thread>
 #include <vector>
 #include <iomanip>
 
 using namespace opencog;
 using namespace std::chrono;
 
+// ============================================================================
+// Allocation Counting
+// ============================================================================
+
+namespace {
+std::atomic<size_t> g_allocations{0};
+}
+
+void* operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
 // ============================================================================
 // Benchmark Utilities
 // ============================================================================
@@ -49,6 +77,22 @@ double benchmark(const std::string& name, Func&& func, int iterations = 1) {
     return per_op;
 }
 
+/**
+ * @brief Report heap allocations per produced item for one run of func
+ */
+template<typename Func>
+void count_allocations(const std::string& name, Func&& func,
+                       const char* unit = "match", const char* units = "matches") {
+    size_t before = g_allocations.load(std::memory_order_relaxed);
+    size_t items = func();
+    size_t allocations = g_allocations.load(std::memory_order_relaxed) - before;
+
+    std::cout << std::left << std::setw(40) << name
+              << std::right << std::setw(12) << std::fixed << std::setprecision(2)
+              << (items ? static_cast<double>(allocations) / static_cast<double>(items) : 0.0)
+              << " allocs/" << unit << " (" << items << " " << units << ")\n";
+}
+
 // ============================================================================
 // AtomSpace Benchmarks
 // ============================================================================
@@ -233,6 +277,26 @@ void bench_pattern() {
         benchmark("Match all concepts (10000)", [&]() {
             size_t count = matcher.count_matches(pattern);
         }, 10);
+
+        // Full-space predicate scans over AtomTable slots
+        auto named_9 = [](const AtomSpace& as, Handle h) {
+            return as.get_name(h).ends_with('9');
+        };
+        std::vector<AtomId> hits;
+        benchmark("Filter scan (10000), 1 thread", [&]() {
+            hits.clear();
+            matcher.filter_into(named_9, hits);
+        }, 10);
+        benchmark("Filter scan (10000), 4 threads", [&]() {
+            hits.clear();
+            matcher.filter_into(named_9, hits, 4);
+        }, 10);
+        benchmark("Filter stream, first 10 hits", [&]() {
+            size_t count = 0;
+            for ([[maybe_unused]] AtomId id : matcher.filter(named_9)) {
+                if (++count == 10) break;
+            }
+        }, 10);
     }
 
     // Link pattern match
@@ -283,6 +347,114 @@ void bench_pattern() {
             auto results = matcher.find_all(pattern);
         }, 100);
     }
+
+    // Two-hop conjunction: allocations per match for each API
+    {
+        AtomSpace space;
+        std::vector<Handle> nodes;
+        for (int i = 0; i < 200; ++i) {
+            nodes.push_back(space.add_node(AtomType::CONCEPT_NODE, "Node" + std::to_string(i)));
+        }
+        for (int i = 0; i < 2000; ++i) {
+            int a = i % nodes.size();
+            int b = (i * 7 + 3) % nodes.size();
+            (void)space.add_link(AtomType::INHERITANCE_LINK, {nodes[a], nodes[b]});
+        }
+
+        // Measure the engine itself, not cached reads
+        MatcherConfig uncached;
+        uncached.cache_capacity = 0;
+        PatternMatcher matcher(space, uncached);
+
+        Pattern pattern;
+        pattern.variables = {"X", "Y", "Z"};
+        pattern.body = and_pattern({
+            link(AtomType::INHERITANCE_LINK, {var("X"), var("Y")}),
+            link(AtomType::INHERITANCE_LINK, {var("Y"), var("Z")})
+        });
+
+        std::vector<MatchResult> buffer;
+        size_t warm = matcher.match_into(pattern, buffer);
+
+        benchmark("Two-hop conjunction, generator", [&]() {
+            size_t count = 0;
+            for ([[maybe_unused]] auto& r : matcher.match(pattern)) ++count;
+        }, 10);
+        benchmark("Two-hop conjunction, match_into", [&]() {
+            matcher.match_into(pattern, buffer);
+        }, 10);
+        benchmark("Two-hop conjunction, for_each_match", [&]() {
+            size_t count = 0;
+            matcher.for_each_match(pattern, [&](const MatchEngine& m) {
+                count += m.value(0u).valid();
+            });
+        }, 10);
+
+        count_allocations("  generator (MatchResult per yield)", [&]() {
+            size_t count = 0;
+            for ([[maybe_unused]] auto& r : matcher.match(pattern)) ++count;
+            return count;
+        });
+        count_allocations("  find_all (fresh vector)", [&]() {
+            return matcher.find_all(pattern).size();
+        });
+        count_allocations("  match_into (reused buffer)", [&]() {
+            return matcher.match_into(pattern, buffer);
+        });
+        count_allocations("  for_each_match (engine view)", [&]() {
+            return matcher.for_each_match(pattern, [](const MatchEngine&) {});
+        });
+        std::cout << "  Matches: " << warm << "\n";
+    }
+
+    // Repeated alpha-equivalent queries: result cache vs fresh search
+    {
+        AtomSpace space;
+        std::vector<Handle> nodes;
+        for (int i = 0; i < 200; ++i) {
+            nodes.push_back(space.add_node(AtomType::CONCEPT_NODE, "Node" + std::to_string(i)));
+        }
+        for (int i = 0; i < 2000; ++i) {
+            (void)space.add_link(AtomType::INHERITANCE_LINK,
+                                 {nodes[i % nodes.size()], nodes[(i * 7 + 3) % nodes.size()]});
+        }
+
+        auto two_hop = [](const char* x, const char* y, const char* z) {
+            Pattern p;
+            p.body = and_pattern({
+                link(AtomType::INHERITANCE_LINK, {var(x), var(y)}),
+                link(AtomType::INHERITANCE_LINK, {var(y), var(z)})
+            });
+            return p;
+        };
+        Pattern first = two_hop("X", "Y", "Z");
+        Pattern renamed = two_hop("A", "B", "C");
+
+        MatcherConfig uncached;
+        uncached.cache_capacity = 0;
+        PatternMatcher fresh(space, uncached);
+        PatternMatcher cached(space);
+
+        std::vector<MatchResult> buffer;
+        benchmark("Repeated two-hop query, no cache", [&]() {
+            fresh.match_into(first, buffer);
+            fresh.match_into(renamed, buffer);
+        }, 10);
+        benchmark("Repeated two-hop query, cached", [&]() {
+            cached.match_into(first, buffer);
+            cached.match_into(renamed, buffer);
+        }, 10);
+
+        // Unrelated mutations do not flush the entry
+        benchmark("Cached query after SimilarityLink add", [&]() {
+            (void)space.add_link(AtomType::SIMILARITY_LINK, {nodes[0], nodes[1]});
+            cached.match_into(first, buffer);
+        }, 10);
+
+        const auto& stats = cached.cache_stats();
+        std::cout << "  Cache hits: " << stats.hits << ", misses: " << stats.misses
+                  << ", hit rate: " << std::setprecision(2) << stats.hit_rate() << "\n";
+    }
 }
 
 // ============================================================================
@@ -339,6 +511,591 @@ void bench_pln() {
             pln::batch_revision(tv1, tv2, out);
         }, 1000);
     }
+
+    // Rule applications: a std::function formula over a premise vector
+    // against the same rule as a type, through its kernel and in a batch
+    {
+        using pln::rules::Deduction;
+        constexpr size_t n = 1'000'000;
+        std::vector<pln::PremiseTVs<Deduction>> premises(n);
+        std::mt19937 rng(11);
+        std::uniform_real_distribution<float> unit(0.05f, 0.95f);
+        for (auto& tvs : premises) {
+            for (auto& tv : tvs) tv = TruthValue{unit(rng), unit(rng)};
+        }
+        std::vector<TruthValue> out(n);
+        const pln::InferenceRule rule = pln::make_rule<Deduction>();
+
+        auto report = [&](const std::string& name, auto&& run) {
+            double us = benchmark(name, run);
+            std::cout << "  " << std::setprecision(1) << n / us << "M applications/s\n";
+        };
+
+        std::vector<TruthValue> scratch;
+        report("Deduction rule (1M), std::function", [&]() {
+            for (size_t i = 0; i < n; ++i) {
+                scratch.assign(premises[i].begin(), premises[i].end());
+                out[i] = rule.formula(scratch);
+            }
+        });
+        report("Deduction rule (1M), static kernel", [&]() {
+            for (size_t i = 0; i < n; ++i) out[i] = rule.kernel(premises[i]);
+        });
+        report("Deduction rule (1M), static batch", [&]() {
+            (void)pln::apply_batch<Deduction>(premises, out);
+        });
+    }
+
+    // Dispatched SoA kernels at each available instruction set
+    {
+        constexpr size_t n = 4099;  // Not a multiple of any vector width
+        SimdVector<float> s1(n), c1(n), s2(n), c2(n), pb(n), pc(n), s_out(n), c_out(n);
+        for (size_t i = 0; i < n; ++i) {
+            s1[i] = 0.8f; c1[i] = 0.9f; s2[i] = 0.7f; c2[i] = 0.85f; pb[i] = 0.5f; pc[i] = 0.4f;
+        }
+
+        using pln::kernels::SimdLevel;
+        const SimdLevel original = pln::kernels::simd_level();
+        std::cout << "  (detected: " << pln::kernels::simd_level_name(pln::kernels::detected_simd_level())
+                  << ")\n";
+        for (SimdLevel level : {SimdLevel::SCALAR, SimdLevel::SSE2, SimdLevel::NEON,
+                                SimdLevel::AVX2, SimdLevel::AVX512}) {
+            if (pln::kernels::set_simd_level(level) != level) continue;
+            const std::string name = pln::kernels::simd_level_name(level);
+            benchmark("Deduction kernel (4099) x 1,000, " + name, [&]() {
+                pln::kernels::deduction(s1.data(), c1.data(), s2.data(), c2.data(), pb.data(), pc.data(),
+                                        s_out.data(), c_out.data(), n);
+            }, 1000);
+            benchmark("Revision kernel (4099) x 1,000, " + name, [&]() {
+                pln::kernels::revision(s1.data(), c1.data(), s2.data(), c2.data(),
+                                       s_out.data(), c_out.data(), n);
+            }, 1000);
+        }
+        pln::kernels::set_simd_level(original);
+    }
+
+    // SoA batch straight from the atom table: gather, kernel, scatter
+    {
+        constexpr size_t n = 1'000'000;
+        AtomSpace space;
+        std::vector<AtomId> ab_ids, bc_ids, b_ids, c_ids;
+        for (size_t i = 0; i < 1000; ++i) {
+            b_ids.push_back(space.add_node(AtomType::CONCEPT_NODE, "B" + std::to_string(i),
+                                           TruthValue{0.3f, 0.9f}).id());
+            ab_ids.push_back(space.add_link(AtomType::INHERITANCE_LINK,
+                {space.make_handle(b_ids.back()), space.add_node(AtomType::CONCEPT_NODE, "X")},
+                TruthValue{0.8f, 0.9f}).id());
+        }
+        // Triples cycle through the same atoms; only the column traffic matters
+        for (size_t i = 1000; i < n; ++i) ab_ids.push_back(ab_ids[i % 1000]);
+        b_ids.resize(n);
+        for (size_t i = 1000; i < n; ++i) b_ids[i] = b_ids[i % 1000];
+        bc_ids = ab_ids;
+        c_ids = b_ids;
+
+        pln::TVBuffer ab(n), bc(n), ac(n);
+        SimdVector<float> sB(n), sC(n);
+
+        auto run = [&] {
+            space.gather_tvs(ab_ids, ab.strength.data(), ab.confidence.data());
+            space.gather_tvs(bc_ids, bc.strength.data(), bc.confidence.data());
+            space.gather_tvs(b_ids, sB.data(), nullptr);
+            space.gather_tvs(c_ids, sC.data(), nullptr);
+            return pln::batch_deduction(ab.view(), bc.view(), {sB.data(), n}, {sC.data(), n},
+                                        ac.columns());
+        };
+
+        benchmark("SoA gather + deduction (1M triples)", [&]() { (void)run(); }, 10);
+        count_allocations("  SoA gather + deduction", run, "triple", "triples");
+    }
+
+    // Whole-graph one-hop deduction: 100 sources x 20 hubs x 50 targets
+    {
+        AtomSpace space;
+        std::vector<Handle> hubs;
+        for (int h = 0; h < 20; ++h) {
+            hubs.push_back(space.add_node(AtomType::CONCEPT_NODE, "H" + std::to_string(h)));
+        }
+        for (int i = 0; i < 100; ++i) {
+            Handle a = space.add_node(AtomType::CONCEPT_NODE, "S" + std::to_string(i));
+            (void)space.add_link(AtomType::INHERITANCE_LINK, {a, hubs[i % hubs.size()]}, TruthValue{0.9f, 0.8f});
+        }
+        for (int i = 0; i < 50; ++i) {
+            Handle c = space.add_node(AtomType::CONCEPT_NODE, "T" + std::to_string(i));
+            for (Handle hub : hubs) {
+                (void)space.add_link(AtomType::INHERITANCE_LINK, {hub, c}, TruthValue{0.8f, 0.9f});
+            }
+        }
+
+        pln::PLNEngine engine(space);
+        size_t pairs = 0;
+        benchmark("Bulk deduction (5000 pairs), first pass", [&]() {
+            pairs = engine.deduce_all().premise_pairs;
+        });
+        benchmark("Bulk deduction (5000 pairs), revising pass", [&]() {
+            pairs = engine.deduce_all().premise_pairs;
+        });
+        (void)pairs;
+    }
+
+    // Semi-naive forward chaining to a fixed point over a layered DAG:
+    // 5 layers of 40 concepts, each linked to 3 concepts of the next layer
+    {
+        AtomSpace space;
+        std::mt19937 rng(7);
+        std::vector<std::vector<Handle>> layers(5);
+        for (size_t l = 0; l < layers.size(); ++l) {
+            for (int i = 0; i < 40; ++i) {
+                layers[l].push_back(space.add_node(AtomType::CONCEPT_NODE,
+                    "L" + std::to_string(l) + "_" + std::to_string(i), TruthValue{0.4f, 0.9f}));
+            }
+        }
+        std::uniform_int_distribution<size_t> pick(0, 39);
+        for (size_t l = 0; l + 1 < layers.size(); ++l) {
+            for (Handle from : layers[l]) {
+                for (int k = 0; k < 3; ++k) {
+                    (void)space.add_link(AtomType::INHERITANCE_LINK, {from, layers[l + 1][pick(rng)]},
+                                         TruthValue{0.9f, 0.9f});
+                }
+            }
+        }
+
+        pln::InferenceConfig config;
+        config.max_results = SIZE_MAX;
+        config.record_proof = false;
+        config.min_confidence = 0.0f;
+        pln::PLNEngine engine(space, config);
+        engine.add_rule(pln::rules::make_deduction_rule());
+
+        size_t conclusions = 0;
+        benchmark("Forward chain to fixed point (5x40 DAG)", [&]() {
+            conclusions = engine.forward_chain_all().size();
+        });
+        std::cout << "  " << conclusions << " conclusions, "
+                  << engine.total_inferences() << " rule firings\n";
+    }
+
+    // Tabled backward chaining: C0->C31 over a 32-concept chain, where
+    // every C0->Ck is an unknown subgoal proven from C0->C(k-1); with
+    // proofs recorded, each subgoal adds one shared DAG node
+    for (bool record : {false, true}) {
+        AtomSpace space;
+        std::vector<Handle> chain;
+        for (int i = 0; i < 32; ++i) {
+            chain.push_back(space.add_node(AtomType::CONCEPT_NODE, "C" + std::to_string(i),
+                                           TruthValue{0.5f, 0.9f}));
+        }
+        Handle goal;
+        for (size_t i = 1; i < chain.size(); ++i) {
+            (void)space.add_link(AtomType::INHERITANCE_LINK, {chain[i - 1], chain[i]},
+                                 TruthValue{0.95f, 0.99f});
+            goal = space.add_link(AtomType::INHERITANCE_LINK, {chain[0], chain[i]}, TruthValue{});
+        }
+
+        pln::InferenceConfig config;
+        config.record_proof = record;
+        config.min_confidence = 0.01f;
+        pln::PLNEngine engine(space, config);
+        engine.add_rule(pln::rules::make_deduction_rule());
+
+        const std::string suffix = record ? ", proofs" : "";
+        std::optional<pln::InferenceResult> result;
+        benchmark("Backward chain (32-chain), cold" + suffix, [&]() {
+            engine.clear_cache();
+            result = engine.backward_chain(goal);
+        }, 100);
+        benchmark("Backward chain (32-chain), tabled" + suffix, [&]() {
+            result = engine.backward_chain(goal);
+        }, 10000);
+        std::cout << "  proven: " << (result ? "yes" : "no") << ", "
+                  << engine.cache_hits() << " table hits";
+        if (record && result) {
+            std::cout << ", " << result->proof.size() << " proof steps";
+        }
+        std::cout << "\n";
+    }
+
+    // Attention-sampled inference on a graph too large to expand: 20,000
+    // concepts with 100,000 random links, 100 of the concepts stimulated
+    {
+        AtomSpace space;
+        AttentionBank bank(space);
+        std::mt19937 rng(11);
+        std::vector<Handle> concepts;
+        for (int i = 0; i < 20000; ++i) {
+            concepts.push_back(space.add_node(AtomType::CONCEPT_NODE, "S" + std::to_string(i),
+                                              TruthValue{0.4f, 0.9f}));
+        }
+        std::uniform_int_distribution<size_t> pick(0, concepts.size() - 1);
+        for (int i = 0; i < 100000; ++i) {
+            (void)space.add_link(AtomType::INHERITANCE_LINK,
+                                 {concepts[pick(rng)], concepts[pick(rng)]},
+                                 TruthValue{0.9f, 0.9f});
+        }
+        for (int i = 0; i < 100; ++i) bank.stimulate(concepts[pick(rng)].id(), 10.0f + i);
+
+        pln::InferenceConfig config;
+        config.record_proof = false;
+        config.max_results = 50;
+        pln::PLNEngine engine(space, config);
+        engine.add_rule(pln::rules::make_deduction_rule());
+
+        pln::SamplingBudget budget;
+        budget.max_evaluations = 2000;
+        size_t conclusions = 0;
+        benchmark("Sampled inference (2000 evaluations)", [&]() {
+            engine.reset_stats();
+            conclusions = engine.sample_forward(bank, budget).size();
+        });
+        std::cout << "  " << engine.total_inferences() << " evaluations, "
+                  << conclusions << " best conclusions kept\n";
+
+        budget.max_evaluations = SIZE_MAX;
+        budget.max_time = std::chrono::microseconds(10000);
+        benchmark("Sampled inference (10 ms budget)", [&]() {
+            engine.reset_stats();
+            conclusions = engine.sample_forward(bank, budget).size();
+        });
+        std::cout << "  " << engine.total_inferences() << " evaluations\n";
+    }
+
+    // Incremental inference: every link of a 5x40 layered DAG as a stimulus,
+    // run until no work is left, serially and on every hardware thread
+    for (size_t threads : {size_t{1}, size_t{0}}) {
+        AtomSpace space;
+        std::vector<Handle> stimuli;
+        std::mt19937 rng(7);
+        std::uniform_int_distribution<size_t> pick(0, 39);
+        std::vector<std::vector<Handle>> layers(5);
+        for (size_t l = 0; l < layers.size(); ++l) {
+            for (int i = 0; i < 40; ++i) {
+                layers[l].push_back(space.add_node(AtomType::CONCEPT_NODE,
+                    "L" + std::to_string(l) + "_" + std::to_string(i), TruthValue{0.4f, 0.9f}));
+            }
+        }
+        for (size_t l = 0; l + 1 < layers.size(); ++l) {
+            for (Handle from : layers[l]) {
+                for (int k = 0; k < 3; ++k) {
+                    stimuli.push_back(space.add_link(AtomType::INHERITANCE_LINK,
+                        {from, layers[l + 1][pick(rng)]}, TruthValue{0.9f, 0.9f}));
+                }
+            }
+        }
+
+        pln::InferenceConfig config;
+        config.max_results = SIZE_MAX;
+        config.record_proof = false;
+        pln::PLNEngine engine(space, config);
+        engine.add_rule(pln::rules::make_deduction_rule());
+        pln::IncrementalInference incr(engine, threads);
+
+        size_t conclusions = 0;
+        benchmark("Incremental inference, " + std::to_string(incr.threads()) + " thread(s)", [&]() {
+            for (Handle h : stimuli) incr.add_stimulus(h);
+            conclusions = incr.run(SIZE_MAX).size();
+        });
+        std::cout << "  " << stimuli.size() << " stimuli, " << conclusions << " conclusions\n";
+    }
+}
+
+// ============================================================================
+// URE Benchmarks
+// ============================================================================
+
+void bench_ure() {
+    std::cout << "\n=== URE Benchmarks ===\n\n";
+
+    // Frontier selection at steady state: each cycle pops one atom and
+    // pushes a fresh one, so cost per step should not depend on frontier size
+    AtomSpace space;
+    std::vector<Handle> atoms;
+    for (int i = 0; i < 200'000; ++i) {
+        atoms.push_back(space.add_node(AtomType::CONCEPT_NODE, "F" + std::to_string(i),
+                                       TruthValue{static_cast<float>(i % 997) / 997.0f, 0.9f}));
+    }
+
+    for (auto [strategy, name] : {std::pair{ure::SearchStrategy::BFS, "BFS"},
+                                  {ure::SearchStrategy::BEST_FIRST, "best-first"},
+                                  {ure::SearchStrategy::RANDOM, "random"}}) {
+        for (size_t size : {size_t{1'000}, size_t{100'000}}) {
+            ure::Frontier frontier(strategy, [&](Handle h) { return space.get_tv(h).strength; }, 1);
+            for (size_t i = 0; i < size; ++i) frontier.push(atoms[i]);
+
+            constexpr size_t cycles = 100'000;
+            double us = benchmark("Frontier " + std::string(name) + ", " + std::to_string(size) +
+                                  " queued", [&]() {
+                for (size_t i = 0; i < cycles; ++i) {
+                    (void)frontier.pop();
+                    frontier.push(atoms[(size + i) % atoms.size()]);
+                }
+            });
+            std::cout << "  " << std::setprecision(1) << us * 1000.0 / cycles << " ns per step\n";
+        }
+    }
+
+    // Rule selection with 2,000 rules, each grounded on one concept:
+    // discrimination-tree lookup against unifying every premise
+    {
+        constexpr size_t num_rules = 2'000;
+        constexpr AtomType link_types[] = {AtomType::INHERITANCE_LINK, AtomType::SIMILARITY_LINK,
+                                           AtomType::IMPLICATION_LINK, AtomType::EVALUATION_LINK};
+        Handle y = space.add_node(AtomType::VARIABLE_NODE, "$Y");
+        ure::RuleBase rules(space);
+        for (size_t i = 0; i < num_rules; ++i) {
+            ure::Rule rule;
+            rule.name = "rule-" + std::to_string(i);
+            rule.premise = space.add_link(link_types[i % 4], {atoms[i / 4], y});
+            rule.conclusion = rule.premise;
+            rule.priority = static_cast<float>(i % 7);
+            rules.add_rule(std::move(rule));
+        }
+
+        std::vector<Handle> sources;
+        for (size_t i = 0; i < 1'000; ++i) {
+            sources.push_back(space.add_link(link_types[i % 4], {atoms[(i * 7) % 500], atoms[i]}));
+        }
+
+        // Programs are shared, so a snapshot costs copying rules and indexing
+        auto staged = rules.get_all_rules();
+        size_t compiled = 0;
+        double snapshot_us = benchmark("Rule set snapshot (2,000 rules)", [&]() {
+            compiled += ure::RuleSet::compile(space, staged)->size();
+        }, 10);
+        std::cout << "  " << std::setprecision(1) << snapshot_us * 1000.0 / (static_cast<double>(compiled) / 10.0)
+                  << " ns per rule\n";
+
+        const auto set = rules.snapshot();
+        std::vector<const ure::Rule*> found;
+        size_t indexed = 0;
+        double index_us = benchmark("Rule selection, index (2,000 rules)", [&]() {
+            for (Handle source : sources) {
+                found.clear();
+                indexed += set->for_atom(space, source, found);
+            }
+        });
+        std::cout << "  " << std::setprecision(1) << index_us * 1000.0 / sources.size()
+                  << " ns per source\n";
+
+        size_t scanned = 0;
+        double scan_us = benchmark("Rule selection, scan (2,000 rules)", [&]() {
+            for (Handle source : sources) {
+                for (const ure::Rule* rule : set->by_priority()) {
+                    scanned += rules.could_apply(*rule, source);
+                }
+            }
+        });
+        std::cout << "  " << std::setprecision(1) << scan_us * 1000.0 / sources.size()
+                  << " ns per source (" << std::setprecision(0) << scan_us / index_us
+                  << "x, " << indexed << " = " << scanned << " matches)\n";
+    }
+
+    // Rule application: match a source and build a nested conclusion
+    // (Implication (And (Inheritance $X $Y) (Inheritance $Y $X)) (Similarity $X $Y))
+    {
+        Handle x = space.add_node(AtomType::VARIABLE_NODE, "$X");
+        Handle y = space.add_node(AtomType::VARIABLE_NODE, "$Y");
+        ure::RuleBase rules(space);
+        ure::Rule rule;
+        rule.name = "symmetric-closure";
+        rule.premise = space.add_link(AtomType::INHERITANCE_LINK, {x, y});
+        rule.conclusion = space.add_link(AtomType::IMPLICATION_LINK, {
+            space.add_link(AtomType::AND_LINK, {rule.premise,
+                space.add_link(AtomType::INHERITANCE_LINK, {y, x})}),
+            space.add_link(AtomType::SIMILARITY_LINK, {x, y})});
+        rules.add_rule(std::move(rule));
+        ure::RuleApplicator applicator(space, rules);
+
+        std::vector<Handle> sources;
+        for (size_t i = 0; i < 20'000; ++i) {
+            sources.push_back(space.add_link(AtomType::INHERITANCE_LINK,
+                                             {atoms[i], atoms[i + 100'000]}));
+        }
+
+        for (const char* pass : {"first", "repeat"}) {
+            size_t applied = 0;
+            double us = benchmark("Rule application, " + std::string(pass) + " (20,000)", [&]() {
+                for (Handle source : sources) applied += applicator.apply_all(source).size();
+            });
+            std::cout << "  " << std::setprecision(1) << us * 1000.0 / sources.size()
+                      << " ns per application (" << applied << " results)\n";
+        }
+    }
+
+    // Forward chaining over 10,000 sources: sequential loop against the
+    // batched chainer (match on every thread, commit in frontier order),
+    // and the sequential loop again with every result's proof recorded
+    struct ChainRun {
+        size_t threads;
+        bool record;
+        bool profile = false;
+    };
+    for (ChainRun run : {ChainRun{1, false}, ChainRun{4, false}, ChainRun{1, true},
+                         ChainRun{1, false, true}}) {
+        AtomSpace chain_space;
+        std::vector<Handle> concepts;
+        for (size_t i = 0; i < 10'001; ++i) {
+            concepts.push_back(chain_space.add_node(AtomType::CONCEPT_NODE, "K" + std::to_string(i)));
+        }
+        Handle x = chain_space.add_node(AtomType::VARIABLE_NODE, "$X");
+        Handle y = chain_space.add_node(AtomType::VARIABLE_NODE, "$Y");
+
+        ure::UREConfig config;
+        config.strategy = ure::SearchStrategy::BFS;
+        config.min_result_confidence = 0.0f;
+        config.record_proofs = run.record;
+        config.profile_rules = run.profile;
+        config.max_iterations = SIZE_MAX;
+        config.max_results = SIZE_MAX;
+        config.timeout = std::chrono::minutes(10);
+        config.threads = run.threads;
+        ure::UREngine engine(chain_space, config);
+
+        ure::Rule flip;
+        flip.name = "flip";
+        flip.premise = chain_space.add_link(AtomType::INHERITANCE_LINK, {x, y});
+        flip.conclusion = chain_space.add_link(AtomType::SIMILARITY_LINK, {y, x});
+        engine.rules().add_rule(flip);
+        ure::Rule back;
+        back.name = "back";
+        back.premise = chain_space.add_link(AtomType::SIMILARITY_LINK, {x, y});
+        back.conclusion = chain_space.add_link(AtomType::INHERITANCE_LINK, {x, y});
+        engine.rules().add_rule(back);
+
+        std::vector<Handle> sources;
+        for (size_t i = 0; i + 1 < concepts.size(); ++i) {
+            sources.push_back(chain_space.add_link(AtomType::INHERITANCE_LINK,
+                                                   {concepts[i], concepts[i + 1]}));
+        }
+
+        size_t produced = 0;
+        const std::string name = "URE forward chain, " + std::to_string(run.threads) +
+                                 " thread(s)" + (run.record ? ", proofs" : "") +
+                                 (run.profile ? ", profiled" : "");
+        double us = benchmark(name, [&]() {
+            produced = engine.forward_chain(std::span<const Handle>(sources)).size();
+        });
+        std::cout << "  " << produced << " results, " << std::setprecision(1)
+                  << us * 1000.0 / static_cast<double>(engine.stats().total_iterations)
+                  << " ns per iteration\n";
+    }
+
+    // Goal-directed query over 10,000 sources: forward chaining until the
+    // target turns up, against bidirectional search meeting it halfway
+    {
+        AtomSpace goal_space;
+        std::vector<Handle> concepts;
+        for (size_t i = 0; i < 10'001; ++i) {
+            concepts.push_back(goal_space.add_node(AtomType::CONCEPT_NODE, "K" + std::to_string(i)));
+        }
+        Handle x = goal_space.add_node(AtomType::VARIABLE_NODE, "$X");
+        Handle y = goal_space.add_node(AtomType::VARIABLE_NODE, "$Y");
+        Handle w = goal_space.add_node(AtomType::VARIABLE_NODE, "$W");
+
+        ure::UREConfig config;
+        config.strategy = ure::SearchStrategy::BFS;
+        config.min_result_confidence = 0.0f;
+        config.max_iterations = SIZE_MAX;
+        config.max_results = SIZE_MAX;
+        config.timeout = std::chrono::minutes(10);
+        ure::UREngine engine(goal_space, config);
+
+        ure::Rule flip;
+        flip.name = "flip";
+        flip.premise = goal_space.add_link(AtomType::INHERITANCE_LINK, {x, y});
+        flip.conclusion = goal_space.add_link(AtomType::SIMILARITY_LINK, {y, x});
+        engine.rules().add_rule(flip);
+        ure::Rule subset;
+        subset.name = "subset";
+        subset.premise = goal_space.add_link(AtomType::SIMILARITY_LINK, {x, y});
+        subset.conclusion = goal_space.add_link(AtomType::SUBSET_LINK, {x, y});
+        engine.rules().add_rule(subset);
+
+        std::vector<Handle> sources;
+        for (size_t i = 0; i + 1 < concepts.size(); ++i) {
+            sources.push_back(goal_space.add_link(AtomType::INHERITANCE_LINK,
+                                                  {concepts[i], concepts[i + 1]}));
+        }
+        Handle target = goal_space.add_link(AtomType::SUBSET_LINK, {concepts[5001], concepts[5000]});
+        Handle open = goal_space.add_link(AtomType::SUBSET_LINK, {concepts[5001], w});
+
+        // Each query searches afresh, not from a proof memoized last time
+        auto report = [&](const std::string& name, auto&& query) {
+            engine.reset_stats();
+            bool found = false;
+            benchmark(name, [&]() {
+                engine.clear_goal_table();
+                found = query().has_value();
+            }, 10);
+            std::cout << "  " << (found ? "found" : "not found") << ", "
+                      << engine.stats().total_iterations / 10 << " states expanded per query\n";
+        };
+        report("URE goal query, forward to target", [&] {
+            return engine.forward_chain_to(sources, target);
+        });
+        report("URE goal query, bidirectional", [&] {
+            return engine.bidirectional_chain(sources, target);
+        });
+        report("URE goal query, bidirectional, open", [&] {
+            return engine.bidirectional_chain(sources, open);
+        });
+
+        // Backward steps over 1,000 rules for goals of 10 shapes under
+        // fresh variable names, scanned each time against memoized
+        for (size_t i = 0; i < 1'000; ++i) {
+            ure::Rule rule;
+            rule.name = "backward-" + std::to_string(i);
+            rule.premise = goal_space.add_link(AtomType::INHERITANCE_LINK, {x, concepts[i]});
+            rule.conclusion = goal_space.add_link(AtomType::IMPLICATION_LINK, {x, concepts[i]});
+            engine.rules().add_rule(std::move(rule));
+        }
+        std::vector<Handle> goals;
+        for (size_t i = 0; i < 1'000; ++i) {
+            Handle v = goal_space.add_node(AtomType::VARIABLE_NODE, "$G" + std::to_string(i));
+            goals.push_back(goal_space.add_link(AtomType::IMPLICATION_LINK, {v, concepts[i % 10]}));
+        }
+        for (size_t capacity : {size_t{0}, ure::GoalTable::DEFAULT_CAPACITY}) {
+            config.goal_table_capacity = capacity;
+            engine.set_config(config);
+            engine.reset_stats();
+            size_t expansions = 0;
+            double us = benchmark(capacity ? "URE backward step, goal table"
+                                           : "URE backward step, no table", [&]() {
+                for (Handle goal : goals) expansions += engine.backward_step(goal).size();
+            });
+            std::cout << "  " << std::setprecision(1) << us * 1000.0 / goals.size()
+                      << " ns per goal (" << expansions << " expansions, "
+                      << std::setprecision(2) << engine.stats().expansion_hit_rate() * 100.0
+                      << "% hits)\n";
+        }
+        for (size_t i = 0; i < 1'000; ++i) {
+            engine.rules().remove_rule("backward-" + std::to_string(i));
+        }
+
+        // Streaming: first result long before the whole run is done, and
+        // a stop from another thread ends the run within a rule firing
+        config.record_proofs = false;
+        engine.set_config(config);
+        benchmark("URE stream, first result", [&]() {
+            auto stream = engine.forward_chain_stream(sources);
+            static_cast<void>(stream.next());
+        }, 100);
+
+        std::stop_source stop;
+        std::chrono::steady_clock::time_point finished;
+        size_t partial = 0;
+        std::thread worker([&] {
+            partial = engine.forward_chain(std::span<const Handle>(sources), stop.get_token()).size();
+            finished = std::chrono::steady_clock::now();
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        const auto requested = std::chrono::steady_clock::now();
+        stop.request_stop();
+        worker.join();
+        std::cout << std::left << std::setw(40) << "URE cancel latency" << std::right
+                  << std::setw(12) << std::fixed << std::setprecision(2)
+                  << std::chrono::duration<double, std::micro>(finished - requested).count()
+                  << " us (" << partial << " results before the stop)\n";
+    }
 }
 
 // ============================================================================
@@ -401,6 +1158,7 @@ int main() {
     bench_attention();
     bench_pattern();
     bench_pln();
+    bench_ure();
 
     std::cout << "\n============================================================\n";
     std::cout << "Benchmarks complete.\n";
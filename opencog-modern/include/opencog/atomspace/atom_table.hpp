@@ -14,6 +14,7 @@
 #include <atomic>
 #include <mutex>
 #include <shared_mutex>
+#include <span>
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -72,22 +73,26 @@ public:
 
     /**
      * @brief Add a node to the table
+     * @param created If non-null, set to whether a new atom was inserted
      * @return AtomId of the created node (or existing if duplicate)
      */
     [[nodiscard]] AtomId add_node(
         AtomType type,
         std::string_view name,
-        TruthValue tv = TruthValue::default_tv()
+        TruthValue tv = TruthValue::default_tv(),
+        bool* created = nullptr
     );
 
     /**
      * @brief Add a link to the table
+     * @param created If non-null, set to whether a new atom was inserted
      * @return AtomId of the created link (or existing if duplicate)
      */
     [[nodiscard]] AtomId add_link(
         AtomType type,
         std::span<const AtomId> outgoing,
-        TruthValue tv = TruthValue::default_tv()
+        TruthValue tv = TruthValue::default_tv(),
+        bool* created = nullptr
     );
 
     /**
@@ -112,6 +117,14 @@ public:
      */
     bool remove_atom(AtomId id, bool recursive = false);
 
+    /**
+     * @brief Remove all atoms and release their names and outgoing sets
+     *
+     * Slots are kept for reuse with their generation counters, so handles
+     * taken before the clear never alias atoms added after it.
+     */
+    void clear();
+
     // ========================================================================
     // Atom Lookup
     // ========================================================================
@@ -143,6 +156,24 @@ public:
     void set_tv(AtomId id, TruthValue tv) noexcept;
     void set_av(AtomId id, AttentionValue av) noexcept;
 
+    /**
+     * @brief Copy the truth values of ids into caller-owned SoA columns
+     *
+     * Writes ids.size() floats to each non-null column. Missing atoms read
+     * as TruthValue{}. Never allocates.
+     */
+    void gather_tvs(std::span<const AtomId> ids,
+                    float* strength, float* confidence) const noexcept;
+
+    /**
+     * @brief Store SoA columns back as the truth values of ids
+     *
+     * A null column leaves that component unchanged. Missing atoms are
+     * skipped.
+     */
+    void scatter_tvs(std::span<const AtomId> ids,
+                     const float* strength, const float* confidence) noexcept;
+
     // ========================================================================
     // Atom Properties (Cold Path)
     // ========================================================================
@@ -158,6 +189,24 @@ public:
     [[nodiscard]] std::vector<AtomId> get_incoming(AtomId id) const;
     [[nodiscard]] size_t get_incoming_size(AtomId id) const noexcept;
 
+    // ========================================================================
+    // Slot Scanning
+    // ========================================================================
+
+    /**
+     * @brief One past the highest slot index allocated so far
+     */
+    [[nodiscard]] size_t slot_count() const;
+
+    /**
+     * @brief Append the live atoms in slots [begin, end) to out
+     *
+     * Stops early once max atoms have been appended.
+     * @return Slot index to resume from (at most slot_count())
+     */
+    size_t scan_slots(size_t begin, size_t end, std::vector<AtomId>& out,
+                      size_t max = SIZE_MAX) const;
+
     // ========================================================================
     // Statistics
     // ========================================================================
@@ -189,7 +238,7 @@ private:
     // ------------------------------------------------------------------------
     // Indices for Fast Lookup
     // ------------------------------------------------------------------------
-    std::unordered_map<uint64_t, AtomId> hash_index_;  // hash -> AtomId
+    std::unordered_multimap<uint64_t, AtomId> hash_index_;  // hash -> atoms with it
 
     // ------------------------------------------------------------------------
     // Free List for Slot Reuse
@@ -215,6 +264,12 @@ private:
     [[nodiscard]] uint64_t compute_node_hash(AtomType type, std::string_view name) const;
     [[nodiscard]] uint64_t compute_link_hash(AtomType type, std::span<const AtomId> outgoing) const;
 
+    // Hash index probes; the caller holds global_mutex_
+    [[nodiscard]] AtomId find_node_locked(AtomType type, std::string_view name,
+                                          uint64_t hash) const;
+    [[nodiscard]] AtomId find_link_locked(AtomType type, std::span<const AtomId> outgoing,
+                                          uint64_t hash) const;
+
     [[nodiscard]] AtomId allocate_slot();
     void free_slot(AtomId id);
 
@@ -222,12 +277,70 @@ private:
         return id.index() % SHARD_COUNT;
     }
 
+    bool remove_atom_locked(AtomId id, bool recursive);
+
     void add_to_incoming(AtomId target, AtomId link);
     void remove_from_incoming(AtomId target, AtomId link);
 
     [[nodiscard]] bool is_valid_slot(AtomId id) const noexcept;
 };
 
+// ============================================================================
+// Atom Cursor
+// ============================================================================
+
+/**
+ * @brief Streaming iteration over every live atom, in slot order
+ *
+ * Atoms are produced in batches so a full-space scan never materializes
+ * the whole atom list; a consumer that stops early skips the rest of the
+ * table. Disjoint slot ranges can be scanned by independent cursors on
+ * different threads.
+ *
+ * Atoms added or removed while a cursor is open may or may not be seen,
+ * but no slot is visited twice.
+ *
+ * Usage:
+ *   AtomCursor cursor(table);
+ *   for (auto batch = cursor.next_batch(); !batch.empty(); batch = cursor.next_batch()) {
+ *       for (AtomId id : batch) process(id);
+ *   }
+ */
+class AtomCursor {
+public:
+    static constexpr size_t DEFAULT_BATCH = 1024;
+
+    explicit AtomCursor(const AtomTable& table,
+                        size_t begin = 0,
+                        size_t end = SIZE_MAX,
+                        size_t batch = DEFAULT_BATCH)
+        : table_(table), pos_(begin), end_(end), batch_(batch > 0 ? batch : 1) {}
+
+    /**
+     * @brief Next batch of live atoms; empty once the range is exhausted
+     *
+     * The span stays valid until the next call.
+     */
+    [[nodiscard]] std::span<const AtomId> next_batch() {
+        buffer_.clear();
+        while (buffer_.empty() && !done()) {
+            pos_ = table_.scan_slots(pos_, end_, buffer_, batch_);
+            if (pos_ >= table_.slot_count()) end_ = pos_;
+        }
+        return buffer_;
+    }
+
+    [[nodiscard]] bool done() const noexcept { return pos_ >= end_; }
+    [[nodiscard]] size_t position() const noexcept { return pos_; }
+
+private:
+    const AtomTable& table_;
+    size_t pos_;
+    size_t end_;
+    size_t batch_;
+    std::vector<AtomId> buffer_;
+};
+
 // ============================================================================
 // Inline Implementations (Hot Path)
 // ============================================================================
@@ -264,6 +377,25 @@ inline void AtomTable::set_tv(AtomId id, TruthValue tv) noexcept {
     }
 }
 
+inline void AtomTable::gather_tvs(std::span<const AtomId> ids,
+                                  float* strength, float* confidence) const noexcept {
+    for (size_t i = 0; i < ids.size(); ++i) {
+        const TruthValue tv = get_tv(ids[i]);
+        if (strength) strength[i] = tv.strength;
+        if (confidence) confidence[i] = tv.confidence;
+    }
+}
+
+inline void AtomTable::scatter_tvs(std::span<const AtomId> ids,
+                                   const float* strength, const float* confidence) noexcept {
+    for (size_t i = 0; i < ids.size(); ++i) {
+        if (!is_valid_slot(ids[i])) continue;
+        TruthValue& tv = truth_values_[ids[i].index()];
+        if (strength) tv.strength = strength[i];
+        if (confidence) tv.confidence = confidence[i];
+    }
+}
+
 inline void AtomTable::set_av(AtomId id, AttentionValue av) noexcept {
     if (is_valid_slot(id)) {
         attention_values_[id.index()] = av;
@@ -13,6 +13,8 @@
 #include <opencog/atomspace/atom_table.hpp>
 #include <opencog/atomspace/index.hpp>
 
+#include <array>
+#include <atomic>
 #include <functional>
 #include <optional>
 #include <ranges>
@@ -21,6 +23,34 @@
 
 namespace opencog {
 
+// ============================================================================
+// Change Notification
+// ============================================================================
+
+/**
+ * @brief Receives notifications of AtomSpace mutations
+ *
+ * Only changes made through the AtomSpace API are reported; writes made
+ * directly on the AtomTable bypass observers. Callbacks run synchronously
+ * on the mutating thread.
+ */
+class AtomSpaceObserver {
+public:
+    virtual ~AtomSpaceObserver() = default;
+
+    /** @brief A new atom was inserted (duplicates are not reported) */
+    virtual void on_atom_added(AtomId id) = 0;
+
+    /** @brief An atom was removed; only its id remains meaningful */
+    virtual void on_atom_removed(AtomId id) = 0;
+
+    /** @brief An atom's truth value was replaced */
+    virtual void on_tv_changed(AtomId id, TruthValue old_tv) = 0;
+
+    /** @brief Every atom was removed at once; no earlier id is meaningful */
+    virtual void on_clear() = 0;
+};
+
 /**
  * @brief The central knowledge hypergraph
  *
@@ -47,11 +77,14 @@ public:
      * Usage:
      *   auto cat = space.add_node(CONCEPT_NODE, "Cat");
      *   auto cat = space.add_node(CONCEPT_NODE, "Cat", TruthValue{0.9, 0.8});
+     *
+     * @param created If non-null, set to whether a new atom was inserted
      */
     [[nodiscard]] Handle add_node(
         AtomType type,
         std::string_view name,
-        TruthValue tv = TruthValue::default_tv()
+        TruthValue tv = TruthValue::default_tv(),
+        bool* created = nullptr
     );
 
     /**
@@ -59,23 +92,28 @@ public:
      *
      * Usage:
      *   auto link = space.add_link(INHERITANCE_LINK, {cat, animal});
+     *
+     * @param created If non-null, set to whether a new atom was inserted
      */
     [[nodiscard]] Handle add_link(
         AtomType type,
         std::initializer_list<Handle> outgoing,
-        TruthValue tv = TruthValue::default_tv()
+        TruthValue tv = TruthValue::default_tv(),
+        bool* created = nullptr
     );
 
     [[nodiscard]] Handle add_link(
         AtomType type,
         std::span<const Handle> outgoing,
-        TruthValue tv = TruthValue::default_tv()
+        TruthValue tv = TruthValue::default_tv(),
+        bool* created = nullptr
     );
 
     [[nodiscard]] Handle add_link(
         AtomType type,
         std::span<const AtomId> outgoing,
-        TruthValue tv = TruthValue::default_tv()
+        TruthValue tv = TruthValue::default_tv(),
+        bool* created = nullptr
     );
 
     // ========================================================================
@@ -131,6 +169,21 @@ public:
     [[nodiscard]] TruthValue get_tv(Handle h) const noexcept;
     void set_tv(Handle h, TruthValue tv);
 
+    /**
+     * @brief Gather truth values into caller-owned SoA columns
+     * @see AtomTable::gather_tvs
+     */
+    void gather_tvs(std::span<const AtomId> ids,
+                    float* strength, float* confidence) const noexcept {
+        table_.gather_tvs(ids, strength, confidence);
+    }
+
+    /**
+     * @brief Batched set_tv from SoA columns; observers see each change
+     */
+    void set_tvs(std::span<const AtomId> ids,
+                 const float* strength, const float* confidence);
+
     [[nodiscard]] AttentionValue get_av(Handle h) const noexcept;
     void set_av(Handle h, AttentionValue av);
 
@@ -184,6 +237,42 @@ public:
     [[nodiscard]] size_t node_count() const noexcept;
     [[nodiscard]] size_t link_count() const noexcept;
 
+    // ========================================================================
+    // Modification Counters
+    // ========================================================================
+
+    /**
+     * @brief Counter bumped whenever an atom is added or removed
+     */
+    [[nodiscard]] uint64_t version() const noexcept {
+        return version_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Counter bumped whenever an atom of this type is added or removed
+     *
+     * Types are hashed into a fixed set of counters, so a change to one type
+     * may also bump the counter of another; the counter never stays unchanged
+     * across a change to its own type. Truth and attention value updates do
+     * not count as modifications.
+     */
+    [[nodiscard]] uint64_t type_version(AtomType type) const noexcept {
+        return type_versions_[type_version_slot(type)].load(std::memory_order_acquire);
+    }
+
+    // ========================================================================
+    // Observers
+    // ========================================================================
+
+    /**
+     * @brief Register an observer of atom additions, removals and TV changes
+     *
+     * Not synchronized with concurrent mutation: register observers before
+     * sharing the AtomSpace between threads.
+     */
+    void add_observer(AtomSpaceObserver* observer);
+    void remove_observer(AtomSpaceObserver* observer);
+
     // ========================================================================
     // Utilities
     // ========================================================================
@@ -216,6 +305,22 @@ public:
 private:
     AtomTable table_;
     IndexManager indices_;
+    std::vector<AtomSpaceObserver*> observers_;
+
+    static constexpr size_t TYPE_VERSION_SLOTS = 128;
+    std::atomic<uint64_t> version_{0};
+    std::array<std::atomic<uint64_t>, TYPE_VERSION_SLOTS> type_versions_{};
+
+    [[nodiscard]] static constexpr size_t type_version_slot(AtomType type) noexcept {
+        return static_cast<size_t>(type) % TYPE_VERSION_SLOTS;
+    }
+
+    void bump_version(AtomType type) noexcept {
+        type_versions_[type_version_slot(type)].fetch_add(1, std::memory_order_acq_rel);
+        version_.fetch_add(1, std::memory_order_acq_rel);
+    }
+
+    void notify_tv_changed(AtomId id, TruthValue tv);
 
     // Helper to convert Handle vector to AtomId span
     [[nodiscard]] std::vector<AtomId> handles_to_ids(std::span<const Handle> handles) const;
@@ -246,7 +351,12 @@ inline TruthValue AtomSpace::get_tv(Handle h) const noexcept {
 }
 
 inline void AtomSpace::set_tv(Handle h, TruthValue tv) {
-    if (h.valid()) table_.set_tv(h.id(), tv);
+    if (!h.valid()) return;
+    if (observers_.empty()) {
+        table_.set_tv(h.id(), tv);
+    } else {
+        notify_tv_changed(h.id(), tv);
+    }
 }
 
 inline AttentionValue AtomSpace::get_av(Handle h) const noexcept {
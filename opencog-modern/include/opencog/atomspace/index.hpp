@@ -12,7 +12,9 @@
 #include <opencog/core/types.hpp>
 
 #include <algorithm>
+#include <mutex>
 #include <shared_mutex>
+#include <span>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -60,6 +62,29 @@ public:
         return it->second;
     }
 
+    /**
+     * @brief Append all atoms of a given type to out
+     *
+     * Lets callers reuse a buffer instead of receiving a fresh vector.
+     */
+    void collect(AtomType type, std::vector<AtomId>& out) const {
+        std::shared_lock lock(mutex_);
+        auto it = by_type_.find(type);
+        if (it == by_type_.end()) return;
+        out.insert(out.end(), it->second.begin(), it->second.end());
+    }
+
+    /**
+     * @brief Append all atoms whose type satisfies pred to out
+     */
+    template<typename Pred>
+    void collect_if(Pred&& pred, std::vector<AtomId>& out) const {
+        std::shared_lock lock(mutex_);
+        for (const auto& [type, ids] : by_type_) {
+            if (pred(type)) out.insert(out.end(), ids.begin(), ids.end());
+        }
+    }
+
     /**
      * @brief Get count of atoms of a given type
      */
@@ -130,8 +155,12 @@ public:
      */
     void insert(AtomType link_type, AtomId link_id, std::span<const AtomId> targets) {
         std::unique_lock lock(mutex_);
-        for (AtomId target : targets) {
-            index_[Key{link_type, target}].push_back(link_id);
+        for (size_t i = 0; i < targets.size(); ++i) {
+            // A target repeated in the outgoing set is indexed once
+            if (std::find(targets.begin(), targets.begin() + i, targets[i]) != targets.begin() + i) {
+                continue;
+            }
+            index_[Key{link_type, targets[i]}].push_back(link_id);
         }
     }
 
@@ -163,6 +192,25 @@ public:
         return it->second;
     }
 
+    /**
+     * @brief Append all links of a type pointing to a target to out
+     */
+    void collect(AtomType link_type, AtomId target, std::vector<AtomId>& out) const {
+        std::shared_lock lock(mutex_);
+        auto it = index_.find(Key{link_type, target});
+        if (it == index_.end()) return;
+        out.insert(out.end(), it->second.begin(), it->second.end());
+    }
+
+    /**
+     * @brief Count links of a type pointing to a target
+     */
+    [[nodiscard]] size_t count(AtomType link_type, AtomId target) const {
+        std::shared_lock lock(mutex_);
+        auto it = index_.find(Key{link_type, target});
+        return it == index_.end() ? 0 : it->second.size();
+    }
+
     void clear() {
         std::unique_lock lock(mutex_);
         index_.clear();
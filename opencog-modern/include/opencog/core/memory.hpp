@@ -30,7 +30,7 @@ namespace opencog {
 // ============================================================================
 
 inline constexpr size_t CACHE_LINE_SIZE = 64;
-inline constexpr size_t SIMD_ALIGNMENT = 32;  // AVX2
+inline constexpr size_t SIMD_ALIGNMENT = 64;  // AVX-512 vector, one cache line
 
 // ============================================================================
 // Aligned Allocation
@@ -0,0 +1,304 @@
+#pragma once
+/**
+ * @file engine.hpp
+ * @brief Explicit-stack pattern matching engine
+ *
+ * MatchEngine compiles a Pattern into a flat node array with integer
+ * variable slots, then searches it with an explicit backtracking stack:
+ * one frame per conjunct, a trail to undo bindings, and candidate buffers
+ * that are reused across matches. Once its buffers have grown, the engine
+ * finds matches without heap allocation; results are read through the
+ * engine itself or materialized into MatchResult on demand.
+ *
+ * PatternMatcher's generator API is a thin adapter over this engine.
+ */
+
+#include <opencog/pattern/pattern.hpp>
+#include <opencog/atomspace/atomspace.hpp>
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace opencog {
+
+// ============================================================================
+// Match Result
+// ============================================================================
+
+/**
+ * @brief Result of a pattern match attempt
+ */
+struct MatchResult {
+    BindingSet bindings;           // Variable bindings
+    AtomId matched_atom;           // The atom that matched
+    float confidence{1.0f};        // Match confidence (for fuzzy matching)
+
+    [[nodiscard]] bool valid() const { return matched_atom.valid(); }
+};
+
+// ============================================================================
+// Match Engine
+// ============================================================================
+
+/**
+ * @brief Non-coroutine backtracking matcher
+ *
+ * A top-level AndPattern is a conjunction: each term matches its own atom
+ * and variables are shared between terms. Negated terms are checked once
+ * every positive term is matched. Nested inside a link or an OrPattern,
+ * And/Or/Not constrain the single atom at that position instead.
+ *
+ * Each span a glob can take is a choice point. The lengths taken are kept
+ * with the bindings they produced; when the search backtracks into a
+ * candidate, its unification is replayed with the last of them moved on
+ * to the next span, so every split of every glob is enumerated.
+ *
+ * Usage:
+ *   MatchEngine engine(space);
+ *   engine.reset(pattern);
+ *   while (engine.next()) {
+ *       AtomId x = engine.value("X");
+ *   }
+ */
+class MatchEngine {
+public:
+    explicit MatchEngine(const AtomSpace& space, bool check_type_hierarchy = true);
+
+    void set_check_type_hierarchy(bool enabled) noexcept { check_type_hierarchy_ = enabled; }
+
+    // ========================================================================
+    // Search Control
+    // ========================================================================
+
+    /**
+     * @brief Compile a pattern and position before its first match
+     *
+     * The engine keeps no references into the pattern.
+     */
+    void reset(const Pattern& pattern);
+
+    /**
+     * @brief Compile a pattern with some variables already bound
+     *
+     * Bindings for names the pattern does not mention are ignored.
+     */
+    void reset(const Pattern& pattern, const BindingSet& initial);
+
+    /**
+     * @brief Rewind the compiled pattern to before its first match
+     *
+     * Clears bindings and pins; the compiled program is kept, so repeated
+     * searches over the same pattern skip recompilation.
+     */
+    void restart();
+
+    /**
+     * @brief Restrict a positive conjunct to a single atom
+     *
+     * Must be called after reset()/restart() and before next(). Pinned
+     * conjuncts are searched first; clause_atoms() stays in pattern order.
+     */
+    void pin(size_t conjunct, AtomId atom);
+
+    /**
+     * @brief Advance to the next match
+     * @return false once the search space is exhausted
+     */
+    [[nodiscard]] bool next();
+
+    // ========================================================================
+    // Current Match (valid after next() returned true)
+    // ========================================================================
+
+    /**
+     * @brief Atom matched by the last positive conjunct
+     */
+    [[nodiscard]] AtomId matched_atom() const noexcept;
+
+    /**
+     * @brief Atoms matched by each positive conjunct, in pattern order
+     */
+    [[nodiscard]] std::span<const AtomId> clause_atoms() const noexcept {
+        return clause_atoms_;
+    }
+
+    [[nodiscard]] std::optional<uint32_t> slot_of(std::string_view var) const noexcept;
+    [[nodiscard]] AtomId value(uint32_t slot) const noexcept { return slots_[slot]; }
+    [[nodiscard]] AtomId value(std::string_view var) const noexcept;
+    [[nodiscard]] std::span<const AtomId> glob_value(std::string_view glob) const noexcept;
+
+    [[nodiscard]] std::span<const std::string> variable_names() const noexcept {
+        return var_names_;
+    }
+
+    // ========================================================================
+    // Compiled Pattern Introspection
+    // ========================================================================
+
+    /** @brief Number of positive top-level conjuncts */
+    [[nodiscard]] size_t conjunct_count() const noexcept { return positive_.size(); }
+
+    /**
+     * @brief Exact atom type a positive conjunct can match
+     * @return nullopt when the conjunct may match atoms of several types
+     */
+    [[nodiscard]] std::optional<AtomType> conjunct_type(size_t conjunct) const noexcept;
+
+    /**
+     * @brief A grounded atom every match of a link conjunct must contain
+     * @return ATOM_NULL when the conjunct has no grounded direct member
+     */
+    [[nodiscard]] AtomId conjunct_anchor(size_t conjunct) const noexcept;
+
+    /** @brief Whether the pattern has negated top-level conjuncts */
+    [[nodiscard]] bool has_negation() const noexcept { return !negative_.empty(); }
+
+    /**
+     * @brief Write the current match into an existing MatchResult
+     *
+     * When out already holds bindings for the same variables (e.g. it is
+     * reused across calls), values are updated in place without allocating.
+     */
+    void materialize(MatchResult& out) const;
+
+    [[nodiscard]] MatchResult result() const;
+
+    // ========================================================================
+    // Drivers
+    // ========================================================================
+
+    /**
+     * @brief Call fn(const MatchEngine&) for each remaining match
+     *
+     * fn may return false to stop early. Returns the number of matches visited.
+     */
+    template<typename Fn>
+    size_t for_each(Fn&& fn, size_t limit = SIZE_MAX) {
+        size_t count = 0;
+        while (count < limit && next()) {
+            ++count;
+            if constexpr (std::is_same_v<std::invoke_result_t<Fn&, const MatchEngine&>, bool>) {
+                if (!fn(static_cast<const MatchEngine&>(*this))) break;
+            } else {
+                fn(static_cast<const MatchEngine&>(*this));
+            }
+        }
+        return count;
+    }
+
+    /**
+     * @brief Materialize up to limit matches into a caller-provided buffer
+     *
+     * Existing elements of out are reused; out is resized to the match count.
+     */
+    size_t collect(std::vector<MatchResult>& out, size_t limit = SIZE_MAX);
+
+private:
+    enum class Op : uint8_t { GROUNDED, VARIABLE, TYPED, GLOB, LINK, AND, OR, NOT };
+
+    struct Node {
+        Op op = Op::GROUNDED;
+        bool constrained = false;          // VARIABLE carries a type constraint
+        bool has_glob = false;             // LINK outgoing contains a glob
+        AtomType type = AtomType::INVALID; // VARIABLE/TYPED/LINK type
+        AtomId atom;                       // GROUNDED atom
+        uint32_t slot = 0;                 // VARIABLE/GLOB slot
+        uint32_t first = 0;                // First child in children_
+        uint32_t count = 0;                // Number of children
+        ArityBounds bounds;                // GLOB min/max, LINK arity bounds
+    };
+
+    struct Candidate {
+        AtomId atom;
+        uint32_t node;
+    };
+
+    struct Frame {
+        std::vector<Candidate> candidates;
+        size_t pos = 0;
+        size_t trail_mark = 0;
+        size_t choice_mark = 0;
+
+        // Full-space conjuncts stream candidates from the AtomTable in
+        // batches instead of listing every atom up front.
+        bool scanning = false;
+        uint32_t scan_node = 0;
+        size_t scan_pos = 0;
+    };
+
+    static constexpr size_t SCAN_BATCH = AtomCursor::DEFAULT_BATCH;
+
+    // A glob span taken by unify_sequence
+    struct Choice {
+        uint32_t node;
+        uint32_t len;
+    };
+
+    static constexpr uint32_t GLOB_FLAG = 0x80000000u;
+    static constexpr uint32_t CHOICE_FLAG = 0x40000000u;   // Trail entry for a Choice
+
+    const AtomSpace& space_;
+    bool check_type_hierarchy_;
+
+    // Compiled program
+    std::vector<Node> nodes_;
+    std::vector<uint32_t> children_;
+    std::vector<uint32_t> positive_;       // Top-level conjuncts to enumerate
+    std::vector<uint32_t> negative_;       // Top-level conjuncts that must fail
+    std::optional<uint32_t> clause_node_;  // Pattern::clause, checked on the match
+    std::vector<std::string> var_names_;
+    std::vector<std::string> glob_names_;
+
+    // Search state
+    std::vector<AtomId> slots_;
+    std::vector<std::optional<std::span<const AtomId>>> glob_slots_;
+    std::vector<uint32_t> trail_;
+    std::vector<Choice> choices_;          // Spans taken, in search order
+    std::vector<Choice> replay_;           // Spans a retry takes again
+    size_t replay_pos_ = 0;
+    std::vector<Frame> frames_;
+    std::vector<AtomId> clause_atoms_;
+    std::vector<AtomId> pins_;             // Per conjunct; ATOM_NULL if free
+    std::vector<uint32_t> order_;          // Search depth -> conjunct
+    std::vector<AtomId> scratch_;
+    std::vector<Candidate> scratch_candidates_;  // Negation checks
+    size_t depth_ = 0;
+    bool started_ = false;
+    bool done_ = true;
+
+    // Compilation
+    uint32_t compile(const PatternTerm& term);
+    uint32_t compile_children(std::span<const PatternTerm> terms, Node node);
+    uint32_t intern(std::vector<std::string>& names, const std::string& name);
+
+    // Search
+    void open_frame();
+    [[nodiscard]] bool refill(Frame& frame);
+    [[nodiscard]] bool needs_scan(uint32_t node) const noexcept;
+    void generate(uint32_t node, std::vector<Candidate>& out);
+    void collect_type(AtomType type, uint32_t node, std::vector<Candidate>& out);
+    [[nodiscard]] bool exists(uint32_t node);
+    [[nodiscard]] bool accept();
+
+    // Unification against the slot array; failures leave partial bindings
+    // on the trail for the caller to undo.
+    [[nodiscard]] bool unify(uint32_t node, AtomId atom);
+    [[nodiscard]] bool unify_outgoing(const Node& link, std::span<const AtomId> outgoing);
+    [[nodiscard]] bool unify_sequence(std::span<const uint32_t> pattern,
+                                      std::span<const AtomId> atoms);
+    void undo(size_t mark) noexcept;
+
+    // Unify again past the last span taken since choice_mark, giving up
+    // earlier spans in turn; false, with the trail undone, once none is left
+    [[nodiscard]] bool retry(uint32_t node, AtomId atom, size_t trail_mark, size_t choice_mark);
+    [[nodiscard]] bool unify_any(uint32_t node, AtomId atom);
+
+    [[nodiscard]] bool type_matches(AtomType pattern_type, AtomType atom_type) const noexcept;
+};
+
+} // namespace opencog
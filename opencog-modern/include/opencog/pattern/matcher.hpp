@@ -4,11 +4,15 @@
  * @brief Coroutine-based pattern matcher
  *
  * Uses C++20 coroutines for lazy evaluation of pattern matches.
- * Only computes as many matches as requested.
+ * Only computes as many matches as requested. The search itself runs on
+ * the explicit-stack MatchEngine; eager queries and the callback API use
+ * it directly and skip coroutine frames altogether.
  */
 
 #include <opencog/pattern/pattern.hpp>
+#include <opencog/pattern/engine.hpp>
 #include <opencog/pattern/generator.hpp>
+#include <opencog/pattern/query_cache.hpp>
 #include <opencog/atomspace/atomspace.hpp>
 
 #include <functional>
@@ -16,21 +20,6 @@
 
 namespace opencog {
 
-// ============================================================================
-// Match Result
-// ============================================================================
-
-/**
- * @brief Result of a pattern match attempt
- */
-struct MatchResult {
-    BindingSet bindings;           // Variable bindings
-    AtomId matched_atom;           // The atom that matched
-    float confidence{1.0f};        // Match confidence (for fuzzy matching)
-
-    [[nodiscard]] bool valid() const { return matched_atom.valid(); }
-};
-
 // ============================================================================
 // Pattern Matcher Configuration
 // ============================================================================
@@ -40,6 +29,7 @@ struct MatcherConfig {
     bool check_type_hierarchy = true;     // Consider type inheritance
     size_t max_results = SIZE_MAX;        // Limit number of results
     float min_confidence = 0.0f;          // Minimum confidence threshold
+    size_t cache_capacity = QueryCache::DEFAULT_CAPACITY;  // Cached result sets (0 disables)
 
     // Callback for match progress (optional)
     std::function<void(size_t matches_found)> progress_callback;
@@ -70,11 +60,16 @@ public:
      *   for (auto& result : matcher.match(pattern)) {
      *       process(result);
      *   }
+     *
+     * The pattern is taken by value so the generator may outlive it.
      */
-    [[nodiscard]] generator<MatchResult> match(const Pattern& pattern);
+    [[nodiscard]] generator<MatchResult> match(Pattern pattern);
 
     /**
      * @brief Execute a pattern on a specific atom
+     *
+     * Returns the first unifier, backtracking over every glob split and
+     * OrPattern branch until one satisfies the whole term.
      */
     [[nodiscard]] std::optional<MatchResult> match_atom(
         const PatternTerm& pattern,
@@ -105,6 +100,30 @@ public:
      */
     [[nodiscard]] bool any_match(const Pattern& pattern);
 
+    /**
+     * @brief Visit matches without materializing them
+     *
+     * fn receives the engine positioned on each match (read bindings with
+     * engine.value("X")) and may return false to stop. No allocation happens
+     * per match once the matcher's buffers have grown.
+     *
+     * Usage:
+     *   matcher.for_each_match(pattern, [&](const MatchEngine& m) {
+     *       process(m.value("X"));
+     *   });
+     */
+    template<typename Fn>
+    size_t for_each_match(const Pattern& pattern, Fn&& fn);
+
+    /**
+     * @brief Materialize matches into a caller-provided buffer
+     *
+     * Reusing the same buffer across calls reuses its binding maps, so a
+     * steady-state query does not allocate.
+     */
+    size_t match_into(const Pattern& pattern, std::vector<MatchResult>& out,
+                      size_t limit = SIZE_MAX);
+
     // ========================================================================
     // Specialized Queries
     // ========================================================================
@@ -112,6 +131,10 @@ public:
     /**
      * @brief Find all atoms satisfying a predicate
      *
+     * Streams the AtomTable in slot order through an AtomCursor, so atoms
+     * are tested only as the caller pulls results, and stops after
+     * config().max_results matches.
+     *
      * Usage:
      *   for (auto& id : matcher.filter([](auto& as, auto h) {
      *       return as.get_tv(h).strength > 0.5;
@@ -121,6 +144,22 @@ public:
         std::function<bool(const AtomSpace&, Handle)> predicate
     );
 
+    /**
+     * @brief Eager filter, optionally split across threads
+     *
+     * The slot range is divided into one contiguous block per thread;
+     * results are appended to out in slot order, so the output does not
+     * depend on the thread count. With threads > 1 the predicate must be
+     * safe to call concurrently.
+     *
+     * @return Number of atoms appended (at most config().max_results)
+     */
+    size_t filter_into(
+        const std::function<bool(const AtomSpace&, Handle)>& predicate,
+        std::vector<AtomId>& out,
+        size_t threads = 1
+    );
+
     /**
      * @brief Find atoms by type with additional filter
      */
@@ -153,71 +192,137 @@ public:
     // Configuration
     // ========================================================================
 
-    void set_config(MatcherConfig config) { config_ = std::move(config); }
+    void set_config(MatcherConfig config);
     [[nodiscard]] const MatcherConfig& config() const { return config_; }
 
+    // ========================================================================
+    // Result Cache
+    // ========================================================================
+
+    /**
+     * @brief Hit/miss counters of the result cache
+     *
+     * find_all, match_into, find_first, count_matches and any_match consult
+     * the cache; only find_all and match_into fill it.
+     */
+    [[nodiscard]] const QueryCacheStats& cache_stats() const noexcept { return cache_.stats(); }
+    [[nodiscard]] size_t cache_size() const noexcept { return cache_.size(); }
+    void clear_cache() { cache_.clear(); }
+
 private:
     const AtomSpace& space_;
     MatcherConfig config_;
 
-    // Internal matching implementations
-    [[nodiscard]] generator<MatchResult> match_term(
-        const PatternTerm& term,
-        BindingSet bindings
-    );
-
-    [[nodiscard]] generator<MatchResult> match_grounded(
-        const GroundedTerm& term,
-        BindingSet bindings
-    );
-
-    [[nodiscard]] generator<MatchResult> match_variable(
-        const VariableTerm& term,
-        BindingSet bindings
-    );
+    // Results of recent eager queries. Consulted only when the engine is
+    // free, so nested queries never clobber the fingerprint buffer.
+    QueryCache cache_;
+    PatternFingerprint fingerprint_;
+    std::vector<uint64_t> stamps_;
 
-    [[nodiscard]] generator<MatchResult> match_typed(
-        const TypedTerm& term,
-        BindingSet bindings
-    );
+    [[nodiscard]] const QueryCache::Entry* cached(const Pattern& pattern, size_t limit);
 
-    [[nodiscard]] generator<MatchResult> match_link_pattern(
-        const LinkPattern& pattern,
-        BindingSet bindings
-    );
+    // Engine reused by eager queries; a nested query issued from inside a
+    // for_each_match callback gets a temporary engine instead.
+    MatchEngine engine_;
+    bool engine_busy_ = false;
 
-    [[nodiscard]] generator<MatchResult> match_and(
-        const AndPattern& pattern,
-        BindingSet bindings
-    );
+    template<typename Fn>
+    size_t run_engine(const Pattern& pattern, size_t limit, Fn&& fn);
 
-    [[nodiscard]] generator<MatchResult> match_or(
-        const OrPattern& pattern,
-        BindingSet bindings
-    );
+    // Unification
+    /**
+     * @brief Receives each unifier in turn; returns true to stop the search
+     *
+     * Every alternative (a glob's span, an OrPattern branch) is a choice
+     * point: the unifier is passed on for the rest of the pattern to
+     * extend, and the next alternative is tried when that fails.
+     */
+    using Unified = std::function<bool(BindingSet&)>;
 
-    [[nodiscard]] bool match_not(
-        const NotPattern& pattern,
-        const BindingSet& bindings
+    /**
+     * @brief Unify an outgoing-set pattern against a link's outgoing set
+     *
+     * Patterns without globs must match the arity exactly; both kinds are
+     * then matched term by term through unify_sequence.
+     */
+    [[nodiscard]] bool unify_outgoing(
+        std::span<const PatternTerm> pattern_outgoing,
+        std::span<const AtomId> atom_outgoing,
+        BindingSet bindings,
+        const Unified& unified
     );
 
-    // Unification
-    [[nodiscard]] std::optional<BindingSet> unify_outgoing(
+    /**
+     * @brief Glob-aware sequence unification
+     *
+     * Binds each glob to a contiguous span of atom_outgoing (no copy).
+     * Candidate lengths are bounded by the glob's own min/max and by the
+     * arity the remaining pattern terms require, and a grounded term
+     * right after a glob only admits lengths that land on that atom.
+     * Every consistent assignment is offered, shorter spans first.
+     */
+    [[nodiscard]] bool unify_sequence(
         std::span<const PatternTerm> pattern_outgoing,
         std::span<const AtomId> atom_outgoing,
-        BindingSet bindings
+        BindingSet bindings,
+        const Unified& unified
     );
 
-    [[nodiscard]] std::optional<BindingSet> unify_term(
+    [[nodiscard]] bool unify_term(
         const PatternTerm& term,
         AtomId atom,
-        BindingSet bindings
+        BindingSet bindings,
+        const Unified& unified
     );
 
     // Type checking
     [[nodiscard]] bool type_matches(AtomType pattern_type, AtomType atom_type) const;
 };
 
+// ============================================================================
+// Template Implementations
+// ============================================================================
+
+template<typename Fn>
+size_t PatternMatcher::run_engine(const Pattern& pattern, size_t limit, Fn&& fn) {
+    auto drive = [&](MatchEngine& engine) {
+        engine.reset(pattern);
+        size_t count = 0;
+        while (count < limit && engine.next()) {
+            ++count;
+            bool keep_going = fn(static_cast<const MatchEngine&>(engine));
+            if (config_.progress_callback) config_.progress_callback(count);
+            if (!keep_going) break;
+        }
+        return count;
+    };
+
+    if (engine_busy_) {
+        MatchEngine nested(space_, config_.check_type_hierarchy);
+        return drive(nested);
+    }
+
+    engine_busy_ = true;
+    struct Release {
+        bool& busy;
+        ~Release() { busy = false; }
+    } release{engine_busy_};
+
+    return drive(engine_);
+}
+
+template<typename Fn>
+size_t PatternMatcher::for_each_match(const Pattern& pattern, Fn&& fn) {
+    return run_engine(pattern, config_.max_results, [&](const MatchEngine& engine) {
+        if constexpr (std::is_same_v<std::invoke_result_t<Fn&, const MatchEngine&>, bool>) {
+            return fn(engine);
+        } else {
+            fn(engine);
+            return true;
+        }
+    });
+}
+
 // ============================================================================
 // Query DSL
 // ============================================================================
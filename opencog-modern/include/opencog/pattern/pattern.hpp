@@ -15,6 +15,7 @@
 
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
 #include <unordered_map>
 #include <variant>
@@ -45,11 +46,20 @@ struct Variable {
  */
 using BindingMap = std::unordered_map<std::string, AtomId>;
 
+/**
+ * @brief Map of glob names to the run of atoms they matched
+ *
+ * Spans point directly into the matched link's outgoing set in the
+ * AtomTable, so they stay valid for as long as that link exists.
+ */
+using GlobBindingMap = std::unordered_map<std::string, std::span<const AtomId>>;
+
 /**
  * @brief A complete set of bindings for a pattern match
  */
 struct BindingSet {
     BindingMap bindings;
+    GlobBindingMap globs;
 
     [[nodiscard]] bool contains(const std::string& var) const {
         return bindings.contains(var);
@@ -64,8 +74,21 @@ struct BindingSet {
         bindings[var] = atom;
     }
 
-    [[nodiscard]] bool empty() const { return bindings.empty(); }
-    [[nodiscard]] size_t size() const { return bindings.size(); }
+    [[nodiscard]] bool contains_glob(const std::string& glob) const {
+        return globs.contains(glob);
+    }
+
+    [[nodiscard]] std::span<const AtomId> get_glob(const std::string& glob) const {
+        auto it = globs.find(glob);
+        return it != globs.end() ? it->second : std::span<const AtomId>{};
+    }
+
+    void bind_glob(const std::string& glob, std::span<const AtomId> atoms) {
+        globs[glob] = atoms;
+    }
+
+    [[nodiscard]] bool empty() const { return bindings.empty() && globs.empty(); }
+    [[nodiscard]] size_t size() const { return bindings.size() + globs.size(); }
 };
 
 // ============================================================================
@@ -78,6 +101,7 @@ struct BindingSet {
 struct GroundedTerm {
     AtomId atom;
 
+    GroundedTerm() = default;
     explicit GroundedTerm(AtomId a) : atom(a) {}
 };
 
@@ -113,20 +137,59 @@ struct GlobTerm {
         : name(std::move(n)), min_count(min), max_count(max) {}
 };
 
-// Forward declaration for recursive structure
+// Forward declarations for recursive structure
 struct LinkPattern;
+struct AndPattern;
+struct OrPattern;
+struct NotPattern;
 
 /**
  * @brief A term in a pattern can be any of these types
+ *
+ * At the top of a Pattern, an AndPattern is a conjunction of separately
+ * matched terms that share variables. Nested inside a link or another
+ * connective, And/Or/Not constrain the single atom at that position.
  */
 using PatternTerm = std::variant<
     GroundedTerm,
     VariableTerm,
     TypedTerm,
     GlobTerm,
-    std::shared_ptr<LinkPattern>
+    std::shared_ptr<LinkPattern>,
+    std::shared_ptr<AndPattern>,
+    std::shared_ptr<OrPattern>,
+    std::shared_ptr<NotPattern>
 >;
 
+// ============================================================================
+// Arity Analysis
+// ============================================================================
+
+/**
+ * @brief Range of outgoing-set sizes a sequence of pattern terms can match
+ *
+ * Fixed terms contribute exactly one atom; globs contribute between
+ * min_count and max_count. max is SIZE_MAX when any glob is unbounded.
+ */
+struct ArityBounds {
+    size_t min = 0;
+    size_t max = 0;
+
+    [[nodiscard]] constexpr bool admits(size_t arity) const noexcept {
+        return arity >= min && arity <= max;
+    }
+};
+
+/**
+ * @brief Compute the arity bounds of an outgoing-set pattern
+ */
+[[nodiscard]] ArityBounds arity_bounds(std::span<const PatternTerm> terms) noexcept;
+
+/**
+ * @brief Check whether an outgoing-set pattern contains any glob
+ */
+[[nodiscard]] bool has_glob(std::span<const PatternTerm> terms) noexcept;
+
 // ============================================================================
 // Link Pattern
 // ============================================================================
@@ -147,10 +210,6 @@ struct LinkPattern {
 // Logical Connectives
 // ============================================================================
 
-struct AndPattern;
-struct OrPattern;
-struct NotPattern;
-
 using LogicalPattern = std::variant<
     std::shared_ptr<AndPattern>,
     std::shared_ptr<OrPattern>,
@@ -213,6 +272,44 @@ struct Pattern {
     }
 };
 
+// ============================================================================
+// Canonical Form
+// ============================================================================
+
+/**
+ * @brief Alpha-renamed structural identity of a pattern
+ *
+ * Variables and globs are numbered in order of first occurrence (body, then
+ * clause), so patterns that differ only in naming share a fingerprint. The
+ * token stream is kept for exact comparison; the hash is for lookup.
+ */
+struct PatternFingerprint {
+    uint64_t hash = 0;
+    std::vector<uint64_t> tokens;           // Canonical structure
+    std::vector<std::string> variables;     // Names by canonical index
+    std::vector<std::string> globs;
+
+    // Atom types whose additions or removals can change the match set.
+    // any_type is set when the pattern enumerates atoms of arbitrary type.
+    std::vector<AtomType> dependencies;
+    bool any_type = false;
+
+    [[nodiscard]] bool same_structure(const PatternFingerprint& other) const noexcept {
+        return hash == other.hash && tokens == other.tokens;
+    }
+};
+
+/**
+ * @brief Compute a pattern's fingerprint into a reusable buffer
+ */
+void fingerprint(const Pattern& pattern, PatternFingerprint& out);
+
+[[nodiscard]] inline PatternFingerprint fingerprint(const Pattern& pattern) {
+    PatternFingerprint out;
+    fingerprint(pattern, out);
+    return out;
+}
+
 // ============================================================================
 // Pattern Builder DSL
 // ============================================================================
@@ -298,6 +395,13 @@ private:
     return TypedTerm{type};
 }
 
+/**
+ * @brief Create a glob term
+ */
+[[nodiscard]] inline GlobTerm glob(std::string name, size_t min = 0, size_t max = SIZE_MAX) {
+    return GlobTerm{std::move(name), min, max};
+}
+
 /**
  * @brief Create a link pattern
  */
@@ -0,0 +1,130 @@
+#pragma once
+/**
+ * @file query_cache.hpp
+ * @brief LRU cache of pattern match results
+ *
+ * Entries are keyed by PatternFingerprint, so alpha-equivalent patterns
+ * share results, and are stamped with the AtomSpace modification counters
+ * of the atom types the pattern enumerates. An entry stays valid until
+ * one of those types is added to or removed from; changes to unrelated
+ * types leave it alone.
+ */
+
+#include <opencog/pattern/engine.hpp>
+#include <opencog/pattern/pattern.hpp>
+#include <opencog/atomspace/atomspace.hpp>
+
+#include <list>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace opencog {
+
+// ============================================================================
+// Cache Statistics
+// ============================================================================
+
+struct QueryCacheStats {
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t insertions = 0;
+    size_t evictions = 0;       // Dropped to stay within capacity
+    size_t invalidations = 0;   // Dropped because a dependency changed
+
+    [[nodiscard]] double hit_rate() const noexcept {
+        size_t total = hits + misses;
+        return total > 0 ? static_cast<double>(hits) / static_cast<double>(total) : 0.0;
+    }
+};
+
+// ============================================================================
+// Query Cache
+// ============================================================================
+
+/**
+ * @brief Bounded LRU map from pattern fingerprints to match results
+ *
+ * Results are stored by canonical variable index rather than by name and
+ * are renamed to the caller's variables when read back. Result sets cut
+ * short by a limit are kept as partial entries that can still answer
+ * queries with an equal or smaller limit.
+ *
+ * Not thread-safe; each PatternMatcher owns its own cache.
+ */
+class QueryCache {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 64;
+    static constexpr size_t DEFAULT_MAX_ROWS = 65536;
+
+    struct Entry {
+        PatternFingerprint key;
+        std::vector<uint64_t> stamps;      // Dependency versions at fill time
+        std::vector<AtomId> atoms;         // Per row: matched atom, then variables
+        std::vector<std::optional<std::span<const AtomId>>> globs;  // Per row
+        size_t rows = 0;
+        bool complete = false;             // Search ran to exhaustion
+    };
+
+    explicit QueryCache(size_t capacity = DEFAULT_CAPACITY, size_t max_rows = DEFAULT_MAX_ROWS);
+
+    /**
+     * @brief Find a valid entry able to answer a query for up to limit rows
+     *
+     * Stale entries are dropped. Counts a hit or a miss.
+     */
+    [[nodiscard]] const Entry* lookup(const AtomSpace& space,
+                                      const PatternFingerprint& key,
+                                      size_t limit);
+
+    /**
+     * @brief Snapshot the versions a later store() should be stamped with
+     *
+     * Taken before running the search, so a change that races with it
+     * leaves the entry already stale.
+     */
+    void capture(const AtomSpace& space, const PatternFingerprint& key,
+                 std::vector<uint64_t>& stamps) const;
+
+    /**
+     * @brief Insert or replace the results for a fingerprint
+     *
+     * Result sets larger than max_rows are not cached.
+     */
+    void store(const PatternFingerprint& key,
+               std::span<const uint64_t> stamps,
+               std::span<const MatchResult> results,
+               bool complete);
+
+    /**
+     * @brief Write up to limit rows of an entry into out, named per key
+     *
+     * Existing elements of out and their binding maps are reused.
+     */
+    static size_t read(const Entry& entry,
+                       const PatternFingerprint& key,
+                       std::vector<MatchResult>& out,
+                       size_t limit);
+
+    void set_capacity(size_t capacity);
+    void clear();
+
+    [[nodiscard]] size_t capacity() const noexcept { return capacity_; }
+    [[nodiscard]] size_t size() const noexcept { return entries_.size(); }
+    [[nodiscard]] const QueryCacheStats& stats() const noexcept { return stats_; }
+    void reset_stats() noexcept { stats_ = {}; }
+
+private:
+    size_t capacity_;
+    size_t max_rows_;
+    std::list<Entry> entries_;   // Most recently used first
+    std::unordered_map<uint64_t, std::list<Entry>::iterator> index_;
+    std::vector<uint64_t> scratch_stamps_;
+    QueryCacheStats stats_;
+
+    void erase(std::list<Entry>::iterator it);
+    void evict_to(size_t capacity);
+};
+
+} // namespace opencog
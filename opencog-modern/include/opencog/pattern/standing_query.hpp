@@ -0,0 +1,204 @@
+#pragma once
+/**
+ * @file standing_query.hpp
+ * @brief Incrementally maintained pattern queries
+ *
+ * A standing query is a Pattern registered once with a QueryRegistry.
+ * Its result set is computed on subscription and then kept up to date from
+ * AtomSpace change notifications, so subscribers pay for each change
+ * instead of re-running the query.
+ *
+ * The registry is organised like a Rete network:
+ * - Alpha memory: each positive conjunct is indexed by the link type it
+ *   matches and, when it has one, a grounded member atom. A new atom only
+ *   reaches the conjuncts whose key it carries.
+ * - Beta memory: each query keeps its complete matches, indexed by every
+ *   atom they bind, so removals and truth value changes touch only the
+ *   matches that mention the changed atom.
+ */
+
+#include <opencog/pattern/engine.hpp>
+#include <opencog/atomspace/atomspace.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace opencog {
+
+// ============================================================================
+// Standing Query Types
+// ============================================================================
+
+using StandingQueryId = uint32_t;
+
+/**
+ * @brief Receives result-set deltas of a standing query
+ *
+ * Called once on subscription with the initial results as additions, then
+ * after each AtomSpace change that alters the result set. Runs on the
+ * mutating thread with no registry lock held, so it may modify the
+ * AtomSpace or the registry.
+ */
+using QueryCallback = std::function<void(std::span<const MatchResult> added,
+                                         std::span<const MatchResult> removed)>;
+
+/**
+ * @brief Optional predicate a match must satisfy to be reported
+ *
+ * Re-evaluated when the truth value of an atom bound by the match changes,
+ * so it should only depend on atoms that appear in the match.
+ */
+using QueryFilter = std::function<bool(const AtomSpace&, const MatchResult&)>;
+
+// ============================================================================
+// Query Registry
+// ============================================================================
+
+/**
+ * @brief Maintains standing queries over an AtomSpace
+ *
+ * Usage:
+ *   QueryRegistry registry(space);
+ *   auto id = registry.subscribe(pattern, [](auto added, auto removed) {
+ *       for (const auto& r : added) handle(r);
+ *   });
+ *   space.add_link(...);   // Callback fires with the new matches
+ *
+ * Queries with negated conjuncts are not monotone in the AtomSpace contents;
+ * they are re-evaluated in full on each addition or removal and diffed
+ * against their previous results.
+ */
+class QueryRegistry : public AtomSpaceObserver {
+public:
+    explicit QueryRegistry(AtomSpace& space);
+    ~QueryRegistry() override;
+
+    QueryRegistry(const QueryRegistry&) = delete;
+    QueryRegistry& operator=(const QueryRegistry&) = delete;
+
+    // ========================================================================
+    // Subscription
+    // ========================================================================
+
+    /**
+     * @brief Register a pattern and deliver its initial results
+     */
+    StandingQueryId subscribe(const Pattern& pattern,
+                              QueryCallback callback,
+                              QueryFilter filter = {});
+
+    /**
+     * @brief Stop maintaining a query
+     * @return false if the id is unknown
+     */
+    bool unsubscribe(StandingQueryId id);
+
+    // ========================================================================
+    // Result Access
+    // ========================================================================
+
+    /**
+     * @brief Snapshot of a query's current results (unordered)
+     */
+    [[nodiscard]] std::vector<MatchResult> results(StandingQueryId id) const;
+
+    [[nodiscard]] size_t result_count(StandingQueryId id) const;
+    [[nodiscard]] size_t query_count() const;
+
+    // ========================================================================
+    // AtomSpaceObserver
+    // ========================================================================
+
+    void on_atom_added(AtomId id) override;
+    void on_atom_removed(AtomId id) override;
+    void on_tv_changed(AtomId id, TruthValue old_tv) override;
+    void on_clear() override;
+
+private:
+    // A complete match of a query's positive conjuncts
+    struct Entry {
+        std::vector<AtomId> key;      // Clause atoms, then variable values
+        std::vector<AtomId> atoms;    // Distinct atoms bound by the match
+        MatchResult result;
+        bool passed = false;          // Satisfies the filter
+        bool live = false;
+        uint32_t epoch = 0;           // Last full re-evaluation that saw it
+    };
+
+    struct KeyHash {
+        size_t operator()(const std::vector<AtomId>& key) const noexcept;
+    };
+
+    struct Query {
+        StandingQueryId id;
+        MatchEngine engine;
+        QueryCallback callback;
+        QueryFilter filter;
+        bool full_reevaluation = false;
+
+        // Beta memory
+        std::vector<Entry> entries;
+        std::vector<uint32_t> free_entries;
+        std::unordered_map<std::vector<AtomId>, uint32_t, KeyHash> by_key;
+        std::unordered_map<AtomId, std::vector<uint32_t>> by_atom;
+        size_t visible = 0;
+        uint32_t epoch = 0;
+
+        Query(StandingQueryId i, const AtomSpace& space) : id(i), engine(space) {}
+    };
+
+    // Alpha memory key: conjunct link type plus an optional grounded member
+    struct AlphaKey {
+        AtomType type;
+        AtomId anchor;
+
+        bool operator==(const AlphaKey&) const = default;
+    };
+
+    struct AlphaKeyHash {
+        size_t operator()(const AlphaKey& key) const noexcept {
+            return hash_combine(static_cast<uint64_t>(key.type), key.anchor.value);
+        }
+    };
+
+    struct AlphaEntry {
+        Query* query;
+        uint32_t conjunct;
+    };
+
+    // Deltas collected under the lock and delivered after releasing it
+    struct Pending {
+        QueryCallback callback;
+        std::vector<MatchResult> added;
+        std::vector<MatchResult> removed;
+    };
+
+    AtomSpace& space_;
+    mutable std::mutex mutex_;
+    StandingQueryId next_id_ = 1;
+
+    std::unordered_map<StandingQueryId, std::unique_ptr<Query>> queries_;
+    std::unordered_map<AlphaKey, std::vector<AlphaEntry>, AlphaKeyHash> alpha_;
+    std::vector<AlphaEntry> alpha_wildcard_;   // Conjuncts without a single type
+    std::vector<Query*> full_queries_;         // Re-evaluated on every change
+
+    std::vector<AtomId> scratch_key_;
+    std::vector<AlphaEntry> scratch_hits_;
+
+    // Beta memory maintenance
+    void build_key(const MatchEngine& engine, std::vector<AtomId>& key) const;
+    bool insert_current(Query& query, Pending& pending);
+    void erase_entry(Query& query, uint32_t index, Pending& pending);
+    void evaluate_all(Query& query, Pending& pending);
+    [[nodiscard]] bool passes(const Query& query, const MatchResult& result) const;
+
+    void detach(Query& query);
+    static void deliver(std::vector<Pending>& pending);
+};
+
+} // namespace opencog
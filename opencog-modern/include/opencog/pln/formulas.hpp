@@ -10,28 +10,19 @@
  * - Abduction
  * - And/Or/Not
  *
- * SIMD versions process multiple truth values in parallel.
+ * SIMD versions process multiple truth values in parallel; see kernels.hpp
+ * for the runtime-dispatched structure-of-arrays kernels.
  */
 
 #include <opencog/core/types.hpp>
 #include <opencog/core/memory.hpp>
+#include <opencog/pln/kernels.hpp>
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <span>
 
-// SIMD intrinsics
-#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
-    #include <immintrin.h>
-    #define OPENCOG_HAS_SSE 1
-    #if defined(__AVX2__)
-        #define OPENCOG_HAS_AVX2 1
-    #endif
-#elif defined(__aarch64__) || defined(_M_ARM64)
-    #include <arm_neon.h>
-    #define OPENCOG_HAS_NEON 1
-#endif
-
 namespace opencog::pln {
 
 // ============================================================================
@@ -53,7 +44,7 @@ inline constexpr float EPSILON = 1e-10f;
  *
  * sAC = sAB * sBC + (1 - sAB) * (sC - sBC * sB) / (1 - sB)
  */
-[[nodiscard]] inline TruthValue deduction(
+[[nodiscard]] constexpr TruthValue deduction(
     TruthValue ab,  // A -> B
     TruthValue bc,  // B -> C
     float sB,       // P(B)
@@ -81,7 +72,7 @@ inline constexpr float EPSILON = 1e-10f;
  *
  * sBA = sAB * sA / sB
  */
-[[nodiscard]] inline TruthValue inversion(
+[[nodiscard]] constexpr TruthValue inversion(
     TruthValue ab,  // A -> B
     float sA,       // P(A)
     float sB        // P(B)
@@ -115,9 +106,9 @@ inline constexpr float EPSILON = 1e-10f;
 /**
  * @brief Abduction formula: (A->B, C->B) => A->C
  *
- * sAC = sAB * sC / sB + (1 - sAB) * sCB * (1 - sC) / (1 - sB)
+ * sAC = sAB * sCB * sC / sB + (1 - sAB) * (1 - sCB) * sC / (1 - sB)
  */
-[[nodiscard]] inline TruthValue abduction(
+[[nodiscard]] constexpr TruthValue abduction(
     TruthValue ab,  // A -> B
     TruthValue cb,  // C -> B
     float sB,       // P(B)
@@ -126,12 +117,8 @@ inline constexpr float EPSILON = 1e-10f;
     float sAB = ab.strength;
     float sCB = cb.strength;
 
-    // Invert CB to get BC (approximately)
-    float sBC = sCB * sC / (sB + EPSILON);
-
-    // Then apply deduction-like formula
-    float term1 = sAB * sC / (sB + EPSILON);
-    float term2 = (1.0f - sAB) * sCB * (1.0f - sC) / (1.0f - sB + EPSILON);
+    float term1 = sAB * sCB * sC / (sB + EPSILON);
+    float term2 = (1.0f - sAB) * (1.0f - sCB) * sC / (1.0f - sB + EPSILON);
     float sAC = term1 + term2;
     sAC = std::clamp(sAC, 0.0f, 1.0f);
 
@@ -144,7 +131,7 @@ inline constexpr float EPSILON = 1e-10f;
 /**
  * @brief Modus ponens: (A, A->B) => B
  */
-[[nodiscard]] inline TruthValue modus_ponens(
+[[nodiscard]] constexpr TruthValue modus_ponens(
     TruthValue a,   // P(A)
     TruthValue ab   // A -> B
 ) noexcept {
@@ -213,228 +200,159 @@ inline constexpr float EPSILON = 1e-10f;
 }
 
 // ============================================================================
-// SIMD Batch Operations
+// Structure-of-Arrays Views
 // ============================================================================
 
-#ifdef OPENCOG_HAS_AVX2
-
 /**
- * @brief Batch deduction using AVX2 (8 operations at once)
- *
- * Processes 8 deduction operations in parallel.
+ * @brief Read-only truth value columns: strengths and confidences apart
  */
-inline void batch_deduction_avx2(
-    const float* sAB, const float* cAB,  // Input: A->B
-    const float* sBC, const float* cBC,  // Input: B->C
-    const float* sB,                      // Input: P(B)
-    const float* sC,                      // Input: P(C)
-    float* sAC, float* cAC,              // Output: A->C
-    size_t count                          // Must be multiple of 8
-) {
-    const __m256 ones = _mm256_set1_ps(1.0f);
-    const __m256 zeros = _mm256_setzero_ps();
-    const __m256 eps = _mm256_set1_ps(EPSILON);
-    const __m256 conf_factor = _mm256_set1_ps(0.9f);
-
-    for (size_t i = 0; i < count; i += 8) {
-        // Load inputs
-        __m256 v_sAB = _mm256_load_ps(sAB + i);
-        __m256 v_cAB = _mm256_load_ps(cAB + i);
-        __m256 v_sBC = _mm256_load_ps(sBC + i);
-        __m256 v_cBC = _mm256_load_ps(cBC + i);
-        __m256 v_sB = _mm256_load_ps(sB + i);
-        __m256 v_sC = _mm256_load_ps(sC + i);
-
-        // term1 = sAB * sBC
-        __m256 term1 = _mm256_mul_ps(v_sAB, v_sBC);
-
-        // term2 = (1 - sAB) * (sC - sBC * sB) / (1 - sB + eps)
-        __m256 one_minus_sAB = _mm256_sub_ps(ones, v_sAB);
-        __m256 sBC_times_sB = _mm256_mul_ps(v_sBC, v_sB);
-        __m256 numerator = _mm256_sub_ps(v_sC, sBC_times_sB);
-        numerator = _mm256_mul_ps(one_minus_sAB, numerator);
-
-        __m256 one_minus_sB = _mm256_sub_ps(ones, v_sB);
-        __m256 denominator = _mm256_add_ps(one_minus_sB, eps);
-        __m256 term2 = _mm256_div_ps(numerator, denominator);
-
-        // sAC = clamp(term1 + term2, 0, 1)
-        __m256 v_sAC = _mm256_add_ps(term1, term2);
-        v_sAC = _mm256_max_ps(v_sAC, zeros);
-        v_sAC = _mm256_min_ps(v_sAC, ones);
-
-        // cAC = cAB * cBC * 0.9
-        __m256 v_cAC = _mm256_mul_ps(v_cAB, v_cBC);
-        v_cAC = _mm256_mul_ps(v_cAC, conf_factor);
-
-        // Store outputs
-        _mm256_store_ps(sAC + i, v_sAC);
-        _mm256_store_ps(cAC + i, v_cAC);
+struct TVView {
+    std::span<const float> strength;
+    std::span<const float> confidence;
+
+    [[nodiscard]] size_t size() const noexcept {
+        return std::min(strength.size(), confidence.size());
     }
-}
+};
 
 /**
- * @brief Batch revision using AVX2
+ * @brief Writable truth value columns
  */
-inline void batch_revision_avx2(
-    const float* s1, const float* c1,  // Input: TV1
-    const float* s2, const float* c2,  // Input: TV2
-    float* s_out, float* c_out,        // Output
-    size_t count
-) {
-    const __m256 k = _mm256_set1_ps(DEFAULT_K);
-    const __m256 ones = _mm256_set1_ps(1.0f);
-    const __m256 eps = _mm256_set1_ps(EPSILON);
-
-    for (size_t i = 0; i < count; i += 8) {
-        __m256 v_s1 = _mm256_load_ps(s1 + i);
-        __m256 v_c1 = _mm256_load_ps(c1 + i);
-        __m256 v_s2 = _mm256_load_ps(s2 + i);
-        __m256 v_c2 = _mm256_load_ps(c2 + i);
-
-        // n = c * K / (1 - c + eps)
-        __m256 one_minus_c1 = _mm256_sub_ps(ones, v_c1);
-        __m256 one_minus_c2 = _mm256_sub_ps(ones, v_c2);
-        __m256 denom1 = _mm256_add_ps(one_minus_c1, eps);
-        __m256 denom2 = _mm256_add_ps(one_minus_c2, eps);
-
-        __m256 n1 = _mm256_div_ps(_mm256_mul_ps(v_c1, k), denom1);
-        __m256 n2 = _mm256_div_ps(_mm256_mul_ps(v_c2, k), denom2);
-
-        // s = (s1 * n1 + s2 * n2) / (n1 + n2 + eps)
-        __m256 n_sum = _mm256_add_ps(n1, n2);
-        __m256 weighted = _mm256_add_ps(
-            _mm256_mul_ps(v_s1, n1),
-            _mm256_mul_ps(v_s2, n2)
-        );
-        __m256 v_s = _mm256_div_ps(weighted, _mm256_add_ps(n_sum, eps));
-
-        // c = n / (n + K)
-        __m256 v_c = _mm256_div_ps(n_sum, _mm256_add_ps(n_sum, k));
-
-        _mm256_store_ps(s_out + i, v_s);
-        _mm256_store_ps(c_out + i, v_c);
+struct TVColumns {
+    std::span<float> strength;
+    std::span<float> confidence;
+
+    [[nodiscard]] size_t size() const noexcept {
+        return std::min(strength.size(), confidence.size());
     }
-}
+
+    operator TVView() const noexcept { return {strength, confidence}; }
+};
 
 /**
- * @brief Batch fuzzy AND using AVX2
+ * @brief Caller-owned aligned scratch for SoA batches
+ *
+ * Allocate once and reuse: with AtomSpace::gather_tvs filling the columns
+ * and the TVView batch functions below consuming them, a batch runs
+ * without touching the heap.
  */
-inline void batch_fuzzy_and_avx2(
-    const float* s1, const float* c1,
-    const float* s2, const float* c2,
-    float* s_out, float* c_out,
-    size_t count
-) {
-    for (size_t i = 0; i < count; i += 8) {
-        __m256 v_s1 = _mm256_load_ps(s1 + i);
-        __m256 v_c1 = _mm256_load_ps(c1 + i);
-        __m256 v_s2 = _mm256_load_ps(s2 + i);
-        __m256 v_c2 = _mm256_load_ps(c2 + i);
-
-        __m256 v_s = _mm256_mul_ps(v_s1, v_s2);
-        __m256 v_c = _mm256_min_ps(v_c1, v_c2);
-
-        _mm256_store_ps(s_out + i, v_s);
-        _mm256_store_ps(c_out + i, v_c);
+struct TVBuffer {
+    SimdVector<float> strength;
+    SimdVector<float> confidence;
+
+    TVBuffer() = default;
+    explicit TVBuffer(size_t n) : strength(n), confidence(n) {}
+
+    [[nodiscard]] size_t size() const noexcept { return strength.size(); }
+
+    /// First n elements (all when n exceeds the size)
+    [[nodiscard]] TVColumns columns(size_t n = SIZE_MAX) noexcept {
+        n = std::min(n, size());
+        return {{strength.data(), n}, {confidence.data(), n}};
     }
-}
 
-/**
- * @brief Batch fuzzy OR using AVX2
- */
-inline void batch_fuzzy_or_avx2(
-    const float* s1, const float* c1,
-    const float* s2, const float* c2,
-    float* s_out, float* c_out,
-    size_t count
-) {
-    const __m256 ones = _mm256_set1_ps(1.0f);
-
-    for (size_t i = 0; i < count; i += 8) {
-        __m256 v_s1 = _mm256_load_ps(s1 + i);
-        __m256 v_c1 = _mm256_load_ps(c1 + i);
-        __m256 v_s2 = _mm256_load_ps(s2 + i);
-        __m256 v_c2 = _mm256_load_ps(c2 + i);
-
-        // s = s1 + s2 - s1 * s2
-        __m256 product = _mm256_mul_ps(v_s1, v_s2);
-        __m256 sum = _mm256_add_ps(v_s1, v_s2);
-        __m256 v_s = _mm256_sub_ps(sum, product);
-        __m256 v_c = _mm256_min_ps(v_c1, v_c2);
-
-        _mm256_store_ps(s_out + i, v_s);
-        _mm256_store_ps(c_out + i, v_c);
+    [[nodiscard]] TVView view(size_t n = SIZE_MAX) const noexcept {
+        n = std::min(n, size());
+        return {{strength.data(), n}, {confidence.data(), n}};
     }
+};
+
+// ============================================================================
+// SoA Batch Operations
+// ============================================================================
+
+// Each processes the shortest of its inputs and output and returns that
+// count. Inputs and outputs may be any alignment; nothing is allocated.
+
+inline size_t batch_deduction(TVView ab, TVView bc,
+                              std::span<const float> sB, std::span<const float> sC,
+                              TVColumns out) noexcept {
+    const size_t n = std::min({ab.size(), bc.size(), sB.size(), sC.size(), out.size()});
+    kernels::deduction(ab.strength.data(), ab.confidence.data(),
+                       bc.strength.data(), bc.confidence.data(),
+                       sB.data(), sC.data(),
+                       out.strength.data(), out.confidence.data(), n);
+    return n;
 }
 
-#endif // OPENCOG_HAS_AVX2
+inline size_t batch_inversion(TVView ab,
+                              std::span<const float> sA, std::span<const float> sB,
+                              TVColumns out) noexcept {
+    const size_t n = std::min({ab.size(), sA.size(), sB.size(), out.size()});
+    kernels::inversion(ab.strength.data(), ab.confidence.data(), sA.data(), sB.data(),
+                       out.strength.data(), out.confidence.data(), n);
+    return n;
+}
+
+inline size_t batch_revision(TVView tv1, TVView tv2, TVColumns out) noexcept {
+    const size_t n = std::min({tv1.size(), tv2.size(), out.size()});
+    kernels::revision(tv1.strength.data(), tv1.confidence.data(),
+                      tv2.strength.data(), tv2.confidence.data(),
+                      out.strength.data(), out.confidence.data(), n);
+    return n;
+}
+
+inline size_t batch_abduction(TVView ab, TVView cb,
+                              std::span<const float> sB, std::span<const float> sC,
+                              TVColumns out) noexcept {
+    const size_t n = std::min({ab.size(), cb.size(), sB.size(), sC.size(), out.size()});
+    kernels::abduction(ab.strength.data(), ab.confidence.data(),
+                       cb.strength.data(), cb.confidence.data(),
+                       sB.data(), sC.data(),
+                       out.strength.data(), out.confidence.data(), n);
+    return n;
+}
+
+inline size_t batch_modus_ponens(TVView a, TVView ab, TVColumns out) noexcept {
+    const size_t n = std::min({a.size(), ab.size(), out.size()});
+    kernels::modus_ponens(a.strength.data(), a.confidence.data(),
+                          ab.strength.data(), ab.confidence.data(),
+                          out.strength.data(), out.confidence.data(), n);
+    return n;
+}
+
+inline size_t batch_fuzzy_and(TVView a, TVView b, TVColumns out) noexcept {
+    const size_t n = std::min({a.size(), b.size(), out.size()});
+    kernels::fuzzy_and(a.strength.data(), a.confidence.data(),
+                       b.strength.data(), b.confidence.data(),
+                       out.strength.data(), out.confidence.data(), n);
+    return n;
+}
+
+inline size_t batch_fuzzy_or(TVView a, TVView b, TVColumns out) noexcept {
+    const size_t n = std::min({a.size(), b.size(), out.size()});
+    kernels::fuzzy_or(a.strength.data(), a.confidence.data(),
+                      b.strength.data(), b.confidence.data(),
+                      out.strength.data(), out.confidence.data(), n);
+    return n;
+}
 
 // ============================================================================
-// Portable Batch Operations (fallback)
+// Batch Operations
 // ============================================================================
 
 /**
- * @brief Portable batch deduction (scalar fallback)
+ * @brief Batch deduction over array-of-structs truth values
+ *
+ * Transposes into structure-of-arrays blocks on the stack and runs the
+ * widest kernel the CPU supports. Any length; no allocation. Prefer the
+ * TVView overloads when the data can be kept or gathered as columns.
  */
-inline void batch_deduction(
+void batch_deduction(
     std::span<const TruthValue> ab,
     std::span<const TruthValue> bc,
     std::span<const float> sB,
     std::span<const float> sC,
     std::span<TruthValue> out
-) {
-    size_t n = std::min({ab.size(), bc.size(), sB.size(), sC.size(), out.size()});
-
-#ifdef OPENCOG_HAS_AVX2
-    // Use SIMD for aligned, multiple-of-8 data
-    if (n >= 8 && n % 8 == 0) {
-        // Convert SoA for SIMD (ideally data would already be in SoA format)
-        SimdVector<float> sAB_vec(n), cAB_vec(n);
-        SimdVector<float> sBC_vec(n), cBC_vec(n);
-        SimdVector<float> sAC_vec(n), cAC_vec(n);
-
-        for (size_t i = 0; i < n; ++i) {
-            sAB_vec[i] = ab[i].strength;
-            cAB_vec[i] = ab[i].confidence;
-            sBC_vec[i] = bc[i].strength;
-            cBC_vec[i] = bc[i].confidence;
-        }
-
-        batch_deduction_avx2(
-            sAB_vec.data(), cAB_vec.data(),
-            sBC_vec.data(), cBC_vec.data(),
-            sB.data(), sC.data(),
-            sAC_vec.data(), cAC_vec.data(),
-            n
-        );
-
-        for (size_t i = 0; i < n; ++i) {
-            out[i] = TruthValue{sAC_vec[i], cAC_vec[i]};
-        }
-        return;
-    }
-#endif
-
-    // Scalar fallback
-    for (size_t i = 0; i < n; ++i) {
-        out[i] = deduction(ab[i], bc[i], sB[i], sC[i]);
-    }
-}
+);
 
 /**
- * @brief Portable batch revision
+ * @brief Batch revision over array-of-structs truth values
  */
-inline void batch_revision(
+void batch_revision(
     std::span<const TruthValue> tv1,
     std::span<const TruthValue> tv2,
     std::span<TruthValue> out
-) {
-    size_t n = std::min({tv1.size(), tv2.size(), out.size()});
-
-    for (size_t i = 0; i < n; ++i) {
-        out[i] = revision(tv1[i], tv2[i]);
-    }
-}
+);
 
 } // namespace opencog::pln
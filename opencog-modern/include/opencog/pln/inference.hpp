@@ -10,11 +10,23 @@
  */
 
 #include <opencog/pln/formulas.hpp>
+#include <opencog/pln/proof.hpp>
+#include <opencog/pln/sampling.hpp>
 #include <opencog/atomspace/atomspace.hpp>
+#include <opencog/attention/attention_bank.hpp>
 #include <opencog/pattern/matcher.hpp>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <deque>
 #include <functional>
-#include <queue>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <unordered_map>
 #include <unordered_set>
 
 namespace opencog::pln {
@@ -23,6 +35,17 @@ namespace opencog::pln {
 // Inference Rule
 // ============================================================================
 
+/// Most premise truth values a statically typed rule can take
+inline constexpr size_t MAX_RULE_ARITY = 16;
+
+/**
+ * @brief Formula of a statically typed rule over its premise truth values
+ *
+ * Instantiated per rule type by make_rule<R>() (static_rules.hpp), so the
+ * formula is inlined into the kernel and premises stay on the stack.
+ */
+using RuleKernel = TruthValue (*)(std::span<const TruthValue>) noexcept;
+
 /**
  * @brief Abstract inference rule
  *
@@ -30,12 +53,28 @@ namespace opencog::pln {
  * - A pattern to match premises
  * - A formula to compute the conclusion's truth value
  * - A template for the conclusion
+ *
+ * The formula receives the truth values of the atoms matched by each
+ * premise conjunct, in pattern order, followed by those of the pattern's
+ * variables in declaration order. The forward chainer skips rules that
+ * lack a premise pattern, formula or conclusion template.
+ *
+ * Rules built from a static rule type also carry a kernel, which the
+ * engines call instead of the formula when its arity fits the premise
+ * pattern; user-defined rules need only the formula.
  */
 struct InferenceRule {
     std::string name;
     Pattern premise_pattern;
     std::function<TruthValue(const std::vector<TruthValue>&)> formula;
-    std::function<Handle(AtomSpace&, const BindingSet&)> conclusion_template;
+    RuleKernel kernel = nullptr;
+    size_t arity = 0;            // Premise truth values the kernel reads
+    // Sets *created, when non-null, to whether it made a new atom
+    std::function<Handle(AtomSpace&, const BindingSet&, bool* created)> conclusion_template;
+
+    // Shape of the conclusion over the premise variables, for backward
+    // chaining; rules without one are forward-only
+    std::optional<Pattern> conclusion_pattern;
 
     // Priority for rule selection
     float priority{1.0f};
@@ -106,19 +145,27 @@ struct InferenceConfig {
     bool allow_cycles = false;            // Allow inference cycles
     bool record_proof = true;             // Record inference steps
 
+    // Backward chaining answers kept by the engine's own cache (0 disables)
+    size_t cache_capacity = 65536;
+    // Proof arena of that cache before it starts a new one (0 for no limit)
+    size_t proof_bytes = size_t{64} << 20;
+
     // Termination conditions
-    std::function<bool(const Handle&)> target_reached;  // Goal check
+    // Goal check, called on each conclusion when it is first derived
+    std::function<bool(const Handle&)> target_reached;
 };
 
 // ============================================================================
-// Inference Step (for proof recording)
+// Sampling Budget
 // ============================================================================
 
-struct InferenceStep {
-    std::string rule_name;
-    std::vector<Handle> premises;
-    Handle conclusion;
-    TruthValue computed_tv;
+/**
+ * @brief Compute allowed to one attention-sampled inference query
+ */
+struct SamplingBudget {
+    size_t max_evaluations = 10000;          // Rule formula evaluations
+    std::chrono::microseconds max_time{0};   // Wall clock for focus scan and sampling; zero for no limit
+    uint64_t seed = 0;                       // Premise sampler seed
 };
 
 // ============================================================================
@@ -128,10 +175,197 @@ struct InferenceStep {
 struct InferenceResult {
     Handle conclusion;
     TruthValue truth_value;
-    std::vector<InferenceStep> proof;  // If record_proof enabled
+    ProofRef proof;  // If record_proof enabled; steps() lists it
     size_t iterations_used;
 };
 
+// ============================================================================
+// Derivation
+// ============================================================================
+
+/**
+ * @brief A rule firing found by PLNEngine::match, applied by commit
+ */
+struct Derivation {
+    uint32_t rule;                     // Index into the engine's rules()
+    std::vector<AtomId> premises;      // Clause atoms, pattern order
+    BindingSet bindings;
+    TruthValue tv;
+};
+
+/**
+ * @brief Rule firings already made: (rule, premise atoms) tuples
+ *
+ * Looked up by hash, but a hit is compared in full, so a hash collision
+ * never drops a firing.
+ */
+class FiringSet {
+public:
+    /** @return true if the firing was not yet present */
+    bool insert(uint32_t rule, std::span<const AtomId> premises);
+
+    [[nodiscard]] size_t size() const noexcept { return firings_.size(); }
+    void clear();
+
+private:
+    struct Firing {
+        uint32_t rule;
+        uint32_t offset;   // Into premises_
+        uint32_t count;
+    };
+
+    std::vector<AtomId> premises_;
+    std::vector<Firing> firings_;
+    std::unordered_multimap<uint64_t, uint32_t> by_hash_;
+};
+
+// ============================================================================
+// Bulk Inference Result
+// ============================================================================
+
+/**
+ * @brief Summary of a whole-graph inference pass
+ */
+struct BulkInferenceResult {
+    size_t premise_pairs = 0;          // Premise pairs evaluated
+    size_t created = 0;                // New conclusion links
+    size_t revised = 0;                // Existing links revised with new evidence
+    std::vector<Handle> conclusions;   // Created or revised links
+};
+
+// ============================================================================
+// Inference Cache
+// ============================================================================
+
+struct InferenceCacheStats {
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t insertions = 0;
+    size_t evictions = 0;       // Dropped to stay within capacity
+    size_t invalidations = 0;   // Dropped because the AtomSpace changed
+    size_t generations = 0;     // Proof stores started because one was full
+
+    [[nodiscard]] double hit_rate() const noexcept {
+        size_t total = hits + misses;
+        return total > 0 ? static_cast<double>(hits) / static_cast<double>(total) : 0.0;
+    }
+};
+
+/**
+ * @brief Bounded concurrent table of backward chaining answers
+ *
+ * Entries are keyed by the goal's content hash combined with a fingerprint
+ * of the rule set and thresholds that produced them, so engines with the
+ * same rules can share one cache. Each entry is stamped with the type
+ * versions of the atom types its rules' premises match, and the truth
+ * values of the facts it was derived from; lookup() drops it once any of
+ * them has changed. Atoms of other types cannot change the answer, so
+ * adding them leaves entries valid.
+ *
+ * The key space is split into independently locked shards, each holding a
+ * fixed number of slots recycled in CLOCK order: a hit sets the slot's
+ * reference bit, and the clock hand evicts the first slot it finds clear.
+ * Lookups return copies, so entries may be evicted while in use.
+ *
+ * Entries' proofs live in the cache's ProofStore, which the engines using
+ * the cache also record their forward chaining proofs in. Once the store
+ * holds proof_bytes, the next run starts a successor and every entry is
+ * dropped; the old store lives on only as long as results that refer to
+ * it. clear() starts a successor too.
+ */
+class InferenceCache {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 65536;
+    static constexpr size_t DEFAULT_SHARDS = 16;
+    static constexpr size_t DEFAULT_PROOF_BYTES = size_t{64} << 20;
+
+    struct Entry {
+        AtomId goal;
+        uint64_t context = 0;                                // Rule set fingerprint
+        bool proven = false;
+        TruthValue tv;
+        std::vector<std::pair<AtomType, uint64_t>> versions; // Of the premise types read
+        std::optional<uint64_t> version;                     // AtomSpace version, when a
+                                                             // premise has no single type
+        std::vector<std::pair<AtomId, TruthValue>> leaves;   // Facts read, sorted by id
+        const ProofNode* proof = nullptr;                    // In proofs
+        std::shared_ptr<const ProofStore> proofs;            // Set with proof
+    };
+
+    explicit InferenceCache(size_t capacity = DEFAULT_CAPACITY,
+                            size_t shards = DEFAULT_SHARDS,
+                            size_t proof_bytes = DEFAULT_PROOF_BYTES);
+
+    /**
+     * @brief Copy out a still-valid entry for a goal
+     *
+     * Stale entries, and those whose proof is in an earlier store, are
+     * dropped. Counts a hit or a miss.
+     */
+    [[nodiscard]] std::optional<Entry> lookup(const AtomSpace& space, uint64_t key,
+                                              AtomId goal, uint64_t context);
+
+    /**
+     * @brief Insert or replace the entry for a key, evicting if the shard is full
+     *
+     * An entry whose proof is in an earlier store is not kept.
+     */
+    void store(uint64_t key, Entry entry);
+
+    void clear();
+
+    /** @brief Total slots; rounded up to a multiple of the shard count */
+    [[nodiscard]] size_t capacity() const noexcept { return shard_capacity_ * shard_count_; }
+    [[nodiscard]] size_t size() const;
+    [[nodiscard]] InferenceCacheStats stats() const noexcept;
+    void reset_stats() noexcept;
+
+    /** @brief Proof nodes of the entries and of the engines sharing this cache */
+    [[nodiscard]] std::shared_ptr<ProofStore> proofs() const noexcept {
+        return proofs_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief The store a run should record into: proofs(), or its successor
+     *        when it has reached proof_bytes
+     */
+    [[nodiscard]] std::shared_ptr<ProofStore> proof_generation();
+
+private:
+    struct Slot {
+        uint64_t key = 0;
+        bool occupied = false;
+        bool referenced = false;
+        Entry entry;
+    };
+
+    struct alignas(CACHE_LINE_SIZE) Shard {
+        mutable std::mutex mutex;
+        std::unordered_map<uint64_t, uint32_t> index;   // Key -> slot
+        std::vector<Slot> slots;
+        size_t hand = 0;                                // CLOCK position
+    };
+
+    std::unique_ptr<Shard[]> shards_;
+    size_t shard_count_;       // Power of two
+    size_t shard_capacity_;
+    size_t proof_bytes_;
+    std::atomic<std::shared_ptr<ProofStore>> proofs_;
+
+    std::atomic<size_t> hits_{0};
+    std::atomic<size_t> misses_{0};
+    std::atomic<size_t> insertions_{0};
+    std::atomic<size_t> evictions_{0};
+    std::atomic<size_t> invalidations_{0};
+    std::atomic<size_t> generations_{0};
+
+    void drop_entries();
+
+    [[nodiscard]] Shard& shard_for(uint64_t key) const noexcept {
+        return shards_[(key ^ (key >> 32)) & (shard_count_ - 1)];
+    }
+};
+
 // ============================================================================
 // PLN Inference Engine
 // ============================================================================
@@ -148,6 +382,15 @@ class PLNEngine {
 public:
     explicit PLNEngine(AtomSpace& space, InferenceConfig config = {});
 
+    /**
+     * @brief Create an engine that shares an answer cache with others
+     *
+     * Engines may run on separate threads over the same AtomSpace; only
+     * answers derived under the same rules and thresholds are shared.
+     */
+    PLNEngine(AtomSpace& space, InferenceConfig config,
+              std::shared_ptr<InferenceCache> cache);
+
     // ========================================================================
     // Rule Management
     // ========================================================================
@@ -158,6 +401,11 @@ public:
 
     [[nodiscard]] const std::vector<InferenceRule>& rules() const { return rules_; }
 
+    /** @brief Incremented whenever the rule list changes */
+    [[nodiscard]] uint64_t rules_version() const noexcept { return rules_version_; }
+
+    [[nodiscard]] AtomSpace& space() const noexcept { return space_; }
+
     // ========================================================================
     // Forward Chaining
     // ========================================================================
@@ -165,8 +413,17 @@ public:
     /**
      * @brief Run forward chaining from a source atom
      *
-     * Applies rules to generate new conclusions, following
-     * inference paths guided by attention.
+     * Semi-naive evaluation to a fixed point: each round matches rule
+     * premises only against the atoms created by the previous round (the
+     * delta), joined with the rest of the AtomSpace through the target
+     * index. Derivations of one conclusion within a round are merged by
+     * revision; a conclusion that already exists is revised with the new
+     * evidence instead of duplicated. Each premise combination fires each
+     * rule at most once per run.
+     *
+     * Stops when a round creates nothing new, after max_iterations rounds,
+     * at max_results conclusions, or when target_reached accepts one.
+     * A node source seeds the first round with its incoming links.
      */
     [[nodiscard]] std::vector<InferenceResult> forward_chain(Handle source);
 
@@ -178,10 +435,76 @@ public:
     );
 
     /**
-     * @brief Run one step of forward chaining
+     * @brief Forward chain with every link a rule could consume as the delta
+     *
+     * Whole-graph consolidation: the first round considers all premises.
+     */
+    [[nodiscard]] std::vector<InferenceResult> forward_chain_all();
+
+    /**
+     * @brief Run one round of forward chaining from a source
      */
     [[nodiscard]] std::vector<InferenceResult> forward_step(Handle source);
 
+    /**
+     * @brief One forward round from premises sampled by attention
+     *
+     * Candidate premises are the links in the bank's attentional focus,
+     * weighted by STI, and the links around focused nodes, which share
+     * their node's STI. Candidates are drawn in proportion to weight,
+     * without replacement, and each is joined with the rest of the
+     * AtomSpace as in forward_step. Drawing stops when the candidates or
+     * the budget run out; a budget stop may cut a premise's matches short.
+     *
+     * Conclusions are committed most confident first and returned sorted
+     * by confidence, so max_results keeps the best found within budget.
+     * Sampling is reproducible for a given seed and AtomSpace.
+     */
+    [[nodiscard]] std::vector<InferenceResult> sample_forward(
+        const AttentionBank& bank,
+        const SamplingBudget& budget = {}
+    );
+
+    /**
+     * @brief Find the rule firings one round from sources would make
+     *
+     * First phase of forward_step. Reads the AtomSpace without writing
+     * it, so engines holding the same rules can match concurrently while
+     * nothing else modifies the space. Appends to out.
+     */
+    void match(std::span<const Handle> sources, std::vector<Derivation>& out);
+
+    /**
+     * @brief Apply firings in order and write their conclusions back
+     *
+     * Second phase of forward_step: derivations of one atom are merged by
+     * revision, new atoms take the merged value and existing ones are
+     * revised with it. Derivations must come from an engine with the same
+     * rules. The ids of created atoms are appended to created if given.
+     */
+    std::vector<InferenceResult> commit(std::span<const Derivation> derived,
+                                        std::vector<AtomId>* created = nullptr);
+
+    // ========================================================================
+    // Bulk Inference
+    // ========================================================================
+
+    /**
+     * @brief Deduce A->C for every pair of links A->B, B->C of a type
+     *
+     * One hop over the whole graph. Premise pairs are enumerated through
+     * the target index, gathered block by block into SoA buffers and run
+     * through the batch deduction kernel. Deductions of the same A->C are
+     * merged by revision, then written back in one phase. Existing
+     * conclusion links are revised with the batch revision kernel, and
+     * missing ones are inserted.
+     *
+     * All conclusions are computed from the truth values as they were
+     * before the pass, so the result does not depend on visiting order.
+     * Conclusions below config().min_confidence are dropped.
+     */
+    BulkInferenceResult deduce_all(AtomType link_type = AtomType::INHERITANCE_LINK);
+
     // ========================================================================
     // Backward Chaining
     // ========================================================================
@@ -189,16 +512,43 @@ public:
     /**
      * @brief Run backward chaining to prove a target
      *
-     * Searches for premises that could derive the target,
-     * recursively until grounded facts are found.
+     * A target whose confidence exceeds min_confidence is grounded.
+     * Otherwise every rule whose conclusion pattern unifies with it is
+     * tried: premise matches already in the AtomSpace become subgoals, and
+     * the derivations are merged by revision, together with any evidence
+     * the target already had.
+     *
+     * Subgoals are tabled by target in the engine's InferenceCache. An
+     * answer, or a failure to find one, is reused until the AtomSpace
+     * changes structurally or a fact it rests on changes truth value. The
+     * table is shared by all queries on this engine and any engine given
+     * the same cache.
+     *
+     * A subgoal already being proven higher up the current search is a
+     * cycle. That path fails, and goals that depended on the cut are not
+     * tabled until the goal that closes the cycle completes.
+     * max_iterations bounds the goal expansions per query.
      */
     [[nodiscard]] std::optional<InferenceResult> backward_chain(Handle target);
 
     /**
      * @brief Find all proofs for a target (up to max_results)
+     *
+     * One result per derivation of the target, or the target alone when
+     * it is grounded. Subgoals are solved as in backward_chain.
      */
     [[nodiscard]] std::vector<InferenceResult> find_proofs(Handle target);
 
+    /**
+     * @brief Drop all tabled subgoal answers
+     */
+    void clear_cache() { inference_cache_->clear(); }
+    [[nodiscard]] size_t cache_size() const { return inference_cache_->size(); }
+
+    [[nodiscard]] const std::shared_ptr<InferenceCache>& cache() const noexcept {
+        return inference_cache_;
+    }
+
     // ========================================================================
     // Configuration
     // ========================================================================
@@ -213,19 +563,75 @@ public:
     [[nodiscard]] size_t total_inferences() const { return total_inferences_; }
     [[nodiscard]] size_t cache_hits() const { return cache_hits_; }
 
+    /**
+     * @brief Counters of the answer cache, summed over every engine using it
+     */
+    [[nodiscard]] InferenceCacheStats cache_stats() const noexcept {
+        return inference_cache_->stats();
+    }
+
     void reset_stats() {
         total_inferences_ = 0;
         cache_hits_ = 0;
     }
 
+    /**
+     * @brief Add another engine's counters to this one's
+     */
+    void merge_stats(const PLNEngine& other) {
+        total_inferences_ += other.total_inferences_;
+        cache_hits_ += other.cache_hits_;
+    }
+
 private:
+    // Rule patterns compiled for the chainers
+    struct CompiledRule {
+        uint32_t rule;                     // Index into rules_
+        MatchEngine engine;                // Premise pattern
+        std::vector<uint32_t> var_slots;   // Engine slots, declaration order
+        MatchEngine conclusion;            // Conclusion pattern, if any
+        RuleKernel kernel = nullptr;       // Set when the arity fits the pattern
+        bool backward = false;
+
+        CompiledRule(uint32_t r, const AtomSpace& space)
+            : rule(r), engine(space), conclusion(space) {}
+    };
+
+    using GoalAnswer = InferenceCache::Entry;
+
+    // Per-query state of a backward chaining search
+    struct GoalSearch {
+        std::unordered_map<AtomId, size_t> depth_of;   // Goals being proven
+        size_t expansions = 0;
+        std::vector<InferenceResult>* derivations = nullptr;  // Top goal only
+        std::shared_ptr<ProofStore> proofs;            // Records new steps
+    };
+
+    // A conjunct of a compiled rule that atoms of some type can satisfy
+    struct PremiseSlot {
+        uint32_t rule;                     // Index into compiled_
+        uint32_t conjunct;
+    };
+
     AtomSpace& space_;
     InferenceConfig config_;
     std::vector<InferenceRule> rules_;
     PatternMatcher matcher_;
 
-    // Inference cache to avoid redundant work
-    std::unordered_map<uint64_t, TruthValue> inference_cache_;
+    // Forward chaining premise index, rebuilt when the rules change
+    std::vector<std::unique_ptr<CompiledRule>> compiled_;
+    std::unordered_map<AtomType, std::vector<PremiseSlot>> premise_index_;
+    std::vector<PremiseSlot> premise_wildcard_;   // Conjuncts of no single type
+    std::vector<AtomType> goal_types_;            // Premise types of backward rules
+    bool goal_wildcard_ = false;                  // A backward premise of no single type
+    bool compiled_stale_ = true;
+    uint64_t rules_version_ = 0;
+    uint64_t rules_fingerprint_ = 0;   // Context of this engine's cache entries
+    std::vector<uint32_t> rule_ids_;   // Interned in the proof store, by rule
+
+    // Backward chaining answer table
+    std::shared_ptr<InferenceCache> inference_cache_;
+    MatchEngine goal_engine_;   // Premise search for a subgoal
 
     // Statistics
     size_t total_inferences_{0};
@@ -239,33 +645,98 @@ private:
 
     [[nodiscard]] bool should_pursue(Handle h) const;
 
-    [[nodiscard]] uint64_t cache_key(
-        const std::string& rule_name,
-        const std::vector<Handle>& premises
-    ) const;
+    void compile_rules();
+    [[nodiscard]] std::vector<AtomId> seed_delta(std::span<const Handle> sources) const;
+    [[nodiscard]] std::vector<InferenceResult> run_forward(std::vector<AtomId> delta,
+                                                           size_t max_rounds);
+    size_t match_delta(std::span<const AtomId> delta, FiringSet& fired,
+                       std::vector<Derivation>& out, size_t max_evaluations = SIZE_MAX,
+                       std::chrono::steady_clock::time_point deadline =
+                           std::chrono::steady_clock::time_point::max());
+    bool commit_round(std::span<const Derivation> derived, size_t round,
+                      std::vector<InferenceResult>& results, std::vector<AtomId>& created);
+
+    [[nodiscard]] GoalAnswer solve(AtomId goal, GoalSearch& search, size_t& low);
+    [[nodiscard]] uint64_t cache_context() const;
+
+    [[nodiscard]] ProofRef proof_ref(std::shared_ptr<const ProofStore> store,
+                                     const ProofNode* root) const {
+        return root ? ProofRef(std::move(store), root, &space_) : ProofRef{};
+    }
 };
 
 // ============================================================================
 // Incremental Inference
 // ============================================================================
 
+/**
+ * @brief Set of atom ids safe for concurrent insertion and lookup
+ *
+ * Split into independently locked shards by id.
+ */
+class ConcurrentIdSet {
+public:
+    static constexpr size_t SHARD_COUNT = 16;
+
+    /** @return true if the id was not yet present */
+    bool insert(AtomId id);
+    [[nodiscard]] bool contains(AtomId id) const;
+    [[nodiscard]] size_t size() const;
+    void clear();
+
+private:
+    struct alignas(CACHE_LINE_SIZE) Shard {
+        std::mutex mutex;
+        std::unordered_set<AtomId> ids;
+    };
+
+    mutable std::array<Shard, SHARD_COUNT> shards_;
+
+    [[nodiscard]] Shard& shard_for(AtomId id) const noexcept {
+        return shards_[(id.value ^ (id.value >> 16)) % SHARD_COUNT];
+    }
+};
+
 /**
  * @brief Manages incremental inference over time
  *
  * Useful for agents that need to reason continuously
  * while handling new information.
+ *
+ * Each step takes a batch of pending stimuli and runs one forward
+ * chaining round from each. Matching is spread over worker threads, each
+ * with its own copy of the engine's rules: a worker drains its own deque
+ * of stimuli from the back and steals from the front of the others' once
+ * it runs dry. The conclusions of the whole batch are then committed to
+ * the AtomSpace by the calling thread, in stimulus order, so results do
+ * not depend on the number of threads or on scheduling.
+ *
+ * add_stimulus may be called from any thread. step() and run() must not
+ * run concurrently with each other or with other writers to the AtomSpace.
  */
 class IncrementalInference {
 public:
-    explicit IncrementalInference(PLNEngine& engine);
+    static constexpr size_t DEFAULT_BATCH_SIZE = 256;
+
+    /**
+     * @param threads Matching threads including the caller's; 0 uses
+     *                one per hardware thread
+     */
+    explicit IncrementalInference(PLNEngine& engine, size_t threads = 1);
+    ~IncrementalInference();
+
+    IncrementalInference(const IncrementalInference&) = delete;
+    IncrementalInference& operator=(const IncrementalInference&) = delete;
 
     /**
      * @brief Add new information to the inference queue
+     *
+     * Atoms already processed are ignored.
      */
     void add_stimulus(Handle atom);
 
     /**
-     * @brief Process one inference step
+     * @brief Process one batch of pending stimuli
      * @return Any new conclusions generated
      */
     [[nodiscard]] std::vector<InferenceResult> step();
@@ -280,10 +751,25 @@ public:
      */
     [[nodiscard]] bool has_pending() const;
 
+    void set_batch_size(size_t size) noexcept { batch_size_ = std::max<size_t>(size, 1); }
+    [[nodiscard]] size_t batch_size() const noexcept { return batch_size_; }
+    [[nodiscard]] size_t threads() const noexcept;
+
 private:
+    struct Pool;   // Worker threads and per-batch scheduling state
+
     PLNEngine& engine_;
-    std::queue<Handle> pending_;
-    std::unordered_set<uint64_t> visited_;
+    size_t batch_size_ = DEFAULT_BATCH_SIZE;
+
+    mutable std::mutex pending_mutex_;
+    std::deque<Handle> pending_;
+    ConcurrentIdSet visited_;
+
+    std::vector<Handle> batch_;
+    std::vector<std::vector<Derivation>> derived_;   // Per batch stimulus
+    std::unique_ptr<Pool> pool_;                     // Null when single-threaded
+
+    void match_batch();
 };
 
 } // namespace opencog::pln
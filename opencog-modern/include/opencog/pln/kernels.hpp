@@ -0,0 +1,109 @@
+#pragma once
+/**
+ * @file kernels.hpp
+ * @brief Runtime-dispatched SIMD kernels for PLN batch formulas
+ *
+ * Kernels take structure-of-arrays input, one array per truth value
+ * component, and compute the same results as the scalar formulas in
+ * formulas.hpp. Arrays need no particular alignment and counts need not be
+ * a multiple of the vector width: AVX-512 finishes with masked loads and
+ * stores, narrower targets with a partial final vector.
+ *
+ * Every kernel is written once against a small vector abstraction and
+ * compiled per instruction set (scalar, SSE2, AVX2, AVX-512, NEON). Only
+ * those translation units get ISA flags, so one binary runs on any CPU of
+ * its architecture and picks the widest supported kernels on first use.
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+namespace opencog::pln::kernels {
+
+// ============================================================================
+// Dispatch Control
+// ============================================================================
+
+enum class SimdLevel : uint8_t {
+    SCALAR,
+    SSE2,       // 4 lanes, x86-64 baseline
+    NEON,       // 4 lanes, AArch64 baseline
+    AVX2,       // 8 lanes, with FMA
+    AVX512      // 16 lanes, masked tails
+};
+
+[[nodiscard]] const char* simd_level_name(SimdLevel level) noexcept;
+
+/**
+ * @brief Widest level both compiled in and supported by this CPU
+ */
+[[nodiscard]] SimdLevel detected_simd_level() noexcept;
+
+/**
+ * @brief Level the kernels currently dispatch to
+ */
+[[nodiscard]] SimdLevel simd_level() noexcept;
+
+/**
+ * @brief Floats processed per vector at the active level
+ */
+[[nodiscard]] size_t simd_width() noexcept;
+
+/**
+ * @brief Force a level, e.g. to compare kernels or rule one out
+ *
+ * Unavailable levels fall back to the next narrower available one.
+ * @return The level actually selected
+ */
+SimdLevel set_simd_level(SimdLevel level) noexcept;
+
+// ============================================================================
+// Batch Kernels
+// ============================================================================
+
+/**
+ * @brief (A->B, B->C) => A->C over count premise pairs
+ */
+void deduction(const float* sAB, const float* cAB,
+               const float* sBC, const float* cBC,
+               const float* sB, const float* sC,
+               float* sAC, float* cAC, size_t count) noexcept;
+
+/**
+ * @brief (A->B) => B->A over count links
+ */
+void inversion(const float* sAB, const float* cAB,
+               const float* sA, const float* sB,
+               float* sBA, float* cBA, size_t count) noexcept;
+
+/**
+ * @brief Merge count pairs of truth values for the same statements
+ */
+void revision(const float* s1, const float* c1,
+              const float* s2, const float* c2,
+              float* s_out, float* c_out, size_t count) noexcept;
+
+/**
+ * @brief (A->B, C->B) => A->C over count premise pairs
+ */
+void abduction(const float* sAB, const float* cAB,
+               const float* sCB, const float* cCB,
+               const float* sB, const float* sC,
+               float* sAC, float* cAC, size_t count) noexcept;
+
+/**
+ * @brief (A, A->B) => B over count premise pairs
+ */
+void modus_ponens(const float* sA, const float* cA,
+                  const float* sAB, const float* cAB,
+                  float* sB, float* cB, size_t count) noexcept;
+
+void fuzzy_and(const float* s1, const float* c1,
+               const float* s2, const float* c2,
+               float* s_out, float* c_out, size_t count) noexcept;
+
+void fuzzy_or(const float* s1, const float* c1,
+              const float* s2, const float* c2,
+              float* s_out, float* c_out, size_t count) noexcept;
+
+} // namespace opencog::pln::kernels
@@ -0,0 +1,203 @@
+#pragma once
+/**
+ * @file proof.hpp
+ * @brief Shared proof DAG for PLN inference
+ *
+ * Every rule firing the engines record becomes one immutable ProofNode,
+ * allocated in an arena together with its premise ids. A node points to
+ * the proofs of its premises, so a derivation used by many conclusions is
+ * stored once, and recording a step costs a single allocation. Results
+ * carry a ProofRef to their root; the flat list of steps is only built
+ * when asked for.
+ *
+ * An arena is never trimmed, so its owner bounds memory by generations:
+ * once a store is full it starts a successor sharing its rule names, and
+ * the old store is freed when the last ProofRef into it goes away.
+ */
+
+#include <opencog/core/memory.hpp>
+#include <opencog/core/types.hpp>
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace opencog::pln {
+
+// ============================================================================
+// Inference Step (for proof recording)
+// ============================================================================
+
+struct InferenceStep {
+    std::string rule_name;
+    std::vector<Handle> premises;
+    Handle conclusion;
+    TruthValue computed_tv;
+};
+
+// ============================================================================
+// Proof Node
+// ============================================================================
+
+/**
+ * @brief One rule firing, or a merge of alternative derivations
+ *
+ * Merge nodes (rule == ProofStore::MERGE) stand for a conclusion whose
+ * evidence was revised from several derivations; their children are those
+ * derivations and they are not steps themselves.
+ */
+struct ProofNode {
+    uint32_t rule;                               // Interned rule name
+    AtomId conclusion;
+    TruthValue tv;                               // As computed by the rule
+    std::span<const AtomId> premises;            // Clause atoms, pattern order
+    std::span<const ProofNode* const> children;  // Proofs of derived premises
+
+    [[nodiscard]] bool is_merge() const noexcept;
+};
+
+// ============================================================================
+// Proof Store
+// ============================================================================
+
+/**
+ * @brief Append-only arena of proof nodes and interned rule names
+ *
+ * Nodes never move or change once added, so readers need no lock; adding
+ * and interning are serialized, which lets engines sharing an
+ * InferenceCache also share its store. Memory is released with the store.
+ */
+class ProofStore {
+public:
+    static constexpr uint32_t MERGE = UINT32_MAX;
+
+    ProofStore();
+    ProofStore(const ProofStore&) = delete;
+    ProofStore& operator=(const ProofStore&) = delete;
+
+    /**
+     * @brief An empty store sharing this one's rule ids
+     */
+    [[nodiscard]] std::shared_ptr<ProofStore> successor() const;
+
+    /**
+     * @brief Id of a rule name, assigned on first use
+     */
+    [[nodiscard]] uint32_t intern(std::string_view rule);
+
+    [[nodiscard]] std::string_view rule_name(uint32_t rule) const;
+
+    /**
+     * @brief Keep another store alive for as long as this one
+     *
+     * Needed before adding a node whose children live in that store.
+     */
+    void retain(std::shared_ptr<const ProofStore> other);
+
+    /**
+     * @brief Record a rule firing; premises and children are copied in
+     */
+    [[nodiscard]] const ProofNode* add(uint32_t rule, AtomId conclusion, TruthValue tv,
+                                       std::span<const AtomId> premises,
+                                       std::span<const ProofNode* const> children = {});
+
+    /**
+     * @brief Join alternative derivations of one conclusion
+     *
+     * Returns nullptr for none and the derivation itself for one.
+     */
+    [[nodiscard]] const ProofNode* merge(std::span<const ProofNode* const> alternatives);
+
+    /** @brief Nodes recorded so far */
+    [[nodiscard]] size_t size() const;
+    [[nodiscard]] size_t bytes_used() const;
+
+private:
+    // Shared by a store and its successors, so rule ids stay valid
+    struct Names {
+        mutable std::mutex mutex;
+        std::deque<std::string> names;                          // Stable storage
+        std::unordered_map<std::string_view, uint32_t> ids;     // Views into names
+    };
+
+    mutable std::mutex mutex_;
+    Arena arena_;
+    size_t nodes_ = 0;
+    std::shared_ptr<Names> names_;
+    std::vector<std::shared_ptr<const ProofStore>> retained_;
+};
+
+inline bool ProofNode::is_merge() const noexcept { return rule == ProofStore::MERGE; }
+
+// ============================================================================
+// Proof Reference
+// ============================================================================
+
+/**
+ * @brief Handle on the proof of one inference result
+ *
+ * Keeps its store alive, so results stay valid after the engine that
+ * produced them is gone.
+ */
+class ProofRef {
+public:
+    ProofRef() = default;
+    ProofRef(std::shared_ptr<const ProofStore> store, const ProofNode* root, AtomSpace* space)
+        : store_(std::move(store)), root_(root), space_(space) {}
+
+    [[nodiscard]] bool empty() const noexcept { return root_ == nullptr; }
+    [[nodiscard]] const ProofNode* root() const noexcept { return root_; }
+    [[nodiscard]] const ProofStore* store() const noexcept { return store_.get(); }
+
+    /**
+     * @brief Visit each step once, premises' proofs before the steps using them
+     */
+    template<typename Visitor>
+    void for_each_step(Visitor&& visit) const;
+
+    /** @brief Number of distinct steps */
+    [[nodiscard]] size_t size() const;
+
+    /**
+     * @brief Materialize the steps in the order of for_each_step
+     */
+    [[nodiscard]] std::vector<InferenceStep> steps() const;
+
+private:
+    std::shared_ptr<const ProofStore> store_;
+    const ProofNode* root_ = nullptr;
+    AtomSpace* space_ = nullptr;
+};
+
+template<typename Visitor>
+void ProofRef::for_each_step(Visitor&& visit) const {
+    if (!root_) return;
+
+    // Iterative post-order, so long chains cannot overflow the stack
+    struct Frame {
+        const ProofNode* node;
+        size_t next_child;
+    };
+    std::vector<Frame> stack{{root_, 0}};
+    std::unordered_set<const ProofNode*> seen{root_};
+
+    while (!stack.empty()) {
+        Frame& frame = stack.back();
+        if (frame.next_child < frame.node->children.size()) {
+            const ProofNode* child = frame.node->children[frame.next_child++];
+            if (seen.insert(child).second) stack.push_back({child, 0});
+            continue;
+        }
+        const ProofNode* node = frame.node;
+        stack.pop_back();
+        if (!node->is_merge()) visit(*node);
+    }
+}
+
+} // namespace opencog::pln
@@ -0,0 +1,74 @@
+#pragma once
+/**
+ * @file sampling.hpp
+ * @brief Weighted sampling for attention-guided inference
+ *
+ * WeightedSampler keeps weights in a Fenwick tree: drawing an index in
+ * proportion to its weight and changing one weight both take O(log n).
+ * Removing each drawn index samples without replacement, which is how PLN
+ * picks premises by STI from the attentional focus.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <vector>
+
+namespace opencog::pln {
+
+// ============================================================================
+// Weighted Sampler
+// ============================================================================
+
+class WeightedSampler {
+public:
+    WeightedSampler() = default;
+    explicit WeightedSampler(std::span<const float> weights) { build(weights); }
+
+    /**
+     * @brief Rebuild for a new weight vector in O(n)
+     *
+     * Negative weights count as zero. When every weight is zero, all
+     * indices are equally likely.
+     */
+    void build(std::span<const float> weights);
+
+    /**
+     * @brief Set the weight of index i
+     */
+    void update(size_t i, double weight);
+
+    /**
+     * @brief Exclude index i from further draws
+     */
+    void remove(size_t i) { update(i, 0.0); }
+
+    /**
+     * @brief Draw an index with probability proportional to its weight
+     *
+     * Requires live() > 0.
+     */
+    template<typename Rng>
+    [[nodiscard]] size_t sample(Rng& rng) const {
+        std::uniform_real_distribution<double> uniform(0.0, total_);
+        return find(uniform(rng));
+    }
+
+    [[nodiscard]] size_t size() const noexcept { return weights_.size(); }
+    [[nodiscard]] double total() const noexcept { return total_; }
+
+    /** @brief Indices that can still be drawn */
+    [[nodiscard]] size_t live() const noexcept { return live_; }
+
+private:
+    std::vector<double> weights_;
+    std::vector<double> tree_;   // 1-based Fenwick tree of partial sums
+    double total_ = 0.0;
+    size_t live_ = 0;
+
+    // First index whose prefix sum exceeds u
+    [[nodiscard]] size_t find(double u) const noexcept;
+};
+
+} // namespace opencog::pln
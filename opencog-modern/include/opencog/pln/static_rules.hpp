@@ -0,0 +1,201 @@
+#pragma once
+/**
+ * @file static_rules.hpp
+ * @brief Statically typed PLN rules
+ *
+ * A static rule is a type with a fixed arity and an inline formula over a
+ * fixed-size span of premise truth values. make_rule<R>() turns one into an
+ * InferenceRule whose kernel is instantiated for R, so the engines evaluate
+ * it without std::function dispatch or a premise vector. apply_batch<R>()
+ * runs the formula over many premise sets in one inlined loop.
+ *
+ * Rules whose shape is only known at run time keep using InferenceRule's
+ * std::function members directly.
+ */
+
+#include <opencog/pln/inference.hpp>
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace opencog::pln {
+
+// ============================================================================
+// Static Rule Concept
+// ============================================================================
+
+/**
+ * @brief A rule type usable with make_rule<R>()
+ *
+ * Required members:
+ * - name, priority and arity as static constants
+ * - formula(span<const TruthValue, arity>), noexcept
+ * - premises(): the premise pattern, whose conjuncts followed by its
+ *   variables supply the arity truth values
+ * - conclude(space, bindings, created): instantiate the conclusion,
+ *   setting *created (when non-null) to whether it made a new atom
+ *
+ * Optional members: conclusion() for backward chaining, and
+ * applicable(space, bindings) to veto a match.
+ */
+template<typename R>
+concept StaticRule = requires(std::span<const TruthValue, R::arity> tvs,
+                              AtomSpace& space, const BindingSet& bindings, bool* created) {
+    { R::name } -> std::convertible_to<std::string_view>;
+    { R::priority } -> std::convertible_to<float>;
+    requires R::arity > 0 && R::arity <= MAX_RULE_ARITY;
+    { R::formula(tvs) } noexcept -> std::same_as<TruthValue>;
+    { R::premises() } -> std::same_as<Pattern>;
+    { R::conclude(space, bindings, created) } -> std::same_as<Handle>;
+};
+
+/// Premise truth values of one application of R
+template<StaticRule R>
+using PremiseTVs = std::array<TruthValue, R::arity>;
+
+// ============================================================================
+// Evaluation
+// ============================================================================
+
+/**
+ * @brief Kernel of R: checks the arity, then runs the inlined formula
+ */
+template<StaticRule R>
+[[nodiscard]] TruthValue rule_kernel(std::span<const TruthValue> tvs) noexcept {
+    if (tvs.size() < R::arity) return TruthValue{};
+    return R::formula(tvs.template first<R::arity>());
+}
+
+/**
+ * @brief Apply R to each premise set
+ * @return Number of conclusions written (the smaller of the two sizes)
+ */
+template<StaticRule R>
+size_t apply_batch(std::span<const PremiseTVs<R>> premises, std::span<TruthValue> out) noexcept {
+    const size_t n = std::min(premises.size(), out.size());
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = R::formula(std::span<const TruthValue, R::arity>(premises[i]));
+    }
+    return n;
+}
+
+/**
+ * @brief Build the engine representation of a static rule
+ */
+template<StaticRule R>
+[[nodiscard]] InferenceRule make_rule() {
+    InferenceRule rule;
+    rule.name = std::string(R::name);
+    rule.priority = R::priority;
+    rule.premise_pattern = R::premises();
+    rule.kernel = &rule_kernel<R>;
+    rule.arity = R::arity;
+    rule.formula = [](const std::vector<TruthValue>& tvs) { return rule_kernel<R>(tvs); };
+    rule.conclusion_template = [](AtomSpace& space, const BindingSet& bindings, bool* created) {
+        return R::conclude(space, bindings, created);
+    };
+    if constexpr (requires { { R::conclusion() } -> std::same_as<Pattern>; }) {
+        rule.conclusion_pattern = R::conclusion();
+    }
+    if constexpr (requires(const AtomSpace& space, const BindingSet& bindings) {
+                      { R::applicable(space, bindings) } -> std::convertible_to<bool>;
+                  }) {
+        rule.applicable = [](const AtomSpace& space, const BindingSet& bindings) {
+            return R::applicable(space, bindings);
+        };
+    }
+    return rule;
+}
+
+// ============================================================================
+// Built-in Static Rules
+// ============================================================================
+
+namespace rules {
+
+/**
+ * @brief Deduction: (A->B, B->C) => A->C
+ *
+ * Premise TVs: A->B, B->C, A, B, C
+ */
+struct Deduction {
+    static constexpr std::string_view name = "deduction";
+    static constexpr float priority = 1.0f;
+    static constexpr size_t arity = 5;
+
+    [[nodiscard]] static constexpr TruthValue formula(std::span<const TruthValue, arity> tvs) noexcept {
+        return deduction(tvs[0], tvs[1], tvs[3].strength, tvs[4].strength);
+    }
+
+    [[nodiscard]] static Pattern premises();
+    [[nodiscard]] static Pattern conclusion();
+    [[nodiscard]] static Handle conclude(AtomSpace& space, const BindingSet& bindings, bool* created);
+    [[nodiscard]] static bool applicable(const AtomSpace& space, const BindingSet& bindings);
+};
+
+/**
+ * @brief Inversion: (A->B) => B->A
+ *
+ * Premise TVs: A->B, A, B
+ */
+struct Inversion {
+    static constexpr std::string_view name = "inversion";
+    static constexpr float priority = 0.8f;
+    static constexpr size_t arity = 3;
+
+    [[nodiscard]] static constexpr TruthValue formula(std::span<const TruthValue, arity> tvs) noexcept {
+        return inversion(tvs[0], tvs[1].strength, tvs[2].strength);
+    }
+
+    [[nodiscard]] static Pattern premises();
+    [[nodiscard]] static Pattern conclusion();
+    [[nodiscard]] static Handle conclude(AtomSpace& space, const BindingSet& bindings, bool* created);
+    [[nodiscard]] static bool applicable(const AtomSpace& space, const BindingSet& bindings);
+};
+
+/**
+ * @brief Modus ponens: (A, A->B) => B
+ *
+ * Premise TVs: A->B, A, B
+ */
+struct ModusPonens {
+    static constexpr std::string_view name = "modus-ponens";
+    static constexpr float priority = 1.0f;
+    static constexpr size_t arity = 3;
+
+    [[nodiscard]] static constexpr TruthValue formula(std::span<const TruthValue, arity> tvs) noexcept {
+        return modus_ponens(tvs[1], tvs[0]);
+    }
+
+    [[nodiscard]] static Pattern premises();
+    [[nodiscard]] static Pattern conclusion();
+    [[nodiscard]] static Handle conclude(AtomSpace& space, const BindingSet& bindings, bool* created);
+};
+
+/**
+ * @brief Abduction: (A->B, C->B) => A->C
+ *
+ * Premise TVs: A->B, C->B, A, B, C
+ */
+struct Abduction {
+    static constexpr std::string_view name = "abduction";
+    static constexpr float priority = 0.6f;
+    static constexpr size_t arity = 5;
+
+    [[nodiscard]] static constexpr TruthValue formula(std::span<const TruthValue, arity> tvs) noexcept {
+        return abduction(tvs[0], tvs[1], tvs[3].strength, tvs[4].strength);
+    }
+
+    [[nodiscard]] static Pattern premises();
+    [[nodiscard]] static Pattern conclusion();
+    [[nodiscard]] static Handle conclude(AtomSpace& space, const BindingSet& bindings, bool* created);
+    [[nodiscard]] static bool applicable(const AtomSpace& space, const BindingSet& bindings);
+};
+
+} // namespace rules
+
+} // namespace opencog::pln
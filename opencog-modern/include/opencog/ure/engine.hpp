@@ -10,33 +10,29 @@
  * - Integration with attention allocation
  */
 
+#include <opencog/ure/frontier.hpp>
+#include <opencog/ure/profiler.hpp>
 #include <opencog/ure/rule.hpp>
+#include <opencog/ure/rule_set.hpp>
 #include <opencog/attention/attention_bank.hpp>
+#include <opencog/pattern/generator.hpp>
 
 #include <chrono>
 #include <functional>
+#include <list>
+#include <memory>
 #include <optional>
 #include <queue>
+#include <stop_token>
+#include <unordered_map>
 #include <variant>
 
 namespace opencog::ure {
 
 // ============================================================================
-// Search Strategies
+// Search Control
 // ============================================================================
 
-/**
- * @brief How to select the next rule/target
- */
-enum class SearchStrategy {
-    BFS,              // Breadth-first (fair exploration)
-    DFS,              // Depth-first (follow chains deeply)
-    BEST_FIRST,       // Priority queue by heuristic
-    ATTENTION,        // Follow attention values
-    RANDOM,           // Random selection
-    ITERATIVE_DEEPENING  // DFS with increasing depth limit
-};
-
 /**
  * @brief Custom priority function for best-first search
  */
@@ -49,9 +45,17 @@ using PriorityFunction = std::function<float(const Rule&, Handle, const BindingS
 struct UREConfig {
     // Search control
     SearchStrategy strategy = SearchStrategy::ATTENTION;
+    uint64_t random_seed = 0;      // RANDOM strategy; 0 draws a seed per search
     size_t max_iterations = 1000;
     size_t max_results = 100;
-    std::chrono::milliseconds timeout{5000};
+    std::chrono::milliseconds timeout{5000};   // Checked between rule firings
+
+    // Parallel forward chaining. With more than one thread, atoms are
+    // taken from the frontier in batches of batch_size, matched by all
+    // threads, and committed in frontier order, so results do not depend
+    // on the thread count. 1 runs the sequential loop; 0 uses every core.
+    size_t threads = 1;
+    size_t batch_size = 64;
 
     // Rule selection
     float min_rule_confidence = 0.1f;
@@ -65,10 +69,18 @@ struct UREConfig {
     bool use_attention = true;
     float attention_boost = 2.0f;  // Multiplier for high-STI atoms
 
-    // Proof recording
+    // Proof recording; ITERATIVE_DEEPENING also stops at this depth
     bool record_proofs = true;
     size_t max_proof_depth = 50;
 
+    // Backward goals memoized across searches (UREngine::goal_table());
+    // 0 turns the table off
+    size_t goal_table_capacity = 4096;
+
+    // Per-rule timing and counts in UREngine::profiler(); costs two clock
+    // reads per rule tried and per conclusion committed
+    bool profile_rules = false;
+
     // Custom priority (for BEST_FIRST)
     PriorityFunction priority_fn;
 
@@ -83,6 +95,8 @@ struct UREConfig {
 
 /**
  * @brief Node in the inference/proof tree
+ *
+ * A node without a rule is an input atom the search started from.
  */
 struct InferenceNode {
     Handle atom;
@@ -90,7 +104,7 @@ struct InferenceNode {
     BindingSet bindings;
     TruthValue tv;
     std::vector<size_t> premise_indices;  // Indices of premise nodes
-    size_t depth{0};
+    size_t depth{0};                      // Inference steps above the inputs
 };
 
 /**
@@ -109,6 +123,50 @@ struct InferenceTree {
     [[nodiscard]] std::string to_string(const AtomSpace& space) const;
 };
 
+/**
+ * @brief The proof of one result, as a node in its search's proof log
+ *
+ * A search appends one node per accepted result to a log that all its
+ * results share, so recording stays linear in the number of results.
+ * Premise indices always point to earlier nodes. A reference holds the
+ * node index and shared ownership of the log, and of the RuleSet its
+ * nodes' rules belong to; only the nodes the conclusion depends on are
+ * visited or extracted.
+ */
+class ProofRef {
+public:
+    ProofRef() = default;
+    ProofRef(std::shared_ptr<const std::vector<InferenceNode>> log, size_t root,
+             std::shared_ptr<const RuleSet> rules = {})
+        : log_(std::move(log)), rules_(std::move(rules)), root_(root) {}
+
+    [[nodiscard]] bool empty() const noexcept { return !log_; }
+    [[nodiscard]] const InferenceNode& root() const { return (*log_)[root_]; }
+    [[nodiscard]] size_t root_index() const noexcept { return root_; }
+    [[nodiscard]] size_t depth() const { return empty() ? 0 : root().depth; }
+
+    /** @brief Number of nodes in this proof */
+    [[nodiscard]] size_t size() const { return subtree().size(); }
+
+    /** @brief Visit each node of this proof once, premises first */
+    void for_each_node(std::function<void(const InferenceNode&)> fn) const;
+
+    /** @brief Copy this proof out of the log, rooted at its last node */
+    [[nodiscard]] InferenceTree tree() const;
+
+    [[nodiscard]] std::string to_string(const AtomSpace& space) const {
+        return tree().to_string(space);
+    }
+
+private:
+    std::shared_ptr<const std::vector<InferenceNode>> log_;
+    std::shared_ptr<const RuleSet> rules_;
+    size_t root_ = 0;
+
+    /// Log indices reachable from the root, ascending
+    [[nodiscard]] std::vector<size_t> subtree() const;
+};
+
 // ============================================================================
 // URE Result
 // ============================================================================
@@ -116,13 +174,102 @@ struct InferenceTree {
 struct UREResult {
     Handle conclusion;
     TruthValue tv;
-    InferenceTree proof;  // If record_proofs enabled
+    ProofRef proof;  // If record_proofs enabled
     size_t iterations_used;
     std::chrono::microseconds time_taken;
 
     [[nodiscard]] bool valid() const { return conclusion.valid(); }
 };
 
+// ============================================================================
+// Goal Table
+// ============================================================================
+
+struct GoalTableStats {
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t evictions = 0;       // Dropped to stay within capacity
+    size_t invalidations = 0;   // Answers dropped because their inputs changed
+
+    [[nodiscard]] double hit_rate() const noexcept {
+        size_t total = hits + misses;
+        return total > 0 ? static_cast<double>(hits) / static_cast<double>(total) : 0.0;
+    }
+};
+
+/**
+ * @brief Bounded LRU memo of backward-chaining goals, by GoalKey
+ *
+ * An entry keeps a goal's expansions: the rules whose conclusions unify
+ * with it, each binding stored as a position in the goal, so any goal of
+ * the same shape reads them back with its own atoms. Ground goals also
+ * keep the proofs found for them. A proof stays usable while its atoms
+ * exist and its inputs keep the truth values it was derived from, since
+ * changing a truth value does not move the AtomSpace version; a list of
+ * every proof, possibly none, only while the AtomSpace is unchanged. Expansions hold rules of one RuleSet, so the owner
+ * clears the table when the rules change.
+ *
+ * Not thread-safe; each UREngine owns its own table.
+ */
+class GoalTable {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 4096;
+    static constexpr uint32_t UNBOUND = UINT32_MAX;
+
+    struct Expansion {
+        const Rule* rule;
+        std::vector<uint32_t> positions;    // Goal position per rule slot
+    };
+
+    struct Answer {
+        UREResult result;
+        std::vector<std::pair<AtomId, TruthValue>> leaves;  // Inputs, as used
+    };
+
+    struct Entry {
+        GoalKey key;
+        bool expanded = false;
+        std::vector<Expansion> expansions;  // In rule priority order
+        std::vector<Answer> answers;        // Ground goals only
+        bool answered = false;              // answers lists every proof...
+        uint64_t answered_at = 0;           // ...as of this AtomSpace version
+    };
+
+    explicit GoalTable(size_t capacity = DEFAULT_CAPACITY);
+
+    /**
+     * @brief The entry for a goal, added empty if missing
+     *
+     * Counts a hit when the entry was present.
+     */
+    [[nodiscard]] Entry& find_or_add(const GoalKey& key);
+
+    /** @brief The entry for a goal if present; counts nothing */
+    [[nodiscard]] Entry* find(const GoalKey& key);
+
+    /**
+     * @brief Drop answers whose proofs use an atom no longer in the space,
+     *        or an input whose truth value has changed
+     */
+    void validate(const AtomSpace& space, Entry& entry);
+
+    void set_capacity(size_t capacity);
+    void clear();
+
+    [[nodiscard]] size_t capacity() const noexcept { return capacity_; }
+    [[nodiscard]] size_t size() const noexcept { return entries_.size(); }
+    [[nodiscard]] const GoalTableStats& stats() const noexcept { return stats_; }
+    void reset_stats() noexcept { stats_ = {}; }
+
+private:
+    size_t capacity_;
+    std::list<Entry> entries_;   // Most recently used first
+    std::unordered_map<uint64_t, std::list<Entry>::iterator> index_;
+    GoalTableStats stats_;
+
+    void evict_to(size_t capacity);
+};
+
 // ============================================================================
 // Unified Rule Engine
 // ============================================================================
@@ -139,6 +286,10 @@ struct UREResult {
 class UREngine {
 public:
     UREngine(AtomSpace& space, UREConfig config = {});
+    ~UREngine();
+
+    UREngine(const UREngine&) = delete;
+    UREngine& operator=(const UREngine&) = delete;
 
     // Set optional attention bank for attention-guided search
     void set_attention_bank(AttentionBank* bank) { attention_ = bank; }
@@ -147,6 +298,12 @@ public:
     // Rule Management
     // ========================================================================
 
+    /**
+     * @brief The engine's rules
+     *
+     * Each search runs on the RuleSet snapshot current when it starts;
+     * edits made meanwhile apply from the next search on.
+     */
     RuleBase& rules() { return rules_; }
     const RuleBase& rules() const { return rules_; }
 
@@ -158,16 +315,33 @@ public:
      * @brief Run forward chaining from source atoms
      *
      * Applies rules to generate new conclusions,
-     * adding them to the AtomSpace.
+     * adding them to the AtomSpace. A stop request, like the timeout, is
+     * noticed between rule matches and between firings; the results found
+     * so far are returned.
      */
     [[nodiscard]] std::vector<UREResult> forward_chain(
-        std::span<const Handle> sources
+        std::span<const Handle> sources,
+        std::stop_token stop = {}
     );
 
     [[nodiscard]] std::vector<UREResult> forward_chain(Handle source) {
         return forward_chain(std::span<const Handle>(&source, 1));
     }
 
+    /**
+     * @brief Forward chaining that yields each result as it is accepted
+     *
+     * The search runs as the generator is advanced: one frontier atom, or
+     * one batch when threads > 1, per resumption. It ends early when the
+     * stop token is triggered or the generator is destroyed. The engine
+     * must outlive the generator, and its config must not change while
+     * the generator is in use.
+     */
+    [[nodiscard]] generator<UREResult> forward_chain_stream(
+        std::vector<Handle> sources,
+        std::stop_token stop = {}
+    );
+
     /**
      * @brief Run forward chaining until a target is found
      */
@@ -183,13 +357,24 @@ public:
     /**
      * @brief Run backward chaining to prove a target
      *
-     * Searches for rules whose conclusions unify with the target,
-     * then recursively tries to prove the premises.
+     * Searches for rules whose conclusions unify with the target and
+     * applies the first whose premises can all be had. A premise in the
+     * AtomSpace is taken as given; a missing one, once the rule's
+     * variables ground it, is added and proven as a subgoal in turn, up
+     * to max_proof_depth. Subgoals on the current path fail, so cycles
+     * end. Each ground goal's proofs are memoized for the rest of the
+     * search and in the goal table for later ones; subgoal atoms left
+     * unproven are removed when the search ends.
      */
     [[nodiscard]] std::optional<UREResult> backward_chain(Handle target);
 
     /**
      * @brief Find all proofs for a target
+     *
+     * An atom already confident enough is its own first proof; then one
+     * per rule whose premises can all be had, by priority, searching as
+     * backward_chain does. A premise proven as a subgoal contributes its
+     * first proof.
      */
     [[nodiscard]] std::vector<UREResult> find_all_proofs(
         Handle target,
@@ -203,7 +388,15 @@ public:
     /**
      * @brief Bidirectional search from both sources and target
      *
-     * More efficient for some problems than pure forward/backward.
+     * The backward side expands the target into subgoals through the
+     * rules whose conclusions unify with it; subgoals keep unbound premise
+     * variables, renamed apart from the goal's own. Subgoals are kept in a
+     * GoalIndex, and every forward conclusion is looked up there and
+     * unified, so a conclusion meets any goal it instantiates, not only an
+     * identical atom. A met goal is resolved by applying the rules that
+     * led to it, up to the target. Each round grows the smaller frontier.
+     * Goal expansions come from the goal table, and a proof of a ground
+     * target already there is returned without searching.
      */
     [[nodiscard]] std::optional<UREResult> bidirectional_chain(
         std::span<const Handle> sources,
@@ -221,6 +414,10 @@ public:
 
     /**
      * @brief Perform one backward chaining step
+     *
+     * Memoized in the goal table, so alpha-equivalent targets share it.
+     * @return The rules whose conclusion unifies with the target, with
+     *         the bindings that make it so
      */
     [[nodiscard]] std::vector<std::pair<const Rule*, BindingSet>> backward_step(
         Handle target
@@ -230,7 +427,10 @@ public:
     // Configuration
     // ========================================================================
 
-    void set_config(UREConfig config) { config_ = std::move(config); }
+    void set_config(UREConfig config) {
+        config_ = std::move(config);
+        goals_.set_capacity(config_.goal_table_capacity);
+    }
     [[nodiscard]] const UREConfig& config() const { return config_; }
 
     // ========================================================================
@@ -241,13 +441,54 @@ public:
         size_t total_iterations{0};
         size_t rules_applied{0};
         size_t atoms_created{0};
-        size_t cache_hits{0};
+        size_t expansion_hits{0};     // Goal expansions read from the goal table
+        size_t expansion_misses{0};   // Goal expansions computed
+        size_t answer_hits{0};        // Goals answered by proofs found before
+        size_t answer_misses{0};      // Ground goals searched for proofs
         std::chrono::microseconds total_time{0};
+
+        [[nodiscard]] double expansion_hit_rate() const noexcept {
+            return hit_rate(expansion_hits, expansion_misses);
+        }
+        [[nodiscard]] double answer_hit_rate() const noexcept {
+            return hit_rate(answer_hits, answer_misses);
+        }
+
+    private:
+        [[nodiscard]] static double hit_rate(size_t hits, size_t misses) noexcept {
+            size_t total = hits + misses;
+            return total > 0 ? static_cast<double>(hits) / static_cast<double>(total) : 0.0;
+        }
     };
 
     [[nodiscard]] Stats stats() const { return stats_; }
     void reset_stats() { stats_ = Stats{}; }
 
+    [[nodiscard]] const GoalTable& goal_table() const { return goals_; }
+    void clear_goal_table() { goals_.clear(); }
+
+    // ========================================================================
+    // Rule Profiling
+    // ========================================================================
+
+    /**
+     * @brief Per-rule profile, filled while config().profile_rules is set
+     *
+     * forward_chain_to and bidirectional_chain credit the proofs of the
+     * answers they return; after forward_chain, credit the results kept.
+     */
+    [[nodiscard]] const RuleProfiler& profiler() const { return profiler_; }
+    [[nodiscard]] RuleProfiler& profiler() { return profiler_; }
+
+    /** @brief Count each step of a proof toward its rule's usefulness */
+    void credit(const ProofRef& proof);
+
+    /**
+     * @brief Set rule priorities and complexities from the profile
+     * @return Number of rules retuned
+     */
+    size_t tune_rules() { return rules_.set_costs(profiler_.tune()); }
+
 private:
     AtomSpace& space_;
     UREConfig config_;
@@ -256,28 +497,134 @@ private:
     AttentionBank* attention_{nullptr};
 
     Stats stats_;
+    RuleProfiler profiler_;
+
+    GoalTable goals_;
+    std::shared_ptr<const RuleSet> goal_rules_;     // Snapshot goals_ was built on
+    GoalKey goal_key_;
+
+    struct Pool;   // Forward-chaining workers, created on first parallel run
+    std::unique_ptr<Pool> pool_;
 
     // Search state
     struct SearchState {
-        std::vector<Handle> frontier;
+        std::shared_ptr<const RuleSet> rules;   // Kept alive for the proofs
+        Frontier frontier;
         std::unordered_set<uint64_t> visited;
-        std::vector<InferenceNode> proof_nodes;
+        std::shared_ptr<std::vector<InferenceNode>> proof_log;
+        std::unordered_map<uint64_t, size_t> proof_of;  // Atom -> its node
         size_t iterations{0};
         std::chrono::steady_clock::time_point start_time;
 
+        // Forward chaining
+        std::stop_token stop;
+        size_t results{0};
+        bool parallel{false};
+        std::vector<Frontier::Entry> batch;
+        std::vector<RuleFiring> firings;
+        std::vector<AtomId> slots;
+        std::vector<RuleAttempt> attempts;
+
+        // Bidirectional and backward chaining: subgoal atoms the search
+        // added, removed when it ends, and the conclusions it derived,
+        // which stay
+        std::vector<AtomId> scaffold;
+        std::unordered_set<uint64_t> derived;
+
+        // Backward chaining: goals being proven, by depth, and those
+        // finished, with their proofs and whether that is all of them
+        struct Solved {
+            Handle goal;
+            std::vector<GoalTable::Answer> answers;
+            bool complete = false;
+        };
+        std::unordered_map<uint64_t, size_t> open;
+        std::unordered_map<uint64_t, Solved> solved;
+
         bool should_stop(const UREConfig& config) const;
+
+        /// Stop requested or timed out, for checks inside an iteration
+        bool interrupted(const UREConfig& config) const;
     };
 
     // Internal methods
-    [[nodiscard]] Handle select_next(SearchState& state);
+    [[nodiscard]] Frontier make_frontier() const;
+
+    /// Pick up the latest rules for a new search
+    void begin_search(SearchState& state);
+
+    // forward_step and backward_step on the applicator's current snapshot
+    [[nodiscard]] std::vector<RuleApplicationResult> apply_rules(Handle source);
+    [[nodiscard]] std::vector<std::pair<const Rule*, BindingSet>> match_conclusions(
+        Handle target);
+
+    /// The goal table entry for a goal, its key left in goal_key_; null
+    /// when the table is off
+    [[nodiscard]] GoalTable::Entry* goal_entry(Handle goal);
+
+    /// Rules whose conclusion unifies with the goal, memoized in the entry
+    /// goal_entry just returned for it
+    [[nodiscard]] std::vector<std::pair<const Rule*, BindingSet>> expand_goal(
+        Handle goal, GoalTable::Entry* entry);
+
+    /// backward_chain and find_all_proofs
+    [[nodiscard]] std::vector<UREResult> prove(Handle target, size_t max_proofs);
+
+    /// Up to wanted proofs of a goal at a depth of the search; low takes
+    /// the shallowest open goal a cycle reached, 0 if a limit cut it short
+    [[nodiscard]] std::vector<GoalTable::Answer> solve_goal(
+        SearchState& state, Handle goal, size_t wanted, size_t depth, size_t& low);
+    [[nodiscard]] std::optional<Frontier::Entry> select_next(SearchState& state);
     [[nodiscard]] float compute_priority(Handle h, const Rule* rule) const;
 
-    void record_application(
+    /// Append a node for the result, derived from the source atom
+    [[nodiscard]] size_t record_application(
         SearchState& state,
+        Handle source,
         const RuleApplicationResult& result
     );
 
-    [[nodiscard]] InferenceTree build_proof_tree(const SearchState& state) const;
+    // Forward chaining: filter, record and enqueue one application
+    void accept_result(SearchState& state, const Frontier::Entry& from,
+                       const RuleApplicationResult& app_result,
+                       std::vector<UREResult>& results);
+    void end_iteration(SearchState& state);
+
+    // Forward chaining: set up a search, then run it a round at a time;
+    // a round returns false once the search is over
+    void start_forward(SearchState& state, std::span<const Handle> sources,
+                       std::stop_token stop);
+    [[nodiscard]] bool forward_round(SearchState& state, std::vector<UREResult>& results);
+    [[nodiscard]] bool forward_round_parallel(SearchState& state,
+                                              std::vector<UREResult>& results);
+
+    /// Commit one atom's firings in order, passing each application to
+    /// accept; false if the search was interrupted part way
+    template<typename Accept>
+    [[nodiscard]] bool commit_firings(const SearchState* state, Handle source,
+                                      std::span<const RuleFiring> firings,
+                                      std::span<const AtomId> slots,
+                                      std::span<RuleAttempt> attempts,
+                                      Accept&& accept);
+
+    // Bidirectional chaining: a subgoal and the step that concludes its parent
+    struct BackwardGoal {
+        static constexpr uint32_t ROOT = UINT32_MAX;
+
+        Handle atom;
+        uint32_t parent{ROOT};
+        const Rule* rule{nullptr};
+        uint32_t clause{0};
+    };
+
+    /// Apply the rules from a met goal up to the target
+    [[nodiscard]] std::optional<UREResult> resolve_goal(
+        SearchState& state,
+        const std::vector<BackwardGoal>& goals,
+        uint32_t goal,
+        Handle atom,
+        TruthValue tv
+    );
 };
 
 // ============================================================================
@@ -0,0 +1,143 @@
+#pragma once
+/**
+ * @file frontier.hpp
+ * @brief Search frontiers for the Unified Rule Engine
+ *
+ * Each search strategy gets the container that makes its selection cheap:
+ * - BFS: ring buffer, O(1) push and pop
+ * - DFS: stack, O(1)
+ * - BEST_FIRST, ATTENTION: indexed 4-ary max-heap with update-key, O(log n)
+ * - RANDOM: swap-remove from a vector, O(1)
+ * - ITERATIVE_DEEPENING: stack that defers atoms past a growing depth limit
+ *
+ * Heap keys come from a key function. Because attention moves without
+ * notice, the top is re-keyed before it is returned and the whole heap is
+ * re-keyed once per frontier-length of pops, which is O(1) amortized.
+ */
+
+#include <opencog/core/types.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace opencog::ure {
+
+// ============================================================================
+// Search Strategies
+// ============================================================================
+
+/**
+ * @brief How to select the next rule/target
+ */
+enum class SearchStrategy {
+    BFS,              // Breadth-first (fair exploration)
+    DFS,              // Depth-first (follow chains deeply)
+    BEST_FIRST,       // Priority queue by heuristic
+    ATTENTION,        // Follow attention values
+    RANDOM,           // Random selection
+    ITERATIVE_DEEPENING  // DFS with increasing depth limit
+};
+
+// ============================================================================
+// Frontier
+// ============================================================================
+
+class Frontier {
+public:
+    struct Entry {
+        Handle atom;
+        size_t depth = 0;     // Rule applications from a source
+        float priority = 0.0f;
+    };
+
+    /// Heap key of an atom; larger is selected first
+    using KeyFunction = std::function<float(Handle)>;
+
+    /// Children per heap node
+    static constexpr size_t ARITY = 4;
+
+    /**
+     * @param strategy Selection order
+     * @param key Heap key, for BEST_FIRST and ATTENTION
+     * @param seed RANDOM selection seed
+     * @param max_depth ITERATIVE_DEEPENING never goes deeper than this
+     */
+    explicit Frontier(SearchStrategy strategy = SearchStrategy::BFS, KeyFunction key = {},
+                      uint64_t seed = 0, size_t max_depth = SIZE_MAX);
+
+    /**
+     * @brief Queue an atom
+     *
+     * In heap modes an atom is queued at most once; pushing it again
+     * re-keys it and keeps the smaller depth.
+     */
+    void push(Handle atom, size_t depth = 0);
+
+    /**
+     * @brief Remove and return the next atom, or nullopt when empty
+     */
+    [[nodiscard]] std::optional<Entry> pop();
+
+    /**
+     * @brief Re-key a queued atom after its priority changed (heap modes)
+     * @return Whether the atom was queued
+     */
+    bool update(Handle atom);
+
+    [[nodiscard]] bool contains(Handle atom) const;
+    [[nodiscard]] size_t size() const noexcept;
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+    void clear();
+
+    [[nodiscard]] SearchStrategy strategy() const noexcept { return strategy_; }
+
+    /** @brief Current ITERATIVE_DEEPENING limit */
+    [[nodiscard]] size_t depth_limit() const noexcept { return depth_limit_; }
+
+private:
+    SearchStrategy strategy_;
+    KeyFunction key_;
+    std::mt19937_64 rng_;
+    size_t max_depth_;
+
+    // BFS ring buffer; capacity is a power of two
+    std::vector<Entry> ring_;
+    size_t head_ = 0;
+    size_t count_ = 0;
+
+    // DFS / ITERATIVE_DEEPENING stack, RANDOM pool
+    std::vector<Entry> items_;
+
+    // ITERATIVE_DEEPENING: entries past the current limit
+    std::vector<Entry> deferred_;
+    size_t depth_limit_ = 1;
+
+    // BEST_FIRST / ATTENTION: the heap holds 8-byte nodes so a node's
+    // children share a cache line; entries live in recycled slots
+    struct HeapNode {
+        float priority;
+        uint32_t slot;
+    };
+    std::vector<HeapNode> heap_;
+    std::vector<Entry> slots_;
+    std::vector<uint32_t> heap_index_;                 // Slot -> heap position
+    std::vector<uint32_t> free_slots_;
+    std::unordered_map<AtomId, uint32_t> slot_of_;     // Queued atom -> slot
+    size_t pops_since_rekey_ = 0;
+
+    [[nodiscard]] bool is_heap() const noexcept;
+    [[nodiscard]] float key_of(Handle atom) const { return key_ ? key_(atom) : 0.0f; }
+
+    void ring_push(const Entry& entry);
+    void heap_place(size_t i, HeapNode node);
+    void heap_rekey(uint32_t slot, float priority);
+    void sift_up(size_t i);
+    void sift_down(size_t i);
+    void rekey_all();
+};
+
+} // namespace opencog::ure
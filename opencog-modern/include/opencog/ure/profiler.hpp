@@ -0,0 +1,113 @@
+#pragma once
+/**
+ * @file profiler.hpp
+ * @brief Per-rule cost and usefulness profile for the Unified Rule Engine
+ *
+ * A call is one candidate rule tried on one source: matching its premise
+ * clauses and committing the conclusions that matched. Call times go
+ * into a log-linear histogram (four buckets per power of two), so the
+ * p99 is exact to within 25% without keeping samples. Usefulness counts
+ * how often a rule's steps appear in the proofs credited to it, normally
+ * the answers a search returned.
+ */
+
+#include <opencog/ure/rule.hpp>
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace opencog::ure {
+
+// ============================================================================
+// Rule Profile
+// ============================================================================
+
+struct RuleProfile {
+    std::string name;
+    size_t calls = 0;           // Times the rule was tried on a source
+    size_t attempts = 0;        // Premise clauses tried
+    size_t matches = 0;         // Clauses that unified
+    size_t applications = 0;    // Conclusions produced
+    size_t atoms_created = 0;   // Atoms those applications added
+    size_t proof_uses = 0;      // Steps in credited proofs
+    uint64_t total_ns = 0;
+    uint64_t p99_ns = 0;
+    double time_share = 0.0;    // Of all profiled rule time
+
+    [[nodiscard]] double success_rate() const noexcept {
+        return attempts > 0 ? static_cast<double>(matches) / static_cast<double>(attempts) : 0.0;
+    }
+
+    [[nodiscard]] double mean_ns() const noexcept {
+        return calls > 0 ? static_cast<double>(total_ns) / static_cast<double>(calls) : 0.0;
+    }
+
+    /** @brief Credited proof steps per application */
+    [[nodiscard]] double usefulness() const noexcept {
+        return applications > 0
+            ? static_cast<double>(proof_uses) / static_cast<double>(applications)
+            : 0.0;
+    }
+};
+
+// ============================================================================
+// Rule Profiler
+// ============================================================================
+
+/**
+ * @brief Accumulates RuleProfiles; keyed by rule name, so a profile carries
+ *        over to the next RuleSet snapshot, such as one with tuned costs
+ *
+ * Not thread-safe; the engine records from the committing thread only.
+ */
+class RuleProfiler {
+public:
+    /** @brief Record one call: its matching effort plus commit time */
+    void record_call(const RuleAttempt& attempt);
+
+    /** @brief Record one committed conclusion */
+    void record_application(const Rule* rule, size_t atoms_created);
+
+    /** @brief Count one proof step made by the rule */
+    void credit(const Rule* rule);
+
+    void clear() { entries_.clear(); }
+    [[nodiscard]] bool empty() const noexcept { return entries_.empty(); }
+
+    /** @brief Profiles by total time, most expensive first */
+    [[nodiscard]] std::vector<RuleProfile> report() const;
+
+    /** @brief The report as an aligned table */
+    [[nodiscard]] std::string to_string() const;
+
+    /**
+     * @brief Costs derived from the profile, for RuleBase::set_costs
+     *
+     * Complexity is a rule's mean call time over the mean across profiled
+     * rules. Priority is its credited proof steps per call, shrunk toward
+     * the rate across all rules, per unit of complexity, scaled so that
+     * the profiled rules average 1.
+     */
+    [[nodiscard]] std::vector<RuleCost> tune() const;
+
+private:
+    static constexpr size_t BUCKETS = 256;
+
+    struct Entry {
+        RuleProfile profile;
+        std::array<uint32_t, BUCKETS> histogram{};
+        uint64_t max_ns = 0;
+    };
+
+    std::unordered_map<std::string, Entry> entries_;
+
+    Entry& entry(const Rule& rule);
+    [[nodiscard]] static size_t bucket(uint64_t ns) noexcept;
+    [[nodiscard]] static uint64_t bucket_limit(size_t bucket) noexcept;
+};
+
+} // namespace opencog::ure
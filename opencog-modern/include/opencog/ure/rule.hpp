@@ -13,15 +13,25 @@
 
 #include <opencog/core/types.hpp>
 #include <opencog/atomspace/atomspace.hpp>
-#include <opencog/pattern/pattern.hpp>
+#include <opencog/pattern/matcher.hpp>
+#include <opencog/ure/rule_index.hpp>
+#include <opencog/ure/rule_program.hpp>
 
+#include <atomic>
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <span>
+#include <stop_token>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace opencog::ure {
 
+class RuleSet;
+
 // ============================================================================
 // Rule Definition
 // ============================================================================
@@ -48,11 +58,60 @@ struct Rule {
     float complexity{1.0f};     // Computational cost estimate
     float priority{1.0f};       // User-assigned priority
 
+    // Premise and conclusion compiled with numbered variables; set by
+    // RuleBase::add_rule, built on demand for rules applied directly
+    std::shared_ptr<const RuleProgram> program;
+
     [[nodiscard]] bool valid() const {
         return !name.empty() && premise.valid() && conclusion.valid();
     }
 };
 
+/**
+ * @brief New priority and complexity for a named rule
+ */
+struct RuleCost {
+    std::string name;
+    float priority;
+    float complexity;
+};
+
+// ============================================================================
+// Rule View
+// ============================================================================
+
+/**
+ * @brief Rules found in one RuleSet snapshot, holding it alive
+ *
+ * The rules are pointers into the snapshot, so a view stays valid after
+ * the rule base moves on to a newer one.
+ */
+class RuleView {
+public:
+    RuleView() = default;
+
+    /** @brief Every rule of a snapshot, by priority */
+    explicit RuleView(std::shared_ptr<const RuleSet> set);
+
+    /** @brief Rules of a snapshot picked out by a lookup */
+    RuleView(std::shared_ptr<const RuleSet> set, std::vector<const Rule*> found);
+
+    [[nodiscard]] std::span<const Rule* const> rules() const noexcept;
+    [[nodiscard]] const std::shared_ptr<const RuleSet>& snapshot() const noexcept { return set_; }
+
+    [[nodiscard]] auto begin() const noexcept { return rules().begin(); }
+    [[nodiscard]] auto end() const noexcept { return rules().end(); }
+    [[nodiscard]] size_t size() const noexcept { return rules().size(); }
+    [[nodiscard]] bool empty() const noexcept { return rules().empty(); }
+    [[nodiscard]] const Rule* front() const noexcept { return rules().front(); }
+    [[nodiscard]] const Rule* operator[](size_t i) const noexcept { return rules()[i]; }
+
+private:
+    std::shared_ptr<const RuleSet> set_;
+    std::vector<const Rule*> found_;
+    bool by_priority_ = false;      // The snapshot's own list, not found_
+};
+
 // ============================================================================
 // Rule Base
 // ============================================================================
@@ -64,10 +123,17 @@ struct Rule {
  * - The AtomSpace (as DefineLinks)
  * - External files
  * - Programmatically added
+ *
+ * Edits are staged, and compiled into a new RuleSet the next time one is
+ * asked for; the RuleSet in use is swapped atomically, never modified.
+ * Edits and snapshot() may be called from any thread. Lookups below
+ * read the current snapshot and return a RuleView that holds it, so the
+ * rules they name stay alive while the view does, whatever edits follow.
  */
 class RuleBase {
 public:
     explicit RuleBase(AtomSpace& space);
+    ~RuleBase();
 
     // ========================================================================
     // Rule Management
@@ -100,23 +166,58 @@ public:
      */
     void clear();
 
+    /**
+     * @brief Change the priority and complexity of rules by name
+     * @return Number of rules changed
+     */
+    size_t set_costs(std::span<const RuleCost> costs);
+
+    // ========================================================================
+    // Snapshots
+    // ========================================================================
+
+    /**
+     * @brief The rules as of the last edit, compiled
+     *
+     * Compiles at most once per batch of edits; otherwise one atomic load.
+     */
+    [[nodiscard]] std::shared_ptr<const RuleSet> snapshot() const;
+
+    /** @brief Number of edits so far; a snapshot is current when it matches */
+    [[nodiscard]] uint64_t version() const noexcept {
+        return version_.load(std::memory_order_acquire);
+    }
+
     // ========================================================================
     // Rule Lookup
     // ========================================================================
 
     [[nodiscard]] std::optional<Rule> get_rule(const std::string& name) const;
     [[nodiscard]] std::vector<Rule> get_all_rules() const;
-    [[nodiscard]] size_t size() const { return rules_.size(); }
+    [[nodiscard]] size_t size() const;
 
     /**
      * @brief Get rules applicable to a given atom type
      */
-    [[nodiscard]] std::vector<const Rule*> get_rules_for_type(AtomType type) const;
+    [[nodiscard]] RuleView get_rules_for_type(AtomType type) const;
 
     /**
-     * @brief Get rules sorted by priority
+     * @brief Get rules sorted by priority, highest first
+     *
+     * Sorted when the snapshot is compiled; no work per call.
      */
-    [[nodiscard]] std::vector<const Rule*> get_rules_by_priority() const;
+    [[nodiscard]] RuleView get_rules_by_priority() const;
+
+    /**
+     * @brief Rules with a premise clause that can unify with a source atom
+     *
+     * Looked up in a discrimination tree over premise structure, so the
+     * cost depends on the source's size, not on the number of rules.
+     * Results are in priority order. Repeated variables are only checked
+     * by unification (could_apply, RuleApplicator::find_applicable).
+     * Callers reusing a buffer look up in a held snapshot() instead.
+     */
+    [[nodiscard]] RuleView get_rules_for_atom(Handle source) const;
 
     // ========================================================================
     // Rule Analysis
@@ -128,19 +229,23 @@ public:
     [[nodiscard]] std::vector<std::string> get_variables(const Rule& rule) const;
 
     /**
-     * @brief Check if a rule could potentially apply to an atom
+     * @brief Check if an atom unifies with one of a rule's premise clauses
      */
     [[nodiscard]] bool could_apply(const Rule& rule, Handle target) const;
 
 private:
     AtomSpace& space_;
+
+    // Staged edits, under mutex_
+    mutable std::mutex mutex_;
     std::vector<Rule> rules_;
+    std::unordered_map<std::string, size_t> name_index_;   // Latest of each name
+    std::atomic<uint64_t> version_{0};
 
-    // Index for fast lookup
-    std::unordered_map<std::string, size_t> name_index_;
-    std::unordered_multimap<AtomType, size_t> type_index_;
+    mutable std::atomic<std::shared_ptr<const RuleSet>> published_;
 
-    void rebuild_indices();
+    /// Record an edit; the caller holds mutex_
+    void edited();
 };
 
 // ============================================================================
@@ -156,16 +261,52 @@ struct RuleApplicationResult {
     [[nodiscard]] bool valid() const { return rule && result.valid(); }
 };
 
+/**
+ * @brief A rule whose premise clause matched a source, not yet applied
+ *
+ * Slot bindings live in a caller-owned buffer at the given offset.
+ */
+struct RuleFiring {
+    const Rule* rule;
+    uint32_t clause;
+    uint32_t slots;       // Offset into the slot buffer
+    AtomId existing;      // Conclusion, when it is already in the AtomSpace
+};
+
+/**
+ * @brief Matching effort spent on one candidate rule for one source
+ */
+struct RuleAttempt {
+    const Rule* rule;
+    uint32_t clauses;        // Premise clauses tried
+    uint32_t matches;        // Clauses that unified
+    uint64_t nanoseconds;
+};
+
 // ============================================================================
 // Rule Applicator
 // ============================================================================
 
 /**
  * @brief Applies rules to atoms
+ *
+ * Matches against a RuleSet snapshot of the rule base. The non-const
+ * calls first pick up a newer snapshot if the rules changed; match_all
+ * uses the one held, so threads sharing an applicator agree on it.
  */
 class RuleApplicator {
 public:
     RuleApplicator(AtomSpace& space, const RuleBase& rules);
+    ~RuleApplicator();
+
+    /** @brief Take the rule base's current snapshot if the rules changed */
+    void refresh();
+
+    /** @brief The snapshot being matched against */
+    [[nodiscard]] const RuleSet& rules() const noexcept { return *rules_; }
+    [[nodiscard]] const std::shared_ptr<const RuleSet>& snapshot() const noexcept {
+        return rules_;
+    }
 
     /**
      * @brief Apply a specific rule with given bindings
@@ -183,8 +324,39 @@ public:
         size_t max_results = SIZE_MAX
     );
 
+    /**
+     * @brief Match every applicable rule against a target, read-only
+     *
+     * Conclusions that already exist are looked up speculatively. Only
+     * reads the AtomSpace and the held snapshot, so several threads may
+     * match at once while nothing writes to the AtomSpace. A stop request ends matching before the
+     * next candidate rule. With attempts given, each candidate rule's
+     * clause count, matches and time are appended to it.
+     * @return Number of firings appended
+     */
+    size_t match_all(
+        Handle target,
+        std::vector<RuleFiring>& firings,
+        std::vector<AtomId>& slots,
+        size_t max_results = SIZE_MAX,
+        std::stop_token stop = {},
+        std::vector<RuleAttempt>* attempts = nullptr
+    ) const;
+
+    /**
+     * @brief Apply a firing from match_all, creating its conclusion if needed
+     */
+    [[nodiscard]] std::optional<RuleApplicationResult> commit(
+        Handle target,
+        const RuleFiring& firing,
+        std::span<const AtomId> slots
+    );
+
     /**
      * @brief Apply all applicable rules to a target
+     *
+     * Matches and instantiates on slot arrays; name-keyed bindings are
+     * only built for the results.
      */
     [[nodiscard]] std::vector<RuleApplicationResult> apply_all(
         Handle target,
@@ -193,18 +365,14 @@ public:
 
 private:
     AtomSpace& space_;
-    const RuleBase& rules_;
+    const RuleBase& base_;
+    std::shared_ptr<const RuleSet> rules_;
     PatternMatcher matcher_;
 
-    [[nodiscard]] Handle instantiate_template(
-        Handle templ,
-        const BindingSet& bindings
-    );
-
     [[nodiscard]] TruthValue compute_tv(
         const Rule& rule,
         const BindingSet& bindings
-    );
+    ) const;
 };
 
 } // namespace opencog::ure
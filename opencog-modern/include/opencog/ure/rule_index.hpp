@@ -0,0 +1,217 @@
+#pragma once
+/**
+ * @file rule_index.hpp
+ * @brief Discrimination trees over URE rule premises and backward goals
+ *
+ * A pattern is flattened in pre-order into tokens: a link contributes its
+ * type and arity, a grounded node its atom id, and a VariableNode a
+ * wildcard standing for one whole subtree. The tokens are inserted into a
+ * trie. Looking up an atom walks its own pre-order through the trie,
+ * following the exact edge and the wildcard edge at each position, so
+ * only patterns whose structure can unify with the atom are reached.
+ * RuleIndex stores premise clauses, each leaf keeping its rules sorted by
+ * priority; GoalIndex stores the subgoals of a backward search. GoalKey
+ * numbers variables instead, giving goals an alpha-canonical identity.
+ */
+
+#include <opencog/core/types.hpp>
+#include <opencog/pattern/pattern.hpp>
+
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace opencog {
+class AtomSpace;
+}
+
+namespace opencog::ure {
+
+struct Rule;
+
+// ============================================================================
+// Premise Unification
+// ============================================================================
+
+/**
+ * @brief Clauses of a premise: the outgoing set of an AndLink, else itself
+ */
+[[nodiscard]] std::vector<Handle> premise_clauses(const AtomSpace& space, Handle premise);
+
+/**
+ * @brief One-way unification of a premise clause against an atom
+ *
+ * VariableNodes in the clause bind to whole subtrees of the atom, and a
+ * variable seen twice must bind the same atom both times. Bindings made
+ * before a failure are left in place.
+ */
+[[nodiscard]] bool unify_premise(const AtomSpace& space, Handle clause, Handle atom,
+                                 BindingSet& bindings);
+
+/**
+ * @brief Copy a pattern with bound variables replaced by their atoms
+ *
+ * Unbound variables are kept as they are. Links the copy had to add are
+ * appended to created, innermost first, when it is given.
+ */
+[[nodiscard]] Handle substitute(AtomSpace& space, Handle pattern, const BindingSet& bindings,
+                                std::vector<AtomId>* created = nullptr);
+
+/**
+ * @brief The grounded instance of a pattern, if it is already in the AtomSpace
+ * @return Invalid handle when a variable is unbound or a link does not exist
+ */
+[[nodiscard]] Handle find_instance(const AtomSpace& space, Handle pattern,
+                                   const BindingSet& bindings);
+
+/** @brief Whether an atom contains a VariableNode */
+[[nodiscard]] bool has_variables(const AtomSpace& space, Handle atom);
+
+// ============================================================================
+// Goal Canonicalization
+// ============================================================================
+
+/**
+ * @brief Alpha-canonical structure of a goal atom
+ *
+ * Pre-order tokens with each VariableNode numbered by first occurrence,
+ * so goals that differ only in variable names share a key. Positions
+ * are pre-order subtrees; atoms holds the goal's own atom at each.
+ */
+struct GoalKey {
+    uint64_t hash = 0;
+    std::vector<uint64_t> tokens;       // Kind and value per position
+    std::vector<AtomId> atoms;          // Subtree per position
+    uint32_t variables = 0;
+
+    [[nodiscard]] bool same_structure(const GoalKey& other) const noexcept {
+        return hash == other.hash && tokens == other.tokens;
+    }
+
+    /** @brief First position holding an atom, or UINT32_MAX */
+    [[nodiscard]] uint32_t position_of(AtomId atom) const noexcept;
+};
+
+/**
+ * @brief Compute a goal's key into a reusable buffer
+ */
+void canonicalize_goal(const AtomSpace& space, Handle goal, GoalKey& out);
+
+// ============================================================================
+// Pattern Trie
+// ============================================================================
+
+/**
+ * @brief Trie of flattened patterns; owners attach values to its nodes
+ */
+class PatternTrie {
+public:
+    /** @brief Insert a pattern, returning the node it ends at */
+    [[nodiscard]] uint32_t insert(const AtomSpace& space, AtomId pattern);
+
+    /** @brief Append the end nodes of every pattern that can match the atom */
+    void find(const AtomSpace& space, AtomId atom, std::vector<uint32_t>& out) const;
+
+    void clear();
+
+    /** @brief Trie nodes, including the root */
+    [[nodiscard]] size_t node_count() const noexcept { return wildcard_.size(); }
+
+private:
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    struct Edge {
+        uint64_t token;     // Atom id, or link type and arity
+        uint32_t parent;
+        uint32_t is_link;
+
+        bool operator==(const Edge&) const = default;
+    };
+
+    struct EdgeHash {
+        size_t operator()(const Edge& e) const noexcept {
+            uint64_t h = e.token * 0x9E3779B97F4A7C15ULL;
+            h ^= (static_cast<uint64_t>(e.parent) << 1 | e.is_link) + (h >> 29);
+            return static_cast<size_t>(h);
+        }
+    };
+
+    std::unordered_map<Edge, uint32_t, EdgeHash> edges_;
+    std::vector<uint32_t> wildcard_{NONE};      // Node -> wildcard child
+
+    [[nodiscard]] uint32_t child(uint32_t node, Edge edge);
+    [[nodiscard]] uint32_t wildcard_child(uint32_t node);
+};
+
+// ============================================================================
+// Rule Index
+// ============================================================================
+
+class RuleIndex {
+public:
+    /**
+     * @brief Index every clause of a rule's premise
+     *
+     * The rule must stay at the same address until the index is cleared.
+     */
+    void insert(const AtomSpace& space, const Rule& rule);
+
+    void clear();
+
+    /**
+     * @brief Append the rules with a clause that can match the source
+     *
+     * Output is in priority order, highest first, then insertion order;
+     * each rule appears once. Repeated variables are not checked here,
+     * unify_premise does that.
+     * @return Number of rules appended
+     */
+    size_t find(const AtomSpace& space, Handle source, std::vector<const Rule*>& out) const;
+
+    /** @brief Trie nodes, including the root */
+    [[nodiscard]] size_t node_count() const noexcept { return trie_.node_count(); }
+
+private:
+    struct Leaf {
+        float priority;
+        uint32_t order;     // Insertion order, for stable ties
+        const Rule* rule;
+    };
+
+    PatternTrie trie_;
+    std::vector<std::vector<Leaf>> leaves_;     // Node -> rules ending here
+    uint32_t inserted_ = 0;
+};
+
+// ============================================================================
+// Goal Index
+// ============================================================================
+
+/**
+ * @brief Subgoals of a backward search, looked up by the atoms that meet them
+ */
+class GoalIndex {
+public:
+    /** @brief Index a goal under a caller-chosen id */
+    void insert(const AtomSpace& space, Handle goal, uint32_t id);
+
+    void clear();
+
+    /**
+     * @brief Append the ids of goals whose structure can match the atom
+     *
+     * Repeated variables are not checked; unify_premise does that.
+     * @return Number of ids appended
+     */
+    size_t find(const AtomSpace& space, Handle atom, std::vector<uint32_t>& out) const;
+
+    [[nodiscard]] size_t size() const noexcept { return size_; }
+
+private:
+    PatternTrie trie_;
+    std::vector<std::vector<uint32_t>> goals_;  // Node -> goals ending here
+    size_t size_ = 0;
+};
+
+} // namespace opencog::ure
@@ -0,0 +1,148 @@
+#pragma once
+/**
+ * @file rule_program.hpp
+ * @brief Precompiled premise matchers and conclusion templates
+ *
+ * A rule's variables are numbered once, when the rule is added, so
+ * matching and instantiation work on a small array of slots instead of
+ * name-keyed bindings:
+ * - Each premise clause becomes a pre-order instruction list that is
+ *   walked alongside the candidate atom, binding slots as it goes. The
+ *   conclusion gets one too, for unifying it with backward goals.
+ * - The conclusion becomes a post-order instruction list. Instantiating
+ *   it is one pass over a value stack; every link is looked up by hash
+ *   first and only added to the AtomSpace when it does not exist yet.
+ */
+
+#include <opencog/core/types.hpp>
+#include <opencog/pattern/pattern.hpp>
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace opencog {
+class AtomSpace;
+}
+
+namespace opencog::ure {
+
+class RuleProgram {
+public:
+    struct Instruction {
+        enum class Op : uint8_t {
+            ATOM,       // Grounded atom
+            SLOT,       // Variable slot
+            LINK,       // Link of type over the last `arg` values
+            CLAUSE      // Premise clause `arg`: the source itself when that
+                        // clause matched, else the next `skip` instructions
+        };
+
+        Op op;
+        AtomType type = AtomType::INVALID;
+        uint32_t arg = 0;       // Slot index, arity or clause
+        uint32_t skip = 0;
+        AtomId atom;
+    };
+
+    /**
+     * @brief Compile a premise (AndLink clauses, or a single clause) and
+     *        conclusion template
+     */
+    [[nodiscard]] static RuleProgram compile(const AtomSpace& space, Handle premise,
+                                             Handle conclusion);
+
+    /** @brief Number of variable slots */
+    [[nodiscard]] size_t slots() const noexcept { return variables_.size(); }
+    [[nodiscard]] size_t clauses() const noexcept { return clause_start_.size(); }
+    [[nodiscard]] const std::string& variable_name(size_t slot) const { return names_[slot]; }
+
+    /**
+     * @brief Match one premise clause against an atom
+     *
+     * Slots must hold ATOM_NULL or earlier bindings; a variable seen
+     * twice must bind the same atom. Slots are left partially bound on
+     * failure.
+     */
+    [[nodiscard]] bool match(const AtomSpace& space, size_t clause, AtomId atom,
+                             std::span<AtomId> slots) const;
+
+    /**
+     * @brief Match the conclusion against a goal atom, as match does a clause
+     *
+     * Variables in the goal are taken as atoms.
+     */
+    [[nodiscard]] bool match_conclusion(const AtomSpace& space, AtomId atom,
+                                        std::span<AtomId> slots) const;
+
+    /**
+     * @brief Find a premise clause's grounded instance without writing
+     * @return The instance if every slot it uses is bound and it exists,
+     *         else ATOM_NULL
+     */
+    [[nodiscard]] AtomId lookup_clause(const AtomSpace& space, size_t clause,
+                                       std::span<const AtomId> slots) const;
+
+    /**
+     * @brief Build a premise clause's grounded instance, as a goal
+     * @param created If non-null, the atoms added for it are appended,
+     *        innermost first
+     * @return Invalid handle if a slot the clause uses is unbound
+     */
+    [[nodiscard]] Handle instantiate_clause(AtomSpace& space, size_t clause,
+                                            std::span<const AtomId> slots,
+                                            std::vector<AtomId>* created = nullptr) const;
+
+    /**
+     * @brief Build the conclusion from bound slots
+     *
+     * Given the clause that matched and the atom it matched, a
+     * conclusion subterm equal to that clause is the atom itself and
+     * needs no lookup.
+     * @return Invalid handle if a slot the conclusion uses is unbound
+     */
+    [[nodiscard]] Handle instantiate(AtomSpace& space, std::span<const AtomId> slots,
+                                     size_t matched_clause = SIZE_MAX,
+                                     AtomId source = ATOM_NULL) const;
+
+    /**
+     * @brief Find the conclusion without writing to the AtomSpace
+     * @return The conclusion if it already exists, else ATOM_NULL
+     */
+    [[nodiscard]] AtomId lookup(const AtomSpace& space, std::span<const AtomId> slots,
+                                size_t matched_clause = SIZE_MAX,
+                                AtomId source = ATOM_NULL) const;
+
+    /** @brief Copy slots into name-keyed bindings, skipping unbound ones */
+    void to_bindings(std::span<const AtomId> slots, BindingSet& out) const;
+
+    /** @brief Read name-keyed bindings into slots */
+    void from_bindings(const BindingSet& bindings, std::span<AtomId> slots) const;
+
+private:
+    std::vector<AtomId> variables_;         // VariableNode per slot
+    std::vector<std::string> names_;
+    std::vector<Instruction> premise_;      // All clauses, pre-order
+    std::vector<uint32_t> clause_start_;
+    std::vector<AtomId> clause_atoms_;
+    std::vector<Instruction> conclusion_;   // Post-order
+    std::vector<Instruction> conclusion_match_;     // Pre-order
+    uint32_t max_stack_ = 0;
+
+    [[nodiscard]] uint32_t slot_of(const AtomSpace& space, AtomId variable);
+    void compile_pattern(const AtomSpace& space, AtomId atom, std::vector<Instruction>& out);
+    void compile_conclusion(const AtomSpace& space, AtomId atom);
+    template<bool Create, typename Space>
+    [[nodiscard]] AtomId evaluate(Space& space, std::span<const AtomId> slots,
+                                  size_t matched_clause, AtomId source) const;
+    [[nodiscard]] static bool match_at(const AtomSpace& space,
+                                       std::span<const Instruction> code, size_t& pc,
+                                       AtomId atom, std::span<AtomId> slots);
+    template<bool Create, typename Space>
+    [[nodiscard]] static AtomId clause_at(Space& space, std::span<const Instruction> code,
+                                          size_t& pc, std::span<const AtomId> slots,
+                                          std::vector<AtomId>* created);
+};
+
+} // namespace opencog::ure
@@ -0,0 +1,90 @@
+#pragma once
+/**
+ * @file rule_set.hpp
+ * @brief Compiled, immutable snapshot of a rule base
+ *
+ * A RuleSet holds copies of its rules in one contiguous array, each with
+ * its compiled RuleProgram (premise matchers, conclusion template and
+ * variable table), along with every lookup over them: by name, by premise
+ * type, by priority and the premise discrimination tree. Nothing changes
+ * after compilation, so a std::shared_ptr<const RuleSet> can be read by
+ * any number of threads at once. Matching against it reads only the
+ * source atoms from the AtomSpace, never the rules' own structure.
+ */
+
+#include <opencog/ure/rule.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace opencog::ure {
+
+class RuleSet {
+public:
+    /**
+     * @brief Compile rules into a snapshot
+     *
+     * Rules keep their compiled program when they have one, so snapshots
+     * of the same rules share it. A later rule shadows an earlier one of
+     * the same name in find().
+     */
+    [[nodiscard]] static std::shared_ptr<const RuleSet> compile(
+        const AtomSpace& space,
+        std::span<const Rule> rules,
+        uint64_t version = 0
+    );
+
+    // Lookups point into the rule array
+    RuleSet(const RuleSet&) = delete;
+    RuleSet& operator=(const RuleSet&) = delete;
+
+    /** @brief Rules in the order they were added */
+    [[nodiscard]] std::span<const Rule> rules() const noexcept { return rules_; }
+    [[nodiscard]] size_t size() const noexcept { return rules_.size(); }
+    [[nodiscard]] bool empty() const noexcept { return rules_.empty(); }
+
+    /** @brief RuleBase edit count this snapshot was compiled at */
+    [[nodiscard]] uint64_t version() const noexcept { return version_; }
+
+    [[nodiscard]] const Rule* find(std::string_view name) const;
+
+    /** @brief Rules by priority, highest first, ties in insertion order */
+    [[nodiscard]] const std::vector<const Rule*>& by_priority() const noexcept {
+        return by_priority_;
+    }
+
+    /** @brief Rules whose premise is an atom of the given type */
+    [[nodiscard]] std::vector<const Rule*> for_type(AtomType type) const;
+
+    /**
+     * @brief Rules with a premise clause that can unify with a source atom
+     * @see RuleIndex::find
+     */
+    size_t for_atom(const AtomSpace& space, Handle source, std::vector<const Rule*>& out) const {
+        return index_.find(space, source, out);
+    }
+
+private:
+    struct NameHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view name) const noexcept {
+            return std::hash<std::string_view>{}(name);
+        }
+    };
+
+    std::vector<Rule> rules_;
+    std::unordered_map<std::string, uint32_t, NameHash, std::equal_to<>> names_;
+    std::unordered_multimap<AtomType, uint32_t> types_;
+    std::vector<const Rule*> by_priority_;
+    RuleIndex index_;
+    uint64_t version_ = 0;
+
+    RuleSet() = default;
+};
+
+} // namespace opencog::ure
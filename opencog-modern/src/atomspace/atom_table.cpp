@@ -86,7 +86,9 @@ void AtomTable::free_slot(AtomId id) {
 // Atom Creation
 // ============================================================================
 
-AtomId AtomTable::add_node(AtomType type, std::string_view name, TruthValue tv) {
+AtomId AtomTable::add_node(AtomType type, std::string_view name, TruthValue tv, bool* created) {
+    if (created) *created = false;
+
     if (!is_node(type)) {
         throw std::invalid_argument("Type must be a node type");
     }
@@ -96,29 +98,14 @@ AtomId AtomTable::add_node(AtomType type, std::string_view name, TruthValue tv)
     // Check for existing atom
     {
         std::shared_lock lock(global_mutex_);
-        auto it = hash_index_.find(hash);
-        if (it != hash_index_.end() && is_valid_slot(it->second)) {
-            // Verify it's the same atom (handle hash collisions)
-            auto& data = node_data_[it->second.index()];
-            if (data && data->name == name &&
-                headers_[it->second.index()].type == type) {
-                return it->second;
-            }
-        }
+        if (AtomId existing = find_node_locked(type, name, hash)) return existing;
     }
 
     // Create new atom
     std::unique_lock lock(global_mutex_);
 
     // Double-check after acquiring write lock
-    auto it = hash_index_.find(hash);
-    if (it != hash_index_.end() && is_valid_slot(it->second)) {
-        auto& data = node_data_[it->second.index()];
-        if (data && data->name == name &&
-            headers_[it->second.index()].type == type) {
-            return it->second;
-        }
-    }
+    if (AtomId existing = find_node_locked(type, name, hash)) return existing;
 
     AtomId id = allocate_slot();
     uint64_t slot = id.index();
@@ -130,15 +117,19 @@ AtomId AtomTable::add_node(AtomType type, std::string_view name, TruthValue tv)
     node_data_[slot] = std::make_unique<NodeData>();
     node_data_[slot]->name = std::string(name);
 
-    hash_index_[hash] = id;
+    hash_index_.emplace(hash, id);
 
     atom_count_.fetch_add(1, std::memory_order_relaxed);
     node_count_.fetch_add(1, std::memory_order_relaxed);
 
+    if (created) *created = true;
     return id;
 }
 
-AtomId AtomTable::add_link(AtomType type, std::span<const AtomId> outgoing, TruthValue tv) {
+AtomId AtomTable::add_link(AtomType type, std::span<const AtomId> outgoing, TruthValue tv,
+                           bool* created) {
+    if (created) *created = false;
+
     if (!is_link(type)) {
         throw std::invalid_argument("Type must be a link type");
     }
@@ -155,42 +146,14 @@ AtomId AtomTable::add_link(AtomType type, std::span<const AtomId> outgoing, Trut
     // Check for existing atom
     {
         std::shared_lock lock(global_mutex_);
-        auto it = hash_index_.find(hash);
-        if (it != hash_index_.end() && is_valid_slot(it->second)) {
-            auto& data = link_data_[it->second.index()];
-            if (data && data->outgoing.size() == outgoing.size() &&
-                headers_[it->second.index()].type == type) {
-                bool match = true;
-                for (size_t i = 0; i < outgoing.size(); ++i) {
-                    if (data->outgoing[i] != outgoing[i]) {
-                        match = false;
-                        break;
-                    }
-                }
-                if (match) return it->second;
-            }
-        }
+        if (AtomId existing = find_link_locked(type, outgoing, hash)) return existing;
     }
 
     // Create new atom
     std::unique_lock lock(global_mutex_);
 
     // Double-check
-    auto it = hash_index_.find(hash);
-    if (it != hash_index_.end() && is_valid_slot(it->second)) {
-        auto& data = link_data_[it->second.index()];
-        if (data && data->outgoing.size() == outgoing.size() &&
-            headers_[it->second.index()].type == type) {
-            bool match = true;
-            for (size_t i = 0; i < outgoing.size(); ++i) {
-                if (data->outgoing[i] != outgoing[i]) {
-                    match = false;
-                    break;
-                }
-            }
-            if (match) return it->second;
-        }
-    }
+    if (AtomId existing = find_link_locked(type, outgoing, hash)) return existing;
 
     AtomId id = allocate_slot();
     uint64_t slot = id.index();
@@ -202,7 +165,7 @@ AtomId AtomTable::add_link(AtomType type, std::span<const AtomId> outgoing, Trut
     link_data_[slot] = std::make_unique<LinkData>();
     link_data_[slot]->outgoing.assign(outgoing.begin(), outgoing.end());
 
-    hash_index_[hash] = id;
+    hash_index_.emplace(hash, id);
 
     // Update incoming sets
     for (AtomId target : outgoing) {
@@ -212,6 +175,7 @@ AtomId AtomTable::add_link(AtomType type, std::span<const AtomId> outgoing, Trut
     atom_count_.fetch_add(1, std::memory_order_relaxed);
     link_count_.fetch_add(1, std::memory_order_relaxed);
 
+    if (created) *created = true;
     return id;
 }
 
@@ -223,6 +187,11 @@ bool AtomTable::remove_atom(AtomId id, bool recursive) {
     if (!is_valid_slot(id)) return false;
 
     std::unique_lock lock(global_mutex_);
+    return remove_atom_locked(id, recursive);
+}
+
+bool AtomTable::remove_atom_locked(AtomId id, bool recursive) {
+    if (!is_valid_slot(id)) return false;
 
     uint64_t slot = id.index();
 
@@ -235,7 +204,7 @@ bool AtomTable::remove_atom(AtomId id, bool recursive) {
         // Recursively remove incoming links first
         auto incoming = incoming_sets_[slot];  // Copy to avoid iterator invalidation
         for (AtomId link_id : incoming) {
-            remove_atom(link_id, true);
+            remove_atom_locked(link_id, true);
         }
     }
 
@@ -248,7 +217,13 @@ bool AtomTable::remove_atom(AtomId id, bool recursive) {
 
     // Remove from hash index
     uint64_t hash = headers_[slot].hash;
-    hash_index_.erase(hash);
+    auto [first, last] = hash_index_.equal_range(hash);
+    for (auto it = first; it != last; ++it) {
+        if (it->second == id) {
+            hash_index_.erase(it);
+            break;
+        }
+    }
 
     // Update statistics
     if (is_node(headers_[slot].type)) {
@@ -264,6 +239,29 @@ bool AtomTable::remove_atom(AtomId id, bool recursive) {
     return true;
 }
 
+void AtomTable::clear() {
+    std::unique_lock lock(global_mutex_);
+
+    // Slots keep their generation counters, so a handle from before the
+    // clear stays invalid when its slot is reused
+    free_slots_.clear();
+    free_slots_.reserve(headers_.size());
+    for (size_t slot = headers_.size(); slot-- > 0;) {
+        headers_[slot] = {};
+        truth_values_[slot] = {};
+        attention_values_[slot] = {};
+        node_data_[slot].reset();
+        link_data_[slot].reset();
+        incoming_sets_[slot] = {};
+        free_slots_.push_back(slot);
+    }
+    hash_index_.clear();
+
+    atom_count_.store(0, std::memory_order_relaxed);
+    node_count_.store(0, std::memory_order_relaxed);
+    link_count_.store(0, std::memory_order_relaxed);
+}
+
 // ============================================================================
 // Atom Lookup
 // ============================================================================
@@ -272,34 +270,35 @@ AtomId AtomTable::get_node(AtomType type, std::string_view name) const {
     uint64_t hash = compute_node_hash(type, name);
 
     std::shared_lock lock(global_mutex_);
-    auto it = hash_index_.find(hash);
-    if (it != hash_index_.end() && is_valid_slot(it->second)) {
-        auto& data = node_data_[it->second.index()];
-        if (data && data->name == name &&
-            headers_[it->second.index()].type == type) {
-            return it->second;
-        }
-    }
-    return ATOM_NULL;
+    return find_node_locked(type, name, hash);
 }
 
 AtomId AtomTable::get_link(AtomType type, std::span<const AtomId> outgoing) const {
     uint64_t hash = compute_link_hash(type, outgoing);
 
     std::shared_lock lock(global_mutex_);
-    auto it = hash_index_.find(hash);
-    if (it != hash_index_.end() && is_valid_slot(it->second)) {
-        auto& data = link_data_[it->second.index()];
-        if (data && data->outgoing.size() == outgoing.size() &&
-            headers_[it->second.index()].type == type) {
-            bool match = true;
-            for (size_t i = 0; i < outgoing.size(); ++i) {
-                if (data->outgoing[i] != outgoing[i]) {
-                    match = false;
-                    break;
-                }
-            }
-            if (match) return it->second;
+    return find_link_locked(type, outgoing, hash);
+}
+
+// Distinct atoms may share a hash, so every atom under it is compared
+AtomId AtomTable::find_node_locked(AtomType type, std::string_view name, uint64_t hash) const {
+    auto [first, last] = hash_index_.equal_range(hash);
+    for (auto it = first; it != last; ++it) {
+        const uint64_t slot = it->second.index();
+        if (!is_valid_slot(it->second) || headers_[slot].type != type) continue;
+        if (node_data_[slot] && node_data_[slot]->name == name) return it->second;
+    }
+    return ATOM_NULL;
+}
+
+AtomId AtomTable::find_link_locked(AtomType type, std::span<const AtomId> outgoing,
+                                   uint64_t hash) const {
+    auto [first, last] = hash_index_.equal_range(hash);
+    for (auto it = first; it != last; ++it) {
+        const uint64_t slot = it->second.index();
+        if (!is_valid_slot(it->second) || headers_[slot].type != type) continue;
+        if (link_data_[slot] && std::ranges::equal(link_data_[slot]->outgoing, outgoing)) {
+            return it->second;
         }
     }
     return ATOM_NULL;
@@ -371,6 +370,32 @@ std::vector<AtomId> AtomTable::get_incoming(AtomId id) const {
     return incoming_sets_[id.index()];
 }
 
+// ============================================================================
+// Slot Scanning
+// ============================================================================
+
+size_t AtomTable::slot_count() const {
+    std::shared_lock lock(global_mutex_);
+    return headers_.size();
+}
+
+size_t AtomTable::scan_slots(size_t begin, size_t end, std::vector<AtomId>& out,
+                             size_t max) const {
+    std::shared_lock lock(global_mutex_);
+
+    end = std::min(end, headers_.size());
+    size_t appended = 0;
+    size_t slot = begin;
+
+    for (; slot < end && appended < max; ++slot) {
+        if (headers_[slot].type == AtomType::INVALID) continue;
+        out.push_back(AtomId::make(slot, generations_[slot]));
+        ++appended;
+    }
+
+    return slot;
+}
+
 size_t AtomTable::get_incoming_size(AtomId id) const noexcept {
     if (!is_valid_slot(id)) return 0;
     return headers_[id.index()].incoming_count;
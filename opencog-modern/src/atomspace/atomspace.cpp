@@ -5,6 +5,7 @@
 
 #include <opencog/atomspace/atomspace.hpp>
 
+#include <algorithm>
 #include <sstream>
 
 namespace opencog {
@@ -16,28 +17,44 @@ AtomSpace::~AtomSpace() = default;
 // Atom Creation
 // ============================================================================
 
-Handle AtomSpace::add_node(AtomType type, std::string_view name, TruthValue tv) {
-    AtomId id = table_.add_node(type, name, tv);
+Handle AtomSpace::add_node(AtomType type, std::string_view name, TruthValue tv, bool* created) {
+    bool inserted = false;
+    AtomId id = table_.add_node(type, name, tv, &inserted);
+    if (created) *created = inserted;
+    if (!inserted) return Handle{id, this};
+
     indices_.type_index.insert(type, id);
+    bump_version(type);
+
+    for (AtomSpaceObserver* observer : observers_) {
+        observer->on_atom_added(id);
+    }
     return Handle{id, this};
 }
 
-Handle AtomSpace::add_link(AtomType type, std::initializer_list<Handle> outgoing, TruthValue tv) {
+Handle AtomSpace::add_link(AtomType type, std::initializer_list<Handle> outgoing, TruthValue tv,
+                           bool* created) {
     std::vector<AtomId> ids;
     ids.reserve(outgoing.size());
     for (const Handle& h : outgoing) {
         ids.push_back(h.id());
     }
-    return add_link(type, std::span<const AtomId>(ids), tv);
+    return add_link(type, std::span<const AtomId>(ids), tv, created);
 }
 
-Handle AtomSpace::add_link(AtomType type, std::span<const Handle> outgoing, TruthValue tv) {
+Handle AtomSpace::add_link(AtomType type, std::span<const Handle> outgoing, TruthValue tv,
+                           bool* created) {
     std::vector<AtomId> ids = handles_to_ids(outgoing);
-    return add_link(type, std::span<const AtomId>(ids), tv);
+    return add_link(type, std::span<const AtomId>(ids), tv, created);
 }
 
-Handle AtomSpace::add_link(AtomType type, std::span<const AtomId> outgoing, TruthValue tv) {
-    AtomId id = table_.add_link(type, outgoing, tv);
+Handle AtomSpace::add_link(AtomType type, std::span<const AtomId> outgoing, TruthValue tv,
+                           bool* created) {
+    bool inserted = false;
+    AtomId id = table_.add_link(type, outgoing, tv, &inserted);
+    if (created) *created = inserted;
+    if (!inserted) return Handle{id, this};
+
     indices_.type_index.insert(type, id);
     indices_.target_type_index.insert(type, id, outgoing);
 
@@ -46,7 +63,11 @@ Handle AtomSpace::add_link(AtomType type, std::span<const AtomId> outgoing, Trut
         AtomType premise_type = table_.get_type(outgoing[0]);
         indices_.implication_index.insert(id, premise_type);
     }
+    bump_version(type);
 
+    for (AtomSpaceObserver* observer : observers_) {
+        observer->on_atom_added(id);
+    }
     return Handle{id, this};
 }
 
@@ -62,6 +83,16 @@ bool AtomSpace::remove(Handle h, bool recursive) {
 bool AtomSpace::remove(AtomId id, bool recursive) {
     if (!table_.contains(id)) return false;
 
+    if (table_.get_incoming_size(id) > 0) {
+        if (!recursive) return false;
+
+        // Remove incoming links through the AtomSpace so that their index
+        // entries are dropped and observers hear about each of them.
+        for (AtomId link : table_.get_incoming(id)) {
+            remove(link, true);
+        }
+    }
+
     AtomType type = table_.get_type(id);
     auto outgoing = table_.get_outgoing(id);
 
@@ -76,7 +107,13 @@ bool AtomSpace::remove(AtomId id, bool recursive) {
         }
     }
 
-    return table_.remove_atom(id, recursive);
+    if (!table_.remove_atom(id, false)) return false;
+    bump_version(type);
+
+    for (AtomSpaceObserver* observer : observers_) {
+        observer->on_atom_removed(id);
+    }
+    return true;
 }
 
 // ============================================================================
@@ -184,6 +221,45 @@ void AtomSpace::for_each_atom_of_type(AtomType type, std::function<void(Handle)>
     }
 }
 
+// ============================================================================
+// Observers
+// ============================================================================
+
+void AtomSpace::add_observer(AtomSpaceObserver* observer) {
+    if (observer && std::find(observers_.begin(), observers_.end(), observer) == observers_.end()) {
+        observers_.push_back(observer);
+    }
+}
+
+void AtomSpace::remove_observer(AtomSpaceObserver* observer) {
+    observers_.erase(std::remove(observers_.begin(), observers_.end(), observer), observers_.end());
+}
+
+void AtomSpace::set_tvs(std::span<const AtomId> ids,
+                        const float* strength, const float* confidence) {
+    if (observers_.empty()) {
+        table_.scatter_tvs(ids, strength, confidence);
+        return;
+    }
+    for (size_t i = 0; i < ids.size(); ++i) {
+        TruthValue tv = table_.get_tv(ids[i]);
+        if (strength) tv.strength = strength[i];
+        if (confidence) tv.confidence = confidence[i];
+        notify_tv_changed(ids[i], tv);
+    }
+}
+
+void AtomSpace::notify_tv_changed(AtomId id, TruthValue tv) {
+    if (!table_.contains(id)) return;
+
+    TruthValue old_tv = table_.get_tv(id);
+    table_.set_tv(id, tv);
+
+    for (AtomSpaceObserver* observer : observers_) {
+        observer->on_tv_changed(id, old_tv);
+    }
+}
+
 // ============================================================================
 // Utilities
 // ============================================================================
@@ -192,9 +268,18 @@ void AtomSpace::clear() {
     // Clear indices first
     indices_.clear();
 
-    // Then clear storage (would need to implement in AtomTable)
-    // For now, just create a new table
-    table_ = AtomTable{};
+    // Then clear storage
+    table_.clear();
+
+    // Every atom is gone, so every counter must move
+    for (auto& counter : type_versions_) {
+        counter.fetch_add(1, std::memory_order_acq_rel);
+    }
+    version_.fetch_add(1, std::memory_order_acq_rel);
+
+    for (AtomSpaceObserver* observer : observers_) {
+        observer->on_clear();
+    }
 }
 
 std::string AtomSpace::to_string(Handle h) const {
@@ -109,23 +109,28 @@ std::vector<AtomId> AttentionBank::get_attentional_focus() const {
     std::vector<std::pair<AtomId, float>> candidates;
     float boundary = af_boundary_.load(std::memory_order_relaxed);
 
-    space_.for_each_atom([&](Handle h) {
-        AttentionValue av = space_.get_av(h);
-        if (av.sti >= boundary) {
-            candidates.emplace_back(h.id(), av.sti);
+    const auto& table = space_.atom_table();
+    AtomCursor cursor(table);
+    for (auto batch = cursor.next_batch(); !batch.empty(); batch = cursor.next_batch()) {
+        for (AtomId id : batch) {
+            float sti = table.get_av(id).sti;
+            if (sti >= boundary) candidates.emplace_back(id, sti);
         }
-    });
+    }
 
-    // Sort by STI descending
-    std::sort(candidates.begin(), candidates.end(),
-        [](const auto& a, const auto& b) { return a.second > b.second; });
+    // Only the top max_size need ordering: select them, then sort those
+    // by STI descending (ties by id, so the focus is deterministic)
+    auto by_sti = [](const auto& a, const auto& b) {
+        return a.second != b.second ? a.second > b.second : a.first < b.first;
+    };
+    const size_t max_size = std::min(candidates.size(), config_.af_max_size);
+    std::nth_element(candidates.begin(), candidates.begin() + static_cast<ptrdiff_t>(max_size),
+                     candidates.end(), by_sti);
+    std::sort(candidates.begin(), candidates.begin() + static_cast<ptrdiff_t>(max_size), by_sti);
 
-    // Extract IDs, respecting max size
     std::vector<AtomId> result;
-    size_t max_size = config_.af_max_size;
-    result.reserve(std::min(candidates.size(), max_size));
-
-    for (size_t i = 0; i < candidates.size() && i < max_size; ++i) {
+    result.reserve(max_size);
+    for (size_t i = 0; i < max_size; ++i) {
         result.push_back(candidates[i].first);
     }
 
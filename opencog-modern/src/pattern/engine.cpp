@@ -0,0 +1,784 @@
+/**
+ * @file engine.cpp
+ * @brief Explicit-stack pattern matching engine implementation
+ */
+
+#include <opencog/pattern/engine.hpp>
+
+#include <algorithm>
+
+namespace opencog {
+
+MatchEngine::MatchEngine(const AtomSpace& space, bool check_type_hierarchy)
+    : space_(space), check_type_hierarchy_(check_type_hierarchy)
+{
+}
+
+// ============================================================================
+// Compilation
+// ============================================================================
+
+void MatchEngine::reset(const Pattern& pattern) {
+    nodes_.clear();
+    children_.clear();
+    positive_.clear();
+    negative_.clear();
+    clause_node_.reset();
+    var_names_.clear();
+    glob_names_.clear();
+
+    // A top-level conjunction is flattened into independent conjuncts;
+    // negated conjuncts are checked after all positive ones have matched.
+    auto add_conjunct = [this](auto& self, const PatternTerm& term) -> void {
+        if (auto* and_ptr = std::get_if<std::shared_ptr<AndPattern>>(&term); and_ptr && *and_ptr) {
+            for (const auto& t : (*and_ptr)->terms) self(self, t);
+        } else if (auto* not_ptr = std::get_if<std::shared_ptr<NotPattern>>(&term); not_ptr && *not_ptr) {
+            negative_.push_back(compile((*not_ptr)->term));
+        } else {
+            positive_.push_back(compile(term));
+        }
+    };
+    add_conjunct(add_conjunct, pattern.body);
+
+    if (pattern.clause) {
+        clause_node_ = compile(*pattern.clause);
+    }
+
+    if (frames_.size() < positive_.size()) {
+        frames_.resize(positive_.size());
+    }
+
+    restart();
+}
+
+void MatchEngine::restart() {
+    slots_.assign(var_names_.size(), ATOM_NULL);
+    glob_slots_.assign(glob_names_.size(), std::nullopt);
+    trail_.clear();
+    choices_.clear();
+    replay_.clear();
+    replay_pos_ = 0;
+
+    clause_atoms_.assign(positive_.size(), ATOM_NULL);
+    pins_.assign(positive_.size(), ATOM_NULL);
+    order_.resize(positive_.size());
+    for (size_t i = 0; i < order_.size(); ++i) order_[i] = static_cast<uint32_t>(i);
+
+    depth_ = 0;
+    started_ = false;
+    done_ = false;
+}
+
+void MatchEngine::pin(size_t conjunct, AtomId atom) {
+    if (conjunct >= pins_.size() || started_) return;
+    pins_[conjunct] = atom;
+
+    // Pinned conjuncts go first: a single candidate that binds variables
+    // narrows every frame below it.
+    std::stable_partition(order_.begin(), order_.end(), [this](uint32_t c) {
+        return pins_[c].valid();
+    });
+}
+
+void MatchEngine::reset(const Pattern& pattern, const BindingSet& initial) {
+    reset(pattern);
+
+    for (const auto& [name, atom] : initial.bindings) {
+        if (auto slot = slot_of(name)) slots_[*slot] = atom;
+    }
+    for (const auto& [name, atoms] : initial.globs) {
+        auto it = std::find(glob_names_.begin(), glob_names_.end(), name);
+        if (it != glob_names_.end()) {
+            glob_slots_[static_cast<size_t>(it - glob_names_.begin())] = atoms;
+        }
+    }
+}
+
+uint32_t MatchEngine::compile(const PatternTerm& term) {
+    Node node;
+
+    if (auto* grounded = std::get_if<GroundedTerm>(&term)) {
+        node.op = Op::GROUNDED;
+        node.atom = grounded->atom;
+    }
+    else if (auto* variable = std::get_if<VariableTerm>(&term)) {
+        node.op = Op::VARIABLE;
+        node.slot = intern(var_names_, variable->name);
+        if (variable->type_constraint) {
+            node.constrained = true;
+            node.type = *variable->type_constraint;
+        }
+    }
+    else if (auto* typed = std::get_if<TypedTerm>(&term)) {
+        node.op = Op::TYPED;
+        node.type = typed->type;
+    }
+    else if (auto* glob = std::get_if<GlobTerm>(&term)) {
+        node.op = Op::GLOB;
+        node.slot = intern(glob_names_, glob->name);
+        node.bounds = ArityBounds{glob->min_count, glob->max_count};
+    }
+    else if (auto* link_ptr = std::get_if<std::shared_ptr<LinkPattern>>(&term); link_ptr && *link_ptr) {
+        const auto& pattern = **link_ptr;
+        node.op = Op::LINK;
+        node.type = pattern.type;
+        node.has_glob = has_glob(pattern.outgoing);
+        node.bounds = arity_bounds(pattern.outgoing);
+        return compile_children(pattern.outgoing, node);
+    }
+    else if (auto* and_ptr = std::get_if<std::shared_ptr<AndPattern>>(&term); and_ptr && *and_ptr) {
+        node.op = Op::AND;
+        return compile_children((*and_ptr)->terms, node);
+    }
+    else if (auto* or_ptr = std::get_if<std::shared_ptr<OrPattern>>(&term); or_ptr && *or_ptr) {
+        node.op = Op::OR;
+        return compile_children((*or_ptr)->terms, node);
+    }
+    else if (auto* not_ptr = std::get_if<std::shared_ptr<NotPattern>>(&term); not_ptr && *not_ptr) {
+        node.op = Op::NOT;
+        return compile_children(std::span<const PatternTerm>(&(*not_ptr)->term, 1), node);
+    }
+    // A null sub-pattern compiles to a grounded ATOM_NULL, which never matches
+
+    nodes_.push_back(node);
+    return static_cast<uint32_t>(nodes_.size() - 1);
+}
+
+uint32_t MatchEngine::compile_children(std::span<const PatternTerm> terms, Node node) {
+    // Reserve the child block first so it stays contiguous even though
+    // each child may lay out a block of its own.
+    node.first = static_cast<uint32_t>(children_.size());
+    node.count = static_cast<uint32_t>(terms.size());
+    children_.resize(children_.size() + terms.size());
+
+    for (size_t i = 0; i < terms.size(); ++i) {
+        uint32_t child = compile(terms[i]);
+        children_[node.first + i] = child;
+    }
+
+    nodes_.push_back(node);
+    return static_cast<uint32_t>(nodes_.size() - 1);
+}
+
+uint32_t MatchEngine::intern(std::vector<std::string>& names, const std::string& name) {
+    auto it = std::find(names.begin(), names.end(), name);
+    if (it != names.end()) {
+        return static_cast<uint32_t>(it - names.begin());
+    }
+    names.push_back(name);
+    return static_cast<uint32_t>(names.size() - 1);
+}
+
+// ============================================================================
+// Search
+// ============================================================================
+
+bool MatchEngine::next() {
+    if (done_) return false;
+
+    if (!started_) {
+        started_ = true;
+        if (positive_.empty()) {
+            // Nothing to enumerate: at most one (empty) match
+            done_ = true;
+            return accept();
+        }
+        open_frame();
+    }
+
+    while (depth_ > 0) {
+        Frame& frame = frames_[depth_ - 1];
+
+        // The last candidate's other glob splits come before the next candidate
+        Candidate candidate;
+        bool unified = false;
+        if (choices_.size() > frame.choice_mark) {
+            candidate = frame.candidates[frame.pos - 1];
+            unified = retry(candidate.node, candidate.atom, frame.trail_mark, frame.choice_mark);
+        } else {
+            undo(frame.trail_mark);
+        }
+
+        if (!unified) {
+            if (frame.pos == frame.candidates.size()) {
+                if (!frame.scanning || !refill(frame)) --depth_;
+                continue;
+            }
+
+            candidate = frame.candidates[frame.pos++];
+            if (!unify(candidate.node, candidate.atom)) continue;
+        }
+
+        clause_atoms_[order_[depth_ - 1]] = candidate.atom;
+
+        if (depth_ < positive_.size()) {
+            open_frame();
+            continue;
+        }
+
+        if (accept()) return true;
+    }
+
+    done_ = true;
+    return false;
+}
+
+void MatchEngine::open_frame() {
+    Frame& frame = frames_[depth_];
+    frame.candidates.clear();
+    frame.pos = 0;
+    frame.trail_mark = trail_.size();
+    frame.choice_mark = choices_.size();
+
+    frame.scanning = false;
+
+    const uint32_t conjunct = order_[depth_];
+    const uint32_t node = positive_[conjunct];
+    if (pins_[conjunct].valid()) {
+        if (space_.contains(pins_[conjunct])) {
+            frame.candidates.push_back({pins_[conjunct], node});
+        }
+    } else if (needs_scan(node)) {
+        frame.scanning = true;
+        frame.scan_node = node;
+        frame.scan_pos = 0;
+        (void)refill(frame);
+    } else {
+        generate(node, frame.candidates);
+    }
+    ++depth_;
+}
+
+bool MatchEngine::refill(Frame& frame) {
+    frame.candidates.clear();
+    frame.pos = 0;
+
+    const auto& table = space_.atom_table();
+    const size_t end = table.slot_count();
+
+    scratch_.clear();
+    while (scratch_.empty() && frame.scan_pos < end) {
+        frame.scan_pos = table.scan_slots(frame.scan_pos, end, scratch_, SCAN_BATCH);
+    }
+
+    for (AtomId id : scratch_) frame.candidates.push_back({id, frame.scan_node});
+    return !frame.candidates.empty();
+}
+
+bool MatchEngine::needs_scan(uint32_t index) const noexcept {
+    // Conjuncts that accept atoms of any type (or any node/link type)
+    // would otherwise copy the whole type index into the frame.
+    const Node& node = nodes_[index];
+    switch (node.op) {
+    case Op::VARIABLE:
+        if (slots_[node.slot].valid()) return false;
+        return !node.constrained ||
+               (check_type_hierarchy_ && (node.type == AtomType::NODE || node.type == AtomType::LINK));
+    case Op::TYPED:
+        return check_type_hierarchy_ && (node.type == AtomType::NODE || node.type == AtomType::LINK);
+    default:
+        return false;
+    }
+}
+
+void MatchEngine::generate(uint32_t index, std::vector<Candidate>& out) {
+    const Node& node = nodes_[index];
+
+    switch (node.op) {
+    case Op::GROUNDED:
+        if (space_.contains(node.atom)) out.push_back({node.atom, index});
+        break;
+
+    case Op::VARIABLE:
+        if (slots_[node.slot].valid()) {
+            if (space_.contains(slots_[node.slot])) out.push_back({slots_[node.slot], index});
+        } else if (node.constrained) {
+            collect_type(node.type, index, out);
+        } else {
+            scratch_.clear();
+            space_.indices().type_index.collect_if([](AtomType) { return true; }, scratch_);
+            for (AtomId id : scratch_) out.push_back({id, index});
+        }
+        break;
+
+    case Op::TYPED:
+        collect_type(node.type, index, out);
+        break;
+
+    case Op::LINK: {
+        // Anchor on the grounded or already-bound member with the fewest
+        // links of this type pointing at it.
+        AtomId anchor;
+        size_t best = SIZE_MAX;
+        const bool generic = check_type_hierarchy_ && node.type == AtomType::LINK;
+
+        for (uint32_t i = 0; i < node.count && !generic; ++i) {
+            const Node& child = nodes_[children_[node.first + i]];
+            AtomId atom;
+            if (child.op == Op::GROUNDED) atom = child.atom;
+            else if (child.op == Op::VARIABLE) atom = slots_[child.slot];
+            if (!atom.valid()) continue;
+
+            size_t count = space_.indices().target_type_index.count(node.type, atom);
+            if (count < best) {
+                best = count;
+                anchor = atom;
+            }
+        }
+
+        if (anchor.valid()) {
+            scratch_.clear();
+            space_.indices().target_type_index.collect(node.type, anchor, scratch_);
+            for (AtomId id : scratch_) out.push_back({id, index});
+        } else {
+            collect_type(node.type, index, out);
+        }
+        break;
+    }
+
+    case Op::AND: {
+        // Atom-level conjunction: candidates come from the first positive
+        // constraint and must then satisfy all of them.
+        for (uint32_t i = 0; i < node.count; ++i) {
+            uint32_t child = children_[node.first + i];
+            if (nodes_[child].op == Op::NOT) continue;
+
+            size_t begin = out.size();
+            generate(child, out);
+            for (size_t j = begin; j < out.size(); ++j) out[j].node = index;
+            break;
+        }
+        break;
+    }
+
+    case Op::OR:
+        for (uint32_t i = 0; i < node.count; ++i) {
+            generate(children_[node.first + i], out);
+        }
+        break;
+
+    case Op::GLOB:
+    case Op::NOT:
+        // Globs only match inside outgoing sets; negations enumerate nothing
+        break;
+    }
+}
+
+void MatchEngine::collect_type(AtomType type, uint32_t index, std::vector<Candidate>& out) {
+    scratch_.clear();
+
+    if (check_type_hierarchy_ && (type == AtomType::NODE || type == AtomType::LINK)) {
+        space_.indices().type_index.collect_if([&](AtomType t) {
+            return type_matches(type, t);
+        }, scratch_);
+    } else {
+        space_.indices().type_index.collect(type, scratch_);
+    }
+
+    for (AtomId id : scratch_) out.push_back({id, index});
+}
+
+bool MatchEngine::exists(uint32_t index) {
+    const size_t mark = trail_.size();
+    const Node& node = nodes_[index];
+
+    // Conjunction inside a negation: every term needs a match of its own
+    if (node.op == Op::AND) {
+        auto exists_all = [&](auto& self, uint32_t i) -> bool {
+            if (i == node.count) return true;
+
+            uint32_t child = children_[node.first + i];
+            if (nodes_[child].op == Op::NOT) {
+                return !exists(children_[nodes_[child].first]) && self(self, i + 1);
+            }
+
+            const size_t begin = scratch_candidates_.size();
+            generate(child, scratch_candidates_);
+
+            bool found = false;
+            for (size_t j = begin; j < scratch_candidates_.size() && !found; ++j) {
+                const Candidate c = scratch_candidates_[j];
+                const size_t inner = trail_.size();
+                const size_t inner_choices = choices_.size();
+                found = unify(c.node, c.atom) && self(self, i + 1);
+                while (!found && choices_.size() > inner_choices) {
+                    found = retry(c.node, c.atom, inner, inner_choices) && self(self, i + 1);
+                }
+                if (!found) undo(inner);
+            }
+
+            scratch_candidates_.resize(begin);
+            return found;
+        };
+
+        bool found = exists_all(exists_all, 0);
+        undo(mark);
+        return found;
+    }
+
+    const size_t begin = scratch_candidates_.size();
+    generate(index, scratch_candidates_);
+
+    bool found = false;
+    for (size_t i = begin; i < scratch_candidates_.size() && !found; ++i) {
+        const Candidate c = scratch_candidates_[i];
+        found = unify_any(c.node, c.atom);
+        undo(mark);
+    }
+
+    scratch_candidates_.resize(begin);
+    return found;
+}
+
+bool MatchEngine::accept() {
+    const size_t mark = trail_.size();
+
+    for (uint32_t node : negative_) {
+        if (exists(node)) return false;
+    }
+
+    if (clause_node_) {
+        bool ok = unify_any(*clause_node_, matched_atom());
+        undo(mark);
+        if (!ok) return false;
+    }
+
+    return true;
+}
+
+// ============================================================================
+// Unification
+// ============================================================================
+
+bool MatchEngine::unify(uint32_t index, AtomId atom) {
+    const Node& node = nodes_[index];
+    const auto& table = space_.atom_table();
+
+    switch (node.op) {
+    case Op::GROUNDED:
+        return node.atom == atom;
+
+    case Op::VARIABLE: {
+        if (node.constrained && !type_matches(node.type, table.get_type(atom))) {
+            return false;
+        }
+        AtomId& bound = slots_[node.slot];
+        if (bound.valid()) return bound == atom;
+        bound = atom;
+        trail_.push_back(node.slot);
+        return true;
+    }
+
+    case Op::TYPED:
+        return type_matches(node.type, table.get_type(atom));
+
+    case Op::LINK:
+        if (!type_matches(node.type, table.get_type(atom))) return false;
+        return unify_outgoing(node, table.get_outgoing(atom));
+
+    case Op::AND:
+        for (uint32_t i = 0; i < node.count; ++i) {
+            if (!unify(children_[node.first + i], atom)) return false;
+        }
+        return true;
+
+    case Op::OR: {
+        const size_t mark = trail_.size();
+        for (uint32_t i = 0; i < node.count; ++i) {
+            if (unify(children_[node.first + i], atom)) return true;
+            undo(mark);
+        }
+        return false;
+    }
+
+    case Op::NOT: {
+        const size_t mark = trail_.size();
+        bool matched = unify(children_[node.first], atom);
+        undo(mark);
+        return !matched;
+    }
+
+    case Op::GLOB:
+        // A glob standing in for a single atom has no span to bind into
+        return false;
+    }
+
+    return false;
+}
+
+bool MatchEngine::unify_outgoing(const Node& link, std::span<const AtomId> outgoing) {
+    if (!link.bounds.admits(outgoing.size())) return false;
+
+    std::span<const uint32_t> pattern(children_.data() + link.first, link.count);
+
+    if (!link.has_glob) {
+        for (size_t i = 0; i < pattern.size(); ++i) {
+            if (!unify(pattern[i], outgoing[i])) return false;
+        }
+        return true;
+    }
+
+    return unify_sequence(pattern, outgoing);
+}
+
+bool MatchEngine::unify_sequence(std::span<const uint32_t> pattern, std::span<const AtomId> atoms) {
+    // Consume fixed-arity terms up to the next glob
+    while (!pattern.empty() && nodes_[pattern.front()].op != Op::GLOB) {
+        if (atoms.empty() || !unify(pattern.front(), atoms.front())) return false;
+        pattern = pattern.subspan(1);
+        atoms = atoms.subspan(1);
+    }
+
+    if (pattern.empty()) return atoms.empty();
+
+    const Node& glob = nodes_[pattern.front()];
+    const auto rest = pattern.subspan(1);
+    const size_t available = atoms.size();
+
+    ArityBounds tail;
+    for (uint32_t index : rest) {
+        const Node& node = nodes_[index];
+        if (node.op == Op::GLOB) {
+            tail.min += node.bounds.min;
+            tail.max = (node.bounds.max > SIZE_MAX - tail.max) ? SIZE_MAX : tail.max + node.bounds.max;
+        } else {
+            tail.min += 1;
+            if (tail.max != SIZE_MAX) tail.max += 1;
+        }
+    }
+
+    if (available < tail.min) return false;
+
+    // A glob that is already bound must repeat the same run of atoms
+    if (const auto& bound = glob_slots_[glob.slot]) {
+        if (bound->size() > available ||
+            !std::equal(bound->begin(), bound->end(), atoms.begin())) {
+            return false;
+        }
+        return unify_sequence(rest, atoms.subspan(bound->size()));
+    }
+
+    size_t min_len = glob.bounds.min;
+    if (tail.max != SIZE_MAX && available > tail.max) {
+        min_len = std::max(min_len, available - tail.max);
+    }
+    size_t max_len = std::min(glob.bounds.max, available - tail.min);
+
+    // A retry takes its recorded spans again, and the last one further
+    const uint32_t index = pattern.front();
+    if (replay_pos_ < replay_.size() && replay_[replay_pos_].node == index) {
+        const size_t taken = replay_[replay_pos_++].len;
+        if (replay_pos_ < replay_.size()) {
+            min_len = max_len = taken;
+        } else {
+            min_len = taken + 1;
+        }
+    }
+
+    // A grounded neighbour pins where the glob may end
+    const Node* anchor = (!rest.empty() && nodes_[rest.front()].op == Op::GROUNDED)
+        ? &nodes_[rest.front()] : nullptr;
+
+    for (size_t len = min_len; len <= max_len; ++len) {
+        if (anchor && (len == available || atoms[len] != anchor->atom)) continue;
+
+        const size_t mark = trail_.size();
+        glob_slots_[glob.slot] = atoms.first(len);
+        trail_.push_back(glob.slot | GLOB_FLAG);
+        choices_.push_back({index, static_cast<uint32_t>(len)});
+        trail_.push_back(CHOICE_FLAG);
+        const size_t recorded = choices_.size();
+
+        if (unify_sequence(rest, atoms.subspan(len))) return true;
+
+        // Spans taken further on are retried by the caller before this one
+        if (choices_.size() > recorded) return false;
+        undo(mark);
+    }
+
+    return false;
+}
+
+bool MatchEngine::retry(uint32_t node, AtomId atom, size_t trail_mark, size_t choice_mark) {
+    std::vector<Choice> pending(choices_.begin() + static_cast<std::ptrdiff_t>(choice_mark), choices_.end());
+    while (!pending.empty()) {
+        replay_ = pending;
+        replay_pos_ = 0;
+        undo(trail_mark);
+
+        // A replay that did not reach its last span would repeat a match
+        const bool unified = unify(node, atom) && replay_pos_ == replay_.size();
+        replay_.clear();
+        replay_pos_ = 0;
+        if (unified) return true;
+
+        // Spans left open by the failure are retried next; otherwise the
+        // last span is exhausted and the one before it moves on
+        if (choices_.size() > choice_mark) {
+            pending.assign(choices_.begin() + static_cast<std::ptrdiff_t>(choice_mark), choices_.end());
+        } else {
+            pending.pop_back();
+        }
+    }
+    undo(trail_mark);
+    return false;
+}
+
+bool MatchEngine::unify_any(uint32_t node, AtomId atom) {
+    const size_t trail_mark = trail_.size();
+    const size_t choice_mark = choices_.size();
+    return unify(node, atom) || retry(node, atom, trail_mark, choice_mark);
+}
+
+void MatchEngine::undo(size_t mark) noexcept {
+    while (trail_.size() > mark) {
+        uint32_t entry = trail_.back();
+        trail_.pop_back();
+        if (entry == CHOICE_FLAG) {
+            choices_.pop_back();
+        } else if (entry & GLOB_FLAG) {
+            glob_slots_[entry & ~GLOB_FLAG].reset();
+        } else {
+            slots_[entry] = ATOM_NULL;
+        }
+    }
+}
+
+bool MatchEngine::type_matches(AtomType pattern_type, AtomType atom_type) const noexcept {
+    if (pattern_type == atom_type) return true;
+    if (!check_type_hierarchy_) return false;
+
+    // Type hierarchy: NODE matches any node type, LINK any link type
+    if (pattern_type == AtomType::NODE && is_node(atom_type)) return true;
+    if (pattern_type == AtomType::LINK && is_link(atom_type)) return true;
+
+    return false;
+}
+
+// ============================================================================
+// Introspection
+// ============================================================================
+
+std::optional<AtomType> MatchEngine::conjunct_type(size_t conjunct) const noexcept {
+    if (conjunct >= positive_.size()) return std::nullopt;
+    const Node& node = nodes_[positive_[conjunct]];
+
+    std::optional<AtomType> type;
+    switch (node.op) {
+    case Op::LINK:
+    case Op::TYPED:
+        type = node.type;
+        break;
+    case Op::VARIABLE:
+        if (node.constrained) type = node.type;
+        break;
+    default:
+        break;
+    }
+
+    // Generic types stand for every node or link type under the hierarchy
+    if (type && check_type_hierarchy_ && (*type == AtomType::NODE || *type == AtomType::LINK)) {
+        return std::nullopt;
+    }
+    return type;
+}
+
+AtomId MatchEngine::conjunct_anchor(size_t conjunct) const noexcept {
+    if (conjunct >= positive_.size()) return ATOM_NULL;
+    const Node& node = nodes_[positive_[conjunct]];
+    if (node.op != Op::LINK) return ATOM_NULL;
+
+    for (uint32_t i = 0; i < node.count; ++i) {
+        const Node& child = nodes_[children_[node.first + i]];
+        if (child.op == Op::GROUNDED) return child.atom;
+    }
+    return ATOM_NULL;
+}
+
+// ============================================================================
+// Results
+// ============================================================================
+
+AtomId MatchEngine::matched_atom() const noexcept {
+    return clause_atoms_.empty() ? ATOM_NULL : clause_atoms_.back();
+}
+
+std::optional<uint32_t> MatchEngine::slot_of(std::string_view var) const noexcept {
+    for (size_t i = 0; i < var_names_.size(); ++i) {
+        if (var_names_[i] == var) return static_cast<uint32_t>(i);
+    }
+    return std::nullopt;
+}
+
+AtomId MatchEngine::value(std::string_view var) const noexcept {
+    auto slot = slot_of(var);
+    return slot ? slots_[*slot] : ATOM_NULL;
+}
+
+std::span<const AtomId> MatchEngine::glob_value(std::string_view glob) const noexcept {
+    for (size_t i = 0; i < glob_names_.size(); ++i) {
+        if (glob_names_[i] == glob && glob_slots_[i]) return *glob_slots_[i];
+    }
+    return {};
+}
+
+void MatchEngine::materialize(MatchResult& out) const {
+    out.matched_atom = matched_atom();
+    out.confidence = 1.0f;
+
+    // Update in place when out already holds the same variables
+    auto& vars = out.bindings.bindings;
+    size_t bound_vars = 0;
+    for (AtomId id : slots_) bound_vars += id.valid() ? 1 : 0;
+
+    bool reuse = vars.size() == bound_vars;
+    for (size_t i = 0; i < var_names_.size() && reuse; ++i) {
+        if (!slots_[i].valid()) continue;
+        auto it = vars.find(var_names_[i]);
+        if (it == vars.end()) reuse = false;
+        else it->second = slots_[i];
+    }
+    if (!reuse) {
+        vars.clear();
+        for (size_t i = 0; i < var_names_.size(); ++i) {
+            if (slots_[i].valid()) vars.emplace(var_names_[i], slots_[i]);
+        }
+    }
+
+    auto& globs = out.bindings.globs;
+    size_t bound_globs = 0;
+    for (const auto& g : glob_slots_) bound_globs += g ? 1 : 0;
+
+    reuse = globs.size() == bound_globs;
+    for (size_t i = 0; i < glob_names_.size() && reuse; ++i) {
+        if (!glob_slots_[i]) continue;
+        auto it = globs.find(glob_names_[i]);
+        if (it == globs.end()) reuse = false;
+        else it->second = *glob_slots_[i];
+    }
+    if (!reuse) {
+        globs.clear();
+        for (size_t i = 0; i < glob_names_.size(); ++i) {
+            if (glob_slots_[i]) globs.emplace(glob_names_[i], *glob_slots_[i]);
+        }
+    }
+}
+
+MatchResult MatchEngine::result() const {
+    MatchResult out;
+    materialize(out);
+    return out;
+}
+
+size_t MatchEngine::collect(std::vector<MatchResult>& out, size_t limit) {
+    size_t count = 0;
+    while (count < limit && next()) {
+        if (count == out.size()) out.emplace_back();
+        materialize(out[count]);
+        ++count;
+    }
+    out.resize(count);
+    return count;
+}
+
+} // namespace opencog
@@ -5,29 +5,51 @@
 
 #include <opencog/pattern/matcher.hpp>
 
+#include <algorithm>
+#include <thread>
+
 namespace opencog {
 
 PatternMatcher::PatternMatcher(const AtomSpace& space, MatcherConfig config)
-    : space_(space), config_(std::move(config))
+    : space_(space)
+    , config_(std::move(config))
+    , cache_(config_.cache_capacity)
+    , engine_(space, config_.check_type_hierarchy)
 {
 }
 
+void PatternMatcher::set_config(MatcherConfig config) {
+    // Cached results were computed under the old type-hierarchy setting
+    if (config.check_type_hierarchy != config_.check_type_hierarchy) {
+        cache_.clear();
+    }
+    config_ = std::move(config);
+    engine_.set_check_type_hierarchy(config_.check_type_hierarchy);
+    cache_.set_capacity(config_.cache_capacity);
+}
+
+const QueryCache::Entry* PatternMatcher::cached(const Pattern& pattern, size_t limit) {
+    if (config_.cache_capacity == 0 || engine_busy_) return nullptr;
+
+    fingerprint(pattern, fingerprint_);
+    return cache_.lookup(space_, fingerprint_, limit);
+}
+
 // ============================================================================
 // Core Matching
 // ============================================================================
 
-generator<MatchResult> PatternMatcher::match(const Pattern& pattern) {
-    BindingSet initial_bindings;
-    size_t result_count = 0;
+generator<MatchResult> PatternMatcher::match(Pattern pattern) {
+    // One coroutine frame for the whole query: the search is driven by a
+    // MatchEngine living in this frame.
+    MatchEngine engine(space_, config_.check_type_hierarchy);
+    engine.reset(pattern);
 
-    for (auto& result : match_term(pattern.body, initial_bindings)) {
-        // Apply additional clause if present
-        if (pattern.clause) {
-            auto clause_result = match_atom(*pattern.clause, result.matched_atom, result.bindings);
-            if (!clause_result) continue;
-        }
+    size_t result_count = 0;
 
-        co_yield result;
+    while (engine.next()) {
+        MatchResult result = engine.result();
+        co_yield std::move(result);
 
         if (++result_count >= config_.max_results) {
             co_return;
@@ -44,42 +66,76 @@ std::optional<MatchResult> PatternMatcher::match_atom(
     AtomId atom,
     BindingSet bindings
 ) {
-    auto result = unify_term(pattern, atom, std::move(bindings));
-    if (result) {
-        return MatchResult{*result, atom, 1.0f};
-    }
-    return std::nullopt;
+    std::optional<MatchResult> first;
+    (void)unify_term(pattern, atom, std::move(bindings), [&](BindingSet& unified) {
+        first = MatchResult{std::move(unified), atom, 1.0f};
+        return true;
+    });
+    return first;
 }
 
 std::optional<MatchResult> PatternMatcher::find_first(const Pattern& pattern) {
-    for (auto& result : match(pattern)) {
-        return result;
+    if (const auto* entry = cached(pattern, 1)) {
+        if (entry->rows == 0) return std::nullopt;
+        std::vector<MatchResult> row;
+        QueryCache::read(*entry, fingerprint_, row, 1);
+        return std::move(row.front());
     }
-    return std::nullopt;
+
+    std::optional<MatchResult> first;
+    run_engine(pattern, 1, [&](const MatchEngine& engine) {
+        first = engine.result();
+        return false;
+    });
+    return first;
 }
 
 std::vector<MatchResult> PatternMatcher::find_all(const Pattern& pattern, size_t limit) {
     std::vector<MatchResult> results;
-    for (auto& result : match(pattern)) {
-        results.push_back(std::move(result));
-        if (results.size() >= limit) break;
-    }
+    match_into(pattern, results, limit);
     return results;
 }
 
-size_t PatternMatcher::count_matches(const Pattern& pattern) {
+size_t PatternMatcher::match_into(
+    const Pattern& pattern,
+    std::vector<MatchResult>& out,
+    size_t limit
+) {
+    limit = std::min(limit, config_.max_results);
+
+    const bool use_cache = config_.cache_capacity > 0 && !engine_busy_;
+    if (const auto* entry = cached(pattern, limit)) {
+        return QueryCache::read(*entry, fingerprint_, out, limit);
+    }
+    if (use_cache) cache_.capture(space_, fingerprint_, stamps_);
+
     size_t count = 0;
-    for ([[maybe_unused]] auto& _ : match(pattern)) {
-        ++count;
+    run_engine(pattern, limit, [&](const MatchEngine& engine) {
+        // Reuse existing elements (and their binding maps) when possible
+        if (count == out.size()) out.emplace_back();
+        engine.materialize(out[count++]);
+        return true;
+    });
+    out.resize(count);
+
+    if (use_cache) {
+        cache_.store(fingerprint_, stamps_, out, count < limit);
     }
     return count;
 }
 
+size_t PatternMatcher::count_matches(const Pattern& pattern) {
+    if (const auto* entry = cached(pattern, config_.max_results)) {
+        return std::min(entry->rows, config_.max_results);
+    }
+    return run_engine(pattern, config_.max_results, [](const MatchEngine&) { return true; });
+}
+
 bool PatternMatcher::any_match(const Pattern& pattern) {
-    for ([[maybe_unused]] auto& _ : match(pattern)) {
-        return true;
+    if (const auto* entry = cached(pattern, 1)) {
+        return entry->rows > 0;
     }
-    return false;
+    return run_engine(pattern, 1, [](const MatchEngine&) { return true; }) > 0;
 }
 
 // ============================================================================
@@ -89,206 +145,179 @@ bool PatternMatcher::any_match(const Pattern& pattern) {
 generator<AtomId> PatternMatcher::filter(
     std::function<bool(const AtomSpace&, Handle)> predicate
 ) {
-    space_.for_each_atom([&](Handle h) {
-        if (predicate(space_, h)) {
-            // Note: Can't co_yield from a lambda, would need restructuring
-        }
-    });
-    // Placeholder - would need to refactor to use coroutines properly
-    co_return;
-}
+    AtomCursor cursor(space_.atom_table());
+    size_t count = 0;
+    if (config_.max_results == 0) co_return;
 
-generator<AtomId> PatternMatcher::filter_by_type(
-    AtomType type,
-    std::function<bool(const AtomSpace&, Handle)> predicate
-) {
-    for (Handle h : space_.get_atoms_by_type(type)) {
-        if (!predicate || predicate(space_, h)) {
-            co_yield h.id();
+    for (auto batch = cursor.next_batch(); !batch.empty(); batch = cursor.next_batch()) {
+        for (AtomId id : batch) {
+            if (!predicate(space_, space_.make_handle(id))) continue;
+
+            co_yield id;
+            if (++count >= config_.max_results) co_return;
         }
     }
 }
 
-// ============================================================================
-// Internal Matching
-// ============================================================================
-
-generator<MatchResult> PatternMatcher::match_term(
-    const PatternTerm& term,
-    BindingSet bindings
+size_t PatternMatcher::filter_into(
+    const std::function<bool(const AtomSpace&, Handle)>& predicate,
+    std::vector<AtomId>& out,
+    size_t threads
 ) {
-    if (auto* grounded = std::get_if<GroundedTerm>(&term)) {
-        for (auto& r : match_grounded(*grounded, bindings)) {
-            co_yield r;
-        }
-    }
-    else if (auto* variable = std::get_if<VariableTerm>(&term)) {
-        for (auto& r : match_variable(*variable, bindings)) {
-            co_yield r;
-        }
-    }
-    else if (auto* typed = std::get_if<TypedTerm>(&term)) {
-        for (auto& r : match_typed(*typed, bindings)) {
-            co_yield r;
-        }
-    }
-    else if (auto* link_ptr = std::get_if<std::shared_ptr<LinkPattern>>(&term)) {
-        if (*link_ptr) {
-            for (auto& r : match_link_pattern(**link_ptr, bindings)) {
-                co_yield r;
+    const size_t limit = config_.max_results;
+    const size_t slots = space_.atom_table().slot_count();
+    const size_t begin = out.size();
+
+    // Each block stops after limit hits; the ordered merge keeps the first
+    // limit overall.
+    auto scan = [&](size_t first, size_t last, std::vector<AtomId>& hits) {
+        const size_t base = hits.size();
+        AtomCursor cursor(space_.atom_table(), first, last);
+        for (auto batch = cursor.next_batch(); !batch.empty(); batch = cursor.next_batch()) {
+            for (AtomId id : batch) {
+                if (!predicate(space_, space_.make_handle(id))) continue;
+                hits.push_back(id);
+                if (hits.size() - base >= limit) return;
             }
         }
-    }
-    // Handle other term types...
-}
+    };
 
-generator<MatchResult> PatternMatcher::match_grounded(
-    const GroundedTerm& term,
-    BindingSet bindings
-) {
-    if (space_.contains(term.atom)) {
-        co_yield MatchResult{bindings, term.atom, 1.0f};
+    threads = std::clamp<size_t>(threads, 1, std::max<size_t>(1, slots / AtomCursor::DEFAULT_BATCH));
+    if (threads == 1 || limit == 0) {
+        if (limit > 0) scan(0, slots, out);
+        return out.size() - begin;
     }
-}
 
-generator<MatchResult> PatternMatcher::match_variable(
-    const VariableTerm& term,
-    BindingSet bindings
-) {
-    // Check if already bound
-    if (bindings.contains(term.name)) {
-        AtomId bound_id = bindings.get(term.name);
-        if (space_.contains(bound_id)) {
-            // Check type constraint
-            if (!term.type_constraint ||
-                type_matches(*term.type_constraint, space_.atom_table().get_type(bound_id))) {
-                co_yield MatchResult{bindings, bound_id, 1.0f};
-            }
+    std::vector<std::vector<AtomId>> blocks(threads);
+    {
+        std::vector<std::jthread> workers;
+        workers.reserve(threads);
+        const size_t step = (slots + threads - 1) / threads;
+        for (size_t t = 0; t < threads; ++t) {
+            const size_t first = std::min(slots, t * step);
+            const size_t last = std::min(slots, first + step);
+            workers.emplace_back([&, t, first, last] { scan(first, last, blocks[t]); });
         }
-        co_return;
     }
 
-    // Find all matching atoms
-    if (term.type_constraint) {
-        // Search atoms of specific type
-        for (Handle h : space_.get_atoms_by_type(*term.type_constraint)) {
-            BindingSet new_bindings = bindings;
-            new_bindings.bind(term.name, h.id());
-            co_yield MatchResult{new_bindings, h.id(), 1.0f};
-        }
-    } else {
-        // Search all atoms (expensive!)
-        space_.for_each_atom([&](Handle h) {
-            // Would need to restructure to use coroutines
-        });
+    for (const auto& block : blocks) {
+        const size_t room = limit - (out.size() - begin);
+        out.insert(out.end(), block.begin(), block.begin() + std::min(room, block.size()));
+        if (out.size() - begin >= limit) break;
     }
+    return out.size() - begin;
 }
 
-generator<MatchResult> PatternMatcher::match_typed(
-    const TypedTerm& term,
-    BindingSet bindings
+generator<AtomId> PatternMatcher::filter_by_type(
+    AtomType type,
+    std::function<bool(const AtomSpace&, Handle)> predicate
 ) {
-    for (Handle h : space_.get_atoms_by_type(term.type)) {
-        co_yield MatchResult{bindings, h.id(), 1.0f};
+    size_t count = 0;
+    if (config_.max_results == 0) co_return;
+
+    for (Handle h : space_.get_atoms_by_type(type)) {
+        if (!predicate || predicate(space_, h)) {
+            AtomId id = h.id();
+            co_yield id;
+            if (++count >= config_.max_results) co_return;
+        }
     }
 }
 
-generator<MatchResult> PatternMatcher::match_link_pattern(
-    const LinkPattern& pattern,
-    BindingSet bindings
+// ============================================================================
+// Unification
+// ============================================================================
+
+bool PatternMatcher::unify_outgoing(
+    std::span<const PatternTerm> pattern_outgoing,
+    std::span<const AtomId> atom_outgoing,
+    BindingSet bindings,
+    const Unified& unified
 ) {
-    // Get all links of this type
-    for (Handle link : space_.get_atoms_by_type(pattern.type)) {
-        auto outgoing = space_.atom_table().get_outgoing(link.id());
-
-        // Try to unify outgoing sets
-        auto result = unify_outgoing(pattern.outgoing, outgoing, bindings);
-        if (result) {
-            co_yield MatchResult{*result, link.id(), 1.0f};
+    if (has_glob(pattern_outgoing)) {
+        if (!arity_bounds(pattern_outgoing).admits(atom_outgoing.size())) {
+            return false;
         }
+    } else if (pattern_outgoing.size() != atom_outgoing.size()) {
+        return false;
     }
+
+    return unify_sequence(pattern_outgoing, atom_outgoing, std::move(bindings), unified);
 }
 
-generator<MatchResult> PatternMatcher::match_and(
-    const AndPattern& pattern,
-    BindingSet bindings
+bool PatternMatcher::unify_sequence(
+    std::span<const PatternTerm> pattern_outgoing,
+    std::span<const AtomId> atom_outgoing,
+    BindingSet bindings,
+    const Unified& unified
 ) {
-    if (pattern.terms.empty()) {
-        co_yield MatchResult{bindings, ATOM_NULL, 1.0f};
-        co_return;
+    if (pattern_outgoing.empty()) {
+        return atom_outgoing.empty() && unified(bindings);
     }
 
-    // Match first term, then recursively match rest
-    for (auto& first_result : match_term(pattern.terms[0], bindings)) {
-        if (pattern.terms.size() == 1) {
-            co_yield first_result;
-        } else {
-            // Create And pattern with remaining terms
-            AndPattern rest;
-            rest.terms.assign(pattern.terms.begin() + 1, pattern.terms.end());
-            for (auto& rest_result : match_and(rest, first_result.bindings)) {
-                co_yield rest_result;
-            }
-        }
+    // A fixed-arity term takes the next atom; each of its unifiers is
+    // carried on to the rest of the sequence
+    if (!std::holds_alternative<GlobTerm>(pattern_outgoing.front())) {
+        if (atom_outgoing.empty()) return false;
+        return unify_term(pattern_outgoing.front(), atom_outgoing.front(), std::move(bindings),
+                          [&](BindingSet& next) {
+            return unify_sequence(pattern_outgoing.subspan(1), atom_outgoing.subspan(1),
+                                  std::move(next), unified);
+        });
     }
-}
 
-generator<MatchResult> PatternMatcher::match_or(
-    const OrPattern& pattern,
-    BindingSet bindings
-) {
-    for (const auto& term : pattern.terms) {
-        for (auto& result : match_term(term, bindings)) {
-            co_yield result;
+    const auto& glob = std::get<GlobTerm>(pattern_outgoing.front());
+    const auto rest = pattern_outgoing.subspan(1);
+    const ArityBounds tail = arity_bounds(rest);
+    const size_t available = atom_outgoing.size();
+
+    if (available < tail.min) return false;
+
+    // A glob that is already bound must repeat the same run of atoms
+    if (bindings.contains_glob(glob.name)) {
+        auto bound = bindings.get_glob(glob.name);
+        if (bound.size() > available ||
+            !std::equal(bound.begin(), bound.end(), atom_outgoing.begin())) {
+            return false;
         }
+        return unify_sequence(rest, atom_outgoing.subspan(bound.size()), std::move(bindings),
+                              unified);
     }
-}
 
-bool PatternMatcher::match_not(
-    const NotPattern& pattern,
-    const BindingSet& bindings
-) {
-    // Not matches if the sub-pattern does NOT match
-    for ([[maybe_unused]] auto& _ : match_term(pattern.term, bindings)) {
-        return false;  // Found a match, so NOT fails
+    // Span lengths that leave the rest of the pattern satisfiable
+    size_t min_len = glob.min_count;
+    if (tail.max != SIZE_MAX && available > tail.max) {
+        min_len = std::max(min_len, available - tail.max);
     }
-    return true;  // No match found, so NOT succeeds
-}
+    const size_t max_len = std::min(glob.max_count, available - tail.min);
 
-// ============================================================================
-// Unification
-// ============================================================================
+    // A grounded neighbour pins where the glob may end
+    const auto* anchor = rest.empty() ? nullptr : std::get_if<GroundedTerm>(&rest.front());
 
-std::optional<BindingSet> PatternMatcher::unify_outgoing(
-    std::span<const PatternTerm> pattern_outgoing,
-    std::span<const AtomId> atom_outgoing,
-    BindingSet bindings
-) {
-    if (pattern_outgoing.size() != atom_outgoing.size()) {
-        return std::nullopt;
-    }
+    for (size_t len = min_len; len <= max_len; ++len) {
+        if (anchor && (len == available || atom_outgoing[len] != anchor->atom)) {
+            continue;
+        }
 
-    for (size_t i = 0; i < pattern_outgoing.size(); ++i) {
-        auto result = unify_term(pattern_outgoing[i], atom_outgoing[i], bindings);
-        if (!result) {
-            return std::nullopt;
+        BindingSet attempt = bindings;
+        attempt.bind_glob(glob.name, atom_outgoing.first(len));
+
+        if (unify_sequence(rest, atom_outgoing.subspan(len), std::move(attempt), unified)) {
+            return true;
         }
-        bindings = *result;
     }
 
-    return bindings;
+    return false;
 }
 
-std::optional<BindingSet> PatternMatcher::unify_term(
+bool PatternMatcher::unify_term(
     const PatternTerm& term,
     AtomId atom,
-    BindingSet bindings
+    BindingSet bindings,
+    const Unified& unified
 ) {
     if (auto* grounded = std::get_if<GroundedTerm>(&term)) {
-        if (grounded->atom == atom) {
-            return bindings;
-        }
-        return std::nullopt;
+        return grounded->atom == atom && unified(bindings);
     }
 
     if (auto* variable = std::get_if<VariableTerm>(&term)) {
@@ -296,46 +325,70 @@ std::optional<BindingSet> PatternMatcher::unify_term(
         if (variable->type_constraint) {
             AtomType actual = space_.atom_table().get_type(atom);
             if (!type_matches(*variable->type_constraint, actual)) {
-                return std::nullopt;
+                return false;
             }
         }
 
         // Check existing binding
         if (bindings.contains(variable->name)) {
-            if (bindings.get(variable->name) == atom) {
-                return bindings;
-            }
-            return std::nullopt;
+            return bindings.get(variable->name) == atom && unified(bindings);
         }
 
         // Create new binding
         bindings.bind(variable->name, atom);
-        return bindings;
+        return unified(bindings);
     }
 
     if (auto* typed = std::get_if<TypedTerm>(&term)) {
         AtomType actual = space_.atom_table().get_type(atom);
-        if (type_matches(typed->type, actual)) {
-            return bindings;
-        }
-        return std::nullopt;
+        return type_matches(typed->type, actual) && unified(bindings);
     }
 
     if (auto* link_ptr = std::get_if<std::shared_ptr<LinkPattern>>(&term)) {
-        if (!*link_ptr) return std::nullopt;
+        if (!*link_ptr) return false;
 
         const auto& pattern = **link_ptr;
         AtomType actual = space_.atom_table().get_type(atom);
 
         if (!type_matches(pattern.type, actual)) {
-            return std::nullopt;
+            return false;
         }
 
         auto outgoing = space_.atom_table().get_outgoing(atom);
-        return unify_outgoing(pattern.outgoing, outgoing, bindings);
+        return unify_outgoing(pattern.outgoing, outgoing, std::move(bindings), unified);
+    }
+
+    // Connectives nested below the top level constrain this one atom
+    if (auto* and_ptr = std::get_if<std::shared_ptr<AndPattern>>(&term)) {
+        if (!*and_ptr) return false;
+        const auto& terms = (*and_ptr)->terms;
+        std::function<bool(size_t, BindingSet&)> conjoin = [&](size_t i, BindingSet& so_far) {
+            if (i == terms.size()) return unified(so_far);
+            return unify_term(terms[i], atom, std::move(so_far), [&](BindingSet& next) {
+                return conjoin(i + 1, next);
+            });
+        };
+        return conjoin(0, bindings);
+    }
+
+    if (auto* or_ptr = std::get_if<std::shared_ptr<OrPattern>>(&term)) {
+        if (!*or_ptr) return false;
+        for (const auto& sub : (*or_ptr)->terms) {
+            if (unify_term(sub, atom, bindings, unified)) return true;
+        }
+        return false;
     }
 
-    return std::nullopt;
+    if (auto* not_ptr = std::get_if<std::shared_ptr<NotPattern>>(&term)) {
+        if (!*not_ptr) return false;
+        const bool matched = unify_term((*not_ptr)->term, atom, bindings,
+                                        [](BindingSet&) { return true; });
+        return !matched && unified(bindings);
+    }
+
+    // GlobTerm: a glob standing in for a single atom has no span to bind
+    // into; it is only unified as part of an outgoing set (unify_sequence).
+    return false;
 }
 
 bool PatternMatcher::type_matches(AtomType pattern_type, AtomType atom_type) const {
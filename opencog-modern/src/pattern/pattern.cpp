@@ -5,9 +5,153 @@
 
 #include <opencog/pattern/pattern.hpp>
 
+#include <algorithm>
+
 namespace opencog {
 
-// Most pattern operations are inline in the header
-// This file exists for any future non-inline implementations
+// ============================================================================
+// Arity Analysis
+// ============================================================================
+
+ArityBounds arity_bounds(std::span<const PatternTerm> terms) noexcept {
+    ArityBounds bounds;
+
+    for (const auto& term : terms) {
+        if (auto* glob = std::get_if<GlobTerm>(&term)) {
+            bounds.min += glob->min_count;
+            bounds.max = (glob->max_count > SIZE_MAX - bounds.max)
+                ? SIZE_MAX
+                : bounds.max + glob->max_count;
+        } else {
+            bounds.min += 1;
+            if (bounds.max != SIZE_MAX) bounds.max += 1;
+        }
+    }
+
+    return bounds;
+}
+
+bool has_glob(std::span<const PatternTerm> terms) noexcept {
+    for (const auto& term : terms) {
+        if (std::holds_alternative<GlobTerm>(term)) return true;
+    }
+    return false;
+}
+
+// ============================================================================
+// Canonical Form
+// ============================================================================
+
+namespace {
+
+enum class Token : uint64_t {
+    GROUNDED = 1, VARIABLE, TYPED, GLOB, LINK, AND, OR, NOT, NONE, CLAUSE
+};
+
+class Canonicalizer {
+public:
+    explicit Canonicalizer(PatternFingerprint& out) : out_(out) {}
+
+    // generating: the term enumerates candidates from the AtomSpace
+    // (a top-level conjunct or a branch of one) rather than only being
+    // unified against atoms reached through an outgoing set.
+    void term(const PatternTerm& term, bool generating) {
+        if (auto* grounded = std::get_if<GroundedTerm>(&term)) {
+            emit(Token::GROUNDED, grounded->atom.value);
+            if (generating) out_.any_type = true;
+        }
+        else if (auto* variable = std::get_if<VariableTerm>(&term)) {
+            emit(Token::VARIABLE, index_of(out_.variables, variable->name));
+            out_.tokens.push_back(variable->type_constraint
+                ? static_cast<uint64_t>(*variable->type_constraint) : UINT64_MAX);
+            if (generating) depend(variable->type_constraint);
+        }
+        else if (auto* typed = std::get_if<TypedTerm>(&term)) {
+            emit(Token::TYPED, static_cast<uint64_t>(typed->type));
+            if (generating) depend(typed->type);
+        }
+        else if (auto* glob = std::get_if<GlobTerm>(&term)) {
+            emit(Token::GLOB, index_of(out_.globs, glob->name));
+            out_.tokens.push_back(glob->min_count);
+            out_.tokens.push_back(glob->max_count);
+        }
+        else if (auto* link_ptr = std::get_if<std::shared_ptr<LinkPattern>>(&term); link_ptr && *link_ptr) {
+            const auto& link = **link_ptr;
+            emit(Token::LINK, static_cast<uint64_t>(link.type));
+            out_.tokens.push_back(link.ordered ? 1 : 0);
+            out_.tokens.push_back(link.outgoing.size());
+            if (generating) depend(link.type);
+            for (const auto& child : link.outgoing) this->term(child, false);
+        }
+        else if (auto* and_ptr = std::get_if<std::shared_ptr<AndPattern>>(&term); and_ptr && *and_ptr) {
+            emit(Token::AND, (*and_ptr)->terms.size());
+            for (const auto& child : (*and_ptr)->terms) this->term(child, generating);
+        }
+        else if (auto* or_ptr = std::get_if<std::shared_ptr<OrPattern>>(&term); or_ptr && *or_ptr) {
+            emit(Token::OR, (*or_ptr)->terms.size());
+            for (const auto& child : (*or_ptr)->terms) this->term(child, generating);
+        }
+        else if (auto* not_ptr = std::get_if<std::shared_ptr<NotPattern>>(&term); not_ptr && *not_ptr) {
+            // A top-level negation searches for counterexamples
+            emit(Token::NOT, 1);
+            this->term((*not_ptr)->term, generating);
+        }
+        else {
+            emit(Token::NONE, 0);
+        }
+    }
+
+    void clause(const std::optional<PatternTerm>& clause) {
+        emit(Token::CLAUSE, clause ? 1 : 0);
+        if (clause) term(*clause, false);
+    }
+
+private:
+    PatternFingerprint& out_;
+
+    void emit(Token token, uint64_t value) {
+        out_.tokens.push_back(static_cast<uint64_t>(token));
+        out_.tokens.push_back(value);
+    }
+
+    static uint64_t index_of(std::vector<std::string>& names, const std::string& name) {
+        auto it = std::find(names.begin(), names.end(), name);
+        if (it == names.end()) {
+            names.push_back(name);
+            return names.size() - 1;
+        }
+        return static_cast<uint64_t>(it - names.begin());
+    }
+
+    void depend(std::optional<AtomType> type) {
+        // Generic NODE/LINK may stand for every concrete type
+        if (!type || *type == AtomType::NODE || *type == AtomType::LINK) {
+            out_.any_type = true;
+            return;
+        }
+        if (std::find(out_.dependencies.begin(), out_.dependencies.end(), *type) ==
+            out_.dependencies.end()) {
+            out_.dependencies.push_back(*type);
+        }
+    }
+};
+
+} // namespace
+
+void fingerprint(const Pattern& pattern, PatternFingerprint& out) {
+    out.tokens.clear();
+    out.variables.clear();
+    out.globs.clear();
+    out.dependencies.clear();
+    out.any_type = false;
+
+    Canonicalizer canon(out);
+    canon.term(pattern.body, true);
+    canon.clause(pattern.clause);
+
+    uint64_t h = out.tokens.size();
+    for (uint64_t token : out.tokens) h = hash_combine(h, token);
+    out.hash = h;
+}
 
 } // namespace opencog
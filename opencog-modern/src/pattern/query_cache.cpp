@@ -0,0 +1,178 @@
+/**
+ * @file query_cache.cpp
+ * @brief LRU cache of pattern match results
+ */
+
+#include <opencog/pattern/query_cache.hpp>
+
+#include <algorithm>
+
+namespace opencog {
+
+QueryCache::QueryCache(size_t capacity, size_t max_rows)
+    : capacity_(capacity), max_rows_(max_rows)
+{
+}
+
+// ============================================================================
+// Lookup
+// ============================================================================
+
+const QueryCache::Entry* QueryCache::lookup(const AtomSpace& space,
+                                            const PatternFingerprint& key,
+                                            size_t limit) {
+    auto found = index_.find(key.hash);
+    if (found == index_.end() || !found->second->key.same_structure(key)) {
+        ++stats_.misses;
+        return nullptr;
+    }
+
+    auto it = found->second;
+    capture(space, key, scratch_stamps_);
+    if (scratch_stamps_ != it->stamps) {
+        erase(it);
+        ++stats_.invalidations;
+        ++stats_.misses;
+        return nullptr;
+    }
+
+    if (!it->complete && it->rows < limit) {
+        ++stats_.misses;
+        return nullptr;
+    }
+
+    entries_.splice(entries_.begin(), entries_, it);
+    ++stats_.hits;
+    return &*it;
+}
+
+void QueryCache::capture(const AtomSpace& space, const PatternFingerprint& key,
+                         std::vector<uint64_t>& stamps) const {
+    stamps.clear();
+    if (key.any_type) {
+        stamps.push_back(space.version());
+        return;
+    }
+    for (AtomType type : key.dependencies) {
+        stamps.push_back(space.type_version(type));
+    }
+}
+
+// ============================================================================
+// Insertion
+// ============================================================================
+
+void QueryCache::store(const PatternFingerprint& key,
+                       std::span<const uint64_t> stamps,
+                       std::span<const MatchResult> results,
+                       bool complete) {
+    if (capacity_ == 0 || results.size() > max_rows_) return;
+
+    if (auto found = index_.find(key.hash); found != index_.end()) {
+        erase(found->second);
+    }
+
+    Entry& entry = entries_.emplace_front();
+    entry.key = key;
+    entry.stamps.assign(stamps.begin(), stamps.end());
+    entry.rows = results.size();
+    entry.complete = complete;
+
+    const size_t vars = key.variables.size();
+    const size_t globs = key.globs.size();
+    entry.atoms.reserve(results.size() * (vars + 1));
+    entry.globs.reserve(results.size() * globs);
+
+    for (const MatchResult& result : results) {
+        entry.atoms.push_back(result.matched_atom);
+        for (const auto& name : key.variables) {
+            entry.atoms.push_back(result.bindings.get(name));
+        }
+        for (const auto& name : key.globs) {
+            auto it = result.bindings.globs.find(name);
+            entry.globs.push_back(it != result.bindings.globs.end()
+                ? std::optional<std::span<const AtomId>>(it->second)
+                : std::nullopt);
+        }
+    }
+
+    index_[key.hash] = entries_.begin();
+    ++stats_.insertions;
+    evict_to(capacity_);
+}
+
+size_t QueryCache::read(const Entry& entry,
+                        const PatternFingerprint& key,
+                        std::vector<MatchResult>& out,
+                        size_t limit) {
+    const size_t rows = std::min(entry.rows, limit);
+    const size_t vars = key.variables.size();
+    const size_t globs = key.globs.size();
+    const size_t stride = vars + 1;
+
+    if (out.size() < rows) out.resize(rows);
+
+    for (size_t row = 0; row < rows; ++row) {
+        MatchResult& result = out[row];
+        const AtomId* atoms = entry.atoms.data() + row * stride;
+        result.matched_atom = atoms[0];
+        result.confidence = 1.0f;
+
+        // Update in place when the maps already hold exactly these names
+        auto& bound = result.bindings.bindings;
+        size_t bound_count = 0;
+        for (size_t v = 0; v < vars; ++v) bound_count += atoms[v + 1].valid() ? 1 : 0;
+
+        bool reuse = bound.size() == bound_count;
+        for (size_t v = 0; v < vars && reuse; ++v) {
+            if (!atoms[v + 1].valid()) continue;
+            auto it = bound.find(key.variables[v]);
+            if (it == bound.end()) reuse = false;
+            else it->second = atoms[v + 1];
+        }
+        if (!reuse) {
+            bound.clear();
+            for (size_t v = 0; v < vars; ++v) {
+                if (atoms[v + 1].valid()) bound.emplace(key.variables[v], atoms[v + 1]);
+            }
+        }
+
+        auto& glob_map = result.bindings.globs;
+        glob_map.clear();
+        for (size_t g = 0; g < globs; ++g) {
+            const auto& span = entry.globs[row * globs + g];
+            if (span) glob_map.emplace(key.globs[g], *span);
+        }
+    }
+
+    out.resize(rows);
+    return rows;
+}
+
+// ============================================================================
+// Capacity
+// ============================================================================
+
+void QueryCache::set_capacity(size_t capacity) {
+    capacity_ = capacity;
+    evict_to(capacity_);
+}
+
+void QueryCache::clear() {
+    entries_.clear();
+    index_.clear();
+}
+
+void QueryCache::erase(std::list<Entry>::iterator it) {
+    index_.erase(it->key.hash);
+    entries_.erase(it);
+}
+
+void QueryCache::evict_to(size_t capacity) {
+    while (entries_.size() > capacity) {
+        erase(std::prev(entries_.end()));
+        ++stats_.evictions;
+    }
+}
+
+} // namespace opencog
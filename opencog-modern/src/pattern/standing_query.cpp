@@ -0,0 +1,404 @@
+/**
+ * @file standing_query.cpp
+ * @brief Incrementally maintained pattern queries
+ */
+
+#include <opencog/pattern/standing_query.hpp>
+
+#include <algorithm>
+
+namespace opencog {
+
+size_t QueryRegistry::KeyHash::operator()(const std::vector<AtomId>& key) const noexcept {
+    uint64_t h = key.size();
+    for (AtomId id : key) h = hash_combine(h, id.value);
+    return static_cast<size_t>(h);
+}
+
+QueryRegistry::QueryRegistry(AtomSpace& space)
+    : space_(space)
+{
+    space_.add_observer(this);
+}
+
+QueryRegistry::~QueryRegistry() {
+    space_.remove_observer(this);
+}
+
+// ============================================================================
+// Subscription
+// ============================================================================
+
+StandingQueryId QueryRegistry::subscribe(const Pattern& pattern,
+                                         QueryCallback callback,
+                                         QueryFilter filter) {
+    Pending pending;
+    pending.callback = callback;
+
+    StandingQueryId id;
+    {
+        std::lock_guard lock(mutex_);
+        id = next_id_++;
+
+        auto query = std::make_unique<Query>(id, space_);
+        query->callback = std::move(callback);
+        query->filter = std::move(filter);
+        query->engine.reset(pattern);
+        query->full_reevaluation = query->engine.has_negation();
+
+        evaluate_all(*query, pending);
+
+        // Register positive conjuncts in the alpha memory
+        Query* q = query.get();
+        if (q->full_reevaluation) {
+            full_queries_.push_back(q);
+        } else {
+            for (size_t c = 0; c < q->engine.conjunct_count(); ++c) {
+                AlphaEntry entry{q, static_cast<uint32_t>(c)};
+                if (auto type = q->engine.conjunct_type(c)) {
+                    alpha_[AlphaKey{*type, q->engine.conjunct_anchor(c)}].push_back(entry);
+                } else {
+                    alpha_wildcard_.push_back(entry);
+                }
+            }
+        }
+
+        queries_.emplace(id, std::move(query));
+    }
+
+    if (pending.callback) pending.callback(pending.added, pending.removed);
+    return id;
+}
+
+bool QueryRegistry::unsubscribe(StandingQueryId id) {
+    std::lock_guard lock(mutex_);
+
+    auto it = queries_.find(id);
+    if (it == queries_.end()) return false;
+
+    detach(*it->second);
+    queries_.erase(it);
+    return true;
+}
+
+void QueryRegistry::detach(Query& query) {
+    auto owned_by = [&](const AlphaEntry& e) { return e.query == &query; };
+
+    for (auto it = alpha_.begin(); it != alpha_.end();) {
+        std::erase_if(it->second, owned_by);
+        it = it->second.empty() ? alpha_.erase(it) : std::next(it);
+    }
+    std::erase_if(alpha_wildcard_, owned_by);
+    std::erase(full_queries_, &query);
+}
+
+// ============================================================================
+// Result Access
+// ============================================================================
+
+std::vector<MatchResult> QueryRegistry::results(StandingQueryId id) const {
+    std::lock_guard lock(mutex_);
+    std::vector<MatchResult> out;
+
+    auto it = queries_.find(id);
+    if (it == queries_.end()) return out;
+
+    out.reserve(it->second->visible);
+    for (const Entry& entry : it->second->entries) {
+        if (entry.live && entry.passed) out.push_back(entry.result);
+    }
+    return out;
+}
+
+size_t QueryRegistry::result_count(StandingQueryId id) const {
+    std::lock_guard lock(mutex_);
+    auto it = queries_.find(id);
+    return it != queries_.end() ? it->second->visible : 0;
+}
+
+size_t QueryRegistry::query_count() const {
+    std::lock_guard lock(mutex_);
+    return queries_.size();
+}
+
+// ============================================================================
+// Change Propagation
+// ============================================================================
+
+void QueryRegistry::on_atom_added(AtomId id) {
+    std::vector<Pending> pending;
+    {
+        std::lock_guard lock(mutex_);
+        if (queries_.empty()) return;
+
+        const auto& table = space_.atom_table();
+        const AtomType type = table.get_type(id);
+
+        // Alpha lookup: conjuncts keyed on this type, on this type plus
+        // one of the new link's members, or on no type at all.
+        scratch_hits_.clear();
+        auto gather = [&](AlphaKey key) {
+            auto it = alpha_.find(key);
+            if (it != alpha_.end()) {
+                scratch_hits_.insert(scratch_hits_.end(), it->second.begin(), it->second.end());
+            }
+        };
+
+        gather(AlphaKey{type, ATOM_NULL});
+        if (is_link(type)) {
+            auto outgoing = table.get_outgoing(id);
+            for (size_t i = 0; i < outgoing.size(); ++i) {
+                if (std::find(outgoing.begin(), outgoing.begin() + i, outgoing[i]) !=
+                    outgoing.begin() + i) {
+                    continue;
+                }
+                gather(AlphaKey{type, outgoing[i]});
+            }
+        }
+        scratch_hits_.insert(scratch_hits_.end(), alpha_wildcard_.begin(), alpha_wildcard_.end());
+
+        // Beta join: each hit re-runs its query with that conjunct pinned
+        // to the new atom, so only matches that contain it are explored.
+        std::vector<std::pair<Query*, size_t>> slots;
+        auto slot_for = [&](Query* query) -> Pending& {
+            for (auto& [q, index] : slots) {
+                if (q == query) return pending[index];
+            }
+            slots.emplace_back(query, pending.size());
+            pending.push_back(Pending{query->callback, {}, {}});
+            return pending.back();
+        };
+
+        for (const AlphaEntry& hit : scratch_hits_) {
+            Query& query = *hit.query;
+            Pending& out = slot_for(&query);
+
+            query.engine.restart();
+            query.engine.pin(hit.conjunct, id);
+            while (query.engine.next()) {
+                insert_current(query, out);
+            }
+        }
+
+        for (Query* query : full_queries_) {
+            evaluate_all(*query, slot_for(query));
+        }
+    }
+
+    deliver(pending);
+}
+
+void QueryRegistry::on_atom_removed(AtomId id) {
+    std::vector<Pending> pending;
+    {
+        std::lock_guard lock(mutex_);
+
+        for (auto& [qid, query] : queries_) {
+            auto it = query->by_atom.find(id);
+            if (!query->full_reevaluation && it == query->by_atom.end()) continue;
+
+            Pending out{query->callback, {}, {}};
+            if (query->full_reevaluation) {
+                evaluate_all(*query, out);
+            } else {
+                // erase_entry edits this list, so work from a copy
+                std::vector<uint32_t> doomed = it->second;
+                for (uint32_t index : doomed) erase_entry(*query, index, out);
+            }
+
+            if (!out.added.empty() || !out.removed.empty()) {
+                pending.push_back(std::move(out));
+            }
+        }
+    }
+
+    deliver(pending);
+}
+
+void QueryRegistry::on_tv_changed(AtomId id, TruthValue /*old_tv*/) {
+    std::vector<Pending> pending;
+    {
+        std::lock_guard lock(mutex_);
+
+        // Only filters can observe truth values; unfiltered result sets
+        // depend on structure alone.
+        for (auto& [qid, query] : queries_) {
+            if (!query->filter) continue;
+
+            auto it = query->by_atom.find(id);
+            if (it == query->by_atom.end()) continue;
+
+            Pending out{query->callback, {}, {}};
+            for (uint32_t index : it->second) {
+                Entry& entry = query->entries[index];
+                const bool passed = passes(*query, entry.result);
+                if (passed == entry.passed) continue;
+
+                entry.passed = passed;
+                if (passed) {
+                    ++query->visible;
+                    out.added.push_back(entry.result);
+                } else {
+                    --query->visible;
+                    out.removed.push_back(entry.result);
+                }
+            }
+
+            if (!out.added.empty() || !out.removed.empty()) {
+                pending.push_back(std::move(out));
+            }
+        }
+    }
+
+    deliver(pending);
+}
+
+void QueryRegistry::on_clear() {
+    std::vector<Pending> pending;
+    {
+        std::lock_guard lock(mutex_);
+
+        // Conjuncts anchored on a grounded atom can never fire again
+        std::erase_if(alpha_, [](const auto& slot) { return slot.first.anchor.valid(); });
+
+        for (auto& [qid, query] : queries_) {
+            Pending out{query->callback, {}, {}};
+            for (Entry& entry : query->entries) {
+                if (!entry.live || !entry.passed) continue;
+                entry.result.bindings.globs.clear();
+                out.removed.push_back(std::move(entry.result));
+            }
+
+            query->entries.clear();
+            query->free_entries.clear();
+            query->by_key.clear();
+            query->by_atom.clear();
+            query->visible = 0;
+
+            // A negated conjunct can hold in the empty space
+            if (query->full_reevaluation) evaluate_all(*query, out);
+
+            if (!out.added.empty() || !out.removed.empty()) {
+                pending.push_back(std::move(out));
+            }
+        }
+    }
+
+    deliver(pending);
+}
+
+void QueryRegistry::deliver(std::vector<Pending>& pending) {
+    for (Pending& p : pending) {
+        if (p.callback && (!p.added.empty() || !p.removed.empty())) {
+            p.callback(p.added, p.removed);
+        }
+    }
+}
+
+// ============================================================================
+// Beta Memory
+// ============================================================================
+
+void QueryRegistry::build_key(const MatchEngine& engine, std::vector<AtomId>& key) const {
+    key.clear();
+    auto clause = engine.clause_atoms();
+    key.insert(key.end(), clause.begin(), clause.end());
+    for (size_t slot = 0; slot < engine.variable_names().size(); ++slot) {
+        key.push_back(engine.value(static_cast<uint32_t>(slot)));
+    }
+}
+
+bool QueryRegistry::insert_current(Query& query, Pending& pending) {
+    build_key(query.engine, scratch_key_);
+
+    auto found = query.by_key.find(scratch_key_);
+    if (found != query.by_key.end()) {
+        query.entries[found->second].epoch = query.epoch;
+        return false;
+    }
+
+    uint32_t index;
+    if (!query.free_entries.empty()) {
+        index = query.free_entries.back();
+        query.free_entries.pop_back();
+    } else {
+        index = static_cast<uint32_t>(query.entries.size());
+        query.entries.emplace_back();
+    }
+
+    Entry& entry = query.entries[index];
+    entry.key = scratch_key_;
+    entry.live = true;
+    entry.epoch = query.epoch;
+    query.engine.materialize(entry.result);
+
+    // Index the match under every atom it binds
+    entry.atoms.clear();
+    auto note = [&](AtomId atom) {
+        if (atom.valid() && std::find(entry.atoms.begin(), entry.atoms.end(), atom) == entry.atoms.end()) {
+            entry.atoms.push_back(atom);
+        }
+    };
+    for (AtomId atom : entry.key) note(atom);
+    for (const auto& [name, atoms] : entry.result.bindings.globs) {
+        for (AtomId atom : atoms) note(atom);
+    }
+    for (AtomId atom : entry.atoms) query.by_atom[atom].push_back(index);
+
+    query.by_key.emplace(entry.key, index);
+
+    entry.passed = passes(query, entry.result);
+    if (entry.passed) {
+        ++query.visible;
+        pending.added.push_back(entry.result);
+    }
+    return true;
+}
+
+void QueryRegistry::erase_entry(Query& query, uint32_t index, Pending& pending) {
+    Entry& entry = query.entries[index];
+    if (!entry.live) return;
+
+    for (AtomId atom : entry.atoms) {
+        auto it = query.by_atom.find(atom);
+        if (it == query.by_atom.end()) continue;
+        std::erase(it->second, index);
+        if (it->second.empty()) query.by_atom.erase(it);
+    }
+    query.by_key.erase(entry.key);
+
+    if (entry.passed) {
+        --query.visible;
+        // Glob spans point into outgoing sets that may already be freed
+        entry.result.bindings.globs.clear();
+        pending.removed.push_back(std::move(entry.result));
+    }
+
+    entry.live = false;
+    entry.passed = false;
+    entry.result = MatchResult{};
+    query.free_entries.push_back(index);
+}
+
+void QueryRegistry::evaluate_all(Query& query, Pending& pending) {
+    ++query.epoch;
+
+    query.engine.restart();
+    while (query.engine.next()) {
+        insert_current(query, pending);
+    }
+
+    // Mark-sweep: anything the full evaluation did not see is gone
+    for (uint32_t index = 0; index < query.entries.size(); ++index) {
+        const Entry& entry = query.entries[index];
+        if (entry.live && entry.epoch != query.epoch) {
+            erase_entry(query, index, pending);
+        }
+    }
+}
+
+bool QueryRegistry::passes(const Query& query, const MatchResult& result) const {
+    return !query.filter || query.filter(space_, result);
+}
+
+} // namespace opencog
@@ -8,6 +8,71 @@
 namespace opencog::pln {
 
 // Most formulas are inline in the header for performance
-// This file exists for any future non-inline implementations
+
+namespace {
+
+/// Truth values transposed per stack block in the AoS batch wrappers
+constexpr size_t TRANSPOSE_BLOCK = 256;
+
+} // namespace
+
+void batch_deduction(
+    std::span<const TruthValue> ab,
+    std::span<const TruthValue> bc,
+    std::span<const float> sB,
+    std::span<const float> sC,
+    std::span<TruthValue> out
+) {
+    const size_t n = std::min({ab.size(), bc.size(), sB.size(), sC.size(), out.size()});
+
+    alignas(CACHE_LINE_SIZE) float sAB[TRANSPOSE_BLOCK], cAB[TRANSPOSE_BLOCK];
+    alignas(CACHE_LINE_SIZE) float sBC[TRANSPOSE_BLOCK], cBC[TRANSPOSE_BLOCK];
+    alignas(CACHE_LINE_SIZE) float sAC[TRANSPOSE_BLOCK], cAC[TRANSPOSE_BLOCK];
+
+    for (size_t base = 0; base < n; base += TRANSPOSE_BLOCK) {
+        const size_t m = std::min(TRANSPOSE_BLOCK, n - base);
+        for (size_t i = 0; i < m; ++i) {
+            sAB[i] = ab[base + i].strength;
+            cAB[i] = ab[base + i].confidence;
+            sBC[i] = bc[base + i].strength;
+            cBC[i] = bc[base + i].confidence;
+        }
+
+        kernels::deduction(sAB, cAB, sBC, cBC, sB.data() + base, sC.data() + base,
+                           sAC, cAC, m);
+
+        for (size_t i = 0; i < m; ++i) {
+            out[base + i] = TruthValue{sAC[i], cAC[i]};
+        }
+    }
+}
+
+void batch_revision(
+    std::span<const TruthValue> tv1,
+    std::span<const TruthValue> tv2,
+    std::span<TruthValue> out
+) {
+    const size_t n = std::min({tv1.size(), tv2.size(), out.size()});
+
+    alignas(CACHE_LINE_SIZE) float s1[TRANSPOSE_BLOCK], c1[TRANSPOSE_BLOCK];
+    alignas(CACHE_LINE_SIZE) float s2[TRANSPOSE_BLOCK], c2[TRANSPOSE_BLOCK];
+    alignas(CACHE_LINE_SIZE) float s_out[TRANSPOSE_BLOCK], c_out[TRANSPOSE_BLOCK];
+
+    for (size_t base = 0; base < n; base += TRANSPOSE_BLOCK) {
+        const size_t m = std::min(TRANSPOSE_BLOCK, n - base);
+        for (size_t i = 0; i < m; ++i) {
+            s1[i] = tv1[base + i].strength;
+            c1[i] = tv1[base + i].confidence;
+            s2[i] = tv2[base + i].strength;
+            c2[i] = tv2[base + i].confidence;
+        }
+
+        kernels::revision(s1, c1, s2, c2, s_out, c_out, m);
+
+        for (size_t i = 0; i < m; ++i) {
+            out[base + i] = TruthValue{s_out[i], c_out[i]};
+        }
+    }
+}
 
 } // namespace opencog::pln
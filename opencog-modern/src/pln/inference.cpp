@@ -4,8 +4,17 @@
  */
 
 #include <opencog/pln/inference.hpp>
+#include <opencog/pln/static_rules.hpp>
 
 #include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <optional>
+#include <condition_variable>
+#include <random>
+#include <thread>
+#include <unordered_map>
 
 namespace opencog::pln {
 
@@ -15,35 +24,111 @@ namespace opencog::pln {
 
 namespace rules {
 
-InferenceRule make_deduction_rule() {
-    InferenceRule rule;
-    rule.name = "deduction";
-    rule.priority = 1.0f;
-    // Full implementation would set up patterns and formulas
-    return rule;
+namespace {
+
+Handle add_inheritance(AtomSpace& space, AtomId from, AtomId to, bool* created) {
+    if (created) *created = false;
+    if (!from.valid() || !to.valid()) return Handle{};
+    AtomId out[2] = {from, to};
+    return space.add_link(AtomType::INHERITANCE_LINK, std::span<const AtomId>(out),
+                          TruthValue::default_tv(), created);
 }
 
-InferenceRule make_inversion_rule() {
-    InferenceRule rule;
-    rule.name = "inversion";
-    rule.priority = 0.8f;
-    return rule;
+Pattern inheritance_pattern(std::vector<std::string> variables, const char* from, const char* to) {
+    Pattern pattern;
+    pattern.variables = std::move(variables);
+    pattern.body = link(AtomType::INHERITANCE_LINK, {var(from), var(to)});
+    return pattern;
 }
 
-InferenceRule make_modus_ponens_rule() {
-    InferenceRule rule;
-    rule.name = "modus-ponens";
-    rule.priority = 1.0f;
-    return rule;
+} // namespace
+
+Pattern Deduction::premises() {
+    Pattern pattern;
+    pattern.variables = {"A", "B", "C"};
+    pattern.body = and_pattern({
+        link(AtomType::INHERITANCE_LINK, {var("A"), var("B")}),
+        link(AtomType::INHERITANCE_LINK, {var("B"), var("C")})
+    });
+    return pattern;
 }
 
-InferenceRule make_abduction_rule() {
-    InferenceRule rule;
-    rule.name = "abduction";
-    rule.priority = 0.6f;
-    return rule;
+Pattern Deduction::conclusion() {
+    return inheritance_pattern({"A", "C"}, "A", "C");
+}
+
+Handle Deduction::conclude(AtomSpace& space, const BindingSet& bindings, bool* created) {
+    return add_inheritance(space, bindings.get("A"), bindings.get("C"), created);
+}
+
+bool Deduction::applicable(const AtomSpace&, const BindingSet& bindings) {
+    return bindings.get("A") != bindings.get("C");
+}
+
+Pattern Inversion::premises() {
+    return inheritance_pattern({"A", "B"}, "A", "B");
+}
+
+Pattern Inversion::conclusion() {
+    return inheritance_pattern({"A", "B"}, "B", "A");
+}
+
+Handle Inversion::conclude(AtomSpace& space, const BindingSet& bindings, bool* created) {
+    return add_inheritance(space, bindings.get("B"), bindings.get("A"), created);
+}
+
+bool Inversion::applicable(const AtomSpace&, const BindingSet& bindings) {
+    return bindings.get("A") != bindings.get("B");
+}
+
+Pattern ModusPonens::premises() {
+    Pattern pattern;
+    pattern.variables = {"A", "B"};
+    pattern.body = link(AtomType::IMPLICATION_LINK, {var("A"), var("B")});
+    return pattern;
 }
 
+Pattern ModusPonens::conclusion() {
+    Pattern pattern;
+    pattern.variables = {"B"};
+    pattern.body = var("B");
+    return pattern;
+}
+
+// The conclusion is B itself, revised with the derived evidence
+Handle ModusPonens::conclude(AtomSpace& space, const BindingSet& bindings, bool* created) {
+    if (created) *created = false;
+    AtomId b = bindings.get("B");
+    return space.contains(b) ? space.make_handle(b) : Handle{};
+}
+
+Pattern Abduction::premises() {
+    Pattern pattern;
+    pattern.variables = {"A", "B", "C"};
+    pattern.body = and_pattern({
+        link(AtomType::INHERITANCE_LINK, {var("A"), var("B")}),
+        link(AtomType::INHERITANCE_LINK, {var("C"), var("B")})
+    });
+    return pattern;
+}
+
+Pattern Abduction::conclusion() {
+    return inheritance_pattern({"A", "C"}, "A", "C");
+}
+
+Handle Abduction::conclude(AtomSpace& space, const BindingSet& bindings, bool* created) {
+    return add_inheritance(space, bindings.get("A"), bindings.get("C"), created);
+}
+
+bool Abduction::applicable(const AtomSpace&, const BindingSet& bindings) {
+    return bindings.get("A") != bindings.get("C");
+}
+
+InferenceRule make_deduction_rule() { return make_rule<Deduction>(); }
+InferenceRule make_inversion_rule() { return make_rule<Inversion>(); }
+InferenceRule make_modus_ponens_rule() { return make_rule<ModusPonens>(); }
+InferenceRule make_abduction_rule() { return make_rule<Abduction>(); }
+
 InferenceRule make_and_rule() {
     InferenceRule rule;
     rule.name = "and-introduction";
@@ -84,144 +169,876 @@ std::vector<InferenceRule> get_standard_rules() {
 // ============================================================================
 
 PLNEngine::PLNEngine(AtomSpace& space, InferenceConfig config)
+    : PLNEngine(space, config,
+                std::make_shared<InferenceCache>(config.cache_capacity,
+                                                 InferenceCache::DEFAULT_SHARDS,
+                                                 config.proof_bytes))
+{
+}
+
+PLNEngine::PLNEngine(AtomSpace& space, InferenceConfig config,
+                     std::shared_ptr<InferenceCache> cache)
     : space_(space)
     , config_(std::move(config))
     , matcher_(space_)
+    , inference_cache_(std::move(cache))
+    , goal_engine_(space_)
 {
 }
 
 void PLNEngine::add_rule(InferenceRule rule) {
     rules_.push_back(std::move(rule));
+    compiled_stale_ = true;
+    ++rules_version_;
 }
 
 void PLNEngine::add_rules(std::vector<InferenceRule> rules) {
     for (auto& rule : rules) {
         rules_.push_back(std::move(rule));
     }
+    compiled_stale_ = true;
+    ++rules_version_;
 }
 
 void PLNEngine::clear_rules() {
     rules_.clear();
+    compiled_stale_ = true;
+    ++rules_version_;
 }
 
+// ============================================================================
+// Firing Set
+// ============================================================================
+
+bool FiringSet::insert(uint32_t rule, std::span<const AtomId> premises) {
+    uint64_t key = rule;
+    for (AtomId p : premises) key = hash_combine(key, p.value);
+
+    auto [first, last] = by_hash_.equal_range(key);
+    for (auto it = first; it != last; ++it) {
+        const Firing& f = firings_[it->second];
+        if (f.rule == rule && std::ranges::equal(
+                std::span<const AtomId>(premises_).subspan(f.offset, f.count), premises)) {
+            return false;
+        }
+    }
+
+    by_hash_.emplace(key, static_cast<uint32_t>(firings_.size()));
+    firings_.push_back(Firing{rule, static_cast<uint32_t>(premises_.size()),
+                              static_cast<uint32_t>(premises.size())});
+    premises_.insert(premises_.end(), premises.begin(), premises.end());
+    return true;
+}
+
+void FiringSet::clear() {
+    premises_.clear();
+    firings_.clear();
+    by_hash_.clear();
+}
+
+// ============================================================================
+// Forward Chaining
+// ============================================================================
+
 std::vector<InferenceResult> PLNEngine::forward_chain(Handle source) {
-    std::vector<InferenceResult> results;
+    return forward_chain(std::span<const Handle>(&source, 1));
+}
 
-    if (!source.valid()) return results;
+std::vector<InferenceResult> PLNEngine::forward_chain(std::span<const Handle> sources) {
+    compile_rules();
+    return run_forward(seed_delta(sources), config_.max_iterations);
+}
 
-    size_t iterations = 0;
-    std::vector<Handle> frontier{source};
-    std::unordered_set<uint64_t> visited;
+std::vector<InferenceResult> PLNEngine::forward_chain_all() {
+    compile_rules();
 
-    while (!frontier.empty() && iterations < config_.max_iterations) {
-        Handle current = frontier.back();
-        frontier.pop_back();
+    std::vector<AtomId> delta;
+    if (!premise_wildcard_.empty()) {
+        AtomCursor cursor(space_.atom_table());
+        for (auto batch = cursor.next_batch(); !batch.empty(); batch = cursor.next_batch()) {
+            delta.insert(delta.end(), batch.begin(), batch.end());
+        }
+    } else {
+        for (const auto& [type, slots] : premise_index_) {
+            space_.indices().type_index.collect(type, delta);
+        }
+    }
+    return run_forward(std::move(delta), config_.max_iterations);
+}
+
+std::vector<InferenceResult> PLNEngine::forward_step(Handle source) {
+    compile_rules();
+    return run_forward(seed_delta(std::span<const Handle>(&source, 1)), 1);
+}
 
-        uint64_t hash = current.id().value;
-        if (visited.contains(hash)) continue;
-        visited.insert(hash);
+std::vector<InferenceResult> PLNEngine::sample_forward(const AttentionBank& bank,
+                                                      const SamplingBudget& budget) {
+    compile_rules();
+    const auto& table = space_.atom_table();
+    const auto start = std::chrono::steady_clock::now();
 
-        // Try each rule
-        for (const auto& rule : rules_) {
-            // Skip if rule doesn't meet confidence threshold
-            // Full implementation would check rule applicability
+    auto consumable = [&](AtomType type) {
+        return !premise_wildcard_.empty() || premise_index_.contains(type);
+    };
 
-            auto step_results = forward_step(current);
-            for (auto& result : step_results) {
-                results.push_back(std::move(result));
+    // Candidate premises weighted by STI: links in focus carry their own,
+    // nodes in focus share theirs among the links they appear in
+    std::vector<AtomId> candidates;
+    std::vector<float> weights;
+    std::unordered_map<AtomId, size_t> slot_of;
+    auto add = [&](AtomId id, float weight) {
+        auto [it, fresh] = slot_of.try_emplace(id, candidates.size());
+        if (fresh) {
+            candidates.push_back(id);
+            weights.push_back(weight);
+        } else {
+            weights[it->second] += weight;
+        }
+    };
 
-                // Check if target reached
-                if (config_.target_reached && config_.target_reached(results.back().conclusion)) {
-                    return results;
-                }
+    std::vector<AtomId> links;
+    for (AtomId id : bank.get_attentional_focus()) {
+        const float sti = table.get_av(id).sti;
+        if (config_.use_attention && sti < config_.attention_threshold) continue;
+        const float weight = std::max(sti, 0.0f);
 
-                // Add conclusion to frontier
-                if (results.size() < config_.max_results) {
-                    frontier.push_back(results.back().conclusion);
-                }
-            }
+        const AtomType type = table.get_type(id);
+        if (is_link(type)) {
+            if (consumable(type)) add(id, weight);
+            continue;
+        }
+        links.clear();
+        for (AtomId link : table.get_incoming(id)) {
+            if (consumable(table.get_type(link))) links.push_back(link);
         }
+        for (AtomId link : links) add(link, weight / static_cast<float>(links.size()));
+    }
 
-        ++iterations;
-        ++total_inferences_;
+    std::vector<InferenceResult> results;
+    if (candidates.empty()) return results;
+
+    // Expand premises drawn by weight, without replacement, until the
+    // budget runs out
+    WeightedSampler sampler(weights);
+    std::mt19937_64 rng(budget.seed);
+    FiringSet fired;
+    std::vector<Derivation> derived;
+    size_t evaluations = 0;
+    size_t sampled = 0;
+
+    const auto deadline = budget.max_time.count() > 0
+        ? start + budget.max_time : std::chrono::steady_clock::time_point::max();
+    while (sampler.live() > 0 && evaluations < budget.max_evaluations) {
+        if (std::chrono::steady_clock::now() >= deadline) break;
+        const size_t i = sampler.sample(rng);
+        sampler.remove(i);
+        ++sampled;
+        evaluations += match_delta(std::span<const AtomId>(&candidates[i], 1), fired, derived,
+                                   budget.max_evaluations - evaluations, deadline);
     }
 
+    // Commit the most confident derivations first, so max_results keeps
+    // the best of what was found
+    std::ranges::stable_sort(derived, std::ranges::greater{},
+                             [](const Derivation& d) { return d.tv.confidence; });
+    std::vector<AtomId> created;
+    commit_round(derived, 0, results, created);
+
+    std::ranges::stable_sort(results, std::ranges::greater{},
+                             [](const InferenceResult& r) { return r.truth_value.confidence; });
+    for (auto& result : results) result.iterations_used = sampled;
     return results;
 }
 
-std::vector<InferenceResult> PLNEngine::forward_chain(std::span<const Handle> sources) {
-    std::vector<InferenceResult> all_results;
+void PLNEngine::compile_rules() {
+    if (!compiled_stale_) return;
+
+    compiled_.clear();
+    premise_index_.clear();
+    premise_wildcard_.clear();
+    goal_types_.clear();
+    goal_wildcard_ = false;
+
+    for (uint32_t r = 0; r < rules_.size(); ++r) {
+        const InferenceRule& rule = rules_[r];
+        const auto* grounded = std::get_if<GroundedTerm>(&rule.premise_pattern.body);
+        if ((!rule.formula && !rule.kernel) || !rule.conclusion_template ||
+            (grounded && !grounded->atom.valid())) {
+            continue;
+        }
+
+        auto compiled = std::make_unique<CompiledRule>(r, space_);
+        compiled->engine.reset(rule.premise_pattern);
+        for (const auto& name : rule.premise_pattern.variables) {
+            auto slot = compiled->engine.slot_of(name);
+            compiled->var_slots.push_back(slot ? *slot : UINT32_MAX);
+        }
+        if (rule.kernel &&
+            rule.arity == compiled->engine.conjunct_count() + compiled->var_slots.size()) {
+            compiled->kernel = rule.kernel;
+        }
+        if (!compiled->kernel && !rule.formula) continue;
+        if (rule.conclusion_pattern) {
+            compiled->conclusion.reset(*rule.conclusion_pattern);
+            compiled->backward = compiled->conclusion.conjunct_count() == 1;
+        }
+
+        const auto index = static_cast<uint32_t>(compiled_.size());
+        for (size_t c = 0; c < compiled->engine.conjunct_count(); ++c) {
+            PremiseSlot slot{index, static_cast<uint32_t>(c)};
+            if (auto type = compiled->engine.conjunct_type(c)) {
+                premise_index_[*type].push_back(slot);
+                if (compiled->backward) goal_types_.push_back(*type);
+            } else {
+                premise_wildcard_.push_back(slot);
+                goal_wildcard_ = goal_wildcard_ || compiled->backward;
+            }
+        }
+        compiled_.push_back(std::move(compiled));
+    }
+    std::ranges::sort(goal_types_);
+    goal_types_.erase(std::ranges::unique(goal_types_).begin(), goal_types_.end());
+
+    rule_ids_.clear();
+    for (const InferenceRule& rule : rules_) {
+        rule_ids_.push_back(inference_cache_->proofs()->intern(rule.name));
+    }
+
+    rules_fingerprint_ = rules_.size();
+    for (const InferenceRule& rule : rules_) {
+        rules_fingerprint_ = hash_combine(rules_fingerprint_, std::hash<std::string>{}(rule.name));
+        rules_fingerprint_ = hash_combine(rules_fingerprint_, std::bit_cast<uint32_t>(rule.priority));
+    }
+
+    compiled_stale_ = false;
+}
+
+std::vector<AtomId> PLNEngine::seed_delta(std::span<const Handle> sources) const {
+    const auto& table = space_.atom_table();
+    std::vector<AtomId> delta;
+    std::unordered_set<AtomId> seen;
+
+    auto add = [&](AtomId id) {
+        if (seen.insert(id).second) delta.push_back(id);
+    };
 
     for (Handle source : sources) {
-        auto results = forward_chain(source);
-        for (auto& r : results) {
-            all_results.push_back(std::move(r));
+        if (!source.valid() || !space_.contains(source.id())) continue;
+        if (is_link(table.get_type(source.id()))) {
+            add(source.id());
+        } else {
+            for (AtomId link : table.get_incoming(source.id())) add(link);
         }
     }
+    return delta;
+}
 
-    return all_results;
+namespace {
+
+/**
+ * @brief Distinct conclusion of a round with its merged evidence
+ */
+struct Conclusion {
+    Handle atom;
+    TruthValue tv;
+    bool created = false;
+    std::vector<const ProofNode*> steps;
+};
+
+/**
+ * @brief Find the atom a conclusion pattern denotes without creating it
+ * @return The atom, ATOM_NULL if it does not exist yet, or nullopt when the
+ *         term is not a plain ordered structure over bound variables
+ */
+std::optional<AtomId> find_conclusion(const AtomSpace& space, const PatternTerm& term,
+                                      const BindingSet& bindings) {
+    if (const auto* v = std::get_if<VariableTerm>(&term)) {
+        AtomId bound = bindings.get(v->name);
+        if (!bound.valid()) return std::nullopt;
+        return space.contains(bound) ? bound : ATOM_NULL;
+    }
+    if (const auto* g = std::get_if<GroundedTerm>(&term)) {
+        return space.contains(g->atom) ? g->atom : ATOM_NULL;
+    }
+    const auto* l = std::get_if<std::shared_ptr<LinkPattern>>(&term);
+    if (!l || !(*l)->ordered) return std::nullopt;
+
+    std::vector<AtomId> outgoing;
+    outgoing.reserve((*l)->outgoing.size());
+    bool missing = false;
+    for (const PatternTerm& child : (*l)->outgoing) {
+        auto found = find_conclusion(space, child, bindings);
+        if (!found) return std::nullopt;
+        missing |= !found->valid();
+        outgoing.push_back(*found);
+    }
+    if (missing) return ATOM_NULL;
+    return space.atom_table().get_link((*l)->type, outgoing);
 }
 
-std::vector<InferenceResult> PLNEngine::forward_step(Handle source) {
+} // namespace
+
+void PLNEngine::match(std::span<const Handle> sources, std::vector<Derivation>& out) {
+    compile_rules();
+    FiringSet fired;
+    match_delta(seed_delta(sources), fired, out);
+}
+
+std::vector<InferenceResult> PLNEngine::commit(std::span<const Derivation> derived,
+                                               std::vector<AtomId>* created) {
+    compile_rules();
+    std::vector<InferenceResult> results;
+    std::vector<AtomId> fresh;
+    commit_round(derived, 0, results, created ? *created : fresh);
+    return results;
+}
+
+std::vector<InferenceResult> PLNEngine::run_forward(std::vector<AtomId> delta, size_t max_rounds) {
     std::vector<InferenceResult> results;
 
-    // For each rule, try to apply it
-    for (const auto& rule : rules_) {
-        // Pattern match to find applicable instances
-        // This is a simplified implementation
+    // Rule firings already made this run
+    FiringSet fired;
 
-        // For example, for deduction:
-        // Find all A->B where A = source
-        // Then find all B->C for those B
-        // Compute A->C
+    std::vector<Derivation> derived;
+    std::vector<AtomId> next_delta;
 
-        // Placeholder - would need full pattern matching
+    for (size_t round = 0; round < max_rounds && !delta.empty(); ++round) {
+        derived.clear();
+        match_delta(delta, fired, derived);
+
+        next_delta.clear();
+        if (commit_round(derived, round, results, next_delta)) break;
+        delta.swap(next_delta);
     }
 
     return results;
 }
 
-std::optional<InferenceResult> PLNEngine::backward_chain(Handle target) {
-    if (!target.valid()) return std::nullopt;
+size_t PLNEngine::match_delta(std::span<const AtomId> delta,
+                              FiringSet& fired,
+                              std::vector<Derivation>& out,
+                              size_t max_evaluations,
+                              std::chrono::steady_clock::time_point deadline) {
+    const auto& table = space_.atom_table();
+    std::vector<TruthValue> premise_tvs;
+    MatchResult scratch;
+    size_t evaluations = 0;
+
+    // A hub atom can pin a conjunct with many matches, so the deadline is
+    // checked per match, not only between delta atoms
+    const bool timed = deadline != std::chrono::steady_clock::time_point::max();
+    bool expired = false;
+
+    // Every rule conjunct the delta atom can satisfy is pinned to it, so
+    // only premise sets containing new atoms are seen. Nothing is written.
+    for (AtomId atom : delta) {
+        const AtomType type = table.get_type(atom);
+        if (type == AtomType::INVALID) continue;
+
+        auto visit = [&](const PremiseSlot& slot) {
+            CompiledRule& compiled = *compiled_[slot.rule];
+            const InferenceRule& rule = rules_[compiled.rule];
+            MatchEngine& engine = compiled.engine;
+
+            engine.restart();
+            engine.pin(slot.conjunct, atom);
+            while (!expired && evaluations < max_evaluations && engine.next()) {
+                if (timed && std::chrono::steady_clock::now() >= deadline) {
+                    expired = true;
+                    break;
+                }
+                auto premises = engine.clause_atoms();
+                if (!fired.insert(compiled.rule, premises)) continue;
+
+                engine.materialize(scratch);
+                if (rule.applicable && !rule.applicable(space_, scratch.bindings)) continue;
+
+                auto var_tv = [&](uint32_t s) {
+                    return s != UINT32_MAX ? table.get_tv(engine.value(s)) : TruthValue{};
+                };
+
+                // Static rules read a fixed array on the stack
+                TruthValue tv;
+                if (compiled.kernel) {
+                    std::array<TruthValue, MAX_RULE_ARITY> fixed;
+                    size_t n = 0;
+                    for (AtomId p : premises) fixed[n++] = table.get_tv(p);
+                    for (uint32_t s : compiled.var_slots) fixed[n++] = var_tv(s);
+                    tv = compiled.kernel(std::span<const TruthValue>(fixed.data(), n));
+                } else {
+                    premise_tvs.clear();
+                    for (AtomId p : premises) premise_tvs.push_back(table.get_tv(p));
+                    for (uint32_t s : compiled.var_slots) premise_tvs.push_back(var_tv(s));
+                    tv = rule.formula(premise_tvs);
+                }
+                ++total_inferences_;
+                ++evaluations;
+                if (tv.confidence < config_.min_confidence) continue;
+
+                out.push_back(Derivation{
+                    compiled.rule,
+                    std::vector<AtomId>(premises.begin(), premises.end()),
+                    scratch.bindings,
+                    tv
+                });
+            }
+        };
 
-    // For backward chaining:
-    // 1. Check if target is already known (grounded)
-    // 2. Find rules whose conclusion can unify with target
-    // 3. Recursively prove premises
+        if (auto it = premise_index_.find(type); it != premise_index_.end()) {
+            for (const PremiseSlot& slot : it->second) visit(slot);
+        }
+        for (const PremiseSlot& slot : premise_wildcard_) visit(slot);
+        if (expired) break;
+    }
+    return evaluations;
+}
+
+bool PLNEngine::commit_round(std::span<const Derivation> derived, size_t round,
+                             std::vector<InferenceResult>& results,
+                             std::vector<AtomId>& created) {
+    // Apply phase: instantiate conclusions, merging derivations of the
+    // same atom by revision. Once max_results or the target is reached,
+    // only derivations of conclusions already taken are merged; nothing
+    // is created that would not be written back.
+    std::vector<Conclusion> conclusions;
+    std::unordered_map<AtomId, size_t> conclusion_of;
+    const auto proofs = inference_cache_->proof_generation();
+    bool done = results.size() >= config_.max_results;
+
+    for (const Derivation& d : derived) {
+        const InferenceRule& rule = rules_[d.rule];
+
+        // Rules with a conclusion pattern are looked up first, so existing
+        // atoms skip the template and missing ones are only made if taken
+        std::optional<AtomId> known;
+        if (rule.conclusion_pattern) {
+            known = find_conclusion(space_, rule.conclusion_pattern->body, d.bindings);
+        }
+
+        Handle h;
+        bool fresh = false;
+        if (known && known->valid()) {
+            h = space_.make_handle(*known);
+        } else {
+            if (done) continue;
+            h = rule.conclusion_template(space_, d.bindings, &fresh);
+        }
+        if (!h.valid()) continue;
+
+        auto [it, first] = conclusion_of.try_emplace(h.id(), conclusions.size());
+        if (first) {
+            if (done) {
+                conclusion_of.erase(it);
+                continue;
+            }
+            conclusions.push_back(Conclusion{h, d.tv, fresh, {}});
+            done = results.size() + conclusions.size() >= config_.max_results ||
+                   (config_.target_reached && config_.target_reached(h));
+        } else {
+            Conclusion& c = conclusions[it->second];
+            c.tv = revision(c.tv, d.tv);
+            c.created = c.created || fresh;
+        }
+
+        if (config_.record_proof) {
+            conclusions[it->second].steps.push_back(
+                proofs->add(rule_ids_[d.rule], h.id(), d.tv, d.premises));
+        }
+    }
+
+    // Write-back: new atoms take the merged value and form the next
+    // delta; existing ones are revised with it
+    for (Conclusion& c : conclusions) {
+        TruthValue tv = c.created ? c.tv : revision(space_.get_tv(c.atom), c.tv);
+        space_.set_tv(c.atom, tv);
+        if (c.created) created.push_back(c.atom.id());
 
-    // Check if grounded
-    TruthValue tv = space_.get_tv(target);
-    if (tv.confidence > config_.min_confidence) {
         InferenceResult result;
-        result.conclusion = target;
+        result.conclusion = c.atom;
         result.truth_value = tv;
-        result.iterations_used = 0;
-        return result;
+        result.proof = proof_ref(proofs, proofs->merge(c.steps));
+        result.iterations_used = round + 1;
+        results.push_back(std::move(result));
+    }
+    return done;
+}
+
+// ============================================================================
+// Bulk Inference
+// ============================================================================
+
+namespace {
+
+/// Premise pairs per SoA block; sized so a block's buffers stay in L2
+constexpr size_t DEDUCTION_BLOCK = 4096;
+
+/**
+ * @brief Premise ids of a block of pairs plus reusable SoA scratch
+ *
+ * Pairs are recorded as ids; run() gathers their truth values column by
+ * column straight from the atom table and calls the SoA kernel.
+ */
+struct DeductionBlock {
+    std::vector<AtomId> from, ab, b, bc, to;
+    TVBuffer ab_tv{DEDUCTION_BLOCK}, bc_tv{DEDUCTION_BLOCK}, ac_tv{DEDUCTION_BLOCK};
+    SimdVector<float> sB{DEDUCTION_BLOCK}, sC{DEDUCTION_BLOCK};
+
+    DeductionBlock() {
+        for (auto* ids : {&from, &ab, &b, &bc, &to}) ids->reserve(DEDUCTION_BLOCK);
     }
 
-    // Try each rule
-    for (const auto& rule : rules_) {
-        // Check if rule conclusion can unify with target
-        // If so, try to prove premises
+    [[nodiscard]] size_t size() const noexcept { return from.size(); }
+    [[nodiscard]] bool full() const noexcept { return size() == DEDUCTION_BLOCK; }
 
-        // Placeholder implementation
+    void push(AtomId a, AtomId ab_link, AtomId b_term, AtomId bc_link, AtomId c) {
+        from.push_back(a);
+        ab.push_back(ab_link);
+        b.push_back(b_term);
+        bc.push_back(bc_link);
+        to.push_back(c);
     }
 
-    return std::nullopt;
+    void run(const AtomTable& table) noexcept {
+        const size_t n = size();
+        table.gather_tvs(ab, ab_tv.strength.data(), ab_tv.confidence.data());
+        table.gather_tvs(bc, bc_tv.strength.data(), bc_tv.confidence.data());
+        table.gather_tvs(b, sB.data(), nullptr);
+        table.gather_tvs(to, sC.data(), nullptr);
+        batch_deduction(ab_tv.view(n), bc_tv.view(n), {sB.data(), n}, {sC.data(), n},
+                        ac_tv.columns(n));
+    }
+
+    void clear() noexcept {
+        for (auto* ids : {&from, &ab, &b, &bc, &to}) ids->clear();
+    }
+};
+
+struct ConclusionKey {
+    AtomId from;
+    AtomId to;
+
+    bool operator==(const ConclusionKey&) const = default;
+};
+
+struct ConclusionKeyHash {
+    size_t operator()(const ConclusionKey& key) const noexcept {
+        return static_cast<size_t>(hash_combine(key.from.value, key.to.value));
+    }
+};
+
+} // namespace
+
+BulkInferenceResult PLNEngine::deduce_all(AtomType link_type) {
+    BulkInferenceResult result;
+    const auto& table = space_.atom_table();
+    const auto& targets = space_.indices().target_type_index;
+
+    // Deduced A->C, merged across middle terms B
+    std::vector<ConclusionKey> keys;
+    std::vector<TruthValue> deduced;
+    std::unordered_map<ConclusionKey, size_t, ConclusionKeyHash> slot_of;
+
+    DeductionBlock block;
+    auto flush = [&] {
+        if (block.size() == 0) return;
+        block.run(table);
+
+        for (size_t i = 0; i < block.size(); ++i) {
+            ConclusionKey key{block.from[i], block.to[i]};
+            TruthValue tv{block.ac_tv.strength[i], block.ac_tv.confidence[i]};
+
+            auto [it, inserted] = slot_of.try_emplace(key, keys.size());
+            if (inserted) {
+                keys.push_back(key);
+                deduced.push_back(tv);
+            } else {
+                deduced[it->second] = revision(deduced[it->second], tv);
+            }
+        }
+        block.clear();
+    };
+
+    // Enumerate B->C, then every A->B through the links pointing at B
+    std::vector<AtomId> links;
+    std::vector<AtomId> into_b;
+    space_.indices().type_index.collect(link_type, links);
+
+    for (AtomId bc : links) {
+        auto bc_out = table.get_outgoing(bc);
+        if (bc_out.size() != 2) continue;
+        const AtomId b = bc_out[0];
+        const AtomId c = bc_out[1];
+
+        into_b.clear();
+        targets.collect(link_type, b, into_b);
+
+        for (AtomId ab : into_b) {
+            auto ab_out = table.get_outgoing(ab);
+            if (ab_out.size() != 2 || ab_out[1] != b || ab_out[0] == c) continue;
+
+            block.push(ab_out[0], ab, b, bc, c);
+            ++result.premise_pairs;
+            if (block.full()) flush();
+        }
+    }
+    flush();
+
+    // Write-back: split conclusions into revisions of existing links and
+    // new insertions, then apply each group in one go.
+    std::vector<AtomId> existing;
+    std::vector<size_t> existing_slot;
+    std::vector<size_t> fresh;
+
+    for (size_t i = 0; i < keys.size(); ++i) {
+        if (deduced[i].confidence < config_.min_confidence) continue;
+
+        AtomId out[2] = {keys[i].from, keys[i].to};
+        AtomId id = table.get_link(link_type, std::span<const AtomId>(out));
+        if (id.valid()) {
+            existing.push_back(id);
+            existing_slot.push_back(i);
+        } else {
+            fresh.push_back(i);
+        }
+    }
+
+    if (!existing.empty()) {
+        const size_t n = existing.size();
+        TVBuffer old_tv(n), new_tv(n), merged(n);
+
+        space_.gather_tvs(existing, old_tv.strength.data(), old_tv.confidence.data());
+        for (size_t i = 0; i < n; ++i) {
+            new_tv.strength[i] = deduced[existing_slot[i]].strength;
+            new_tv.confidence[i] = deduced[existing_slot[i]].confidence;
+        }
+
+        batch_revision(old_tv.view(), new_tv.view(), merged.columns());
+        space_.set_tvs(existing, merged.strength.data(), merged.confidence.data());
+
+        for (AtomId id : existing) {
+            result.conclusions.push_back(space_.make_handle(id));
+        }
+        result.revised = n;
+    }
+
+    for (size_t i : fresh) {
+        AtomId out[2] = {keys[i].from, keys[i].to};
+        result.conclusions.push_back(
+            space_.add_link(link_type, std::span<const AtomId>(out), deduced[i]));
+    }
+    result.created = fresh.size();
+
+    total_inferences_ += result.premise_pairs;
+    return result;
+}
+
+// ============================================================================
+// Backward Chaining
+// ============================================================================
+
+std::optional<InferenceResult> PLNEngine::backward_chain(Handle target) {
+    if (!target.valid() || !space_.contains(target.id())) return std::nullopt;
+    compile_rules();
+
+    GoalSearch search;
+    search.proofs = inference_cache_->proof_generation();
+    size_t low = SIZE_MAX;
+    GoalAnswer answer = solve(target.id(), search, low);
+    if (!answer.proven) return std::nullopt;
+
+    InferenceResult result;
+    result.conclusion = target;
+    result.truth_value = answer.tv;
+    result.proof = proof_ref(answer.proofs, answer.proof);
+    result.iterations_used = search.expansions;
+    return result;
 }
 
 std::vector<InferenceResult> PLNEngine::find_proofs(Handle target) {
     std::vector<InferenceResult> proofs;
+    if (!target.valid() || !space_.contains(target.id())) return proofs;
+    compile_rules();
 
-    // Depth-first search for all proofs
-    auto first_proof = backward_chain(target);
-    if (first_proof) {
-        proofs.push_back(std::move(*first_proof));
-    }
+    GoalSearch search;
+    search.derivations = &proofs;
+    search.proofs = inference_cache_->proof_generation();
+    size_t low = SIZE_MAX;
+    GoalAnswer answer = solve(target.id(), search, low);
 
+    if (proofs.empty() && answer.proven) {
+        InferenceResult result;
+        result.conclusion = target;
+        result.truth_value = answer.tv;
+        result.proof = proof_ref(answer.proofs, answer.proof);
+        proofs.push_back(std::move(result));
+    }
+    if (proofs.size() > config_.max_results) proofs.resize(config_.max_results);
+    for (auto& proof : proofs) proof.iterations_used = search.expansions;
     return proofs;
 }
 
+PLNEngine::GoalAnswer PLNEngine::solve(AtomId goal, GoalSearch& search, size_t& low) {
+    const auto& table = space_.atom_table();
+    const bool top = search.depth_of.empty();
+    const uint64_t context = cache_context();
+    const uint64_t key = hash_combine(context, table.get_hash(goal));
+
+    // Tabled answer; find_proofs re-derives its target to list every proof
+    if (!(top && search.derivations)) {
+        if (auto cached = inference_cache_->lookup(space_, key, goal, context)) {
+            ++cache_hits_;
+            return std::move(*cached);
+        }
+    }
+
+    GoalAnswer answer;
+    answer.goal = goal;
+    answer.context = context;
+    // Only atoms of the types premises match can add a derivation
+    for (AtomType type : goal_types_) {
+        answer.versions.emplace_back(type, space_.type_version(type));
+    }
+    if (goal_wildcard_) answer.version = space_.version();
+
+    const TruthValue own = table.get_tv(goal);
+    answer.leaves.emplace_back(goal, own);
+    if (own.confidence > config_.min_confidence) {
+        answer.proven = true;
+        answer.tv = own;
+        return answer;
+    }
+
+    // A goal already on the search stack closes a cycle: fail this path
+    // and keep everything above the cycle's head out of the table
+    if (auto it = search.depth_of.find(goal); it != search.depth_of.end()) {
+        low = std::min(low, it->second);
+        return answer;
+    }
+    if (search.expansions >= config_.max_iterations) {
+        low = 0;
+        return answer;
+    }
+    ++search.expansions;
+
+    const size_t depth = search.depth_of.size() + 1;
+    search.depth_of.emplace(goal, depth);
+    size_t my_low = depth;
+
+    // Matches of one rule's premises, gathered before recursing so the
+    // shared engines are free for the subgoals
+    struct PremiseMatch {
+        std::vector<AtomId> clauses;
+        std::vector<AtomId> vars;
+    };
+    std::vector<PremiseMatch> matches;
+    std::vector<TruthValue> premise_tvs;
+    std::vector<const ProofNode*> sub_proofs;   // Of one match's derived premises
+    std::vector<const ProofNode*> derivations;  // Of the goal
+    MatchResult unifier;
+    bool derived = false;
+
+    for (const auto& compiled : compiled_) {
+        if (!compiled->backward) continue;
+        const InferenceRule& rule = rules_[compiled->rule];
+
+        MatchEngine& conclusion = compiled->conclusion;
+        conclusion.restart();
+        conclusion.pin(0, goal);
+        if (!conclusion.next()) continue;
+        conclusion.materialize(unifier);
+
+        matches.clear();
+        goal_engine_.reset(rule.premise_pattern, unifier.bindings);
+        MatchResult bindings;
+        while (goal_engine_.next()) {
+            auto clauses = goal_engine_.clause_atoms();
+            if (std::ranges::find(clauses, goal) != clauses.end()) continue;
+            if (rule.applicable) {
+                goal_engine_.materialize(bindings);
+                if (!rule.applicable(space_, bindings.bindings)) continue;
+            }
+
+            PremiseMatch match{std::vector<AtomId>(clauses.begin(), clauses.end()), {}};
+            for (const auto& name : rule.premise_pattern.variables) {
+                match.vars.push_back(goal_engine_.value(name));
+            }
+            matches.push_back(std::move(match));
+        }
+
+        for (const PremiseMatch& match : matches) {
+            premise_tvs.clear();
+            sub_proofs.clear();
+            bool proven = true;
+
+            for (AtomId premise : match.clauses) {
+                GoalAnswer sub = solve(premise, search, my_low);
+                answer.leaves.insert(answer.leaves.end(), sub.leaves.begin(), sub.leaves.end());
+                if (!sub.proven) {
+                    proven = false;
+                    break;
+                }
+                premise_tvs.push_back(sub.tv);
+                if (sub.proof) {
+                    // A tabled answer may be in a newer store than this search's
+                    if (sub.proofs != search.proofs) search.proofs->retain(sub.proofs);
+                    sub_proofs.push_back(sub.proof);
+                }
+            }
+            if (!proven) continue;
+
+            for (AtomId v : match.vars) {
+                const TruthValue tv = v.valid() ? table.get_tv(v) : TruthValue{};
+                premise_tvs.push_back(tv);
+                if (v.valid()) answer.leaves.emplace_back(v, tv);
+            }
+
+            const TruthValue tv = compiled->kernel ? compiled->kernel(premise_tvs)
+                                                   : rule.formula(premise_tvs);
+            ++total_inferences_;
+            if (tv.confidence < config_.min_confidence) continue;
+
+            // The step shares its premises' proof nodes rather than copying them
+            const ProofNode* step = nullptr;
+            if (config_.record_proof) {
+                step = search.proofs->add(rule_ids_[compiled->rule], goal, tv,
+                                          match.clauses, sub_proofs);
+                derivations.push_back(step);
+            }
+
+            if (top && search.derivations) {
+                InferenceResult result;
+                result.conclusion = space_.make_handle(goal);
+                result.truth_value = tv;
+                result.proof = proof_ref(search.proofs, step);
+                search.derivations->push_back(std::move(result));
+            }
+
+            answer.tv = derived ? revision(answer.tv, tv) : tv;
+            derived = true;
+        }
+    }
+    answer.proof = search.proofs->merge(derivations);
+    if (answer.proof) answer.proofs = search.proofs;
+
+    search.depth_of.erase(goal);
+
+    if (derived) {
+        answer.proven = true;
+        if (own.confidence > 0.0f) answer.tv = revision(own, answer.tv);
+    }
+
+    std::ranges::sort(answer.leaves, {}, [](const auto& leaf) { return leaf.first; });
+    auto dup = std::ranges::unique(answer.leaves, {}, [](const auto& leaf) { return leaf.first; });
+    answer.leaves.erase(dup.begin(), dup.end());
+
+    // Table the answer once every goal it depends on has completed
+    if (my_low >= depth) {
+        inference_cache_->store(key, answer);
+    }
+    low = std::min(low, my_low);
+    return answer;
+}
+
 std::vector<InferenceResult> PLNEngine::apply_rule(
     const InferenceRule& rule,
     const BindingSet& bindings
@@ -252,55 +1069,273 @@ bool PLNEngine::should_pursue(Handle h) const {
     return true;
 }
 
-uint64_t PLNEngine::cache_key(
-    const std::string& rule_name,
-    const std::vector<Handle>& premises
-) const {
-    uint64_t key = std::hash<std::string>{}(rule_name);
-    for (const Handle& h : premises) {
-        key = hash_combine(key, h.id().value);
+uint64_t PLNEngine::cache_context() const {
+    // Besides the goal, answers depend on the rules, the grounding
+    // threshold and whether proofs were recorded
+    uint64_t context = hash_combine(rules_fingerprint_,
+                                    std::bit_cast<uint32_t>(config_.min_confidence));
+    return hash_combine(context, config_.record_proof ? 1 : 0);
+}
+
+// ============================================================================
+// ConcurrentIdSet
+// ============================================================================
+
+bool ConcurrentIdSet::insert(AtomId id) {
+    Shard& shard = shard_for(id);
+    std::lock_guard lock(shard.mutex);
+    return shard.ids.insert(id).second;
+}
+
+bool ConcurrentIdSet::contains(AtomId id) const {
+    Shard& shard = shard_for(id);
+    std::lock_guard lock(shard.mutex);
+    return shard.ids.contains(id);
+}
+
+size_t ConcurrentIdSet::size() const {
+    size_t total = 0;
+    for (Shard& shard : shards_) {
+        std::lock_guard lock(shard.mutex);
+        total += shard.ids.size();
     }
-    return key;
+    return total;
 }
 
+void ConcurrentIdSet::clear() {
+    for (Shard& shard : shards_) {
+        std::lock_guard lock(shard.mutex);
+        shard.ids.clear();
+    }
+}
+
+// ============================================================================
+// Worker Pool
+// ============================================================================
+
+namespace {
+
+/**
+ * @brief Batch indices owned by one worker
+ *
+ * The owner pops from the back and thieves steal from the front. A deque
+ * is filled once per batch and never pushed to afterwards, so both ends
+ * fit in one atomic word and every take is a single compare-exchange.
+ */
+class WorkDeque {
+public:
+    void reset(uint32_t begin, uint32_t end) noexcept {
+        bounds_.store(pack(begin, end), std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] std::optional<uint32_t> pop() noexcept { return take(false); }
+    [[nodiscard]] std::optional<uint32_t> steal() noexcept { return take(true); }
+
+private:
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> bounds_{0};   // end << 32 | begin
+
+    static constexpr uint64_t pack(uint32_t begin, uint32_t end) noexcept {
+        return (static_cast<uint64_t>(end) << 32) | begin;
+    }
+
+    std::optional<uint32_t> take(bool front) noexcept {
+        uint64_t bounds = bounds_.load(std::memory_order_relaxed);
+        for (;;) {
+            const auto begin = static_cast<uint32_t>(bounds);
+            const auto end = static_cast<uint32_t>(bounds >> 32);
+            if (begin >= end) return std::nullopt;
+
+            const uint64_t next = front ? pack(begin + 1, end) : pack(begin, end - 1);
+            if (bounds_.compare_exchange_weak(bounds, next, std::memory_order_relaxed)) {
+                return front ? begin : end - 1;
+            }
+        }
+    }
+};
+
+} // namespace
+
+struct IncrementalInference::Pool {
+    struct Worker {
+        WorkDeque deque;
+        std::unique_ptr<PLNEngine> engine;   // Null for the calling thread
+        uint64_t rules_version = UINT64_MAX;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;   // workers[0] is the caller
+    std::vector<std::jthread> threads;
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    uint64_t generation = 0;                // Batches published, under mutex
+    bool stopping = false;
+    std::atomic<size_t> running{0};         // Helper threads still matching
+
+    std::span<const Handle> batch;
+    std::vector<std::vector<Derivation>>* derived = nullptr;
+
+    // Match stimuli until every deque is empty
+    void drain(size_t self, PLNEngine& engine) {
+        auto take = [&]() -> std::optional<uint32_t> {
+            if (auto i = workers[self]->deque.pop()) return i;
+            for (size_t k = 1; k < workers.size(); ++k) {
+                if (auto i = workers[(self + k) % workers.size()]->deque.steal()) return i;
+            }
+            return std::nullopt;
+        };
+        while (auto i = take()) {
+            engine.match(batch.subspan(*i, 1), (*derived)[*i]);
+        }
+    }
+
+    void serve(size_t self) {
+        uint64_t seen = 0;
+        for (;;) {
+            {
+                std::unique_lock lock(mutex);
+                wake.wait(lock, [&] { return stopping || generation != seen; });
+                if (stopping) return;
+                seen = generation;
+            }
+            drain(self, *workers[self]->engine);
+            if (running.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                running.notify_all();
+            }
+        }
+    }
+};
+
 // ============================================================================
 // IncrementalInference Implementation
 // ============================================================================
 
-IncrementalInference::IncrementalInference(PLNEngine& engine)
+IncrementalInference::IncrementalInference(PLNEngine& engine, size_t threads)
     : engine_(engine)
 {
+    if (threads == 0) threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    if (threads == 1) return;
+
+    pool_ = std::make_unique<Pool>();
+    for (size_t i = 0; i < threads; ++i) {
+        pool_->workers.push_back(std::make_unique<Pool::Worker>());
+    }
+    for (size_t i = 1; i < threads; ++i) {
+        pool_->threads.emplace_back([pool = pool_.get(), i] { pool->serve(i); });
+    }
 }
 
-void IncrementalInference::add_stimulus(Handle atom) {
-    if (atom.valid()) {
-        pending_.push(atom);
+IncrementalInference::~IncrementalInference() {
+    if (!pool_) return;
+    {
+        std::lock_guard lock(pool_->mutex);
+        pool_->stopping = true;
     }
+    pool_->wake.notify_all();
+    pool_->threads.clear();   // Joins
 }
 
-std::vector<InferenceResult> IncrementalInference::step() {
-    if (pending_.empty()) return {};
+size_t IncrementalInference::threads() const noexcept {
+    return pool_ ? pool_->workers.size() : 1;
+}
 
-    Handle current = pending_.front();
-    pending_.pop();
+void IncrementalInference::add_stimulus(Handle atom) {
+    if (!atom.valid() || visited_.contains(atom.id())) return;
+    std::lock_guard lock(pending_mutex_);
+    pending_.push_back(atom);
+}
 
-    // Skip if already visited
-    if (visited_.contains(current.id().value)) return {};
-    visited_.insert(current.id().value);
+std::vector<InferenceResult> IncrementalInference::step() {
+    batch_.clear();
+    {
+        std::lock_guard lock(pending_mutex_);
+        while (!pending_.empty() && batch_.size() < batch_size_) {
+            Handle current = pending_.front();
+            pending_.pop_front();
+            if (visited_.insert(current.id())) batch_.push_back(current);
+        }
+    }
+    if (batch_.empty()) return {};
 
-    // Run one step of inference
-    auto results = engine_.forward_step(current);
+    match_batch();
+
+    // Batched commit in stimulus order. A firing reachable from several
+    // stimuli of the batch is applied once.
+    std::vector<Derivation> derived;
+    FiringSet fired;
+    for (auto& slot : derived_) {
+        for (Derivation& d : slot) {
+            if (fired.insert(d.rule, d.premises)) derived.push_back(std::move(d));
+        }
+    }
+    auto results = engine_.commit(derived);
 
     // Add new conclusions to pending
-    for (const auto& result : results) {
-        if (!visited_.contains(result.conclusion.id().value)) {
-            pending_.push(result.conclusion);
+    {
+        std::lock_guard lock(pending_mutex_);
+        for (const auto& result : results) {
+            if (!visited_.contains(result.conclusion.id())) {
+                pending_.push_back(result.conclusion);
+            }
         }
     }
 
     return results;
 }
 
+void IncrementalInference::match_batch() {
+    derived_.resize(batch_.size());
+    for (auto& slot : derived_) slot.clear();
+
+    if (!pool_ || batch_.size() < 2) {
+        for (size_t i = 0; i < batch_.size(); ++i) {
+            engine_.match(std::span<const Handle>(&batch_[i], 1), derived_[i]);
+        }
+        return;
+    }
+
+    Pool& pool = *pool_;
+    const size_t workers = pool.workers.size();
+
+    // Helpers match with their own engines, refreshed when the rules change
+    for (size_t w = 1; w < workers; ++w) {
+        Pool::Worker& worker = *pool.workers[w];
+        if (!worker.engine || worker.rules_version != engine_.rules_version()) {
+            worker.engine = std::make_unique<PLNEngine>(engine_.space(), engine_.config(),
+                                                        engine_.cache());
+            worker.engine->add_rules(engine_.rules());
+            worker.rules_version = engine_.rules_version();
+        } else {
+            worker.engine->set_config(engine_.config());
+        }
+    }
+
+    // Contiguous share of the batch per worker; stealing evens out the rest
+    const size_t n = batch_.size();
+    for (size_t w = 0; w < workers; ++w) {
+        pool.workers[w]->deque.reset(static_cast<uint32_t>(n * w / workers),
+                                     static_cast<uint32_t>(n * (w + 1) / workers));
+    }
+    pool.batch = batch_;
+    pool.derived = &derived_;
+    pool.running.store(workers - 1, std::memory_order_relaxed);
+    {
+        std::lock_guard lock(pool.mutex);
+        ++pool.generation;
+    }
+    pool.wake.notify_all();
+
+    pool.drain(0, engine_);
+    for (size_t left = pool.running.load(std::memory_order_acquire); left != 0;
+         left = pool.running.load(std::memory_order_acquire)) {
+        pool.running.wait(left, std::memory_order_acquire);
+    }
+
+    for (size_t w = 1; w < workers; ++w) {
+        engine_.merge_stats(*pool.workers[w]->engine);
+        pool.workers[w]->engine->reset_stats();
+    }
+}
+
 std::vector<InferenceResult> IncrementalInference::run(size_t max_steps) {
     std::vector<InferenceResult> all_results;
 
@@ -315,6 +1350,7 @@ std::vector<InferenceResult> IncrementalInference::run(size_t max_steps) {
 }
 
 bool IncrementalInference::has_pending() const {
+    std::lock_guard lock(pending_mutex_);
     return !pending_.empty();
 }
 
@@ -0,0 +1,179 @@
+/**
+ * @file inference_cache.cpp
+ * @brief Sharded CLOCK cache of backward chaining answers
+ */
+
+#include <opencog/pln/inference.hpp>
+
+#include <algorithm>
+#include <bit>
+
+namespace opencog::pln {
+
+InferenceCache::InferenceCache(size_t capacity, size_t shards, size_t proof_bytes)
+    : shard_count_(std::bit_ceil(std::max<size_t>(shards, 1)))
+    , shard_capacity_((capacity + shard_count_ - 1) / shard_count_)
+    , proof_bytes_(proof_bytes)
+    , proofs_(std::make_shared<ProofStore>())
+{
+    shards_ = std::make_unique<Shard[]>(shard_count_);
+}
+
+// ============================================================================
+// Lookup
+// ============================================================================
+
+std::optional<InferenceCache::Entry> InferenceCache::lookup(const AtomSpace& space,
+                                                            uint64_t key,
+                                                            AtomId goal,
+                                                            uint64_t context) {
+    Shard& shard = shard_for(key);
+    std::lock_guard lock(shard.mutex);
+
+    auto found = shard.index.find(key);
+    if (found == shard.index.end()) {
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        return std::nullopt;
+    }
+
+    Slot& slot = shard.slots[found->second];
+    if (slot.entry.goal != goal || slot.entry.context != context) {
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        return std::nullopt;
+    }
+
+    const auto& table = space.atom_table();
+    const bool valid =
+        (!slot.entry.version || *slot.entry.version == space.version()) &&
+        std::ranges::all_of(slot.entry.versions, [&](const auto& version) {
+            return space.type_version(version.first) == version.second;
+        }) &&
+        (!slot.entry.proofs || slot.entry.proofs == proofs()) &&
+        std::ranges::all_of(slot.entry.leaves, [&](const auto& leaf) {
+            return table.get_tv(leaf.first) == leaf.second;
+        });
+    if (!valid) {
+        shard.index.erase(found);
+        slot.occupied = false;
+        slot.entry = Entry{};
+        invalidations_.fetch_add(1, std::memory_order_relaxed);
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        return std::nullopt;
+    }
+
+    slot.referenced = true;
+    hits_.fetch_add(1, std::memory_order_relaxed);
+    return slot.entry;
+}
+
+// ============================================================================
+// Insertion
+// ============================================================================
+
+void InferenceCache::store(uint64_t key, Entry entry) {
+    if (shard_capacity_ == 0) return;
+
+    Shard& shard = shard_for(key);
+    std::lock_guard lock(shard.mutex);
+
+    // Checked under the shard lock, so a concurrent successor cannot miss it
+    if (entry.proofs && entry.proofs != proofs()) return;
+    insertions_.fetch_add(1, std::memory_order_relaxed);
+
+    if (auto found = shard.index.find(key); found != shard.index.end()) {
+        Slot& slot = shard.slots[found->second];
+        slot.entry = std::move(entry);
+        slot.referenced = true;
+        return;
+    }
+
+    size_t victim;
+    if (shard.slots.size() < shard_capacity_) {
+        victim = shard.slots.size();
+        shard.slots.emplace_back();
+    } else {
+        // Advance the hand, clearing reference bits, to the first slot that
+        // is free or was not used since the hand last passed it
+        for (;;) {
+            Slot& slot = shard.slots[shard.hand];
+            if (!slot.occupied) break;
+            if (!slot.referenced) {
+                shard.index.erase(slot.key);
+                evictions_.fetch_add(1, std::memory_order_relaxed);
+                break;
+            }
+            slot.referenced = false;
+            shard.hand = (shard.hand + 1) % shard_capacity_;
+        }
+        victim = shard.hand;
+        shard.hand = (shard.hand + 1) % shard_capacity_;
+    }
+
+    Slot& slot = shard.slots[victim];
+    slot.key = key;
+    slot.occupied = true;
+    slot.referenced = false;
+    slot.entry = std::move(entry);
+    shard.index.emplace(key, static_cast<uint32_t>(victim));
+}
+
+// ============================================================================
+// Maintenance
+// ============================================================================
+
+std::shared_ptr<ProofStore> InferenceCache::proof_generation() {
+    auto current = proofs();
+    if (proof_bytes_ == 0 || current->bytes_used() < proof_bytes_) return current;
+
+    // Whoever swaps drops the entries; a loser gets the winner's store
+    auto next = current->successor();
+    if (!proofs_.compare_exchange_strong(current, next, std::memory_order_acq_rel)) {
+        return current;
+    }
+    generations_.fetch_add(1, std::memory_order_relaxed);
+    drop_entries();
+    return next;
+}
+
+void InferenceCache::clear() {
+    proofs_.store(proofs()->successor(), std::memory_order_release);
+    drop_entries();
+}
+
+void InferenceCache::drop_entries() {
+    for (size_t i = 0; i < shard_count_; ++i) {
+        std::lock_guard lock(shards_[i].mutex);
+        shards_[i].index.clear();
+        shards_[i].slots.clear();
+        shards_[i].hand = 0;
+    }
+}
+
+size_t InferenceCache::size() const {
+    size_t total = 0;
+    for (size_t i = 0; i < shard_count_; ++i) {
+        std::lock_guard lock(shards_[i].mutex);
+        total += shards_[i].index.size();
+    }
+    return total;
+}
+
+InferenceCacheStats InferenceCache::stats() const noexcept {
+    InferenceCacheStats stats;
+    stats.hits = hits_.load(std::memory_order_relaxed);
+    stats.misses = misses_.load(std::memory_order_relaxed);
+    stats.insertions = insertions_.load(std::memory_order_relaxed);
+    stats.evictions = evictions_.load(std::memory_order_relaxed);
+    stats.invalidations = invalidations_.load(std::memory_order_relaxed);
+    stats.generations = generations_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void InferenceCache::reset_stats() noexcept {
+    for (auto* counter : {&hits_, &misses_, &insertions_, &evictions_, &invalidations_,
+                          &generations_}) {
+        counter->store(0, std::memory_order_relaxed);
+    }
+}
+
+} // namespace opencog::pln
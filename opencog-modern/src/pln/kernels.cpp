@@ -0,0 +1,297 @@
+/**
+ * @file kernels.cpp
+ * @brief Baseline PLN batch kernels and runtime dispatch
+ *
+ * Compiled without ISA flags: holds the scalar kernels, the 4-wide kernels
+ * every CPU of the architecture supports (SSE2 or NEON), and the CPU
+ * feature checks that decide whether the wider tables may be used.
+ */
+
+#include "kernels_impl.hpp"
+
+#include <atomic>
+
+#if !defined(OPENCOG_DISABLE_SIMD)
+    #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        #include <immintrin.h>
+        #define OPENCOG_KERNELS_SSE2 1
+    #elif defined(__aarch64__) || defined(_M_ARM64)
+        #include <arm_neon.h>
+        #define OPENCOG_KERNELS_NEON 1
+    #endif
+    #if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        #include <intrin.h>
+    #endif
+#endif
+
+namespace opencog::pln::kernels {
+
+namespace detail {
+namespace {
+
+// ============================================================================
+// Baseline Vector Types
+// ============================================================================
+
+struct Scalar {
+    using reg = float;
+    static constexpr size_t lanes = 1;
+
+    static reg set1(float x) noexcept { return x; }
+    static reg load(const float* p) noexcept { return *p; }
+    static void store(float* p, reg v) noexcept { *p = v; }
+    static reg load_partial(const float* p, size_t) noexcept { return *p; }
+    static void store_partial(float* p, reg v, size_t) noexcept { *p = v; }
+
+    static reg add(reg a, reg b) noexcept { return a + b; }
+    static reg sub(reg a, reg b) noexcept { return a - b; }
+    static reg mul(reg a, reg b) noexcept { return a * b; }
+    static reg div(reg a, reg b) noexcept { return a / b; }
+    static reg min(reg a, reg b) noexcept { return b < a ? b : a; }
+    static reg max(reg a, reg b) noexcept { return a < b ? b : a; }
+};
+
+constexpr KernelTable SCALAR_TABLE = make_table<Scalar>(SimdLevel::SCALAR);
+
+#ifdef OPENCOG_KERNELS_SSE2
+
+struct Sse2 {
+    using reg = __m128;
+    static constexpr size_t lanes = 4;
+
+    static reg set1(float x) noexcept { return _mm_set1_ps(x); }
+    static reg load(const float* p) noexcept { return _mm_loadu_ps(p); }
+    static void store(float* p, reg v) noexcept { _mm_storeu_ps(p, v); }
+
+    static reg load_partial(const float* p, size_t n) noexcept {
+        alignas(16) float buffer[lanes] = {};
+        for (size_t i = 0; i < n; ++i) buffer[i] = p[i];
+        return _mm_load_ps(buffer);
+    }
+    static void store_partial(float* p, reg v, size_t n) noexcept {
+        alignas(16) float buffer[lanes];
+        _mm_store_ps(buffer, v);
+        for (size_t i = 0; i < n; ++i) p[i] = buffer[i];
+    }
+
+    static reg add(reg a, reg b) noexcept { return _mm_add_ps(a, b); }
+    static reg sub(reg a, reg b) noexcept { return _mm_sub_ps(a, b); }
+    static reg mul(reg a, reg b) noexcept { return _mm_mul_ps(a, b); }
+    static reg div(reg a, reg b) noexcept { return _mm_div_ps(a, b); }
+    static reg min(reg a, reg b) noexcept { return _mm_min_ps(a, b); }
+    static reg max(reg a, reg b) noexcept { return _mm_max_ps(a, b); }
+};
+
+constexpr KernelTable SSE2_TABLE = make_table<Sse2>(SimdLevel::SSE2);
+
+#endif // OPENCOG_KERNELS_SSE2
+
+#ifdef OPENCOG_KERNELS_NEON
+
+struct Neon {
+    using reg = float32x4_t;
+    static constexpr size_t lanes = 4;
+
+    static reg set1(float x) noexcept { return vdupq_n_f32(x); }
+    static reg load(const float* p) noexcept { return vld1q_f32(p); }
+    static void store(float* p, reg v) noexcept { vst1q_f32(p, v); }
+
+    static reg load_partial(const float* p, size_t n) noexcept {
+        float buffer[lanes] = {};
+        for (size_t i = 0; i < n; ++i) buffer[i] = p[i];
+        return vld1q_f32(buffer);
+    }
+    static void store_partial(float* p, reg v, size_t n) noexcept {
+        float buffer[lanes];
+        vst1q_f32(buffer, v);
+        for (size_t i = 0; i < n; ++i) p[i] = buffer[i];
+    }
+
+    static reg add(reg a, reg b) noexcept { return vaddq_f32(a, b); }
+    static reg sub(reg a, reg b) noexcept { return vsubq_f32(a, b); }
+    static reg mul(reg a, reg b) noexcept { return vmulq_f32(a, b); }
+    static reg div(reg a, reg b) noexcept { return vdivq_f32(a, b); }
+    static reg min(reg a, reg b) noexcept { return vminq_f32(a, b); }
+    static reg max(reg a, reg b) noexcept { return vmaxq_f32(a, b); }
+};
+
+constexpr KernelTable NEON_TABLE = make_table<Neon>(SimdLevel::NEON);
+
+#endif // OPENCOG_KERNELS_NEON
+
+// ============================================================================
+// CPU Feature Detection
+// ============================================================================
+
+struct CpuFeatures {
+    bool avx2 = false;      // AVX2 and FMA, with OS support for YMM state
+    bool avx512 = false;    // AVX-512F, with OS support for ZMM state
+};
+
+CpuFeatures detect_cpu() noexcept {
+    CpuFeatures cpu;
+#if defined(OPENCOG_DISABLE_SIMD)
+    // Baseline only
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    // libgcc's checks include the XGETBV test for OS-enabled register state
+    __builtin_cpu_init();
+    cpu.avx2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    cpu.avx512 = __builtin_cpu_supports("avx512f");
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    int regs[4];
+    __cpuid(regs, 0);
+    const int max_leaf = regs[0];
+
+    __cpuid(regs, 1);
+    const bool osxsave = (regs[2] & (1 << 27)) != 0;
+    const bool fma = (regs[2] & (1 << 12)) != 0;
+    if (!osxsave || max_leaf < 7) return cpu;
+
+    const unsigned long long xcr0 = _xgetbv(0);
+    const bool ymm_state = (xcr0 & 0x6) == 0x6;
+    const bool zmm_state = (xcr0 & 0xE6) == 0xE6;
+
+    __cpuidex(regs, 7, 0);
+    cpu.avx2 = ymm_state && fma && (regs[1] & (1 << 5)) != 0;
+    cpu.avx512 = zmm_state && (regs[1] & (1 << 16)) != 0;
+#endif
+    return cpu;
+}
+
+const CpuFeatures& cpu_features() noexcept {
+    static const CpuFeatures cpu = detect_cpu();
+    return cpu;
+}
+
+// ============================================================================
+// Table Selection
+// ============================================================================
+
+const KernelTable* table_for(SimdLevel level) noexcept {
+    switch (level) {
+        case SimdLevel::SCALAR:
+            return &SCALAR_TABLE;
+        case SimdLevel::SSE2:
+#ifdef OPENCOG_KERNELS_SSE2
+            return &SSE2_TABLE;
+#else
+            return nullptr;
+#endif
+        case SimdLevel::NEON:
+#ifdef OPENCOG_KERNELS_NEON
+            return &NEON_TABLE;
+#else
+            return nullptr;
+#endif
+        case SimdLevel::AVX2:
+            return cpu_features().avx2 ? avx2_table() : nullptr;
+        case SimdLevel::AVX512:
+            return cpu_features().avx512 ? avx512_table() : nullptr;
+    }
+    return nullptr;
+}
+
+// Widest available table at or below level
+const KernelTable* select(SimdLevel level) noexcept {
+    for (int l = static_cast<int>(level); l >= 0; --l) {
+        if (const KernelTable* table = table_for(static_cast<SimdLevel>(l))) return table;
+    }
+    return &SCALAR_TABLE;
+}
+
+std::atomic<const KernelTable*> g_active{nullptr};
+
+const KernelTable& active() noexcept {
+    const KernelTable* table = g_active.load(std::memory_order_acquire);
+    if (!table) [[unlikely]] {
+        table = select(SimdLevel::AVX512);
+        g_active.store(table, std::memory_order_release);
+    }
+    return *table;
+}
+
+} // namespace
+} // namespace detail
+
+// ============================================================================
+// Dispatch Control
+// ============================================================================
+
+const char* simd_level_name(SimdLevel level) noexcept {
+    switch (level) {
+        case SimdLevel::SCALAR: return "scalar";
+        case SimdLevel::SSE2:   return "sse2";
+        case SimdLevel::NEON:   return "neon";
+        case SimdLevel::AVX2:   return "avx2";
+        case SimdLevel::AVX512: return "avx512";
+    }
+    return "unknown";
+}
+
+SimdLevel detected_simd_level() noexcept {
+    return detail::select(SimdLevel::AVX512)->level;
+}
+
+SimdLevel simd_level() noexcept {
+    return detail::active().level;
+}
+
+size_t simd_width() noexcept {
+    return detail::active().width;
+}
+
+SimdLevel set_simd_level(SimdLevel level) noexcept {
+    const detail::KernelTable* table = detail::select(level);
+    detail::g_active.store(table, std::memory_order_release);
+    return table->level;
+}
+
+// ============================================================================
+// Batch Kernels
+// ============================================================================
+
+void deduction(const float* sAB, const float* cAB,
+               const float* sBC, const float* cBC,
+               const float* sB, const float* sC,
+               float* sAC, float* cAC, size_t count) noexcept {
+    detail::active().deduction(sAB, cAB, sBC, cBC, sB, sC, sAC, cAC, count);
+}
+
+void inversion(const float* sAB, const float* cAB,
+               const float* sA, const float* sB,
+               float* sBA, float* cBA, size_t count) noexcept {
+    detail::active().inversion(sAB, cAB, sA, sB, sBA, cBA, count);
+}
+
+void revision(const float* s1, const float* c1,
+              const float* s2, const float* c2,
+              float* s_out, float* c_out, size_t count) noexcept {
+    detail::active().revision(s1, c1, s2, c2, s_out, c_out, count);
+}
+
+void abduction(const float* sAB, const float* cAB,
+               const float* sCB, const float* cCB,
+               const float* sB, const float* sC,
+               float* sAC, float* cAC, size_t count) noexcept {
+    detail::active().abduction(sAB, cAB, sCB, cCB, sB, sC, sAC, cAC, count);
+}
+
+void modus_ponens(const float* sA, const float* cA,
+                  const float* sAB, const float* cAB,
+                  float* sB, float* cB, size_t count) noexcept {
+    detail::active().modus_ponens(sA, cA, sAB, cAB, sB, cB, count);
+}
+
+void fuzzy_and(const float* s1, const float* c1,
+               const float* s2, const float* c2,
+               float* s_out, float* c_out, size_t count) noexcept {
+    detail::active().fuzzy_and(s1, c1, s2, c2, s_out, c_out, count);
+}
+
+void fuzzy_or(const float* s1, const float* c1,
+              const float* s2, const float* c2,
+              float* s_out, float* c_out, size_t count) noexcept {
+    detail::active().fuzzy_or(s1, c1, s2, c2, s_out, c_out, count);
+}
+
+} // namespace opencog::pln::kernels
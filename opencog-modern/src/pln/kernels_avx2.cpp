@@ -0,0 +1,59 @@
+/**
+ * @file kernels_avx2.cpp
+ * @brief AVX2 instantiation of the PLN batch kernels
+ *
+ * Built with -mavx2 -mfma; only reached after a runtime CPU check.
+ */
+
+#include "kernels_impl.hpp"
+
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#endif
+
+namespace opencog::pln::kernels::detail {
+
+#if defined(__AVX2__) && defined(__FMA__)
+
+namespace {
+
+struct Avx2 {
+    using reg = __m256;
+    static constexpr size_t lanes = 8;
+
+    static reg set1(float x) noexcept { return _mm256_set1_ps(x); }
+    static reg load(const float* p) noexcept { return _mm256_loadu_ps(p); }
+    static void store(float* p, reg v) noexcept { _mm256_storeu_ps(p, v); }
+
+    static __m256i mask(size_t n) noexcept {
+        const __m256i index = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        return _mm256_cmpgt_epi32(_mm256_set1_epi32(static_cast<int>(n)), index);
+    }
+    static reg load_partial(const float* p, size_t n) noexcept {
+        return _mm256_maskload_ps(p, mask(n));
+    }
+    static void store_partial(float* p, reg v, size_t n) noexcept {
+        _mm256_maskstore_ps(p, mask(n), v);
+    }
+
+    static reg add(reg a, reg b) noexcept { return _mm256_add_ps(a, b); }
+    static reg sub(reg a, reg b) noexcept { return _mm256_sub_ps(a, b); }
+    static reg mul(reg a, reg b) noexcept { return _mm256_mul_ps(a, b); }
+    static reg div(reg a, reg b) noexcept { return _mm256_div_ps(a, b); }
+    static reg min(reg a, reg b) noexcept { return _mm256_min_ps(a, b); }
+    static reg max(reg a, reg b) noexcept { return _mm256_max_ps(a, b); }
+};
+
+constexpr KernelTable AVX2_TABLE = make_table<Avx2>(SimdLevel::AVX2);
+
+} // namespace
+
+const KernelTable* avx2_table() noexcept { return &AVX2_TABLE; }
+
+#else
+
+const KernelTable* avx2_table() noexcept { return nullptr; }
+
+#endif
+
+} // namespace opencog::pln::kernels::detail
@@ -0,0 +1,59 @@
+/**
+ * @file kernels_avx512.cpp
+ * @brief AVX-512 instantiation of the PLN batch kernels
+ *
+ * Built with -mavx512f; only reached after a runtime CPU check. Tails use
+ * masked loads and stores, so no lane outside the arrays is touched.
+ */
+
+#include "kernels_impl.hpp"
+
+#if defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+namespace opencog::pln::kernels::detail {
+
+#if defined(__AVX512F__)
+
+namespace {
+
+struct Avx512 {
+    using reg = __m512;
+    static constexpr size_t lanes = 16;
+
+    static reg set1(float x) noexcept { return _mm512_set1_ps(x); }
+    static reg load(const float* p) noexcept { return _mm512_loadu_ps(p); }
+    static void store(float* p, reg v) noexcept { _mm512_storeu_ps(p, v); }
+
+    static __mmask16 mask(size_t n) noexcept {
+        return static_cast<__mmask16>((1u << n) - 1u);
+    }
+    static reg load_partial(const float* p, size_t n) noexcept {
+        return _mm512_maskz_loadu_ps(mask(n), p);
+    }
+    static void store_partial(float* p, reg v, size_t n) noexcept {
+        _mm512_mask_storeu_ps(p, mask(n), v);
+    }
+
+    static reg add(reg a, reg b) noexcept { return _mm512_add_ps(a, b); }
+    static reg sub(reg a, reg b) noexcept { return _mm512_sub_ps(a, b); }
+    static reg mul(reg a, reg b) noexcept { return _mm512_mul_ps(a, b); }
+    static reg div(reg a, reg b) noexcept { return _mm512_div_ps(a, b); }
+    static reg min(reg a, reg b) noexcept { return _mm512_min_ps(a, b); }
+    static reg max(reg a, reg b) noexcept { return _mm512_max_ps(a, b); }
+};
+
+constexpr KernelTable AVX512_TABLE = make_table<Avx512>(SimdLevel::AVX512);
+
+} // namespace
+
+const KernelTable* avx512_table() noexcept { return &AVX512_TABLE; }
+
+#else
+
+const KernelTable* avx512_table() noexcept { return nullptr; }
+
+#endif
+
+} // namespace opencog::pln::kernels::detail
@@ -0,0 +1,231 @@
+#pragma once
+/**
+ * @file kernels_impl.hpp
+ * @brief Generic PLN batch kernels, instantiated once per instruction set
+ *
+ * Private to the kernel translation units. Each of them defines a vector
+ * type V for its target and builds a KernelTable from make_table<V>().
+ *
+ * V provides:
+ *   using reg;                        // Register type
+ *   static constexpr size_t lanes;
+ *   set1, load, store                 // Unaligned full-vector access
+ *   load_partial, store_partial       // First n < lanes elements, rest zero
+ *   add, sub, mul, div, min, max
+ *
+ * Everything below lives in an anonymous namespace and touches only V and
+ * built-in arithmetic, so code built with different ISA flags can never be
+ * merged by the linker and leak wide instructions into another target.
+ */
+
+#include <opencog/pln/kernels.hpp>
+
+#include <cstddef>
+
+namespace opencog::pln::kernels::detail {
+
+// Mirrors formulas.hpp; kept local so that header's inline functions are
+// never emitted from an ISA-specific translation unit
+inline constexpr float K = 800.0f;
+inline constexpr float EPS = 1e-10f;
+
+struct KernelTable {
+    SimdLevel level;
+    size_t width;
+
+    void (*deduction)(const float*, const float*, const float*, const float*,
+                      const float*, const float*, float*, float*, size_t) noexcept;
+    void (*inversion)(const float*, const float*, const float*, const float*,
+                      float*, float*, size_t) noexcept;
+    void (*revision)(const float*, const float*, const float*, const float*,
+                     float*, float*, size_t) noexcept;
+    void (*abduction)(const float*, const float*, const float*, const float*,
+                      const float*, const float*, float*, float*, size_t) noexcept;
+    void (*modus_ponens)(const float*, const float*, const float*, const float*,
+                         float*, float*, size_t) noexcept;
+    void (*fuzzy_and)(const float*, const float*, const float*, const float*,
+                      float*, float*, size_t) noexcept;
+    void (*fuzzy_or)(const float*, const float*, const float*, const float*,
+                     float*, float*, size_t) noexcept;
+};
+
+// Defined in ISA-specific translation units; nullptr when not compiled in
+const KernelTable* avx2_table() noexcept;
+const KernelTable* avx512_table() noexcept;
+
+namespace {
+
+// ============================================================================
+// Block Iteration
+// ============================================================================
+
+/**
+ * @brief One vector's worth of a sweep; Tail marks the final partial vector
+ */
+template <class V, bool Tail>
+struct Lane {
+    size_t offset;
+    size_t n;
+
+    [[nodiscard]] typename V::reg load(const float* p) const noexcept {
+        if constexpr (Tail) return V::load_partial(p + offset, n);
+        else return V::load(p + offset);
+    }
+
+    void store(float* p, typename V::reg v) const noexcept {
+        if constexpr (Tail) V::store_partial(p + offset, v, n);
+        else V::store(p + offset, v);
+    }
+};
+
+template <class V, class Body>
+inline void sweep(size_t count, Body&& body) noexcept {
+    size_t i = 0;
+    for (; i + V::lanes <= count; i += V::lanes) body(Lane<V, false>{i, V::lanes});
+    if (i < count) body(Lane<V, true>{i, count - i});
+}
+
+template <class V>
+inline typename V::reg clamp01(typename V::reg x) noexcept {
+    return V::min(V::max(x, V::set1(0.0f)), V::set1(1.0f));
+}
+
+// ============================================================================
+// Kernels
+// ============================================================================
+
+template <class V>
+void deduction(const float* sAB, const float* cAB,
+               const float* sBC, const float* cBC,
+               const float* sB, const float* sC,
+               float* sAC, float* cAC, size_t count) noexcept {
+    const auto one = V::set1(1.0f);
+    const auto eps = V::set1(EPS);
+    const auto factor = V::set1(0.9f);
+
+    sweep<V>(count, [&](auto lane) {
+        auto ab = lane.load(sAB);
+        auto bc = lane.load(sBC);
+        auto b = lane.load(sB);
+        auto c = lane.load(sC);
+
+        // sAB * sBC + (1 - sAB) * (sC - sBC * sB) / (1 - sB + eps)
+        auto term1 = V::mul(ab, bc);
+        auto term2 = V::div(V::mul(V::sub(one, ab), V::sub(c, V::mul(bc, b))),
+                            V::add(V::sub(one, b), eps));
+        lane.store(sAC, clamp01<V>(V::add(term1, term2)));
+        lane.store(cAC, V::mul(V::mul(lane.load(cAB), lane.load(cBC)), factor));
+    });
+}
+
+template <class V>
+void inversion(const float* sAB, const float* cAB,
+               const float* sA, const float* sB,
+               float* sBA, float* cBA, size_t count) noexcept {
+    const auto eps = V::set1(EPS);
+    const auto factor = V::set1(0.7f);
+
+    sweep<V>(count, [&](auto lane) {
+        auto s = V::div(V::mul(lane.load(sAB), lane.load(sA)), V::add(lane.load(sB), eps));
+        lane.store(sBA, clamp01<V>(s));
+        lane.store(cBA, V::mul(lane.load(cAB), factor));
+    });
+}
+
+template <class V>
+void revision(const float* s1, const float* c1,
+              const float* s2, const float* c2,
+              float* s_out, float* c_out, size_t count) noexcept {
+    const auto k = V::set1(K);
+    const auto one = V::set1(1.0f);
+    const auto eps = V::set1(EPS);
+
+    sweep<V>(count, [&](auto lane) {
+        auto conf1 = lane.load(c1);
+        auto conf2 = lane.load(c2);
+
+        // n = c * K / (1 - c + eps)
+        auto n1 = V::div(V::mul(conf1, k), V::add(V::sub(one, conf1), eps));
+        auto n2 = V::div(V::mul(conf2, k), V::add(V::sub(one, conf2), eps));
+        auto n = V::add(n1, n2);
+
+        auto weighted = V::add(V::mul(lane.load(s1), n1), V::mul(lane.load(s2), n2));
+        lane.store(s_out, V::div(weighted, V::add(n, eps)));
+        lane.store(c_out, V::div(n, V::add(n, k)));
+    });
+}
+
+template <class V>
+void abduction(const float* sAB, const float* cAB,
+               const float* sCB, const float* cCB,
+               const float* sB, const float* sC,
+               float* sAC, float* cAC, size_t count) noexcept {
+    const auto one = V::set1(1.0f);
+    const auto eps = V::set1(EPS);
+    const auto factor = V::set1(0.6f);
+
+    sweep<V>(count, [&](auto lane) {
+        auto ab = lane.load(sAB);
+        auto cb = lane.load(sCB);
+        auto b = lane.load(sB);
+        auto c = lane.load(sC);
+
+        // sAB * sCB * sC / sB + (1 - sAB) * (1 - sCB) * sC / (1 - sB)
+        auto term1 = V::div(V::mul(V::mul(ab, cb), c), V::add(b, eps));
+        auto term2 = V::div(V::mul(V::mul(V::sub(one, ab), V::sub(one, cb)), c),
+                            V::add(V::sub(one, b), eps));
+        lane.store(sAC, clamp01<V>(V::add(term1, term2)));
+        lane.store(cAC, V::mul(V::mul(lane.load(cAB), lane.load(cCB)), factor));
+    });
+}
+
+template <class V>
+void modus_ponens(const float* sA, const float* cA,
+                  const float* sAB, const float* cAB,
+                  float* sB, float* cB, size_t count) noexcept {
+    const auto one = V::set1(1.0f);
+    const auto half = V::set1(0.5f);
+    const auto factor = V::set1(0.9f);
+
+    sweep<V>(count, [&](auto lane) {
+        auto a = lane.load(sA);
+        auto s = V::add(V::mul(a, lane.load(sAB)), V::mul(V::sub(one, a), half));
+        lane.store(sB, s);
+        lane.store(cB, V::mul(V::mul(lane.load(cA), lane.load(cAB)), factor));
+    });
+}
+
+template <class V>
+void fuzzy_and(const float* s1, const float* c1,
+               const float* s2, const float* c2,
+               float* s_out, float* c_out, size_t count) noexcept {
+    sweep<V>(count, [&](auto lane) {
+        lane.store(s_out, V::mul(lane.load(s1), lane.load(s2)));
+        lane.store(c_out, V::min(lane.load(c1), lane.load(c2)));
+    });
+}
+
+template <class V>
+void fuzzy_or(const float* s1, const float* c1,
+              const float* s2, const float* c2,
+              float* s_out, float* c_out, size_t count) noexcept {
+    sweep<V>(count, [&](auto lane) {
+        auto a = lane.load(s1);
+        auto b = lane.load(s2);
+        lane.store(s_out, V::sub(V::add(a, b), V::mul(a, b)));
+        lane.store(c_out, V::min(lane.load(c1), lane.load(c2)));
+    });
+}
+
+template <class V>
+constexpr KernelTable make_table(SimdLevel level) noexcept {
+    return KernelTable{
+        level, V::lanes,
+        &deduction<V>, &inversion<V>, &revision<V>, &abduction<V>,
+        &modus_ponens<V>, &fuzzy_and<V>, &fuzzy_or<V>
+    };
+}
+
+} // namespace
+
+} // namespace opencog::pln::kernels::detail
@@ -0,0 +1,107 @@
+/**
+ * @file proof.cpp
+ * @brief Proof DAG arena and lazy step extraction
+ */
+
+#include <opencog/pln/proof.hpp>
+
+#include <algorithm>
+
+namespace opencog::pln {
+
+// ============================================================================
+// Proof Store
+// ============================================================================
+
+ProofStore::ProofStore() : names_(std::make_shared<Names>()) {}
+
+std::shared_ptr<ProofStore> ProofStore::successor() const {
+    auto next = std::make_shared<ProofStore>();
+    next->names_ = names_;
+    return next;
+}
+
+uint32_t ProofStore::intern(std::string_view rule) {
+    std::lock_guard lock(names_->mutex);
+    if (auto it = names_->ids.find(rule); it != names_->ids.end()) return it->second;
+
+    const auto id = static_cast<uint32_t>(names_->names.size());
+    const std::string& name = names_->names.emplace_back(rule);
+    names_->ids.emplace(name, id);
+    return id;
+}
+
+std::string_view ProofStore::rule_name(uint32_t rule) const {
+    std::lock_guard lock(names_->mutex);
+    return rule < names_->names.size() ? std::string_view(names_->names[rule]) : std::string_view{};
+}
+
+void ProofStore::retain(std::shared_ptr<const ProofStore> other) {
+    if (!other || other.get() == this) return;
+    std::lock_guard lock(mutex_);
+    if (std::ranges::find(retained_, other) == retained_.end()) {
+        retained_.push_back(std::move(other));
+    }
+}
+
+const ProofNode* ProofStore::add(uint32_t rule, AtomId conclusion, TruthValue tv,
+                                 std::span<const AtomId> premises,
+                                 std::span<const ProofNode* const> children) {
+    std::lock_guard lock(mutex_);
+
+    std::span<AtomId> premise_copy;
+    if (!premises.empty()) {
+        premise_copy = arena_.allocate_array<AtomId>(premises.size());
+        std::ranges::copy(premises, premise_copy.begin());
+    }
+    std::span<const ProofNode*> child_copy;
+    if (!children.empty()) {
+        child_copy = arena_.allocate_array<const ProofNode*>(children.size());
+        std::ranges::copy(children, child_copy.begin());
+    }
+
+    ++nodes_;
+    return arena_.create<ProofNode>(ProofNode{rule, conclusion, tv, premise_copy, child_copy});
+}
+
+const ProofNode* ProofStore::merge(std::span<const ProofNode* const> alternatives) {
+    if (alternatives.empty()) return nullptr;
+    if (alternatives.size() == 1) return alternatives.front();
+    return add(MERGE, alternatives.front()->conclusion, TruthValue{}, {}, alternatives);
+}
+
+size_t ProofStore::size() const {
+    std::lock_guard lock(mutex_);
+    return nodes_;
+}
+
+size_t ProofStore::bytes_used() const {
+    std::lock_guard lock(mutex_);
+    return arena_.bytes_used();
+}
+
+// ============================================================================
+// Proof Reference
+// ============================================================================
+
+size_t ProofRef::size() const {
+    size_t count = 0;
+    for_each_step([&](const ProofNode&) { ++count; });
+    return count;
+}
+
+std::vector<InferenceStep> ProofRef::steps() const {
+    std::vector<InferenceStep> steps;
+    for_each_step([&](const ProofNode& node) {
+        InferenceStep step;
+        step.rule_name = std::string(store_->rule_name(node.rule));
+        step.premises.reserve(node.premises.size());
+        for (AtomId p : node.premises) step.premises.emplace_back(p, space_);
+        step.conclusion = Handle{node.conclusion, space_};
+        step.computed_tv = node.tv;
+        steps.push_back(std::move(step));
+    });
+    return steps;
+}
+
+} // namespace opencog::pln
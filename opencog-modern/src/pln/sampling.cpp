@@ -0,0 +1,70 @@
+/**
+ * @file sampling.cpp
+ * @brief Fenwick tree weighted sampler
+ */
+
+#include <opencog/pln/sampling.hpp>
+
+#include <algorithm>
+#include <bit>
+
+namespace opencog::pln {
+
+void WeightedSampler::build(std::span<const float> weights) {
+    const size_t n = weights.size();
+    weights_.resize(n);
+
+    double sum = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        weights_[i] = std::max(static_cast<double>(weights[i]), 0.0);
+        sum += weights_[i];
+    }
+    if (sum <= 0.0) std::ranges::fill(weights_, 1.0);   // Uniform
+
+    // Linear construction: push each node's sum into its parent
+    tree_.assign(n + 1, 0.0);
+    total_ = 0.0;
+    live_ = 0;
+    for (size_t i = 1; i <= n; ++i) {
+        tree_[i] += weights_[i - 1];
+        if (size_t parent = i + (i & (~i + 1)); parent <= n) tree_[parent] += tree_[i];
+        total_ += weights_[i - 1];
+        if (weights_[i - 1] > 0.0) ++live_;
+    }
+}
+
+void WeightedSampler::update(size_t i, double weight) {
+    if (i >= weights_.size()) return;
+    weight = std::max(weight, 0.0);
+
+    const double delta = weight - weights_[i];
+    if (weights_[i] > 0.0 && weight == 0.0) --live_;
+    if (weights_[i] == 0.0 && weight > 0.0) ++live_;
+    weights_[i] = weight;
+
+    for (size_t j = i + 1; j < tree_.size(); j += j & (~j + 1)) tree_[j] += delta;
+    total_ = live_ > 0 ? std::max(total_ + delta, 0.0) : 0.0;
+}
+
+size_t WeightedSampler::find(double u) const noexcept {
+    const size_t n = weights_.size();
+    size_t pos = 0;
+    for (size_t step = std::bit_floor(n); step > 0; step >>= 1) {
+        if (pos + step <= n && tree_[pos + step] <= u) {
+            pos += step;
+            u -= tree_[pos];
+        }
+    }
+
+    // Rounding can land past the end or on a removed index; fall back to
+    // the nearest index still carrying weight
+    pos = std::min(pos, n - 1);
+    if (weights_[pos] > 0.0) return pos;
+    for (size_t d = 1; d < n; ++d) {
+        if (pos >= d && weights_[pos - d] > 0.0) return pos - d;
+        if (pos + d < n && weights_[pos + d] > 0.0) return pos + d;
+    }
+    return pos;
+}
+
+} // namespace opencog::pln
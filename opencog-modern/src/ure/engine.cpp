@@ -6,8 +6,12 @@
 #include <opencog/ure/engine.hpp>
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include <queue>
 #include <random>
+#include <thread>
 
 namespace opencog::ure {
 
@@ -58,6 +62,126 @@ std::string InferenceTree::to_string(const AtomSpace& space) const {
     return result;
 }
 
+// ============================================================================
+// ProofRef Implementation
+// ============================================================================
+
+std::vector<size_t> ProofRef::subtree() const {
+    std::vector<size_t> reached;
+    if (empty()) return reached;
+
+    std::unordered_set<size_t> seen{root_};
+    std::vector<size_t> stack{root_};
+    while (!stack.empty()) {
+        const size_t idx = stack.back();
+        stack.pop_back();
+        reached.push_back(idx);
+        for (size_t premise : (*log_)[idx].premise_indices) {
+            if (seen.insert(premise).second) stack.push_back(premise);
+        }
+    }
+
+    // Premises precede their conclusions in the log
+    std::ranges::sort(reached);
+    return reached;
+}
+
+void ProofRef::for_each_node(std::function<void(const InferenceNode&)> fn) const {
+    for (size_t idx : subtree()) fn((*log_)[idx]);
+}
+
+InferenceTree ProofRef::tree() const {
+    InferenceTree tree;
+    const std::vector<size_t> reached = subtree();
+    if (reached.empty()) return tree;
+
+    tree.nodes.reserve(reached.size());
+    for (size_t idx : reached) {
+        InferenceNode node = (*log_)[idx];
+        for (size_t& premise : node.premise_indices) {
+            premise = static_cast<size_t>(std::ranges::lower_bound(reached, premise) -
+                                          reached.begin());
+        }
+        tree.nodes.push_back(std::move(node));
+    }
+    tree.root_index = tree.nodes.size() - 1;
+    return tree;
+}
+
+// ============================================================================
+// GoalTable Implementation
+// ============================================================================
+
+GoalTable::GoalTable(size_t capacity)
+    : capacity_(capacity)
+{
+}
+
+GoalTable::Entry& GoalTable::find_or_add(const GoalKey& key) {
+    if (auto found = index_.find(key.hash); found != index_.end()) {
+        if (found->second->key.same_structure(key)) {
+            entries_.splice(entries_.begin(), entries_, found->second);
+            ++stats_.hits;
+            return *found->second;
+        }
+        // A different goal with the same hash gives way
+        entries_.erase(found->second);
+        index_.erase(found);
+    }
+
+    ++stats_.misses;
+    evict_to(capacity_ > 0 ? capacity_ - 1 : 0);
+    Entry& entry = entries_.emplace_front();
+    entry.key = key;
+    index_[key.hash] = entries_.begin();
+    return entry;
+}
+
+GoalTable::Entry* GoalTable::find(const GoalKey& key) {
+    auto found = index_.find(key.hash);
+    if (found == index_.end() || !found->second->key.same_structure(key)) return nullptr;
+    return &*found->second;
+}
+
+void GoalTable::validate(const AtomSpace& space, Entry& entry) {
+    const AtomTable& table = space.atom_table();
+    auto removed = std::ranges::remove_if(entry.answers, [&](const Answer& answer) {
+        bool gone = !space.contains(answer.result.conclusion) ||
+            !std::ranges::all_of(answer.leaves, [&](const auto& leaf) {
+                return table.contains(leaf.first) && table.get_tv(leaf.first) == leaf.second;
+            });
+        if (!gone && !answer.result.proof.empty()) {
+            answer.result.proof.for_each_node([&](const InferenceNode& node) {
+                gone |= !space.contains(node.atom);
+            });
+        }
+        return gone;
+    });
+    if (removed.empty()) return;
+
+    entry.answers.erase(removed.begin(), removed.end());
+    entry.answered = false;
+    ++stats_.invalidations;
+}
+
+void GoalTable::set_capacity(size_t capacity) {
+    capacity_ = capacity;
+    evict_to(capacity_);
+}
+
+void GoalTable::clear() {
+    entries_.clear();
+    index_.clear();
+}
+
+void GoalTable::evict_to(size_t capacity) {
+    while (entries_.size() > capacity) {
+        index_.erase(entries_.back().key.hash);
+        entries_.pop_back();
+        ++stats_.evictions;
+    }
+}
+
 // ============================================================================
 // SearchState Implementation
 // ============================================================================
@@ -73,103 +197,344 @@ bool UREngine::SearchState::should_stop(const UREConfig& config) const {
     // Check if frontier is empty
     if (frontier.empty()) return true;
 
-    return false;
+    return interrupted(config);
+}
+
+bool UREngine::SearchState::interrupted(const UREConfig& config) const {
+    return stop.stop_requested() ||
+           std::chrono::steady_clock::now() - start_time >= config.timeout;
 }
 
 // ============================================================================
 // UREngine Implementation
 // ============================================================================
 
+// ============================================================================
+// Worker Pool
+// ============================================================================
+
+/**
+ * Persistent helper threads for forward_round_parallel. The calling thread
+ * matches too; atoms of a batch are claimed from a shared counter. Each
+ * atom's firings and slot bindings go to buffers owned by its batch
+ * position, which keep their capacity from batch to batch.
+ */
+struct UREngine::Pool {
+    struct Output {
+        std::vector<RuleFiring> firings;
+        std::vector<AtomId> slots;
+        std::vector<RuleAttempt> attempts;
+    };
+
+    const RuleApplicator* applicator = nullptr;
+    std::vector<std::jthread> threads;
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    uint64_t generation = 0;                // Batches published, under mutex
+    bool stopping = false;
+    std::atomic<size_t> running{0};         // Helper threads still matching
+
+    std::span<const Frontier::Entry> batch;
+    std::vector<Output> outputs;
+    std::atomic<size_t> next{0};
+    std::stop_token stop;
+    bool profile = false;
+
+    void drain() {
+        for (size_t i = next.fetch_add(1, std::memory_order_relaxed); i < batch.size();
+             i = next.fetch_add(1, std::memory_order_relaxed)) {
+            applicator->match_all(batch[i].atom, outputs[i].firings, outputs[i].slots,
+                                  SIZE_MAX, stop, profile ? &outputs[i].attempts : nullptr);
+        }
+    }
+
+    void serve() {
+        uint64_t seen = 0;
+        for (;;) {
+            {
+                std::unique_lock lock(mutex);
+                wake.wait(lock, [&] { return stopping || generation != seen; });
+                if (stopping) return;
+                seen = generation;
+            }
+            drain();
+            if (running.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                running.notify_all();
+            }
+        }
+    }
+
+    /// Match a batch on every thread; returns once all are done
+    void match(std::span<const Frontier::Entry> entries, std::stop_token token, bool timed) {
+        batch = entries;
+        stop = std::move(token);
+        profile = timed;
+        if (outputs.size() < entries.size()) outputs.resize(entries.size());
+        for (size_t i = 0; i < entries.size(); ++i) {
+            outputs[i].firings.clear();
+            outputs[i].slots.clear();
+            outputs[i].attempts.clear();
+        }
+        next.store(0, std::memory_order_relaxed);
+        running.store(threads.size(), std::memory_order_relaxed);
+        {
+            std::lock_guard lock(mutex);
+            ++generation;
+        }
+        wake.notify_all();
+
+        drain();
+        for (size_t left = running.load(std::memory_order_acquire); left != 0;
+             left = running.load(std::memory_order_acquire)) {
+            running.wait(left, std::memory_order_acquire);
+        }
+    }
+
+    ~Pool() {
+        {
+            std::lock_guard lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        threads.clear();   // Joins
+    }
+};
+
 UREngine::UREngine(AtomSpace& space, UREConfig config)
     : space_(space)
     , config_(std::move(config))
     , rules_(space)
     , applicator_(space, rules_)
+    , goals_(config_.goal_table_capacity)
 {
 }
 
+UREngine::~UREngine() = default;
+
 // ============================================================================
 // Forward Chaining
 // ============================================================================
 
-std::vector<UREResult> UREngine::forward_chain(std::span<const Handle> sources) {
-    auto start_time = std::chrono::steady_clock::now();
+std::vector<UREResult> UREngine::forward_chain(std::span<const Handle> sources,
+                                               std::stop_token stop) {
     std::vector<UREResult> results;
 
     SearchState state;
-    state.start_time = start_time;
+    start_forward(state, sources, std::move(stop));
+    while (forward_round(state, results)) {}
+
+    auto elapsed = std::chrono::steady_clock::now() - state.start_time;
+    stats_.total_time += std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
+
+    return results;
+}
+
+generator<UREResult> UREngine::forward_chain_stream(std::vector<Handle> sources,
+                                                    std::stop_token stop) {
+    SearchState state;
+    start_forward(state, sources, std::move(stop));
+
+    // Counts time spent in the search, also when the consumer stops early
+    struct Timer {
+        UREngine& engine;
+        std::chrono::steady_clock::time_point start;
+        ~Timer() {
+            auto elapsed = std::chrono::steady_clock::now() - start;
+            engine.stats_.total_time +=
+                std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
+        }
+    } timer{*this, state.start_time};
+
+    std::vector<UREResult> round;
+    for (bool more = true; more;) {
+        more = forward_round(state, round);
+        for (UREResult& result : round) co_yield std::move(result);
+        round.clear();
+    }
+}
+
+void UREngine::start_forward(SearchState& state, std::span<const Handle> sources,
+                             std::stop_token stop) {
+    begin_search(state);
+    state.frontier = make_frontier();
+    state.start_time = std::chrono::steady_clock::now();
+    state.stop = std::move(stop);
 
     // Initialize frontier with sources
     for (Handle h : sources) {
         if (h.valid()) {
-            state.frontier.push_back(h);
+            state.frontier.push(h);
             state.visited.insert(h.id().value);
         }
     }
 
-    while (!state.should_stop(config_) && results.size() < config_.max_results) {
-        Handle current = select_next(state);
-        if (!current.valid()) break;
+    const size_t threads = config_.threads == 0
+        ? std::max<size_t>(std::thread::hardware_concurrency(), 1)
+        : config_.threads;
+
+    state.parallel = threads > 1;
+    if (state.parallel && (!pool_ || pool_->threads.size() + 1 != threads)) {
+        pool_.reset();
+        pool_ = std::make_unique<Pool>();
+        pool_->applicator = &applicator_;
+        for (size_t i = 1; i < threads; ++i) {
+            pool_->threads.emplace_back([pool = pool_.get()] { pool->serve(); });
+        }
+    }
+}
 
-        // Apply rules to current atom
-        auto step_results = forward_step(current);
+bool UREngine::forward_round(SearchState& state, std::vector<UREResult>& results) {
+    if (state.should_stop(config_) || state.results >= config_.max_results) return false;
+    if (state.parallel) return forward_round_parallel(state, results);
+
+    auto next = select_next(state);
+    if (!next || !next->atom.valid()) return false;
+
+    // Apply rules to current atom
+    state.firings.clear();
+    state.slots.clear();
+    state.attempts.clear();
+    applicator_.match_all(next->atom, state.firings, state.slots, SIZE_MAX, state.stop,
+                          config_.profile_rules ? &state.attempts : nullptr);
+    const Frontier::Entry from = *next;
+    auto accept = [&](const RuleApplicationResult& app_result) {
+        accept_result(state, from, app_result, results);
+    };
+    if (!commit_firings(&state, from.atom, state.firings, state.slots, state.attempts, accept)) {
+        return false;
+    }
+    end_iteration(state);
+    return true;
+}
 
-        for (auto& app_result : step_results) {
-            // Check result filter
-            if (config_.result_filter && !config_.result_filter(app_result.result)) {
-                continue;
-            }
+bool UREngine::forward_round_parallel(SearchState& state, std::vector<UREResult>& results) {
+    // Never take more atoms than the iteration budget has left
+    const size_t batch_size = std::max<size_t>(config_.batch_size, 1);
+    const size_t room = std::min(batch_size, config_.max_iterations - state.iterations);
+    state.batch.clear();
+    while (state.batch.size() < room) {
+        auto next = select_next(state);
+        if (!next || !next->atom.valid()) break;
+        state.batch.push_back(*next);
+    }
+    if (state.batch.empty()) return false;
 
-            // Check confidence threshold
-            if (app_result.computed_tv.confidence < config_.min_result_confidence) {
-                continue;
-            }
+    // Match speculatively on all threads; the AtomSpace is not written
+    pool_->match(state.batch, state.stop, config_.profile_rules);
 
-            // Record the application
-            if (config_.record_proofs) {
-                record_application(state, app_result);
-            }
+    // Commit in frontier order, as the sequential loop would
+    for (size_t i = 0; i < state.batch.size(); ++i) {
+        if (i > 0 && (state.results >= config_.max_results || state.interrupted(config_))) {
+            return false;
+        }
+
+        Pool::Output& out = pool_->outputs[i];
+        auto accept = [&](const RuleApplicationResult& app_result) {
+            accept_result(state, state.batch[i], app_result, results);
+        };
+        if (!commit_firings(&state, state.batch[i].atom, out.firings, out.slots, out.attempts,
+                            accept)) {
+            return false;
+        }
+        end_iteration(state);
+    }
+    return true;
+}
 
-            // Build result
-            UREResult ure_result;
-            ure_result.conclusion = app_result.result;
-            ure_result.tv = app_result.computed_tv;
-            ure_result.iterations_used = state.iterations;
+template<typename Accept>
+bool UREngine::commit_firings(const SearchState* state, Handle source,
+                              std::span<const RuleFiring> firings,
+                              std::span<const AtomId> slots,
+                              std::span<RuleAttempt> attempts,
+                              Accept&& accept) {
+    const bool profile = config_.profile_rules;
+    bool completed = true;
+    size_t attempt = 0;
+
+    for (const RuleFiring& firing : firings) {
+        if (state && state->interrupted(config_)) {
+            completed = false;
+            break;
+        }
 
-            if (config_.record_proofs) {
-                ure_result.proof = build_proof_tree(state);
+        const auto started = profile ? std::chrono::steady_clock::now()
+                                     : std::chrono::steady_clock::time_point{};
+        const size_t atoms_before = profile ? space_.size() : 0;
+        auto app_result = applicator_.commit(source, firing, slots);
+
+        // Firings come grouped by rule, in the order the rules were tried
+        if (profile) {
+            while (attempt < attempts.size() && attempts[attempt].rule != firing.rule) ++attempt;
+            if (attempt < attempts.size()) {
+                attempts[attempt].nanoseconds += static_cast<uint64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now() - started).count());
             }
+            if (app_result) profiler_.record_application(firing.rule, space_.size() - atoms_before);
+        }
 
-            auto elapsed = std::chrono::steady_clock::now() - start_time;
-            ure_result.time_taken = std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
+        if (!app_result) continue;
+        stats_.rules_applied++;
+        accept(*app_result);
+    }
 
-            results.push_back(std::move(ure_result));
-            stats_.atoms_created++;
+    for (const RuleAttempt& a : attempts) profiler_.record_call(a);
+    return completed;
+}
 
-            // Callback
-            if (config_.on_result) {
-                config_.on_result(app_result);
-            }
+void UREngine::accept_result(SearchState& state, const Frontier::Entry& from,
+                             const RuleApplicationResult& app_result,
+                             std::vector<UREResult>& results) {
+    // Check result filter
+    if (config_.result_filter && !config_.result_filter(app_result.result)) {
+        return;
+    }
 
-            // Add to frontier if not visited
-            if (!state.visited.contains(app_result.result.id().value)) {
-                state.frontier.push_back(app_result.result);
-                state.visited.insert(app_result.result.id().value);
-            }
-        }
+    // Check confidence threshold
+    if (app_result.computed_tv.confidence < config_.min_result_confidence) {
+        return;
+    }
 
-        state.iterations++;
-        stats_.total_iterations++;
+    // Build result
+    UREResult ure_result;
+    ure_result.conclusion = app_result.result;
+    ure_result.tv = app_result.computed_tv;
+    ure_result.iterations_used = state.iterations;
 
-        if (config_.on_iteration) {
-            config_.on_iteration(state.iterations);
-        }
+    if (config_.record_proofs) {
+        const size_t node = record_application(state, from.atom, app_result);
+        ure_result.proof = ProofRef(state.proof_log, node, state.rules);
     }
 
-    auto elapsed = std::chrono::steady_clock::now() - start_time;
-    stats_.total_time += std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
+    auto elapsed = std::chrono::steady_clock::now() - state.start_time;
+    ure_result.time_taken = std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
 
-    return results;
+    results.push_back(std::move(ure_result));
+    state.results++;
+    stats_.atoms_created++;
+
+    // Callback
+    if (config_.on_result) {
+        config_.on_result(app_result);
+    }
+
+    // Add to frontier if not visited; a queued atom whose truth
+    // value was revised is re-keyed in place
+    if (state.visited.insert(app_result.result.id().value).second) {
+        state.frontier.push(app_result.result, from.depth + 1);
+    } else {
+        state.frontier.update(app_result.result);
+    }
+}
+
+void UREngine::end_iteration(SearchState& state) {
+    state.iterations++;
+    stats_.total_iterations++;
+
+    if (config_.on_iteration) {
+        config_.on_iteration(state.iterations);
+    }
 }
 
 std::optional<UREResult> UREngine::forward_chain_to(
@@ -192,6 +557,7 @@ std::optional<UREResult> UREngine::forward_chain_to(
     // Find the target in results
     for (auto& result : results) {
         if (result.conclusion.id() == target.id()) {
+            if (config_.profile_rules) credit(result.proof);
             return result;
         }
     }
@@ -200,26 +566,21 @@ std::optional<UREResult> UREngine::forward_chain_to(
 }
 
 std::vector<RuleApplicationResult> UREngine::forward_step(Handle source) {
-    std::vector<RuleApplicationResult> results;
-
-    // Get applicable rules
-    AtomType type = space_.get_type(source);
-    auto applicable_rules = rules_.get_rules_for_type(type);
-
-    // Also try generic rules
-    auto generic_rules = rules_.get_rules_by_priority();
-
-    for (const Rule* rule : applicable_rules) {
-        if (!rule || rule->name.empty()) continue;
-
-        // Try to apply rule
-        auto rule_results = applicator_.find_applicable(source);
-        for (auto& result : rule_results) {
-            results.push_back(std::move(result));
-            stats_.rules_applied++;
-        }
-    }
+    applicator_.refresh();
+    return apply_rules(source);
+}
 
+std::vector<RuleApplicationResult> UREngine::apply_rules(Handle source) {
+    // One index lookup finds every rule with a premise clause unifying
+    // with the source, already in priority order
+    std::vector<RuleApplicationResult> results;
+    std::vector<RuleFiring> firings;
+    std::vector<AtomId> slots;
+    std::vector<RuleAttempt> attempts;
+    applicator_.match_all(source, firings, slots, SIZE_MAX, {},
+                          config_.profile_rules ? &attempts : nullptr);
+    static_cast<void>(commit_firings(nullptr, source, firings, slots, attempts,
+        [&](RuleApplicationResult& app_result) { results.push_back(std::move(app_result)); }));
     return results;
 }
 
@@ -228,9 +589,53 @@ std::vector<RuleApplicationResult> UREngine::forward_step(Handle source) {
 // ============================================================================
 
 std::optional<UREResult> UREngine::backward_chain(Handle target) {
-    auto start_time = std::chrono::steady_clock::now();
+    auto proofs = prove(target, 1);
+    if (proofs.empty()) return std::nullopt;
+    return std::move(proofs.front());
+}
 
-    if (!target.valid()) return std::nullopt;
+std::vector<UREResult> UREngine::find_all_proofs(Handle target, size_t max_proofs) {
+    return prove(target, max_proofs);
+}
+
+std::vector<UREResult> UREngine::prove(Handle target, size_t max_proofs) {
+    std::vector<UREResult> proofs;
+    if (!target.valid() || max_proofs == 0) return proofs;
+
+    SearchState state;
+    begin_search(state);
+    state.start_time = std::chrono::steady_clock::now();
+
+    auto finish = [&] {
+        // Table what the search finished: a ground goal's proofs, and
+        // whether they are all of them
+        std::vector<GoalTable::Entry*> listed;
+        if (config_.goal_table_capacity > 0) {
+            for (const auto& [id, solved] : state.solved) {
+                canonicalize_goal(space_, solved.goal, goal_key_);
+                GoalTable::Entry* entry = goals_.find(goal_key_);
+                if (!entry || entry->key.variables != 0) continue;
+                if (solved.complete || solved.answers.size() > entry->answers.size()) {
+                    entry->answers = solved.answers;
+                    entry->answered = solved.complete;
+                }
+                if (entry->answered) listed.push_back(entry);
+            }
+        }
+
+        // Subgoal atoms nothing was proven for are only search state:
+        // newest first, so links go before their parts
+        for (auto it = state.scaffold.rbegin(); it != state.scaffold.rend(); ++it) {
+            if (!state.derived.contains(it->value)) space_.remove(*it, false);
+        }
+
+        // Applying rules and the subgoals added atoms; the lists are as of now
+        for (GoalTable::Entry* entry : listed) entry->answered_at = space_.version();
+
+        auto elapsed = std::chrono::steady_clock::now() - state.start_time;
+        stats_.total_time += std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
+        return std::move(proofs);
+    };
 
     // Check if already grounded
     TruthValue tv = space_.get_tv(target);
@@ -239,83 +644,251 @@ std::optional<UREResult> UREngine::backward_chain(Handle target) {
         result.conclusion = target;
         result.tv = tv;
         result.iterations_used = 0;
-        return result;
+        proofs.push_back(std::move(result));
+        if (proofs.size() >= max_proofs) return finish();
     }
 
-    // Find rules whose conclusion could unify with target
-    SearchState state;
-    state.start_time = start_time;
-    state.frontier.push_back(target);
+    size_t low = SIZE_MAX;
+    for (GoalTable::Answer& answer : solve_goal(state, target, max_proofs - proofs.size(), 1, low)) {
+        proofs.push_back(std::move(answer.result));
+    }
+    return finish();
+}
 
-    while (!state.should_stop(config_)) {
-        if (state.frontier.empty()) break;
+std::vector<GoalTable::Answer> UREngine::solve_goal(
+    SearchState& state,
+    Handle goal,
+    size_t wanted,
+    size_t depth,
+    size_t& low
+) {
+    std::vector<GoalTable::Answer> found;
+    const uint64_t id = goal.id().value;
+
+    // Proven earlier in this search
+    if (auto it = state.solved.find(id); it != state.solved.end()) {
+        const auto& answers = it->second.answers;
+        if (it->second.complete || answers.size() >= wanted) {
+            stats_.answer_hits++;
+            const size_t n = std::min(wanted, answers.size());
+            found.assign(answers.begin(), answers.begin() + static_cast<std::ptrdiff_t>(n));
+            return found;
+        }
+    }
 
-        Handle current = state.frontier.back();
-        state.frontier.pop_back();
+    // A goal already being proven closes a cycle: fail this path, and keep
+    // the goals above the cycle's head from counting as complete
+    if (auto it = state.open.find(id); it != state.open.end()) {
+        low = std::min(low, it->second);
+        return found;
+    }
+    if (depth > config_.max_proof_depth || state.iterations >= config_.max_iterations ||
+        state.interrupted(config_)) {
+        low = 0;
+        return found;
+    }
 
-        auto step_results = backward_step(current);
+    // A ground goal's proofs are reusable while their atoms exist; the
+    // list of all of them only while the AtomSpace is unchanged
+    GoalTable::Entry* entry = goal_entry(goal);
+    if (entry && entry->key.variables == 0) {
+        goals_.validate(space_, *entry);
+        const bool all = entry->answered && entry->answered_at == space_.version();
+        if (all || entry->answers.size() >= wanted) {
+            stats_.answer_hits++;
+            const size_t n = std::min(wanted, entry->answers.size());
+            found.assign(entry->answers.begin(),
+                         entry->answers.begin() + static_cast<std::ptrdiff_t>(n));
+            return found;
+        }
+        stats_.answer_misses++;
+    }
 
-        for (auto& [rule, bindings] : step_results) {
-            // Try to prove premises
-            // This would recursively call backward_chain on each premise
+    // Read before recursing: subgoals reuse the goal key and may evict the entry
+    const auto expansions = expand_goal(goal, entry);
 
-            // For now, check if premises are grounded
-            bool all_grounded = true;
-            // ... premise checking logic ...
+    state.open.emplace(id, depth);
+    size_t my_low = depth;
+    bool exhausted = true;
 
-            if (all_grounded) {
-                // Apply rule
-                auto app_result = applicator_.apply(*rule, bindings);
-                if (app_result) {
-                    UREResult result;
-                    result.conclusion = app_result->result;
-                    result.tv = app_result->computed_tv;
-                    result.iterations_used = state.iterations;
+    // A premise is in the AtomSpace, or proven as a subgoal
+    struct Premise {
+        AtomId atom;
+        std::optional<GoalTable::Answer> proof;
+    };
+    std::vector<Premise> premises;
+    std::vector<AtomId> slots;
 
-                    auto elapsed = std::chrono::steady_clock::now() - start_time;
-                    result.time_taken = std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
+    for (const auto& [rule, bindings] : expansions) {
+        if (found.size() >= wanted) {
+            exhausted = false;
+            break;
+        }
+        if (state.iterations >= config_.max_iterations || state.interrupted(config_)) {
+            exhausted = false;
+            my_low = 0;
+            break;
+        }
+        state.iterations++;
 
-                    return result;
-                }
+        const RuleProgram& program = *rule->program;
+        slots.assign(program.slots(), ATOM_NULL);
+        program.from_bindings(bindings, slots);
+        premises.clear();
+        for (size_t c = 0; c < program.clauses(); ++c) {
+            AtomId premise = program.lookup_clause(space_, c, slots);
+            if (premise.valid() && !state.open.contains(premise.value) &&
+                std::ranges::find(state.scaffold, premise) == state.scaffold.end()) {
+                premises.push_back(Premise{premise, std::nullopt});
+                continue;
             }
-        }
 
-        state.iterations++;
-    }
+            // Missing: add it as a goal, unless a variable only the
+            // premises use leaves it unground
+            Handle subgoal = premise.valid()
+                ? space_.make_handle(premise)
+                : program.instantiate_clause(space_, c, slots, &state.scaffold);
+            if (!subgoal.valid()) break;
 
-    return std::nullopt;
-}
+            auto sub = solve_goal(state, subgoal, 1, depth + 1, my_low);
+            if (sub.empty()) break;
+            premises.push_back(Premise{subgoal.id(), std::move(sub.front())});
+        }
+        if (premises.size() != program.clauses()) continue;
+
+        // The truth values the answer is computed from, to revalidate it by
+        std::vector<std::pair<AtomId, TruthValue>> leaves;
+        for (const Premise& premise : premises) {
+            if (premise.proof) {
+                leaves.insert(leaves.end(), premise.proof->leaves.begin(),
+                              premise.proof->leaves.end());
+            } else {
+                leaves.emplace_back(premise.atom, space_.atom_table().get_tv(premise.atom));
+            }
+        }
 
-std::vector<UREResult> UREngine::find_all_proofs(Handle target, size_t max_proofs) {
-    std::vector<UREResult> proofs;
+        // Apply rule
+        auto app_result = applicator_.apply(*rule, bindings);
+        if (!app_result) continue;
+        stats_.rules_applied++;
+        state.derived.insert(app_result->result.id().value);
 
-    // Run backward chaining multiple times with different strategies
-    auto first = backward_chain(target);
-    if (first) {
-        proofs.push_back(std::move(*first));
+        UREResult result;
+        result.conclusion = app_result->result;
+        result.tv = app_result->computed_tv;
+        result.iterations_used = state.iterations;
+        auto elapsed = std::chrono::steady_clock::now() - state.start_time;
+        result.time_taken = std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
+
+        if (config_.record_proofs) {
+            // Inputs and subgoal proofs first, then the step concluding the goal
+            auto log = std::make_shared<std::vector<InferenceNode>>();
+            InferenceNode step{result.conclusion, rule, std::move(app_result->bindings),
+                               result.tv, {}, 1};
+            for (const Premise& premise : premises) {
+                if (premise.proof && !premise.proof->result.proof.empty()) {
+                    InferenceTree tree = premise.proof->result.proof.tree();
+                    const size_t offset = log->size();
+                    step.depth = std::max(step.depth, tree.root().depth + 1);
+                    step.premise_indices.push_back(offset + tree.root_index);
+                    for (InferenceNode& node : tree.nodes) {
+                        for (size_t& index : node.premise_indices) index += offset;
+                        log->push_back(std::move(node));
+                    }
+                    continue;
+                }
+                step.premise_indices.push_back(log->size());
+                Handle atom = space_.make_handle(premise.atom);
+                log->push_back(InferenceNode{atom, nullptr, {}, space_.get_tv(atom), {}, 0});
+            }
+            const size_t root = log->size();
+            log->push_back(std::move(step));
+            result.proof = ProofRef(std::move(log), root, state.rules);
+        }
+        found.push_back(GoalTable::Answer{std::move(result), std::move(leaves)});
     }
 
-    // Additional proof search could use different rule orderings, etc.
+    state.open.erase(id);
 
-    return proofs;
+    // Memoize unless a cycle through a goal still open, or a limit, may
+    // have hidden proofs
+    const bool complete = exhausted && my_low >= depth;
+    if (complete || !found.empty()) {
+        state.solved[id] = SearchState::Solved{goal, found, complete};
+    }
+    low = std::min(low, my_low);
+    return found;
 }
 
 std::vector<std::pair<const Rule*, BindingSet>> UREngine::backward_step(Handle target) {
-    std::vector<std::pair<const Rule*, BindingSet>> results;
+    applicator_.refresh();
+    return match_conclusions(target);
+}
 
-    // Find rules whose conclusion could unify with target
-    for (const Rule* rule : rules_.get_rules_by_priority()) {
-        if (!rule || !rule->valid()) continue;
+std::vector<std::pair<const Rule*, BindingSet>> UREngine::match_conclusions(Handle target) {
+    return expand_goal(target, goal_entry(target));
+}
+
+GoalTable::Entry* UREngine::goal_entry(Handle goal) {
+    if (config_.goal_table_capacity == 0 || !goal.valid()) return nullptr;
 
-        // Check if conclusion could unify
-        // Full implementation would use pattern matcher
+    // Expansions name rules of one snapshot
+    if (goal_rules_ != applicator_.snapshot()) {
+        goals_.clear();
+        goal_rules_ = applicator_.snapshot();
+    }
+    canonicalize_goal(space_, goal, goal_key_);
+    return &goals_.find_or_add(goal_key_);
+}
 
-        // Placeholder: simple type check
-        if (space_.get_type(rule->conclusion) == space_.get_type(target)) {
+std::vector<std::pair<const Rule*, BindingSet>> UREngine::expand_goal(
+    Handle goal,
+    GoalTable::Entry* entry
+) {
+    std::vector<std::pair<const Rule*, BindingSet>> results;
+    if (!goal.valid()) return results;
+
+    // Read a memoized expansion back with this goal's atoms
+    std::vector<AtomId> slots;
+    if (entry && entry->expanded) {
+        stats_.expansion_hits++;
+        for (const GoalTable::Expansion& expansion : entry->expansions) {
+            slots.clear();
+            for (uint32_t position : expansion.positions) {
+                slots.push_back(position == GoalTable::UNBOUND ? ATOM_NULL
+                                                               : goal_key_.atoms[position]);
+            }
             BindingSet bindings;
-            results.emplace_back(rule, bindings);
+            expansion.rule->program->to_bindings(slots, bindings);
+            results.emplace_back(expansion.rule, std::move(bindings));
+        }
+        return results;
+    }
+
+    // Find rules whose conclusion could unify with target
+    if (entry) stats_.expansion_misses++;
+    for (const Rule* rule : applicator_.rules().by_priority()) {
+        if (!rule->valid()) continue;
+
+        const RuleProgram& program = *rule->program;
+        slots.assign(program.slots(), ATOM_NULL);
+        if (!program.match_conclusion(space_, goal.id(), slots)) continue;
+
+        BindingSet bindings;
+        program.to_bindings(slots, bindings);
+        results.emplace_back(rule, std::move(bindings));
+
+        // Bindings are subtrees of the goal; keep where they were
+        if (entry) {
+            GoalTable::Expansion& expansion = entry->expansions.emplace_back();
+            expansion.rule = rule;
+            for (AtomId bound : slots) {
+                expansion.positions.push_back(bound.valid() ? goal_key_.position_of(bound)
+                                                            : GoalTable::UNBOUND);
+            }
         }
     }
+    if (entry) entry->expanded = true;
 
     return results;
 }
@@ -328,145 +901,275 @@ std::optional<UREResult> UREngine::bidirectional_chain(
     std::span<const Handle> sources,
     Handle target
 ) {
-    // Run forward and backward in alternation
-    // Meet in the middle
+    if (!target.valid()) return std::nullopt;
 
     SearchState forward_state, backward_state;
+    begin_search(forward_state);
+    forward_state.frontier = make_frontier();
+    backward_state.frontier = make_frontier();
     forward_state.start_time = std::chrono::steady_clock::now();
     backward_state.start_time = forward_state.start_time;
 
-    // Initialize
-    for (Handle h : sources) {
-        forward_state.frontier.push_back(h);
-        forward_state.visited.insert(h.id().value);
-    }
-    backward_state.frontier.push_back(target);
-    backward_state.visited.insert(target.id().value);
-
-    while (!forward_state.should_stop(config_) && !backward_state.should_stop(config_)) {
-        // One forward step
-        if (!forward_state.frontier.empty()) {
-            Handle current = select_next(forward_state);
-            auto results = forward_step(current);
-
-            for (auto& result : results) {
-                // Check if we've reached something in backward frontier
-                if (backward_state.visited.contains(result.result.id().value)) {
-                    // Found connection!
-                    UREResult ure_result;
-                    ure_result.conclusion = result.result;
-                    ure_result.tv = result.computed_tv;
-                    return ure_result;
-                }
+    std::vector<BackwardGoal> goals;
+    std::unordered_map<uint64_t, uint32_t> goal_of;     // Goal atom -> goal
+    GoalIndex goal_index;
+    std::vector<Handle> reached;                        // Forward atoms, in order
+    std::vector<uint32_t> candidates;
+
+    auto finish = [&](std::optional<UREResult> result) {
+        auto elapsed = std::chrono::steady_clock::now() - forward_state.start_time;
+        stats_.total_time += std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
+
+        // Subgoals are only search state: take out the atoms made for them,
+        // newest first so links go before their parts, unless the search
+        // reached or derived them, or another atom has come to use them
+        for (auto it = backward_state.scaffold.rbegin(); it != backward_state.scaffold.rend(); ++it) {
+            if (forward_state.visited.contains(it->value) ||
+                forward_state.derived.contains(it->value)) {
+                continue;
+            }
+            space_.remove(*it, false);
+        }
 
-                forward_state.frontier.push_back(result.result);
-                forward_state.visited.insert(result.result.id().value);
+        if (result) {
+            result->iterations_used = forward_state.iterations;
+            result->time_taken = std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
+            if (config_.profile_rules) credit(result->proof);
+
+            // Later searches for a ground target can reuse the proof, while
+            // its input atoms keep their truth values; without a proof
+            // there is nothing to check it by
+            GoalTable::Entry* entry = goal_entry(target);
+            if (entry && entry->key.variables == 0 && entry->answers.empty() &&
+                !result->proof.empty()) {
+                GoalTable::Answer answer{*result, {}};
+                result->proof.for_each_node([&](const InferenceNode& node) {
+                    if (!node.rule_used) answer.leaves.emplace_back(node.atom.id(), node.tv);
+                });
+                entry->answers.push_back(std::move(answer));
             }
         }
+        return result;
+    };
 
-        // One backward step
-        if (!backward_state.frontier.empty()) {
-            Handle current = backward_state.frontier.back();
-            backward_state.frontier.pop_back();
+    // A forward atom meets every indexed goal it instantiates
+    auto meet_forward = [&](Handle atom, TruthValue tv) -> std::optional<UREResult> {
+        candidates.clear();
+        goal_index.find(space_, atom, candidates);
+        for (uint32_t goal : candidates) {
+            BindingSet bindings;
+            if (!unify_premise(space_, goals[goal].atom, atom, bindings)) continue;
+            if (auto result = resolve_goal(forward_state, goals, goal, atom, tv)) return result;
+        }
+        return std::nullopt;
+    };
 
-            // Check if connected to forward
-            if (forward_state.visited.contains(current.id().value)) {
-                UREResult result;
-                result.conclusion = current;
-                result.tv = space_.get_tv(current);
+    // A new goal meets the forward atoms found before it
+    auto add_goal = [&](BackwardGoal goal, size_t depth) -> std::optional<UREResult> {
+        if (!goal_of.try_emplace(goal.atom.id().value, static_cast<uint32_t>(goals.size())).second) {
+            return std::nullopt;
+        }
+        const auto id = static_cast<uint32_t>(goals.size());
+        goals.push_back(goal);
+        goal_index.insert(space_, goal.atom, id);
+        backward_state.frontier.push(goal.atom, depth);
+
+        if (!has_variables(space_, goal.atom)) {
+            if (!forward_state.visited.contains(goal.atom.id().value)) return std::nullopt;
+            return resolve_goal(forward_state, goals, id, goal.atom, space_.get_tv(goal.atom));
+        }
+        for (Handle atom : reached) {
+            BindingSet bindings;
+            if (!unify_premise(space_, goal.atom, atom, bindings)) continue;
+            if (auto result = resolve_goal(forward_state, goals, id, atom, space_.get_tv(atom))) {
                 return result;
             }
+        }
+        return std::nullopt;
+    };
 
-            auto premises = backward_step(current);
-            // Add premises to backward frontier
+    // A proof of the target found by an earlier search
+    if (GoalTable::Entry* known = goal_entry(target); known && known->key.variables == 0) {
+        goals_.validate(space_, *known);
+        if (!known->answers.empty()) {
+            stats_.answer_hits++;
+            return finish(known->answers.front().result);
         }
     }
 
-    return std::nullopt;
-}
+    // Initialize
+    if (auto result = add_goal(BackwardGoal{target}, 0)) return finish(result);
+    for (Handle h : sources) {
+        if (!h.valid() || !forward_state.visited.insert(h.id().value).second) continue;
+        forward_state.frontier.push(h);
+        reached.push_back(h);
+        if (auto result = meet_forward(h, space_.get_tv(h))) return finish(result);
+    }
 
-// ============================================================================
-// Internal Methods
-// ============================================================================
+    std::unordered_set<std::string> goal_variables;
+    while (forward_state.iterations < config_.max_iterations &&
+           std::chrono::steady_clock::now() - forward_state.start_time < config_.timeout) {
+        const bool can_forward = !forward_state.frontier.empty();
+        const bool can_backward = !backward_state.frontier.empty();
+        if (!can_forward && !can_backward) break;
+
+        // Grow the smaller frontier
+        const bool forward = can_forward &&
+            (!can_backward || forward_state.frontier.size() <= backward_state.frontier.size());
+
+        if (forward) {
+            auto next = select_next(forward_state);
+            if (!next) break;
+            for (auto& result : apply_rules(next->atom)) {
+                if (config_.record_proofs) {
+                    static_cast<void>(record_application(forward_state, next->atom, result));
+                }
+                if (forward_state.visited.insert(result.result.id().value).second) {
+                    forward_state.frontier.push(result.result, next->depth + 1);
+                    reached.push_back(result.result);
+                }
+                if (auto met = meet_forward(result.result, result.computed_tv)) return finish(met);
+            }
+        } else {
+            auto next = select_next(backward_state);
+            if (!next) break;
+            const uint32_t parent = goal_of.at(next->atom.id().value);
+
+            // Premise variables the conclusion left unbound must not
+            // capture the goal's own variables
+            goal_variables.clear();
+            const AtomTable& table = space_.atom_table();
+            auto collect = [&](auto& self, AtomId id) -> void {
+                const AtomType type = table.get_type(id);
+                if (type == AtomType::VARIABLE_NODE) {
+                    goal_variables.emplace(space_.get_name(space_.make_handle(id)));
+                } else if (is_link(type)) {
+                    for (AtomId child : table.get_outgoing(id)) self(self, child);
+                }
+            };
+            collect(collect, next->atom.id());
+
+            if (next->depth < config_.max_proof_depth) {
+                for (auto& [rule, bindings] : match_conclusions(next->atom)) {
+                    const RuleProgram& program = *rule->program;
+                    for (size_t v = 0; v < program.slots(); ++v) {
+                        const std::string& name = program.variable_name(v);
+                        if (bindings.contains(name) || !goal_variables.contains(name)) continue;
+                        const std::string renamed = name + "'" + std::to_string(goals.size());
+                        Handle fresh = space_.get_node(AtomType::VARIABLE_NODE, renamed);
+                        if (!fresh.valid()) {
+                            fresh = space_.add_node(AtomType::VARIABLE_NODE, renamed);
+                            backward_state.scaffold.push_back(fresh.id());
+                        }
+                        bindings.bind(name, fresh.id());
+                    }
+
+                    auto clauses = premise_clauses(space_, rule->premise);
+                    for (uint32_t c = 0; c < clauses.size(); ++c) {
+                        BackwardGoal goal{substitute(space_, clauses[c], bindings,
+                                                     &backward_state.scaffold),
+                                          parent, rule, c};
+                        if (auto met = add_goal(goal, next->depth + 1)) return finish(met);
+                    }
+                }
+            }
+        }
 
-Handle UREngine::select_next(SearchState& state) {
-    if (state.frontier.empty()) return Handle{};
+        end_iteration(forward_state);
+    }
 
-    switch (config_.strategy) {
-        case SearchStrategy::BFS: {
-            Handle h = state.frontier.front();
-            state.frontier.erase(state.frontier.begin());
-            return h;
-        }
+    return finish(std::nullopt);
+}
 
-        case SearchStrategy::DFS: {
-            Handle h = state.frontier.back();
-            state.frontier.pop_back();
-            return h;
+std::optional<UREResult> UREngine::resolve_goal(
+    SearchState& state,
+    const std::vector<BackwardGoal>& goals,
+    uint32_t goal,
+    Handle atom,
+    TruthValue tv
+) {
+    // Apply each goal's rule to the atom meeting it, yielding an atom
+    // that meets its parent
+    std::optional<size_t> node;
+    std::vector<AtomId> slots;
+    for (; goals[goal].parent != BackwardGoal::ROOT; goal = goals[goal].parent) {
+        const BackwardGoal& step = goals[goal];
+        const RuleProgram& program = *step.rule->program;
+
+        slots.assign(program.slots(), ATOM_NULL);
+        if (!program.match(space_, step.clause, atom.id(), slots)) return std::nullopt;
+        BindingSet bindings;
+        program.to_bindings(slots, bindings);
+
+        auto applied = applicator_.apply(*step.rule, bindings);
+        if (!applied) return std::nullopt;
+        BindingSet parent_bindings;
+        if (!unify_premise(space_, goals[step.parent].atom, applied->result, parent_bindings)) {
+            return std::nullopt;
         }
 
-        case SearchStrategy::BEST_FIRST: {
-            // Find highest priority
-            size_t best_idx = 0;
-            float best_priority = -std::numeric_limits<float>::infinity();
-
-            for (size_t i = 0; i < state.frontier.size(); ++i) {
-                float p = compute_priority(state.frontier[i], nullptr);
-                if (p > best_priority) {
-                    best_priority = p;
-                    best_idx = i;
-                }
-            }
+        stats_.rules_applied++;
+        stats_.atoms_created++;
+        state.derived.insert(applied->result.id().value);
+        if (config_.record_proofs) node = record_application(state, atom, *applied);
+        atom = applied->result;
+        tv = applied->computed_tv;
+    }
 
-            Handle h = state.frontier[best_idx];
-            state.frontier.erase(state.frontier.begin() + best_idx);
-            return h;
+    UREResult result;
+    result.conclusion = atom;
+    result.tv = tv;
+    if (config_.record_proofs && state.proof_log) {
+        if (!node) {
+            auto it = state.proof_of.find(atom.id().value);
+            if (it != state.proof_of.end()) node = it->second;
         }
+        if (node) result.proof = ProofRef(state.proof_log, *node, state.rules);
+    }
+    return result;
+}
 
-        case SearchStrategy::ATTENTION: {
-            if (!attention_) {
-                // Fallback to BFS
-                Handle h = state.frontier.front();
-                state.frontier.erase(state.frontier.begin());
-                return h;
-            }
+// ============================================================================
+// Rule Profiling
+// ============================================================================
 
-            // Select by STI
-            size_t best_idx = 0;
-            float best_sti = -std::numeric_limits<float>::infinity();
+void UREngine::credit(const ProofRef& proof) {
+    proof.for_each_node([this](const InferenceNode& node) { profiler_.credit(node.rule_used); });
+}
 
-            for (size_t i = 0; i < state.frontier.size(); ++i) {
-                float sti = space_.get_av(state.frontier[i]).sti;
-                if (config_.use_attention) {
-                    sti *= config_.attention_boost;
-                }
-                if (sti > best_sti) {
-                    best_sti = sti;
-                    best_idx = i;
-                }
-            }
+// ============================================================================
+// Internal Methods
+// ============================================================================
 
-            Handle h = state.frontier[best_idx];
-            state.frontier.erase(state.frontier.begin() + best_idx);
-            return h;
-        }
+void UREngine::begin_search(SearchState& state) {
+    applicator_.refresh();
+    state.rules = applicator_.snapshot();
+}
+
+Frontier UREngine::make_frontier() const {
+    uint64_t seed = config_.random_seed;
+    if (config_.strategy == SearchStrategy::RANDOM && seed == 0) seed = std::random_device{}();
 
-        case SearchStrategy::RANDOM: {
-            static std::mt19937 rng(std::random_device{}());
-            std::uniform_int_distribution<size_t> dist(0, state.frontier.size() - 1);
-            size_t idx = dist(rng);
+    switch (config_.strategy) {
+        case SearchStrategy::BEST_FIRST:
+            return Frontier(config_.strategy,
+                            [this](Handle h) { return compute_priority(h, nullptr); });
 
-            Handle h = state.frontier[idx];
-            state.frontier.erase(state.frontier.begin() + idx);
-            return h;
+        case SearchStrategy::ATTENTION: {
+            // Without an attention bank there is no STI to follow: BFS
+            if (!attention_) return Frontier(SearchStrategy::BFS);
+            const float boost = config_.use_attention ? config_.attention_boost : 1.0f;
+            return Frontier(config_.strategy,
+                            [this, boost](Handle h) { return space_.get_av(h).sti * boost; });
         }
 
-        case SearchStrategy::ITERATIVE_DEEPENING:
-            // Would need additional depth tracking
-            return state.frontier.back();
+        default:
+            return Frontier(config_.strategy, {}, seed, config_.max_proof_depth);
     }
+}
 
-    return Handle{};
+std::optional<Frontier::Entry> UREngine::select_next(SearchState& state) {
+    return state.frontier.pop();
 }
 
 float UREngine::compute_priority(Handle h, const Rule* rule) const {
@@ -491,25 +1194,37 @@ float UREngine::compute_priority(Handle h, const Rule* rule) const {
     return priority;
 }
 
-void UREngine::record_application(
+size_t UREngine::record_application(
     SearchState& state,
+    Handle source,
     const RuleApplicationResult& result
 ) {
+    if (!state.proof_log) state.proof_log = std::make_shared<std::vector<InferenceNode>>();
+    auto& log = *state.proof_log;
+
+    // An input atom gets a leaf the first time something is derived from it
+    auto [it, fresh] = state.proof_of.try_emplace(source.id().value, log.size());
+    if (fresh) {
+        InferenceNode leaf;
+        leaf.atom = source;
+        leaf.tv = space_.get_tv(source);
+        log.push_back(std::move(leaf));
+    }
+    const size_t premise = it->second;
+
     InferenceNode node;
     node.atom = result.result;
     node.rule_used = result.rule;
     node.bindings = result.bindings;
     node.tv = result.computed_tv;
-    node.depth = state.proof_nodes.empty() ? 0 : state.proof_nodes.back().depth + 1;
-
-    state.proof_nodes.push_back(std::move(node));
-}
-
-InferenceTree UREngine::build_proof_tree(const SearchState& state) const {
-    InferenceTree tree;
-    tree.nodes = state.proof_nodes;
-    tree.root_index = tree.nodes.empty() ? 0 : tree.nodes.size() - 1;
-    return tree;
+    node.premise_indices.push_back(premise);
+    node.depth = log[premise].depth + 1;
+
+    // Later derivations from this atom build on its first proof
+    const size_t index = log.size();
+    state.proof_of.try_emplace(result.result.id().value, index);
+    log.push_back(std::move(node));
+    return index;
 }
 
 // ============================================================================
@@ -0,0 +1,253 @@
+/**
+ * @file frontier.cpp
+ * @brief Strategy-specific URE search frontiers
+ */
+
+#include <opencog/ure/frontier.hpp>
+
+#include <algorithm>
+
+namespace opencog::ure {
+
+Frontier::Frontier(SearchStrategy strategy, KeyFunction key, uint64_t seed, size_t max_depth)
+    : strategy_(strategy)
+    , key_(std::move(key))
+    , rng_(seed)
+    , max_depth_(max_depth)
+{
+}
+
+bool Frontier::is_heap() const noexcept {
+    return strategy_ == SearchStrategy::BEST_FIRST || strategy_ == SearchStrategy::ATTENTION;
+}
+
+// ============================================================================
+// Push / Pop
+// ============================================================================
+
+void Frontier::push(Handle atom, size_t depth) {
+    Entry entry{atom, depth, 0.0f};
+
+    switch (strategy_) {
+        case SearchStrategy::BFS:
+            ring_push(entry);
+            return;
+
+        case SearchStrategy::DFS:
+        case SearchStrategy::RANDOM:
+            items_.push_back(entry);
+            return;
+
+        case SearchStrategy::ITERATIVE_DEEPENING:
+            if (depth > max_depth_) return;
+            (depth > depth_limit_ ? deferred_ : items_).push_back(entry);
+            return;
+
+        case SearchStrategy::BEST_FIRST:
+        case SearchStrategy::ATTENTION: {
+            entry.priority = key_of(atom);
+            if (auto it = slot_of_.find(atom.id()); it != slot_of_.end()) {
+                Entry& queued = slots_[it->second];
+                queued.depth = std::min(queued.depth, depth);
+                heap_rekey(it->second, entry.priority);
+                return;
+            }
+
+            uint32_t slot;
+            if (!free_slots_.empty()) {
+                slot = free_slots_.back();
+                free_slots_.pop_back();
+                slots_[slot] = entry;
+            } else {
+                slot = static_cast<uint32_t>(slots_.size());
+                slots_.push_back(entry);
+                heap_index_.push_back(0);
+            }
+            slot_of_.emplace(atom.id(), slot);
+            heap_.push_back(HeapNode{entry.priority, slot});
+            sift_up(heap_.size() - 1);
+            return;
+        }
+    }
+}
+
+std::optional<Frontier::Entry> Frontier::pop() {
+    switch (strategy_) {
+        case SearchStrategy::BFS: {
+            if (count_ == 0) return std::nullopt;
+            Entry entry = ring_[head_];
+            head_ = (head_ + 1) & (ring_.size() - 1);
+            --count_;
+            return entry;
+        }
+
+        case SearchStrategy::DFS: {
+            if (items_.empty()) return std::nullopt;
+            Entry entry = items_.back();
+            items_.pop_back();
+            return entry;
+        }
+
+        case SearchStrategy::RANDOM: {
+            if (items_.empty()) return std::nullopt;
+            std::uniform_int_distribution<size_t> pick(0, items_.size() - 1);
+            const size_t i = pick(rng_);
+            Entry entry = items_[i];
+            items_[i] = items_.back();
+            items_.pop_back();
+            return entry;
+        }
+
+        case SearchStrategy::ITERATIVE_DEEPENING: {
+            // Deepen once everything within the limit is expanded
+            if (items_.empty() && !deferred_.empty()) {
+                depth_limit_ = std::ranges::min(deferred_, {}, &Entry::depth).depth;
+                auto within = std::ranges::stable_partition(deferred_,
+                    [&](const Entry& e) { return e.depth > depth_limit_; });
+                items_.assign(within.begin(), within.end());
+                deferred_.erase(within.begin(), within.end());
+            }
+            if (items_.empty()) return std::nullopt;
+            Entry entry = items_.back();
+            items_.pop_back();
+            return entry;
+        }
+
+        case SearchStrategy::BEST_FIRST:
+        case SearchStrategy::ATTENTION: {
+            if (heap_.empty()) return std::nullopt;
+            if (key_ && ++pops_since_rekey_ >= heap_.size()) rekey_all();
+
+            // Priorities may have moved since the top was keyed; settle it
+            for (size_t tries = 0; key_ && tries < heap_.size(); ++tries) {
+                const uint32_t top = heap_[0].slot;
+                const float fresh = key_(slots_[top].atom);
+                if (fresh == heap_[0].priority) break;
+                heap_rekey(top, fresh);
+            }
+
+            const uint32_t slot = heap_[0].slot;
+            Entry entry = slots_[slot];
+            slot_of_.erase(entry.atom.id());
+            free_slots_.push_back(slot);
+
+            HeapNode last = heap_.back();
+            heap_.pop_back();
+            if (!heap_.empty()) {
+                heap_place(0, last);
+                sift_down(0);
+            }
+            return entry;
+        }
+    }
+    return std::nullopt;
+}
+
+bool Frontier::update(Handle atom) {
+    auto it = slot_of_.find(atom.id());
+    if (it == slot_of_.end()) return false;
+    heap_rekey(it->second, key_of(atom));
+    return true;
+}
+
+bool Frontier::contains(Handle atom) const {
+    if (is_heap()) return slot_of_.contains(atom.id());
+
+    auto same = [&](const Entry& e) { return e.atom.id() == atom.id(); };
+    for (size_t i = 0; i < count_; ++i) {
+        if (same(ring_[(head_ + i) & (ring_.size() - 1)])) return true;
+    }
+    return std::ranges::any_of(items_, same) || std::ranges::any_of(deferred_, same);
+}
+
+size_t Frontier::size() const noexcept {
+    return count_ + items_.size() + deferred_.size() + heap_.size();
+}
+
+void Frontier::clear() {
+    ring_.clear();
+    head_ = count_ = 0;
+    items_.clear();
+    deferred_.clear();
+    depth_limit_ = 1;
+    heap_.clear();
+    slots_.clear();
+    heap_index_.clear();
+    free_slots_.clear();
+    slot_of_.clear();
+    pops_since_rekey_ = 0;
+}
+
+// ============================================================================
+// Ring Buffer
+// ============================================================================
+
+void Frontier::ring_push(const Entry& entry) {
+    if (count_ == ring_.size()) {
+        // Unwrap into a buffer twice the size
+        std::vector<Entry> grown(std::max<size_t>(16, ring_.size() * 2));
+        for (size_t i = 0; i < count_; ++i) grown[i] = ring_[(head_ + i) & (ring_.size() - 1)];
+        ring_.swap(grown);
+        head_ = 0;
+    }
+    ring_[(head_ + count_) & (ring_.size() - 1)] = entry;
+    ++count_;
+}
+
+// ============================================================================
+// Heap
+// ============================================================================
+
+void Frontier::heap_place(size_t i, HeapNode node) {
+    heap_index_[node.slot] = static_cast<uint32_t>(i);
+    heap_[i] = node;
+}
+
+void Frontier::heap_rekey(uint32_t slot, float priority) {
+    slots_[slot].priority = priority;
+    const size_t i = heap_index_[slot];
+    const bool raised = heap_[i].priority < priority;
+    heap_[i].priority = priority;
+    raised ? sift_up(i) : sift_down(i);
+}
+
+void Frontier::sift_up(size_t i) {
+    const HeapNode node = heap_[i];
+    while (i > 0) {
+        const size_t parent = (i - 1) / ARITY;
+        if (!(heap_[parent].priority < node.priority)) break;
+        heap_place(i, heap_[parent]);
+        i = parent;
+    }
+    heap_place(i, node);
+}
+
+void Frontier::sift_down(size_t i) {
+    const HeapNode node = heap_[i];
+    const size_t n = heap_.size();
+    for (;;) {
+        const size_t first = i * ARITY + 1;
+        if (first >= n) break;
+        size_t best = first;
+        for (size_t c = first + 1; c < std::min(first + ARITY, n); ++c) {
+            if (heap_[best].priority < heap_[c].priority) best = c;
+        }
+        if (!(node.priority < heap_[best].priority)) break;
+        heap_place(i, heap_[best]);
+        i = best;
+    }
+    heap_place(i, node);
+}
+
+void Frontier::rekey_all() {
+    for (HeapNode& node : heap_) {
+        node.priority = key_(slots_[node.slot].atom);
+        slots_[node.slot].priority = node.priority;
+    }
+    for (size_t i = heap_.size() / ARITY + 1; i-- > 0;) {
+        if (i < heap_.size()) sift_down(i);
+    }
+    pops_since_rekey_ = 0;
+}
+
+} // namespace opencog::ure
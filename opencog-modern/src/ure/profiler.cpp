@@ -0,0 +1,158 @@
+/**
+ * @file profiler.cpp
+ * @brief Per-rule cost and usefulness profile for the Unified Rule Engine
+ */
+
+#include <opencog/ure/profiler.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstdio>
+
+namespace opencog::ure {
+
+// ============================================================================
+// Histogram
+// ============================================================================
+
+size_t RuleProfiler::bucket(uint64_t ns) noexcept {
+    if (ns < 8) return static_cast<size_t>(ns);
+    const auto exponent = static_cast<size_t>(std::bit_width(ns) - 1);    // >= 3
+    const auto sub = static_cast<size_t>((ns >> (exponent - 2)) & 3);
+    return 8 + (exponent - 3) * 4 + sub;
+}
+
+uint64_t RuleProfiler::bucket_limit(size_t bucket) noexcept {
+    if (bucket < 8) return bucket;
+    const size_t exponent = (bucket - 8) / 4 + 3;
+    const uint64_t sub = (bucket - 8) % 4;
+    if (exponent == 63 && sub == 3) return UINT64_MAX;
+    return ((4 + sub + 1) << (exponent - 2)) - 1;
+}
+
+// ============================================================================
+// Recording
+// ============================================================================
+
+RuleProfiler::Entry& RuleProfiler::entry(const Rule& rule) {
+    auto [it, fresh] = entries_.try_emplace(rule.name);
+    if (fresh) it->second.profile.name = rule.name;
+    return it->second;
+}
+
+void RuleProfiler::record_call(const RuleAttempt& attempt) {
+    Entry& e = entry(*attempt.rule);
+    e.profile.calls++;
+    e.profile.attempts += attempt.clauses;
+    e.profile.matches += attempt.matches;
+    e.profile.total_ns += attempt.nanoseconds;
+    e.max_ns = std::max(e.max_ns, attempt.nanoseconds);
+    e.histogram[bucket(attempt.nanoseconds)]++;
+}
+
+void RuleProfiler::record_application(const Rule* rule, size_t atoms_created) {
+    Entry& e = entry(*rule);
+    e.profile.applications++;
+    e.profile.atoms_created += atoms_created;
+}
+
+void RuleProfiler::credit(const Rule* rule) {
+    if (rule) entry(*rule).profile.proof_uses++;
+}
+
+// ============================================================================
+// Reporting
+// ============================================================================
+
+std::vector<RuleProfile> RuleProfiler::report() const {
+    std::vector<RuleProfile> profiles;
+    profiles.reserve(entries_.size());
+
+    uint64_t total = 0;
+    for (const auto& [name, e] : entries_) total += e.profile.total_ns;
+
+    for (const auto& [name, e] : entries_) {
+        RuleProfile profile = e.profile;
+        profile.time_share = total > 0
+            ? static_cast<double>(profile.total_ns) / static_cast<double>(total)
+            : 0.0;
+
+        // Upper edge of the bucket holding the 99th percentile call
+        const size_t rank = (profile.calls * 99 + 99) / 100;
+        size_t seen = 0;
+        for (size_t b = 0; b < BUCKETS && profile.calls > 0; ++b) {
+            seen += e.histogram[b];
+            if (seen >= rank) {
+                profile.p99_ns = std::min(bucket_limit(b), e.max_ns);
+                break;
+            }
+        }
+        profiles.push_back(std::move(profile));
+    }
+
+    std::ranges::sort(profiles, [](const RuleProfile& a, const RuleProfile& b) {
+        return a.total_ns != b.total_ns ? a.total_ns > b.total_ns : a.name < b.name;
+    });
+    return profiles;
+}
+
+std::string RuleProfiler::to_string() const {
+    std::string out;
+    char line[256];
+    std::snprintf(line, sizeof(line), "%-24s %10s %8s %10s %10s %10s %10s %8s %7s\n",
+                  "rule", "calls", "match%", "mean ns", "p99 ns", "applied",
+                  "created", "proofs", "time%");
+    out += line;
+
+    for (const RuleProfile& p : report()) {
+        std::snprintf(line, sizeof(line),
+                      "%-24.24s %10zu %7.1f%% %10.0f %10llu %10zu %10zu %8zu %6.1f%%\n",
+                      p.name.c_str(), p.calls, p.success_rate() * 100.0, p.mean_ns(),
+                      static_cast<unsigned long long>(p.p99_ns), p.applications,
+                      p.atoms_created, p.proof_uses, p.time_share * 100.0);
+        out += line;
+    }
+    return out;
+}
+
+std::vector<RuleCost> RuleProfiler::tune() const {
+    std::vector<RuleCost> costs;
+
+    std::vector<const RuleProfile*> called;
+    double mean_cost = 0.0;
+    size_t total_calls = 0;
+    size_t total_uses = 0;
+    for (const auto& [name, e] : entries_) {
+        if (e.profile.calls == 0 || e.profile.name.empty()) continue;
+        called.push_back(&e.profile);
+        mean_cost += e.profile.mean_ns();
+        total_calls += e.profile.calls;
+        total_uses += e.profile.proof_uses;
+    }
+    if (called.empty()) return costs;
+    mean_cost /= static_cast<double>(called.size());
+
+    // Proof steps per call, shrunk toward the rate across all rules, per
+    // unit of cost: the order that finds a proof step soonest per time spent
+    const double prior = (static_cast<double>(total_uses) + 1.0) /
+                         (static_cast<double>(total_calls) + 2.0);
+    std::vector<double> scores;
+    double mean_score = 0.0;
+    for (const RuleProfile* p : called) {
+        const double complexity = mean_cost > 0.0 ? std::max(p->mean_ns() / mean_cost, 1e-3) : 1.0;
+        const double yield = (static_cast<double>(p->proof_uses) + prior) /
+                             (static_cast<double>(p->calls) + 1.0);
+        costs.push_back({p->name, 0.0f, static_cast<float>(complexity)});
+        scores.push_back(yield / complexity);
+        mean_score += scores.back();
+    }
+    mean_score /= static_cast<double>(scores.size());
+
+    for (size_t i = 0; i < costs.size(); ++i) {
+        costs[i].priority = static_cast<float>(scores[i] / mean_score);
+    }
+    std::ranges::sort(costs, {}, &RuleCost::name);
+    return costs;
+}
+
+} // namespace opencog::ure
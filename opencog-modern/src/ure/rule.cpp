@@ -4,31 +4,57 @@
  */
 
 #include <opencog/ure/rule.hpp>
+#include <opencog/ure/rule_set.hpp>
 
 #include <algorithm>
+#include <chrono>
 
 namespace opencog::ure {
 
+// ============================================================================
+// RuleView Implementation
+// ============================================================================
+
+RuleView::RuleView(std::shared_ptr<const RuleSet> set)
+    : set_(std::move(set)), by_priority_(true)
+{
+}
+
+RuleView::RuleView(std::shared_ptr<const RuleSet> set, std::vector<const Rule*> found)
+    : set_(std::move(set)), found_(std::move(found))
+{
+}
+
+std::span<const Rule* const> RuleView::rules() const noexcept {
+    if (by_priority_) return set_->by_priority();
+    return found_;
+}
+
 // ============================================================================
 // RuleBase Implementation
 // ============================================================================
 
 RuleBase::RuleBase(AtomSpace& space)
     : space_(space)
+    , published_(RuleSet::compile(space, {}))
 {
 }
 
-void RuleBase::add_rule(Rule rule) {
-    size_t index = rules_.size();
-    name_index_[rule.name] = index;
+RuleBase::~RuleBase() = default;
 
-    // Index by premise type (for fast lookup)
-    if (rule.premise.valid()) {
-        AtomType type = space_.get_type(rule.premise);
-        type_index_.emplace(type, index);
-    }
+void RuleBase::edited() {
+    version_.fetch_add(1, std::memory_order_release);
+}
+
+void RuleBase::add_rule(Rule rule) {
+    // Compiled once here; every snapshot shares the program
+    rule.program = std::make_shared<const RuleProgram>(
+        RuleProgram::compile(space_, rule.premise, rule.conclusion));
 
+    std::lock_guard lock(mutex_);
+    name_index_[rule.name] = rules_.size();
     rules_.push_back(std::move(rule));
+    edited();
 }
 
 void RuleBase::add_rule_from_atom(Handle rule_atom) {
@@ -64,72 +90,91 @@ void RuleBase::add_rule_from_atom(Handle rule_atom) {
 }
 
 void RuleBase::load_from_atomspace() {
-    // Find all DefineLinks and try to parse them as rules
+    // Find all DefineLinks and try to parse them as rules; staged edits
+    // compile into one snapshot
     for (Handle h : space_.get_atoms_by_type(AtomType::DEFINE_LINK)) {
         add_rule_from_atom(h);
     }
 }
 
 bool RuleBase::remove_rule(const std::string& name) {
+    std::lock_guard lock(mutex_);
     auto it = name_index_.find(name);
     if (it == name_index_.end()) return false;
 
-    size_t index = it->second;
-
-    // Remove from indices
-    name_index_.erase(it);
-
-    // Note: We don't actually remove from rules_ to avoid invalidating indices
-    // Instead, we could mark as deleted or use a more sophisticated data structure
-    rules_[index] = Rule{};  // Clear the rule
-
-    rebuild_indices();
+    rules_.erase(rules_.begin() + static_cast<std::ptrdiff_t>(it->second));
+    name_index_.clear();
+    for (size_t i = 0; i < rules_.size(); ++i) name_index_[rules_[i].name] = i;
+    edited();
     return true;
 }
 
 void RuleBase::clear() {
+    std::lock_guard lock(mutex_);
     rules_.clear();
     name_index_.clear();
-    type_index_.clear();
+    edited();
+}
+
+size_t RuleBase::set_costs(std::span<const RuleCost> costs) {
+    std::lock_guard lock(mutex_);
+    size_t changed = 0;
+    for (const RuleCost& cost : costs) {
+        auto it = name_index_.find(cost.name);
+        if (it == name_index_.end()) continue;
+        Rule& rule = rules_[it->second];
+        rule.priority = cost.priority;
+        rule.complexity = cost.complexity;
+        ++changed;
+    }
+    if (changed > 0) edited();
+    return changed;
+}
+
+std::shared_ptr<const RuleSet> RuleBase::snapshot() const {
+    auto set = published_.load(std::memory_order_acquire);
+    if (set->version() == version()) return set;
+
+    std::lock_guard lock(mutex_);
+    set = published_.load(std::memory_order_acquire);
+    const uint64_t version = version_.load(std::memory_order_relaxed);
+    if (set->version() != version) {
+        set = RuleSet::compile(space_, rules_, version);
+        published_.store(set, std::memory_order_release);
+    }
+    return set;
 }
 
 std::optional<Rule> RuleBase::get_rule(const std::string& name) const {
-    auto it = name_index_.find(name);
-    if (it == name_index_.end()) return std::nullopt;
-    return rules_[it->second];
+    const Rule* rule = snapshot()->find(name);
+    if (!rule) return std::nullopt;
+    return *rule;
 }
 
 std::vector<Rule> RuleBase::get_all_rules() const {
-    std::vector<Rule> result;
-    for (const auto& rule : rules_) {
-        if (!rule.name.empty()) {
-            result.push_back(rule);
-        }
-    }
-    return result;
+    auto set = snapshot();
+    return {set->rules().begin(), set->rules().end()};
 }
 
-std::vector<const Rule*> RuleBase::get_rules_for_type(AtomType type) const {
-    std::vector<const Rule*> result;
-    auto range = type_index_.equal_range(type);
-    for (auto it = range.first; it != range.second; ++it) {
-        result.push_back(&rules_[it->second]);
-    }
-    return result;
+size_t RuleBase::size() const {
+    return snapshot()->size();
 }
 
-std::vector<const Rule*> RuleBase::get_rules_by_priority() const {
-    std::vector<const Rule*> result;
-    for (const auto& rule : rules_) {
-        if (!rule.name.empty()) {
-            result.push_back(&rule);
-        }
-    }
+RuleView RuleBase::get_rules_for_type(AtomType type) const {
+    auto set = snapshot();
+    auto found = set->for_type(type);
+    return {std::move(set), std::move(found)};
+}
 
-    std::sort(result.begin(), result.end(),
-        [](const Rule* a, const Rule* b) { return a->priority > b->priority; });
+RuleView RuleBase::get_rules_by_priority() const {
+    return RuleView(snapshot());
+}
 
-    return result;
+RuleView RuleBase::get_rules_for_atom(Handle source) const {
+    auto set = snapshot();
+    std::vector<const Rule*> found;
+    set->for_atom(space_, source, found);
+    return {std::move(set), std::move(found)};
 }
 
 std::vector<std::string> RuleBase::get_variables(const Rule& rule) const {
@@ -139,33 +184,20 @@ std::vector<std::string> RuleBase::get_variables(const Rule& rule) const {
 bool RuleBase::could_apply(const Rule& rule, Handle target) const {
     if (!rule.valid() || !target.valid()) return false;
 
-    // Quick check: does premise type match target type?
-    AtomType premise_type = space_.get_type(rule.premise);
-    AtomType target_type = space_.get_type(target);
-
-    // Exact match or type hierarchy match
-    if (premise_type == target_type) return true;
-    if (premise_type == AtomType::LINK && is_link(target_type)) return true;
-    if (premise_type == AtomType::NODE && is_node(target_type)) return true;
-
-    return false;
-}
-
-void RuleBase::rebuild_indices() {
-    name_index_.clear();
-    type_index_.clear();
-
-    for (size_t i = 0; i < rules_.size(); ++i) {
-        const auto& rule = rules_[i];
-        if (rule.name.empty()) continue;
-
-        name_index_[rule.name] = i;
-
-        if (rule.premise.valid()) {
-            AtomType type = space_.get_type(rule.premise);
-            type_index_.emplace(type, i);
+    if (rule.program) {
+        std::vector<AtomId> slots(rule.program->slots());
+        for (size_t c = 0; c < rule.program->clauses(); ++c) {
+            std::ranges::fill(slots, ATOM_NULL);
+            if (rule.program->match(space_, c, target.id(), slots)) return true;
         }
+        return false;
     }
+
+    for (Handle clause : premise_clauses(space_, rule.premise)) {
+        BindingSet bindings;
+        if (unify_premise(space_, clause, target, bindings)) return true;
+    }
+    return false;
 }
 
 // ============================================================================
@@ -173,18 +205,34 @@ void RuleBase::rebuild_indices() {
 // ============================================================================
 
 RuleApplicator::RuleApplicator(AtomSpace& space, const RuleBase& rules)
-    : space_(space), rules_(rules), matcher_(space)
+    : space_(space), base_(rules), rules_(rules.snapshot()), matcher_(space)
 {
 }
 
+RuleApplicator::~RuleApplicator() = default;
+
+void RuleApplicator::refresh() {
+    if (rules_->version() != base_.version()) rules_ = base_.snapshot();
+}
+
 std::optional<RuleApplicationResult> RuleApplicator::apply(
     const Rule& rule,
     const BindingSet& bindings
 ) {
     if (!rule.valid()) return std::nullopt;
 
+    // Rules that never went through a RuleBase are compiled here
+    std::optional<RuleProgram> local;
+    const RuleProgram* program = rule.program.get();
+    if (!program) {
+        local = RuleProgram::compile(space_, rule.premise, rule.conclusion);
+        program = &*local;
+    }
+
     // Instantiate conclusion template with bindings
-    Handle result = instantiate_template(rule.conclusion, bindings);
+    std::vector<AtomId> slots(program->slots());
+    program->from_bindings(bindings, slots);
+    Handle result = program->instantiate(space_, slots);
     if (!result.valid()) return std::nullopt;
 
     // Compute truth value
@@ -197,77 +245,125 @@ std::vector<RuleApplicationResult> RuleApplicator::find_applicable(
     Handle target,
     size_t max_results
 ) {
+    refresh();
     std::vector<RuleApplicationResult> results;
 
-    for (const Rule* rule : rules_.get_rules_by_priority()) {
-        if (!rules_.could_apply(*rule, target)) continue;
+    std::vector<const Rule*> candidates;
+    rules_->for_atom(space_, target, candidates);
 
-        // Try to match rule premise against target
-        // Full implementation would use pattern matcher
+    std::vector<AtomId> slots;
+    for (const Rule* rule : candidates) {
+        // The index matched structure; matching binds the variables
+        const RuleProgram& program = *rule->program;
+        for (size_t c = 0; c < program.clauses(); ++c) {
+            if (results.size() >= max_results) return results;
 
-        if (results.size() >= max_results) break;
+            slots.assign(program.slots(), ATOM_NULL);
+            if (!program.match(space_, c, target.id(), slots)) continue;
+
+            RuleApplicationResult applicable{rule, {}, Handle{}, {}};
+            program.to_bindings(slots, applicable.bindings);
+            results.push_back(std::move(applicable));
+        }
     }
 
     return results;
 }
 
-std::vector<RuleApplicationResult> RuleApplicator::apply_all(
+size_t RuleApplicator::match_all(
     Handle target,
-    size_t max_results
-) {
-    std::vector<RuleApplicationResult> results;
+    std::vector<RuleFiring>& firings,
+    std::vector<AtomId>& slots,
+    size_t max_results,
+    std::stop_token stop,
+    std::vector<RuleAttempt>* attempts
+) const {
+    const size_t before = firings.size();
+
+    std::vector<const Rule*> candidates;
+    rules_->for_atom(space_, target, candidates);
+
+    for (const Rule* rule : candidates) {
+        if (stop.stop_requested()) break;
+        const auto started = attempts ? std::chrono::steady_clock::now()
+                                      : std::chrono::steady_clock::time_point{};
+        RuleAttempt attempt{rule, 0, 0, 0};
+
+        const RuleProgram& program = *rule->program;
+        for (size_t c = 0; c < program.clauses(); ++c) {
+            if (firings.size() - before >= max_results) break;
+
+            ++attempt.clauses;
+            const size_t offset = slots.size();
+            slots.resize(offset + program.slots(), ATOM_NULL);
+            auto bound = std::span<AtomId>(slots).subspan(offset);
+            if (!program.match(space_, c, target.id(), bound)) {
+                slots.resize(offset);
+                continue;
+            }
+
+            ++attempt.matches;
+            firings.push_back(RuleFiring{rule, static_cast<uint32_t>(c),
+                                         static_cast<uint32_t>(offset),
+                                         program.lookup(space_, bound, c, target.id())});
+        }
 
-    for (auto& applicable : find_applicable(target, max_results)) {
-        auto result = apply(*applicable.rule, applicable.bindings);
-        if (result) {
-            results.push_back(std::move(*result));
+        if (attempts && attempt.clauses > 0) {
+            attempt.nanoseconds = static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - started).count());
+            attempts->push_back(attempt);
         }
+        if (firings.size() - before >= max_results) break;
     }
 
-    return results;
+    return firings.size() - before;
 }
 
-Handle RuleApplicator::instantiate_template(
-    Handle templ,
-    const BindingSet& bindings
+std::optional<RuleApplicationResult> RuleApplicator::commit(
+    Handle target,
+    const RuleFiring& firing,
+    std::span<const AtomId> slots
 ) {
-    if (!templ.valid()) return Handle{};
+    const RuleProgram& program = *firing.rule->program;
+    auto bound = slots.subspan(firing.slots, program.slots());
 
-    AtomType type = space_.get_type(templ);
+    Handle result = firing.existing.valid()
+        ? space_.make_handle(firing.existing)
+        : program.instantiate(space_, bound, firing.clause, target.id());
+    if (!result.valid()) return std::nullopt;
 
-    // If it's a VariableNode, look up binding
-    if (type == AtomType::VARIABLE_NODE) {
-        std::string var_name(space_.get_name(templ));
-        if (bindings.contains(var_name)) {
-            return space_.make_handle(bindings.get(var_name));
-        }
-        return Handle{};  // Unbound variable
-    }
+    RuleApplicationResult applied{firing.rule, {}, result, {}};
+    program.to_bindings(bound, applied.bindings);
+    applied.computed_tv = compute_tv(*firing.rule, applied.bindings);
+    return applied;
+}
 
-    // If it's a node, return as-is
-    if (is_node(type)) {
-        return templ;
-    }
+std::vector<RuleApplicationResult> RuleApplicator::apply_all(
+    Handle target,
+    size_t max_results
+) {
+    refresh();
+    std::vector<RuleApplicationResult> results;
 
-    // If it's a link, recursively instantiate
-    auto outgoing = space_.get_outgoing(templ);
-    std::vector<Handle> new_outgoing;
-    new_outgoing.reserve(outgoing.size());
+    std::vector<RuleFiring> firings;
+    std::vector<AtomId> slots;
+    match_all(target, firings, slots);
 
-    for (const Handle& h : outgoing) {
-        Handle instantiated = instantiate_template(h, bindings);
-        if (!instantiated.valid()) return Handle{};
-        new_outgoing.push_back(instantiated);
+    for (const RuleFiring& firing : firings) {
+        if (results.size() >= max_results) break;
+        if (auto applied = commit(target, firing, slots)) {
+            results.push_back(std::move(*applied));
+        }
     }
 
-    // Create or get the instantiated link
-    return space_.add_link(type, new_outgoing);
+    return results;
 }
 
 TruthValue RuleApplicator::compute_tv(
     const Rule& rule,
     const BindingSet& bindings
-) {
+) const {
     // Use rule's TV formula if provided, otherwise default
     if (rule.tv_formula.valid()) {
         // Execute formula (would need Scheme/grounded schema support)
@@ -0,0 +1,358 @@
+/**
+ * @file rule_index.cpp
+ * @brief Discrimination trees over URE rule premises and backward goals
+ */
+
+#include <opencog/ure/rule_index.hpp>
+#include <opencog/ure/rule.hpp>
+
+#include <algorithm>
+
+namespace opencog::ure {
+
+namespace {
+
+struct Token {
+    uint64_t value;
+    bool is_link;
+    bool is_variable;
+    uint32_t end;       // One past this token's subtree
+};
+
+/// Pre-order tokens of an atom's tree; premises turn variables into wildcards
+void flatten(const AtomTable& table, AtomId id, bool premise, std::vector<Token>& out) {
+    const AtomType type = table.get_type(id);
+    const auto at = static_cast<uint32_t>(out.size());
+
+    if (premise && type == AtomType::VARIABLE_NODE) {
+        out.push_back({0, false, true, at + 1});
+    } else if (is_link(type)) {
+        auto outgoing = table.get_outgoing(id);
+        const uint64_t shape = static_cast<uint64_t>(type) << 32 | outgoing.size();
+        out.push_back({shape, true, false, 0});
+        for (AtomId child : outgoing) flatten(table, child, premise, out);
+    } else {
+        out.push_back({id.value, false, false, at + 1});
+    }
+    out[at].end = static_cast<uint32_t>(out.size());
+}
+
+} // namespace
+
+// ============================================================================
+// Premise Unification
+// ============================================================================
+
+std::vector<Handle> premise_clauses(const AtomSpace& space, Handle premise) {
+    if (space.get_type(premise) == AtomType::AND_LINK) return space.get_outgoing(premise);
+    return {premise};
+}
+
+bool unify_premise(const AtomSpace& space, Handle clause, Handle atom, BindingSet& bindings) {
+    const AtomTable& table = space.atom_table();
+
+    auto unify = [&](auto& self, AtomId pattern, AtomId target) -> bool {
+        const AtomType type = table.get_type(pattern);
+        if (type == AtomType::VARIABLE_NODE) {
+            std::string name(space.get_name(space.make_handle(pattern)));
+            auto [it, fresh] = bindings.bindings.try_emplace(std::move(name), target);
+            return fresh || it->second == target;
+        }
+        if (!is_link(type)) return pattern == target;
+        if (table.get_type(target) != type) return false;
+
+        auto pattern_out = table.get_outgoing(pattern);
+        auto target_out = table.get_outgoing(target);
+        if (pattern_out.size() != target_out.size()) return false;
+        for (size_t i = 0; i < pattern_out.size(); ++i) {
+            if (!self(self, pattern_out[i], target_out[i])) return false;
+        }
+        return true;
+    };
+
+    if (!clause.valid() || !atom.valid()) return false;
+    return unify(unify, clause.id(), atom.id());
+}
+
+Handle substitute(AtomSpace& space, Handle pattern, const BindingSet& bindings,
+                  std::vector<AtomId>* created) {
+    if (!pattern.valid()) return pattern;
+    const AtomTable& table = space.atom_table();
+
+    auto copy = [&](auto& self, AtomId id) -> AtomId {
+        const AtomType type = table.get_type(id);
+        if (type == AtomType::VARIABLE_NODE) {
+            AtomId bound = bindings.get(std::string(space.get_name(space.make_handle(id))));
+            return bound.valid() ? bound : id;
+        }
+        if (!is_link(type)) return id;
+
+        auto outgoing = table.get_outgoing(id);
+        std::vector<AtomId> copied(outgoing.begin(), outgoing.end());
+        bool changed = false;
+        for (AtomId& child : copied) {
+            const AtomId replaced = self(self, child);
+            changed |= replaced != child;
+            child = replaced;
+        }
+        if (!changed) return id;
+        if (created) {
+            if (AtomId found = table.get_link(type, copied); found.valid()) return found;
+            const AtomId added = space.add_link(type, std::span<const AtomId>(copied)).id();
+            created->push_back(added);
+            return added;
+        }
+        return space.add_link(type, std::span<const AtomId>(copied)).id();
+    };
+
+    return space.make_handle(copy(copy, pattern.id()));
+}
+
+Handle find_instance(const AtomSpace& space, Handle pattern, const BindingSet& bindings) {
+    if (!pattern.valid()) return Handle{};
+    const AtomTable& table = space.atom_table();
+
+    auto find = [&](auto& self, AtomId id) -> AtomId {
+        const AtomType type = table.get_type(id);
+        if (type == AtomType::VARIABLE_NODE) {
+            return bindings.get(std::string(space.get_name(space.make_handle(id))));
+        }
+        if (!is_link(type)) return id;
+
+        auto outgoing = table.get_outgoing(id);
+        std::vector<AtomId> found(outgoing.size());
+        for (size_t i = 0; i < outgoing.size(); ++i) {
+            found[i] = self(self, outgoing[i]);
+            if (!found[i].valid()) return ATOM_NULL;
+        }
+        return table.get_link(type, found);
+    };
+
+    const AtomId id = find(find, pattern.id());
+    return id.valid() ? space.make_handle(id) : Handle{};
+}
+
+bool has_variables(const AtomSpace& space, Handle atom) {
+    if (!atom.valid()) return false;
+    const AtomTable& table = space.atom_table();
+
+    auto scan = [&](auto& self, AtomId id) -> bool {
+        const AtomType type = table.get_type(id);
+        if (type == AtomType::VARIABLE_NODE) return true;
+        if (!is_link(type)) return false;
+        for (AtomId child : table.get_outgoing(id)) {
+            if (self(self, child)) return true;
+        }
+        return false;
+    };
+    return scan(scan, atom.id());
+}
+
+// ============================================================================
+// Goal Canonicalization
+// ============================================================================
+
+uint32_t GoalKey::position_of(AtomId atom) const noexcept {
+    auto it = std::ranges::find(atoms, atom);
+    return it != atoms.end() ? static_cast<uint32_t>(it - atoms.begin()) : UINT32_MAX;
+}
+
+void canonicalize_goal(const AtomSpace& space, Handle goal, GoalKey& out) {
+    enum : uint64_t { ATOM, LINK, VARIABLE };
+
+    out.tokens.clear();
+    out.atoms.clear();
+    out.variables = 0;
+    if (!goal.valid()) {
+        out.hash = 0;
+        return;
+    }
+
+    const AtomTable& table = space.atom_table();
+    std::vector<AtomId> seen;       // Variables by canonical number
+
+    auto walk = [&](auto& self, AtomId id) -> void {
+        const AtomType type = table.get_type(id);
+        out.atoms.push_back(id);
+
+        if (type == AtomType::VARIABLE_NODE) {
+            auto it = std::ranges::find(seen, id);
+            if (it == seen.end()) it = seen.insert(seen.end(), id);
+            out.tokens.push_back(VARIABLE);
+            out.tokens.push_back(static_cast<uint64_t>(it - seen.begin()));
+        } else if (is_link(type)) {
+            auto outgoing = table.get_outgoing(id);
+            out.tokens.push_back(LINK);
+            out.tokens.push_back(static_cast<uint64_t>(type) << 32 | outgoing.size());
+            for (AtomId child : outgoing) self(self, child);
+        } else {
+            out.tokens.push_back(ATOM);
+            out.tokens.push_back(id.value);
+        }
+    };
+    walk(walk, goal.id());
+
+    out.variables = static_cast<uint32_t>(seen.size());
+    uint64_t h = out.tokens.size();
+    for (uint64_t token : out.tokens) h = hash_combine(h, token);
+    out.hash = h;
+}
+
+// ============================================================================
+// Pattern Trie
+// ============================================================================
+
+uint32_t PatternTrie::child(uint32_t node, Edge edge) {
+    edge.parent = node;
+    auto [it, fresh] = edges_.try_emplace(edge, static_cast<uint32_t>(wildcard_.size()));
+    if (fresh) wildcard_.push_back(NONE);
+    return it->second;
+}
+
+uint32_t PatternTrie::wildcard_child(uint32_t node) {
+    if (wildcard_[node] == NONE) {
+        wildcard_[node] = static_cast<uint32_t>(wildcard_.size());
+        wildcard_.push_back(NONE);
+    }
+    return wildcard_[node];
+}
+
+uint32_t PatternTrie::insert(const AtomSpace& space, AtomId pattern) {
+    std::vector<Token> tokens;
+    flatten(space.atom_table(), pattern, true, tokens);
+
+    uint32_t node = 0;
+    for (const Token& token : tokens) {
+        node = token.is_variable
+            ? wildcard_child(node)
+            : child(node, Edge{token.value, 0, token.is_link});
+    }
+    return node;
+}
+
+void PatternTrie::find(const AtomSpace& space, AtomId atom, std::vector<uint32_t>& out) const {
+    if (wildcard_.size() == 1) return;
+
+    std::vector<Token> tokens;
+    flatten(space.atom_table(), atom, false, tokens);
+
+    // Walk the trie along the atom; a wildcard edge consumes a subtree
+    struct Cursor {
+        uint32_t node;
+        uint32_t pos;
+    };
+    std::vector<Cursor> stack{{0, 0}};
+
+    while (!stack.empty()) {
+        const Cursor cur = stack.back();
+        stack.pop_back();
+
+        if (cur.pos == tokens.size()) {
+            out.push_back(cur.node);
+            continue;
+        }
+        const Token& token = tokens[cur.pos];
+        if (uint32_t wild = wildcard_[cur.node]; wild != NONE) {
+            stack.push_back({wild, token.end});
+        }
+        if (auto it = edges_.find(Edge{token.value, cur.node, token.is_link}); it != edges_.end()) {
+            stack.push_back({it->second, cur.pos + 1});
+        }
+    }
+}
+
+void PatternTrie::clear() {
+    edges_.clear();
+    wildcard_.assign(1, NONE);
+}
+
+// ============================================================================
+// Rule Index
+// ============================================================================
+
+void RuleIndex::insert(const AtomSpace& space, const Rule& rule) {
+    if (!rule.premise.valid()) return;
+    const uint32_t order = inserted_++;
+
+    for (Handle clause : premise_clauses(space, rule.premise)) {
+        const uint32_t node = trie_.insert(space, clause.id());
+        if (leaves_.size() <= node) leaves_.resize(node + 1);
+
+        // Keep the leaf sorted by priority, ties in insertion order
+        auto& leaf = leaves_[node];
+        if (std::ranges::any_of(leaf, [&](const Leaf& l) { return l.rule == &rule; })) continue;
+        auto pos = std::ranges::upper_bound(leaf, rule.priority, std::greater<>{}, &Leaf::priority);
+        leaf.insert(pos, Leaf{rule.priority, order, &rule});
+    }
+}
+
+void RuleIndex::clear() {
+    trie_.clear();
+    leaves_.clear();
+    inserted_ = 0;
+}
+
+size_t RuleIndex::find(const AtomSpace& space, Handle source,
+                       std::vector<const Rule*>& out) const {
+    if (!source.valid()) return 0;
+
+    std::vector<uint32_t> nodes;
+    trie_.find(space, source.id(), nodes);
+
+    std::vector<const std::vector<Leaf>*> hits;
+    for (uint32_t node : nodes) {
+        if (node < leaves_.size() && !leaves_[node].empty()) hits.push_back(&leaves_[node]);
+    }
+
+    const size_t before = out.size();
+    if (hits.empty()) return 0;
+    if (hits.size() == 1) {
+        for (const Leaf& leaf : *hits.front()) out.push_back(leaf.rule);
+        return out.size() - before;
+    }
+
+    // Several leaves matched: merge them, dropping rules reached twice
+    std::vector<Leaf> merged;
+    for (const auto* leaf : hits) merged.insert(merged.end(), leaf->begin(), leaf->end());
+    std::ranges::sort(merged, [](const Leaf& a, const Leaf& b) {
+        return a.priority != b.priority ? a.priority > b.priority : a.order < b.order;
+    });
+    for (size_t i = 0; i < merged.size(); ++i) {
+        if (i > 0 && merged[i].rule == merged[i - 1].rule) continue;
+        out.push_back(merged[i].rule);
+    }
+    return out.size() - before;
+}
+
+// ============================================================================
+// Goal Index
+// ============================================================================
+
+void GoalIndex::insert(const AtomSpace& space, Handle goal, uint32_t id) {
+    if (!goal.valid()) return;
+    const uint32_t node = trie_.insert(space, goal.id());
+    if (goals_.size() <= node) goals_.resize(node + 1);
+    goals_[node].push_back(id);
+    ++size_;
+}
+
+void GoalIndex::clear() {
+    trie_.clear();
+    goals_.clear();
+    size_ = 0;
+}
+
+size_t GoalIndex::find(const AtomSpace& space, Handle atom, std::vector<uint32_t>& out) const {
+    if (!atom.valid()) return 0;
+
+    std::vector<uint32_t> nodes;
+    trie_.find(space, atom.id(), nodes);
+
+    const size_t before = out.size();
+    for (uint32_t node : nodes) {
+        if (node < goals_.size()) out.insert(out.end(), goals_[node].begin(), goals_[node].end());
+    }
+    return out.size() - before;
+}
+
+} // namespace opencog::ure
@@ -0,0 +1,291 @@
+/**
+ * @file rule_program.cpp
+ * @brief Precompiled premise matchers and conclusion templates
+ */
+
+#include <opencog/ure/rule_program.hpp>
+#include <opencog/atomspace/atomspace.hpp>
+
+#include <algorithm>
+#include <array>
+
+namespace opencog::ure {
+
+// ============================================================================
+// Compilation
+// ============================================================================
+
+RuleProgram RuleProgram::compile(const AtomSpace& space, Handle premise, Handle conclusion) {
+    RuleProgram program;
+
+    if (premise.valid()) {
+        auto add_clause = [&](AtomId clause) {
+            program.clause_start_.push_back(static_cast<uint32_t>(program.premise_.size()));
+            program.clause_atoms_.push_back(clause);
+            program.compile_pattern(space, clause, program.premise_);
+        };
+        if (space.get_type(premise) == AtomType::AND_LINK) {
+            for (AtomId clause : space.atom_table().get_outgoing(premise.id())) add_clause(clause);
+        } else {
+            add_clause(premise.id());
+        }
+    }
+
+    if (conclusion.valid()) {
+        program.compile_conclusion(space, conclusion.id());
+        program.compile_pattern(space, conclusion.id(), program.conclusion_match_);
+
+        // Deepest point of the value stack
+        uint32_t depth = 0;
+        for (const Instruction& in : program.conclusion_) {
+            if (in.op == Instruction::Op::CLAUSE) continue;
+            depth = in.op == Instruction::Op::LINK ? depth - in.arg + 1 : depth + 1;
+            program.max_stack_ = std::max(program.max_stack_, depth);
+        }
+    }
+    return program;
+}
+
+uint32_t RuleProgram::slot_of(const AtomSpace& space, AtomId variable) {
+    auto it = std::ranges::find(variables_, variable);
+    if (it != variables_.end()) return static_cast<uint32_t>(it - variables_.begin());
+
+    variables_.push_back(variable);
+    names_.emplace_back(space.get_name(space.make_handle(variable)));
+    return static_cast<uint32_t>(variables_.size() - 1);
+}
+
+void RuleProgram::compile_pattern(const AtomSpace& space, AtomId atom,
+                                  std::vector<Instruction>& out) {
+    const AtomTable& table = space.atom_table();
+    const AtomType type = table.get_type(atom);
+
+    if (type == AtomType::VARIABLE_NODE) {
+        out.push_back({Instruction::Op::SLOT, type, slot_of(space, atom), 0, ATOM_NULL});
+    } else if (is_link(type)) {
+        auto outgoing = table.get_outgoing(atom);
+        out.push_back({Instruction::Op::LINK, type,
+                       static_cast<uint32_t>(outgoing.size()), 0, ATOM_NULL});
+        for (AtomId child : outgoing) compile_pattern(space, child, out);
+    } else {
+        out.push_back({Instruction::Op::ATOM, type, 0, 0, atom});
+    }
+}
+
+void RuleProgram::compile_conclusion(const AtomSpace& space, AtomId atom) {
+    const AtomTable& table = space.atom_table();
+    const AtomType type = table.get_type(atom);
+
+    if (type == AtomType::VARIABLE_NODE) {
+        conclusion_.push_back({Instruction::Op::SLOT, type, slot_of(space, atom), 0, ATOM_NULL});
+    } else if (is_link(type)) {
+        // A copy of a premise clause gets a shortcut for when it matched
+        const auto clause = std::ranges::find(clause_atoms_, atom);
+        const size_t marker = conclusion_.size();
+        if (clause != clause_atoms_.end()) {
+            conclusion_.push_back({Instruction::Op::CLAUSE, type,
+                                   static_cast<uint32_t>(clause - clause_atoms_.begin()), 0,
+                                   ATOM_NULL});
+        }
+
+        auto outgoing = table.get_outgoing(atom);
+        for (AtomId child : outgoing) compile_conclusion(space, child);
+        conclusion_.push_back({Instruction::Op::LINK, type,
+                               static_cast<uint32_t>(outgoing.size()), 0, ATOM_NULL});
+
+        if (clause != clause_atoms_.end()) {
+            conclusion_[marker].skip = static_cast<uint32_t>(conclusion_.size() - marker - 1);
+        }
+    } else {
+        conclusion_.push_back({Instruction::Op::ATOM, type, 0, 0, atom});
+    }
+}
+
+// ============================================================================
+// Matching
+// ============================================================================
+
+bool RuleProgram::match(const AtomSpace& space, size_t clause, AtomId atom,
+                        std::span<AtomId> slots) const {
+    if (clause >= clause_start_.size() || !atom.valid()) return false;
+    size_t pc = clause_start_[clause];
+    return match_at(space, premise_, pc, atom, slots);
+}
+
+bool RuleProgram::match_conclusion(const AtomSpace& space, AtomId atom,
+                                   std::span<AtomId> slots) const {
+    if (conclusion_match_.empty() || !atom.valid()) return false;
+    size_t pc = 0;
+    return match_at(space, conclusion_match_, pc, atom, slots);
+}
+
+bool RuleProgram::match_at(const AtomSpace& space, std::span<const Instruction> code,
+                           size_t& pc, AtomId atom, std::span<AtomId> slots) {
+    const Instruction& in = code[pc++];
+    switch (in.op) {
+        case Instruction::Op::ATOM:
+            return in.atom == atom;
+
+        case Instruction::Op::SLOT: {
+            AtomId& bound = slots[in.arg];
+            if (!bound.valid()) bound = atom;
+            return bound == atom;
+        }
+
+        case Instruction::Op::LINK: {
+            const AtomTable& table = space.atom_table();
+            if (table.get_type(atom) != in.type) return false;
+            auto outgoing = table.get_outgoing(atom);
+            if (outgoing.size() != in.arg) return false;
+            for (AtomId child : outgoing) {
+                if (!match_at(space, code, pc, child, slots)) return false;
+            }
+            return true;
+        }
+
+        case Instruction::Op::CLAUSE:
+            break;
+    }
+    return false;
+}
+
+AtomId RuleProgram::lookup_clause(const AtomSpace& space, size_t clause,
+                                  std::span<const AtomId> slots) const {
+    if (clause >= clause_start_.size()) return ATOM_NULL;
+    size_t pc = clause_start_[clause];
+    return clause_at<false>(space, premise_, pc, slots, nullptr);
+}
+
+Handle RuleProgram::instantiate_clause(AtomSpace& space, size_t clause,
+                                       std::span<const AtomId> slots,
+                                       std::vector<AtomId>* created) const {
+    if (clause >= clause_start_.size()) return Handle{};
+    size_t pc = clause_start_[clause];
+    AtomId id = clause_at<true>(space, premise_, pc, slots, created);
+    return id.valid() ? space.make_handle(id) : Handle{};
+}
+
+template<bool Create, typename Space>
+AtomId RuleProgram::clause_at(Space& space, std::span<const Instruction> code, size_t& pc,
+                              std::span<const AtomId> slots, std::vector<AtomId>* created) {
+    const Instruction& in = code[pc++];
+    switch (in.op) {
+        case Instruction::Op::ATOM:
+            return in.atom;
+
+        case Instruction::Op::SLOT:
+            return in.arg < slots.size() ? slots[in.arg] : ATOM_NULL;
+
+        case Instruction::Op::LINK: {
+            std::array<AtomId, 8> inline_outgoing;
+            std::vector<AtomId> heap_outgoing;
+            std::span<AtomId> outgoing(inline_outgoing.data(), in.arg);
+            if (in.arg > inline_outgoing.size()) {
+                heap_outgoing.resize(in.arg);
+                outgoing = heap_outgoing;
+            }
+            for (AtomId& child : outgoing) {
+                child = clause_at<Create>(space, code, pc, slots, created);
+                if (!child.valid()) return ATOM_NULL;
+            }
+            AtomId id = space.atom_table().get_link(in.type, outgoing);
+            if constexpr (Create) {
+                if (!id.valid()) {
+                    bool added = false;
+                    id = space.add_link(in.type, std::span<const AtomId>(outgoing),
+                                        TruthValue::default_tv(), &added).id();
+                    if (added && created) created->push_back(id);
+                }
+            }
+            return id;
+        }
+
+        case Instruction::Op::CLAUSE:
+            break;
+    }
+    return ATOM_NULL;
+}
+
+// ============================================================================
+// Instantiation
+// ============================================================================
+
+Handle RuleProgram::instantiate(AtomSpace& space, std::span<const AtomId> slots,
+                                size_t matched_clause, AtomId source) const {
+    AtomId id = evaluate<true>(space, slots, matched_clause, source);
+    return id.valid() ? space.make_handle(id) : Handle{};
+}
+
+AtomId RuleProgram::lookup(const AtomSpace& space, std::span<const AtomId> slots,
+                           size_t matched_clause, AtomId source) const {
+    return evaluate<false>(space, slots, matched_clause, source);
+}
+
+template<bool Create, typename Space>
+AtomId RuleProgram::evaluate(Space& space, std::span<const AtomId> slots,
+                             size_t matched_clause, AtomId source) const {
+    if (conclusion_.empty()) return ATOM_NULL;
+
+    // Templates are shallow; spill to the heap only for unusually wide ones
+    std::array<AtomId, 32> inline_stack;
+    std::vector<AtomId> heap_stack;
+    AtomId* stack = inline_stack.data();
+    if (max_stack_ > inline_stack.size()) {
+        heap_stack.resize(max_stack_);
+        stack = heap_stack.data();
+    }
+
+    const AtomTable& table = space.atom_table();
+    size_t top = 0;
+    for (size_t pc = 0; pc < conclusion_.size(); ++pc) {
+        const Instruction& in = conclusion_[pc];
+        switch (in.op) {
+            case Instruction::Op::CLAUSE:
+                if (in.arg == matched_clause && source.valid()) {
+                    stack[top++] = source;
+                    pc += in.skip;
+                }
+                break;
+
+            case Instruction::Op::ATOM:
+                stack[top++] = in.atom;
+                break;
+
+            case Instruction::Op::SLOT:
+                if (in.arg >= slots.size() || !slots[in.arg].valid()) return ATOM_NULL;
+                stack[top++] = slots[in.arg];
+                break;
+
+            case Instruction::Op::LINK: {
+                top -= in.arg;
+                std::span<const AtomId> outgoing(stack + top, in.arg);
+                AtomId id = table.get_link(in.type, outgoing);
+                if (!id.valid()) {
+                    if constexpr (!Create) return ATOM_NULL;
+                    else id = space.add_link(in.type, outgoing).id();
+                }
+                stack[top++] = id;
+                break;
+            }
+        }
+    }
+    return stack[0];
+}
+
+// ============================================================================
+// Bindings
+// ============================================================================
+
+void RuleProgram::to_bindings(std::span<const AtomId> slots, BindingSet& out) const {
+    for (size_t i = 0; i < names_.size() && i < slots.size(); ++i) {
+        if (slots[i].valid()) out.bind(names_[i], slots[i]);
+    }
+}
+
+void RuleProgram::from_bindings(const BindingSet& bindings, std::span<AtomId> slots) const {
+    for (size_t i = 0; i < names_.size() && i < slots.size(); ++i) {
+        slots[i] = bindings.get(names_[i]);
+    }
+}
+
+} // namespace opencog::ure
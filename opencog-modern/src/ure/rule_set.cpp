@@ -0,0 +1,58 @@
+/**
+ * @file rule_set.cpp
+ * @brief Compiled, immutable snapshot of a rule base
+ */
+
+#include <opencog/ure/rule_set.hpp>
+
+#include <algorithm>
+
+namespace opencog::ure {
+
+std::shared_ptr<const RuleSet> RuleSet::compile(
+    const AtomSpace& space,
+    std::span<const Rule> rules,
+    uint64_t version
+) {
+    std::shared_ptr<RuleSet> set(new RuleSet());
+    set->version_ = version;
+
+    set->rules_.reserve(rules.size());
+    for (const Rule& rule : rules) {
+        if (rule.name.empty()) continue;
+        Rule& copy = set->rules_.emplace_back(rule);
+        if (!copy.program) {
+            copy.program = std::make_shared<const RuleProgram>(
+                RuleProgram::compile(space, copy.premise, copy.conclusion));
+        }
+    }
+
+    // The array is final; the lookups can point into it
+    for (size_t i = 0; i < set->rules_.size(); ++i) {
+        const Rule& rule = set->rules_[i];
+        const auto index = static_cast<uint32_t>(i);
+        set->names_.insert_or_assign(rule.name, index);
+        if (rule.premise.valid()) set->types_.emplace(space.get_type(rule.premise), index);
+        set->by_priority_.push_back(&rule);
+        set->index_.insert(space, rule);
+    }
+    std::ranges::stable_sort(set->by_priority_, std::greater<>{}, &Rule::priority);
+
+    return set;
+}
+
+const Rule* RuleSet::find(std::string_view name) const {
+    auto it = names_.find(name);
+    return it != names_.end() ? &rules_[it->second] : nullptr;
+}
+
+std::vector<const Rule*> RuleSet::for_type(AtomType type) const {
+    std::vector<const Rule*> result;
+    auto range = types_.equal_range(type);
+    for (auto it = range.first; it != range.second; ++it) {
+        result.push_back(&rules_[it->second]);
+    }
+    return result;
+}
+
+} // namespace opencog::ure
@@ -118,6 +118,45 @@ TEST(AtomSpace_duplicate_link_returns_same) {
     return true;
 }
 
+TEST(AtomSpace_hash_collisions_still_dedupe) {
+    AtomSpace space;
+
+    std::vector<Handle> nodes;
+    for (int i = 0; i < 60; ++i) {
+        nodes.push_back(space.add_node(AtomType::CONCEPT_NODE, "N" + std::to_string(i)));
+    }
+
+    // Enough links that some share a hash
+    std::vector<Handle> links;
+    for (AtomType type : {AtomType::INHERITANCE_LINK, AtomType::SIMILARITY_LINK}) {
+        for (Handle a : nodes) {
+            for (Handle b : nodes) links.push_back(space.add_link(type, {a, b}));
+        }
+    }
+    const size_t count = space.link_count();
+    ASSERT_EQ(count, links.size());
+
+    size_t i = 0;
+    for (AtomType type : {AtomType::INHERITANCE_LINK, AtomType::SIMILARITY_LINK}) {
+        for (Handle a : nodes) {
+            for (Handle b : nodes) {
+                ASSERT_EQ(space.get_link(type, {a, b}).id(), links[i].id());
+                ASSERT_EQ(space.add_link(type, {a, b}).id(), links[i].id());
+                ++i;
+            }
+        }
+    }
+    ASSERT_EQ(space.link_count(), count);
+
+    // Removing one atom leaves others under the same hash findable
+    ASSERT(space.remove(links[0]));
+    for (size_t k = 1; k < links.size(); ++k) {
+        const auto out = space.get_outgoing(links[k]);
+        ASSERT_EQ(space.get_link(space.get_type(links[k]), {out[0], out[1]}).id(), links[k].id());
+    }
+    return true;
+}
+
 TEST(AtomSpace_get_node) {
     AtomSpace space;
 
@@ -315,3 +354,46 @@ TEST(AtomSpace_clear) {
     ASSERT_EQ(space.size(), 0u);
     return true;
 }
+
+TEST(AtomSpace_clear_invalidates_old_handles) {
+    AtomSpace space;
+
+    Handle a = space.add_node(AtomType::CONCEPT_NODE, "A");
+    space.clear();
+    ASSERT(!space.contains(a));
+
+    // The reused slot gets a new generation
+    Handle b = space.add_node(AtomType::CONCEPT_NODE, "B");
+    ASSERT(b.valid());
+    ASSERT_EQ(a.id().index(), b.id().index());
+    ASSERT_NE(a.id(), b.id());
+    ASSERT(!space.contains(a));
+    ASSERT_EQ(space.get_name(b), "B");
+    ASSERT(!space.get_node(AtomType::CONCEPT_NODE, "A").valid());
+    return true;
+}
+
+TEST(AtomSpace_gather_and_set_tvs) {
+    AtomSpace space;
+    Handle a = space.add_node(AtomType::CONCEPT_NODE, "A", TruthValue{0.25f, 0.5f});
+    Handle b = space.add_node(AtomType::CONCEPT_NODE, "B", TruthValue{0.75f, 0.125f});
+    Handle gone = space.add_node(AtomType::CONCEPT_NODE, "Gone", TruthValue{0.5f, 0.5f});
+    space.remove(gone);
+
+    std::vector<AtomId> ids = {b.id(), gone.id(), a.id()};
+    float s[3], c[3];
+    space.gather_tvs(ids, s, c);
+    ASSERT_EQ(s[0], 0.75f);
+    ASSERT_EQ(c[0], 0.125f);
+    ASSERT_EQ(s[1], 0.0f);   // Missing atoms read as TruthValue{}
+    ASSERT_EQ(s[2], 0.25f);
+
+    // Strengths only; confidences untouched, missing atom skipped
+    float new_s[3] = {0.1f, 0.2f, 0.3f};
+    space.set_tvs(ids, new_s, nullptr);
+    ASSERT_EQ(space.get_tv(b).strength, 0.1f);
+    ASSERT_EQ(space.get_tv(b).confidence, 0.125f);
+    ASSERT_EQ(space.get_tv(a).strength, 0.3f);
+    ASSERT_EQ(space.size(), 2u);
+    return true;
+}
@@ -4,6 +4,7 @@
  */
 
 #include <opencog/pattern/matcher.hpp>
+#include <opencog/pattern/standing_query.hpp>
 
 namespace test {
 extern bool register_test(const std::string& name, std::function<bool()> func);
@@ -286,3 +287,792 @@ TEST(GlobTerm_creation) {
     ASSERT_EQ(glob.max_count, 5u);
     return true;
 }
+
+TEST(Glob_matches_variable_arity) {
+    AtomSpace space;
+
+    Handle a = space.add_node(AtomType::CONCEPT_NODE, "A");
+    Handle b = space.add_node(AtomType::CONCEPT_NODE, "B");
+    Handle c = space.add_node(AtomType::CONCEPT_NODE, "C");
+
+    (void)space.add_link(AtomType::ORDERED_LINK, {a});
+    (void)space.add_link(AtomType::ORDERED_LINK, {a, b});
+    (void)space.add_link(AtomType::ORDERED_LINK, {a, b, c});
+
+    PatternMatcher matcher(space);
+
+    Pattern pattern;
+    pattern.body = link(AtomType::ORDERED_LINK, {ground(a.id()), glob("REST")});
+
+    auto results = matcher.find_all(pattern);
+    ASSERT_EQ(results.size(), 3u);
+
+    for (const auto& result : results) {
+        auto rest = result.bindings.get_glob("REST");
+        ASSERT_EQ(rest.size() + 1, space.atom_table().get_outgoing(result.matched_atom).size());
+    }
+    return true;
+}
+
+TEST(Glob_respects_bounds) {
+    AtomSpace space;
+
+    std::vector<Handle> nodes;
+    for (int i = 0; i < 4; ++i) {
+        nodes.push_back(space.add_node(AtomType::CONCEPT_NODE, "N" + std::to_string(i)));
+    }
+    for (size_t n = 1; n <= nodes.size(); ++n) {
+        (void)space.add_link(AtomType::ORDERED_LINK,
+            std::vector<Handle>(nodes.begin(), nodes.begin() + static_cast<long>(n)));
+    }
+
+    PatternMatcher matcher(space);
+
+    Pattern pattern;
+    pattern.body = link(AtomType::ORDERED_LINK, {glob("G", 2, 3)});
+
+    ASSERT_EQ(matcher.count_matches(pattern), 2u);
+    return true;
+}
+
+TEST(Glob_anchored_between_fixed_terms) {
+    AtomSpace space;
+
+    Handle a = space.add_node(AtomType::CONCEPT_NODE, "A");
+    Handle b = space.add_node(AtomType::CONCEPT_NODE, "B");
+    Handle c = space.add_node(AtomType::CONCEPT_NODE, "C");
+    Handle event = space.add_node(AtomType::CONCEPT_NODE, "Event");
+
+    Handle seq = space.add_link(AtomType::ORDERED_LINK, {a, event, b, c});
+
+    PatternMatcher matcher(space);
+
+    Pattern pattern;
+    pattern.variables = {"LAST"};
+    pattern.body = link(AtomType::ORDERED_LINK, {
+        glob("BEFORE"),
+        ground(event.id()),
+        glob("AFTER", 1),
+        var("LAST")
+    });
+
+    auto result = matcher.find_first(pattern);
+    ASSERT(result.has_value());
+    ASSERT_EQ(result->matched_atom, seq.id());
+
+    auto before = result->bindings.get_glob("BEFORE");
+    auto after = result->bindings.get_glob("AFTER");
+    ASSERT_EQ(before.size(), 1u);
+    ASSERT_EQ(before[0], a.id());
+    ASSERT_EQ(after.size(), 1u);
+    ASSERT_EQ(after[0], b.id());
+    ASSERT_EQ(result->bindings.get("LAST"), c.id());
+
+    // The glob span aliases the link's own outgoing set
+    auto outgoing = space.atom_table().get_outgoing(seq.id());
+    ASSERT(before.data() == outgoing.data());
+    return true;
+}
+
+TEST(Glob_repeated_name_must_repeat_run) {
+    AtomSpace space;
+
+    Handle a = space.add_node(AtomType::CONCEPT_NODE, "A");
+    Handle b = space.add_node(AtomType::CONCEPT_NODE, "B");
+    Handle sep = space.add_node(AtomType::CONCEPT_NODE, "Sep");
+
+    (void)space.add_link(AtomType::ORDERED_LINK, {a, b, sep, a, b});
+    (void)space.add_link(AtomType::ORDERED_LINK, {a, b, sep, b, a});
+
+    PatternMatcher matcher(space);
+
+    Pattern pattern;
+    pattern.body = link(AtomType::ORDERED_LINK, {glob("X"), ground(sep.id()), glob("X")});
+
+    ASSERT_EQ(matcher.count_matches(pattern), 1u);
+    return true;
+}
+
+TEST(Glob_match_atom_backtracks_into_nested_splits) {
+    AtomSpace space;
+
+    Handle a = space.add_node(AtomType::CONCEPT_NODE, "A");
+    Handle b = space.add_node(AtomType::CONCEPT_NODE, "B");
+    Handle inner = space.add_link(AtomType::ORDERED_LINK, {a, b});
+    Handle outer = space.add_link(AtomType::ORDERED_LINK, {inner, b});
+
+    PatternMatcher matcher(space);
+
+    // The inner link's first split binds X to A; only its second, X = B,
+    // lets the outer link's last term match
+    PatternTerm pattern = link(AtomType::ORDERED_LINK, {
+        link(AtomType::ORDERED_LINK, {glob("G"), var("X"), glob("H")}),
+        var("X")
+    });
+
+    auto result = matcher.match_atom(pattern, outer.id());
+    ASSERT(result.has_value());
+    ASSERT_EQ(result->bindings.get("X"), b.id());
+    ASSERT_EQ(result->bindings.get_glob("G").size(), 1u);
+    ASSERT(result->bindings.get_glob("H").empty());
+    return true;
+}
+
+TEST(Glob_split_chosen_by_later_conjunct) {
+    AtomSpace space;
+
+    Handle a = space.add_node(AtomType::CONCEPT_NODE, "A");
+    Handle b = space.add_node(AtomType::CONCEPT_NODE, "B");
+    Handle c = space.add_node(AtomType::CONCEPT_NODE, "C");
+    Handle animal = space.add_node(AtomType::CONCEPT_NODE, "animal");
+    (void)space.add_link(AtomType::ORDERED_LINK, {a, b, c});
+    (void)space.add_link(AtomType::INHERITANCE_LINK, {c, animal});
+
+    PatternMatcher matcher(space);
+
+    // Only the last split, X = C, satisfies the second conjunct
+    Pattern pattern;
+    pattern.variables = {"X"};
+    pattern.body = and_pattern({
+        link(AtomType::ORDERED_LINK, {glob("G"), var("X"), glob("H")}),
+        link(AtomType::INHERITANCE_LINK, {var("X"), ground(animal.id())})
+    });
+
+    auto results = matcher.find_all(pattern);
+    ASSERT_EQ(results.size(), 1u);
+    ASSERT_EQ(results[0].bindings.get("X"), c.id());
+    ASSERT_EQ(results[0].bindings.get_glob("G").size(), 2u);
+    ASSERT(results[0].bindings.get_glob("H").empty());
+
+    // A split nested in a link is chosen by a term after it
+    Handle inner = space.add_link(AtomType::ORDERED_LINK, {a, b});
+    Handle outer = space.add_link(AtomType::ORDERED_LINK, {inner, b});
+    Pattern nested;
+    nested.variables = {"Y"};
+    nested.body = link(AtomType::ORDERED_LINK, {
+        link(AtomType::ORDERED_LINK, {glob("P"), var("Y"), glob("Q")}),
+        var("Y")
+    });
+    auto found = matcher.find_all(nested);
+    ASSERT_EQ(found.size(), 1u);
+    ASSERT_EQ(found[0].matched_atom, outer.id());
+    ASSERT_EQ(found[0].bindings.get("Y"), b.id());
+    return true;
+}
+
+TEST(Glob_enumerates_every_split) {
+    AtomSpace space;
+
+    Handle a = space.add_node(AtomType::CONCEPT_NODE, "A");
+    Handle b = space.add_node(AtomType::CONCEPT_NODE, "B");
+    Handle c = space.add_node(AtomType::CONCEPT_NODE, "C");
+    (void)space.add_link(AtomType::ORDERED_LINK, {a, b, c});
+
+    PatternMatcher matcher(space);
+
+    // X can be any of the three members
+    Pattern pattern;
+    pattern.variables = {"X"};
+    pattern.body = link(AtomType::ORDERED_LINK, {glob("G"), var("X"), glob("H")});
+
+    auto results = matcher.find_all(pattern);
+    ASSERT_EQ(results.size(), 3u);
+    for (size_t i = 0; i < results.size(); ++i) {
+        ASSERT_EQ(results[i].bindings.get_glob("G").size(), i);
+        ASSERT_EQ(results[i].bindings.get_glob("H").size(), 2 - i);
+    }
+    ASSERT_EQ(results[0].bindings.get("X"), a.id());
+    ASSERT_EQ(results[2].bindings.get("X"), c.id());
+
+    // Three globs over three atoms, the last never empty, split six ways
+    Pattern pair;
+    pair.body = link(AtomType::ORDERED_LINK, {glob("L"), glob("M"), glob("R", 1)});
+    ASSERT_EQ(matcher.count_matches(pair), 6u);
+    return true;
+}
+
+TEST(Conjunction_shares_variables) {
+    AtomSpace space;
+
+    Handle a = space.add_node(AtomType::CONCEPT_NODE, "A");
+    Handle b = space.add_node(AtomType::CONCEPT_NODE, "B");
+    Handle c = space.add_node(AtomType::CONCEPT_NODE, "C");
+    Handle d = space.add_node(AtomType::CONCEPT_NODE, "D");
+    Handle x = space.add_node(AtomType::CONCEPT_NODE, "X");
+
+    (void)space.add_link(AtomType::INHERITANCE_LINK, {a, b});
+    (void)space.add_link(AtomType::INHERITANCE_LINK, {b, c});
+    (void)space.add_link(AtomType::INHERITANCE_LINK, {b, d});
+    (void)space.add_link(AtomType::INHERITANCE_LINK, {x, x});
+
+    PatternMatcher matcher(space);
+
+    Pattern pattern;
+    pattern.variables = {"X", "Y", "Z"};
+    pattern.body = and_pattern({
+        link(AtomType::INHERITANCE_LINK, {var("X"), var("Y")}),
+        link(AtomType::INHERITANCE_LINK, {var("Y"), var("Z")})
+    });
+
+    // A->B->C, A->B->D and the self-loop X->X->X
+    auto results = matcher.find_all(pattern);
+    ASSERT_EQ(results.size(), 3u);
+
+    size_t through_b = 0;
+    for (const auto& result : results) {
+        if (result.bindings.get("Y") == b.id()) {
+            ASSERT_EQ(result.bindings.get("X"), a.id());
+            ++through_b;
+        }
+    }
+    ASSERT_EQ(through_b, 2u);
+    return true;
+}
+
+TEST(Conjunction_with_negation) {
+    AtomSpace space;
+
+    Handle cat = space.add_node(AtomType::CONCEPT_NODE, "Cat");
+    Handle dog = space.add_node(AtomType::CONCEPT_NODE, "Dog");
+    Handle animal = space.add_node(AtomType::CONCEPT_NODE, "Animal");
+    Handle pet = space.add_node(AtomType::CONCEPT_NODE, "Pet");
+
+    (void)space.add_link(AtomType::INHERITANCE_LINK, {cat, animal});
+    (void)space.add_link(AtomType::INHERITANCE_LINK, {dog, animal});
+    (void)space.add_link(AtomType::INHERITANCE_LINK, {dog, pet});
+
+    PatternMatcher matcher(space);
+
+    Pattern pattern;
+    pattern.variables = {"X"};
+    pattern.body = and_pattern({
+        link(AtomType::INHERITANCE_LINK, {var("X"), ground(animal.id())}),
+        not_pattern(link(AtomType::INHERITANCE_LINK, {var("X"), ground(pet.id())}))
+    });
+
+    auto results = matcher.find_all(pattern);
+    ASSERT_EQ(results.size(), 1u);
+    ASSERT_EQ(results[0].bindings.get("X"), cat.id());
+    return true;
+}
+
+TEST(Or_pattern_matches_alternatives) {
+    AtomSpace space;
+
+    (void)space.add_node(AtomType::CONCEPT_NODE, "Cat");
+    (void)space.add_node(AtomType::PREDICATE_NODE, "is-fluffy");
+    (void)space.add_node(AtomType::SCHEMA_NODE, "eat");
+
+    PatternMatcher matcher(space);
+
+    Pattern pattern;
+    pattern.body = or_pattern({
+        typed(AtomType::CONCEPT_NODE),
+        typed(AtomType::PREDICATE_NODE)
+    });
+
+    ASSERT_EQ(matcher.count_matches(pattern), 2u);
+    return true;
+}
+
+TEST(Match_into_reuses_buffer) {
+    AtomSpace space;
+
+    Handle animal = space.add_node(AtomType::CONCEPT_NODE, "Animal");
+    for (int i = 0; i < 10; ++i) {
+        Handle s = space.add_node(AtomType::CONCEPT_NODE, "Species" + std::to_string(i));
+        (void)space.add_link(AtomType::INHERITANCE_LINK, {s, animal});
+    }
+
+    PatternMatcher matcher(space);
+
+    Pattern pattern;
+    pattern.variables = {"X"};
+    pattern.body = link(AtomType::INHERITANCE_LINK, {var("X"), ground(animal.id())});
+
+    std::vector<MatchResult> buffer;
+    ASSERT_EQ(matcher.match_into(pattern, buffer), 10u);
+    ASSERT_EQ(buffer.size(), 10u);
+
+    ASSERT_EQ(matcher.match_into(pattern, buffer, 4), 4u);
+    ASSERT_EQ(buffer.size(), 4u);
+    for (const auto& result : buffer) {
+        ASSERT(result.bindings.contains("X"));
+        ASSERT(result.valid());
+    }
+    return true;
+}
+
+TEST(For_each_match_stops_early) {
+    AtomSpace space;
+
+    for (int i = 0; i < 20; ++i) {
+        (void)space.add_node(AtomType::CONCEPT_NODE, "Node" + std::to_string(i));
+    }
+
+    PatternMatcher matcher(space);
+
+    Pattern pattern;
+    pattern.variables = {"X"};
+    pattern.body = var("X", AtomType::CONCEPT_NODE);
+
+    size_t seen = 0;
+    size_t visited = matcher.for_each_match(pattern, [&](const MatchEngine& m) {
+        ASSERT(m.value("X").valid());
+        return ++seen < 5;
+    });
+    ASSERT_EQ(visited, 5u);
+    ASSERT_EQ(seen, 5u);
+    return true;
+}
+
+TEST(MatchEngine_initial_bindings) {
+    AtomSpace space;
+
+    Handle a = space.add_node(AtomType::CONCEPT_NODE, "A");
+    Handle b = space.add_node(AtomType::CONCEPT_NODE, "B");
+    Handle c = space.add_node(AtomType::CONCEPT_NODE, "C");
+
+    (void)space.add_link(AtomType::INHERITANCE_LINK, {a, c});
+    (void)space.add_link(AtomType::INHERITANCE_LINK, {b, c});
+
+    Pattern pattern;
+    pattern.variables = {"X", "Y"};
+    pattern.body = link(AtomType::INHERITANCE_LINK, {var("X"), var("Y")});
+
+    BindingSet initial;
+    initial.bind("X", b.id());
+
+    MatchEngine engine(space);
+    engine.reset(pattern, initial);
+
+    size_t count = 0;
+    while (engine.next()) {
+        ASSERT_EQ(engine.value("X"), b.id());
+        ASSERT_EQ(engine.value("Y"), c.id());
+        ++count;
+    }
+    ASSERT_EQ(count, 1u);
+    return true;
+}
+
+// ============================================================================
+// Standing Queries
+// ============================================================================
+
+TEST(StandingQuery_initial_and_incremental) {
+    AtomSpace space;
+    QueryRegistry registry(space);
+
+    Handle a = space.add_node(AtomType::CONCEPT_NODE, "A");
+    Handle b = space.add_node(AtomType::CONCEPT_NODE, "B");
+    Handle c = space.add_node(AtomType::CONCEPT_NODE, "C");
+    Handle d = space.add_node(AtomType::CONCEPT_NODE, "D");
+    (void)space.add_link(AtomType::INHERITANCE_LINK, {a, b});
+
+    // Two-hop chains X -> Y -> Z
+    Pattern pattern;
+    pattern.variables = {"X", "Y", "Z"};
+    pattern.body = and_pattern({
+        link(AtomType::INHERITANCE_LINK, {var("X"), var("Y")}),
+        link(AtomType::INHERITANCE_LINK, {var("Y"), var("Z")})
+    });
+
+    size_t added = 0, removed = 0, calls = 0;
+    auto id = registry.subscribe(pattern, [&](auto add, auto rem) {
+        added += add.size();
+        removed += rem.size();
+        ++calls;
+    });
+    ASSERT_EQ(calls, 1u);
+    ASSERT_EQ(added, 0u);
+
+    (void)space.add_link(AtomType::INHERITANCE_LINK, {b, c});
+    ASSERT_EQ(added, 1u);
+    ASSERT_EQ(registry.result_count(id), 1u);
+
+    auto results = registry.results(id);
+    ASSERT_EQ(results.size(), 1u);
+    ASSERT_EQ(results[0].bindings.get("X"), a.id());
+    ASSERT_EQ(results[0].bindings.get("Z"), c.id());
+
+    // Unrelated link types never reach the query
+    (void)space.add_link(AtomType::SIMILARITY_LINK, {c, d});
+    ASSERT_EQ(calls, 2u);
+
+    (void)space.add_link(AtomType::INHERITANCE_LINK, {c, d});
+    ASSERT_EQ(added, 2u);
+    ASSERT_EQ(registry.result_count(id), 2u);
+    ASSERT_EQ(removed, 0u);
+    return true;
+}
+
+TEST(StandingQuery_self_join_has_no_duplicates) {
+    AtomSpace space;
+    QueryRegistry registry(space);
+
+    Handle a = space.add_node(AtomType::CONCEPT_NODE, "A");
+
+    Pattern pattern;
+    pattern.variables = {"X", "Y", "Z"};
+    pattern.body = and_pattern({
+        link(AtomType::INHERITANCE_LINK, {var("X"), var("Y")}),
+        link(AtomType::INHERITANCE_LINK, {var("Y"), var("Z")})
+    });
+
+    size_t added = 0;
+    auto id = registry.subscribe(pattern, [&](auto add, auto) { added += add.size(); });
+
+    // A -> A joins with itself through both conjuncts; reported once
+    (void)space.add_link(AtomType::INHERITANCE_LINK, {a, a});
+    ASSERT_EQ(added, 1u);
+    ASSERT_EQ(registry.result_count(id), 1u);
+    return true;
+}
+
+TEST(StandingQuery_recursive_remove) {
+    AtomSpace space;
+    QueryRegistry registry(space);
+
+    Handle cat = space.add_node(AtomType::CONCEPT_NODE, "Cat");
+    Handle dog = space.add_node(AtomType::CONCEPT_NODE, "Dog");
+    Handle animal = space.add_node(AtomType::CONCEPT_NODE, "Animal");
+    (void)space.add_link(AtomType::INHERITANCE_LINK, {cat, animal});
+    (void)space.add_link(AtomType::INHERITANCE_LINK, {dog, animal});
+
+    Pattern pattern;
+    pattern.variables = {"X"};
+    pattern.body = link(AtomType::INHERITANCE_LINK, {var("X"), ground(animal.id())});
+
+    size_t removed = 0;
+    auto id = registry.subscribe(pattern, [&](auto, auto rem) { removed += rem.size(); });
+    ASSERT_EQ(registry.result_count(id), 2u);
+
+    // Removing Cat takes its link, and the link's match, with it
+    ASSERT(space.remove(cat, true));
+    ASSERT_EQ(removed, 1u);
+    ASSERT_EQ(registry.result_count(id), 1u);
+    ASSERT_EQ(space.count_atoms(AtomType::INHERITANCE_LINK), 1u);
+
+    ASSERT(registry.unsubscribe(id));
+    ASSERT_EQ(registry.query_count(), 0u);
+    return true;
+}
+
+TEST(StandingQuery_filter_follows_tv) {
+    AtomSpace space;
+    QueryRegistry registry(space);
+
+    Handle cat = space.add_node(AtomType::CONCEPT_NODE, "Cat");
+    Handle animal = space.add_node(AtomType::CONCEPT_NODE, "Animal");
+    Handle link_h = space.add_link(AtomType::INHERITANCE_LINK, {cat, animal},
+                                   TruthValue{0.2f, 0.9f});
+
+    Pattern pattern;
+    pattern.variables = {"X", "Y"};
+    pattern.body = link(AtomType::INHERITANCE_LINK, {var("X"), var("Y")});
+
+    size_t added = 0, removed = 0;
+    auto id = registry.subscribe(
+        pattern,
+        [&](auto add, auto rem) { added += add.size(); removed += rem.size(); },
+        [](const AtomSpace& as, const MatchResult& r) {
+            return as.atom_table().get_tv(r.matched_atom).strength > 0.5f;
+        });
+    ASSERT_EQ(registry.result_count(id), 0u);
+
+    space.set_tv(link_h, TruthValue{0.8f, 0.9f});
+    ASSERT_EQ(added, 1u);
+    ASSERT_EQ(registry.result_count(id), 1u);
+
+    space.set_tv(link_h, TruthValue{0.1f, 0.9f});
+    ASSERT_EQ(removed, 1u);
+    ASSERT_EQ(registry.result_count(id), 0u);
+    return true;
+}
+
+TEST(StandingQuery_negation_reevaluates) {
+    AtomSpace space;
+    QueryRegistry registry(space);
+
+    Handle cat = space.add_node(AtomType::CONCEPT_NODE, "Cat");
+    Handle animal = space.add_node(AtomType::CONCEPT_NODE, "Animal");
+    (void)space.add_link(AtomType::INHERITANCE_LINK, {cat, animal});
+
+    // Inheritances without a matching similarity
+    Pattern pattern;
+    pattern.variables = {"X", "Y"};
+    pattern.body = and_pattern({
+        link(AtomType::INHERITANCE_LINK, {var("X"), var("Y")}),
+        not_pattern(link(AtomType::SIMILARITY_LINK, {var("X"), var("Y")}))
+    });
+
+    auto id = registry.subscribe(pattern, [](auto, auto) {});
+    ASSERT_EQ(registry.result_count(id), 1u);
+
+    Handle sim = space.add_link(AtomType::SIMILARITY_LINK, {cat, animal});
+    ASSERT_EQ(registry.result_count(id), 0u);
+
+    ASSERT(space.remove(sim));
+    ASSERT_EQ(registry.result_count(id), 1u);
+    return true;
+}
+
+TEST(StandingQuery_duplicate_add_is_silent) {
+    AtomSpace space;
+    QueryRegistry registry(space);
+
+    Handle a = space.add_node(AtomType::CONCEPT_NODE, "A");
+    Handle b = space.add_node(AtomType::CONCEPT_NODE, "B");
+
+    Pattern pattern;
+    pattern.variables = {"X", "Y"};
+    pattern.body = link(AtomType::INHERITANCE_LINK, {var("X"), var("Y")});
+
+    size_t calls = 0;
+    registry.subscribe(pattern, [&](auto, auto) { ++calls; });
+
+    (void)space.add_link(AtomType::INHERITANCE_LINK, {a, b});
+    (void)space.add_link(AtomType::INHERITANCE_LINK, {a, b});
+    ASSERT_EQ(calls, 2u);
+    ASSERT_EQ(space.get_atoms_by_type(AtomType::INHERITANCE_LINK).size(), 1u);
+    return true;
+}
+
+TEST(StandingQuery_clear_drops_results) {
+    AtomSpace space;
+    QueryRegistry registry(space);
+
+    Handle a = space.add_node(AtomType::CONCEPT_NODE, "A");
+    Handle b = space.add_node(AtomType::CONCEPT_NODE, "B");
+    (void)space.add_link(AtomType::INHERITANCE_LINK, {a, b});
+
+    Pattern pattern;
+    pattern.variables = {"X", "Y"};
+    pattern.body = link(AtomType::INHERITANCE_LINK, {var("X"), var("Y")});
+
+    size_t removed = 0;
+    auto id = registry.subscribe(pattern, [&](auto, auto rem) { removed += rem.size(); });
+    ASSERT_EQ(registry.result_count(id), 1u);
+
+    space.clear();
+    ASSERT_EQ(removed, 1u);
+    ASSERT_EQ(registry.result_count(id), 0u);
+    ASSERT(registry.results(id).empty());
+
+    // The query keeps tracking the refilled space
+    Handle c = space.add_node(AtomType::CONCEPT_NODE, "C");
+    Handle d = space.add_node(AtomType::CONCEPT_NODE, "D");
+    (void)space.add_link(AtomType::INHERITANCE_LINK, {c, d});
+    auto results = registry.results(id);
+    ASSERT_EQ(results.size(), 1u);
+    ASSERT_EQ(results[0].bindings.get("X"), c.id());
+    return true;
+}
+
+// ============================================================================
+// Query Cache
+// ============================================================================
+
+TEST(Fingerprint_alpha_renaming) {
+    Pattern p1;
+    p1.body = link(AtomType::INHERITANCE_LINK, {var("X"), var("Y")});
+    Pattern p2;
+    p2.body = link(AtomType::INHERITANCE_LINK, {var("A"), var("B")});
+    Pattern p3;
+    p3.body = link(AtomType::INHERITANCE_LINK, {var("X"), var("X")});
+
+    auto f1 = fingerprint(p1);
+    auto f2 = fingerprint(p2);
+    auto f3 = fingerprint(p3);
+
+    ASSERT(f1.same_structure(f2));
+    ASSERT(!f1.same_structure(f3));
+    ASSERT_EQ(f2.variables[0], "A");
+    ASSERT_EQ(f1.dependencies.size(), 1u);
+    ASSERT_EQ(f1.dependencies[0], AtomType::INHERITANCE_LINK);
+    ASSERT(!f1.any_type);
+    return true;
+}
+
+TEST(QueryCache_hits_renamed_pattern) {
+    AtomSpace space;
+
+    Handle cat = space.add_node(AtomType::CONCEPT_NODE, "Cat");
+    Handle animal = space.add_node(AtomType::CONCEPT_NODE, "Animal");
+    (void)space.add_link(AtomType::INHERITANCE_LINK, {cat, animal});
+
+    PatternMatcher matcher(space);
+
+    Pattern p1;
+    p1.body = link(AtomType::INHERITANCE_LINK, {var("X"), var("Y")});
+    Pattern p2;
+    p2.body = link(AtomType::INHERITANCE_LINK, {var("A"), var("B")});
+
+    auto r1 = matcher.find_all(p1);
+    ASSERT_EQ(matcher.cache_stats().misses, 1u);
+
+    auto r2 = matcher.find_all(p2);
+    ASSERT_EQ(matcher.cache_stats().hits, 1u);
+    ASSERT_EQ(r2.size(), 1u);
+    ASSERT_EQ(r2[0].bindings.get("A"), cat.id());
+    ASSERT_EQ(r2[0].bindings.get("B"), animal.id());
+    ASSERT(!r2[0].bindings.contains("X"));
+
+    ASSERT_EQ(matcher.count_matches(p1), 1u);
+    ASSERT_EQ(matcher.cache_stats().hits, 2u);
+    return true;
+}
+
+TEST(QueryCache_invalidated_by_type) {
+    AtomSpace space;
+
+    Handle a = space.add_node(AtomType::CONCEPT_NODE, "A");
+    Handle b = space.add_node(AtomType::CONCEPT_NODE, "B");
+    (void)space.add_link(AtomType::INHERITANCE_LINK, {a, b});
+
+    PatternMatcher matcher(space);
+    Pattern pattern;
+    pattern.body = link(AtomType::INHERITANCE_LINK, {var("X"), var("Y")});
+
+    ASSERT_EQ(matcher.find_all(pattern).size(), 1u);
+
+    // Unrelated type: entry survives
+    (void)space.add_link(AtomType::SIMILARITY_LINK, {a, b});
+    ASSERT_EQ(matcher.find_all(pattern).size(), 1u);
+    ASSERT_EQ(matcher.cache_stats().hits, 1u);
+
+    // Same type: entry is stale
+    Handle link_h = space.add_link(AtomType::INHERITANCE_LINK, {b, a});
+    ASSERT_EQ(matcher.find_all(pattern).size(), 2u);
+    ASSERT_EQ(matcher.cache_stats().invalidations, 1u);
+
+    ASSERT(space.remove(link_h));
+    ASSERT_EQ(matcher.find_all(pattern).size(), 1u);
+    ASSERT_EQ(matcher.cache_stats().invalidations, 2u);
+    return true;
+}
+
+TEST(QueryCache_partial_entries_and_eviction) {
+    AtomSpace space;
+
+    Handle hub = space.add_node(AtomType::CONCEPT_NODE, "Hub");
+    for (int i = 0; i < 10; ++i) {
+        Handle n = space.add_node(AtomType::CONCEPT_NODE, "N" + std::to_string(i));
+        (void)space.add_link(AtomType::INHERITANCE_LINK, {n, hub});
+    }
+
+    MatcherConfig config;
+    config.cache_capacity = 1;
+    PatternMatcher matcher(space, config);
+
+    Pattern pattern;
+    pattern.body = link(AtomType::INHERITANCE_LINK, {var("X"), ground(hub.id())});
+
+    // A limited result set answers smaller limits but not larger ones
+    ASSERT_EQ(matcher.find_all(pattern, 3).size(), 3u);
+    ASSERT_EQ(matcher.find_all(pattern, 2).size(), 2u);
+    ASSERT_EQ(matcher.cache_stats().hits, 1u);
+    ASSERT_EQ(matcher.find_all(pattern).size(), 10u);
+    ASSERT_EQ(matcher.cache_stats().misses, 2u);
+
+    Pattern other;
+    other.body = link(AtomType::INHERITANCE_LINK, {ground(hub.id()), var("X")});
+    ASSERT_EQ(matcher.find_all(other).size(), 0u);
+    ASSERT_EQ(matcher.cache_size(), 1u);
+    ASSERT_EQ(matcher.cache_stats().evictions, 1u);
+    return true;
+}
+
+// ============================================================================
+// Full-Space Scans
+// ============================================================================
+
+TEST(Filter_streams_matching_atoms) {
+    AtomSpace space;
+
+    for (int i = 0; i < 3000; ++i) {
+        float strength = (i % 3 == 0) ? 0.9f : 0.1f;
+        (void)space.add_node(AtomType::CONCEPT_NODE, "N" + std::to_string(i), TruthValue{strength, 0.9f});
+    }
+
+    MatcherConfig config;
+    config.cache_capacity = 0;
+    PatternMatcher matcher(space, config);
+
+    auto strong = [](const AtomSpace& as, Handle h) { return as.get_tv(h).strength > 0.5f; };
+
+    size_t count = 0;
+    for (AtomId id : matcher.filter(strong)) {
+        ASSERT(space.get_tv(space.make_handle(id)).strength > 0.5f);
+        ++count;
+    }
+    ASSERT_EQ(count, 1000u);
+
+    // Early termination
+    config.max_results = 10;
+    matcher.set_config(config);
+    count = 0;
+    for ([[maybe_unused]] AtomId id : matcher.filter(strong)) ++count;
+    ASSERT_EQ(count, 10u);
+    return true;
+}
+
+TEST(Filter_into_parallel_matches_serial) {
+    AtomSpace space;
+
+    for (int i = 0; i < 5000; ++i) {
+        (void)space.add_node(AtomType::CONCEPT_NODE, "N" + std::to_string(i),
+                             TruthValue{(i % 7 == 0) ? 0.9f : 0.1f, 0.9f});
+    }
+    // Holes in the slot range
+    for (int i = 0; i < 5000; i += 11) {
+        space.remove(space.get_node(AtomType::CONCEPT_NODE, "N" + std::to_string(i)));
+    }
+
+    PatternMatcher matcher(space);
+    auto strong = [](const AtomSpace& as, Handle h) { return as.get_tv(h).strength > 0.5f; };
+
+    std::vector<AtomId> serial, parallel;
+    matcher.filter_into(strong, serial);
+    matcher.filter_into(strong, parallel, 4);
+    ASSERT_GT(serial.size(), 0u);
+    ASSERT(serial == parallel);
+    return true;
+}
+
+TEST(Untyped_variable_conjunct_streams) {
+    AtomSpace space;
+
+    Handle a = space.add_node(AtomType::CONCEPT_NODE, "A");
+    Handle b = space.add_node(AtomType::PREDICATE_NODE, "B");
+    (void)space.add_link(AtomType::INHERITANCE_LINK, {a, b});
+    for (int i = 0; i < 2500; ++i) {
+        (void)space.add_node(AtomType::CONCEPT_NODE, "Filler" + std::to_string(i));
+    }
+
+    MatcherConfig config;
+    config.cache_capacity = 0;
+    PatternMatcher matcher(space, config);
+
+    // Every atom, across more than one scan batch
+    Pattern all;
+    all.body = var("X");
+    ASSERT_EQ(matcher.count_matches(all), space.size());
+
+    // Generic NODE under the type hierarchy: every node, no links
+    Pattern nodes;
+    nodes.body = typed(AtomType::NODE);
+    ASSERT_EQ(matcher.count_matches(nodes), space.node_count());
+
+    // Joined with a link conjunct
+    Pattern joined;
+    joined.body = and_pattern({
+        var("X"),
+        link(AtomType::INHERITANCE_LINK, {var("X"), var("Y")})
+    });
+    auto results = matcher.find_all(joined);
+    ASSERT_EQ(results.size(), 1u);
+    ASSERT_EQ(results[0].bindings.get("X"), a.id());
+    return true;
+}
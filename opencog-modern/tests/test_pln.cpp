@@ -5,7 +5,10 @@
 
 #include <opencog/pln/formulas.hpp>
 #include <opencog/pln/inference.hpp>
+#include <opencog/pln/static_rules.hpp>
 #include <cmath>
+#include <random>
+#include <thread>
 
 namespace test {
 extern bool register_test(const std::string& name, std::function<bool()> func);
@@ -201,6 +204,159 @@ TEST(PLN_batch_revision) {
     return true;
 }
 
+TEST(PLN_batch_deduction_any_length) {
+    // Longer than one transpose block, not a multiple of any vector width
+    const size_t n = 301;
+    std::vector<TruthValue> ab(n), bc(n), out(n);
+    std::vector<float> sB(n), sC(n);
+    for (size_t i = 0; i < n; ++i) {
+        ab[i] = TruthValue{0.002f * i, 0.9f};
+        bc[i] = TruthValue{1.0f - 0.002f * i, 0.8f};
+        sB[i] = 0.3f;
+        sC[i] = 0.001f * i;
+    }
+
+    batch_deduction(ab, bc, sB, sC, out);
+
+    for (size_t i = 0; i < n; ++i) {
+        TruthValue expected = deduction(ab[i], bc[i], sB[i], sC[i]);
+        ASSERT_NEAR(out[i].strength, expected.strength, 1e-5f);
+        ASSERT_NEAR(out[i].confidence, expected.confidence, 1e-6f);
+    }
+    return true;
+}
+
+TEST(PLN_soa_batch_from_gathered_columns) {
+    AtomSpace space;
+    std::vector<AtomId> ab_ids, bc_ids, b_ids, c_ids;
+    for (int i = 0; i < 21; ++i) {
+        Handle a = space.add_node(AtomType::CONCEPT_NODE, "A" + std::to_string(i));
+        Handle b = space.add_node(AtomType::CONCEPT_NODE, "B" + std::to_string(i),
+                                  TruthValue{0.02f * i, 0.9f});
+        Handle c = space.add_node(AtomType::CONCEPT_NODE, "C" + std::to_string(i),
+                                  TruthValue{0.5f, 0.9f});
+        ab_ids.push_back(space.add_link(AtomType::INHERITANCE_LINK, {a, b},
+                                        TruthValue{0.04f * i, 0.8f}).id());
+        bc_ids.push_back(space.add_link(AtomType::INHERITANCE_LINK, {b, c},
+                                        TruthValue{0.9f, 0.7f}).id());
+        b_ids.push_back(b.id());
+        c_ids.push_back(c.id());
+    }
+
+    const size_t n = ab_ids.size();
+    TVBuffer ab(n), bc(n), out(n);
+    SimdVector<float> sB(n), sC(n);
+    space.gather_tvs(ab_ids, ab.strength.data(), ab.confidence.data());
+    space.gather_tvs(bc_ids, bc.strength.data(), bc.confidence.data());
+    space.gather_tvs(b_ids, sB.data(), nullptr);
+    space.gather_tvs(c_ids, sC.data(), nullptr);
+
+    ASSERT_EQ(batch_deduction(ab.view(), bc.view(), {sB.data(), n}, {sC.data(), n},
+                              out.columns()), n);
+
+    for (size_t i = 0; i < n; ++i) {
+        TruthValue expected = deduction(space.get_tv(space.make_handle(ab_ids[i])),
+                                        space.get_tv(space.make_handle(bc_ids[i])),
+                                        sB[i], sC[i]);
+        ASSERT_NEAR(out.strength[i], expected.strength, 1e-5f);
+        ASSERT_NEAR(out.confidence[i], expected.confidence, 1e-6f);
+    }
+
+    // Shortest input bounds the batch
+    ASSERT_EQ(batch_fuzzy_and(ab.view(5), bc.view(), out.columns()), 5u);
+    return true;
+}
+
+// ============================================================================
+// Kernel Dispatch Tests
+// ============================================================================
+
+TEST(Kernels_match_scalar_formulas_at_every_level) {
+    using kernels::SimdLevel;
+
+    // Odd length and offset pointers: exercises unaligned loads and tails
+    constexpr size_t n = 37;
+    std::vector<float> in[6], out(n + 2), out_c(n + 2);
+    for (auto& v : in) v.resize(n + 1);
+    for (size_t i = 0; i <= n; ++i) {
+        in[0][i] = 0.013f * i;            // strengths
+        in[1][i] = 0.5f + 0.01f * i;      // confidences
+        in[2][i] = 0.9f - 0.017f * i;
+        in[3][i] = 0.95f - 0.005f * i;
+        in[4][i] = 0.2f + 0.004f * i;     // priors
+        in[5][i] = 0.1f + 0.02f * i;
+    }
+    const float* a = in[0].data() + 1;
+    const float* ca = in[1].data() + 1;
+    const float* b = in[2].data() + 1;
+    const float* cb = in[3].data() + 1;
+    const float* p1 = in[4].data() + 1;
+    const float* p2 = in[5].data() + 1;
+
+    const SimdLevel original = kernels::simd_level();
+    bool ok = true;
+
+    for (SimdLevel level : {SimdLevel::SCALAR, SimdLevel::SSE2, SimdLevel::NEON,
+                            SimdLevel::AVX2, SimdLevel::AVX512}) {
+        if (kernels::set_simd_level(level) != level) continue;
+
+        auto check = [&](auto expected) {
+            for (size_t i = 0; i < n; ++i) {
+                TruthValue tv = expected(i);
+                if (std::abs(out[i + 1] - tv.strength) > 1e-5f * std::max(1.0f, tv.strength)) ok = false;
+                if (std::abs(out_c[i + 1] - tv.confidence) > 1e-5f) ok = false;
+            }
+            // Masked and partial tails never write past count
+            if (out[0] != -1.0f || out[n + 1] != -1.0f) ok = false;
+            std::fill(out.begin(), out.end(), -1.0f);
+            std::fill(out_c.begin(), out_c.end(), -1.0f);
+        };
+        std::fill(out.begin(), out.end(), -1.0f);
+        std::fill(out_c.begin(), out_c.end(), -1.0f);
+        float* s_out = out.data() + 1;
+        float* c_out = out_c.data() + 1;
+
+        kernels::deduction(a, ca, b, cb, p1, p2, s_out, c_out, n);
+        check([&](size_t i) { return deduction({a[i], ca[i]}, {b[i], cb[i]}, p1[i], p2[i]); });
+
+        kernels::abduction(a, ca, b, cb, p1, p2, s_out, c_out, n);
+        check([&](size_t i) { return abduction({a[i], ca[i]}, {b[i], cb[i]}, p1[i], p2[i]); });
+
+        kernels::inversion(a, ca, p1, p2, s_out, c_out, n);
+        check([&](size_t i) { return inversion({a[i], ca[i]}, p1[i], p2[i]); });
+
+        kernels::revision(a, ca, b, cb, s_out, c_out, n);
+        check([&](size_t i) { return revision({a[i], ca[i]}, {b[i], cb[i]}); });
+
+        kernels::modus_ponens(a, ca, b, cb, s_out, c_out, n);
+        check([&](size_t i) { return modus_ponens({a[i], ca[i]}, {b[i], cb[i]}); });
+
+        kernels::fuzzy_and(a, ca, b, cb, s_out, c_out, n);
+        check([&](size_t i) { return fuzzy_and({a[i], ca[i]}, {b[i], cb[i]}); });
+
+        kernels::fuzzy_or(a, ca, b, cb, s_out, c_out, n);
+        check([&](size_t i) { return fuzzy_or({a[i], ca[i]}, {b[i], cb[i]}); });
+    }
+
+    kernels::set_simd_level(original);
+    return ok;
+}
+
+TEST(Kernels_dispatch_falls_back) {
+    using kernels::SimdLevel;
+    const SimdLevel original = kernels::simd_level();
+
+    ASSERT(kernels::set_simd_level(SimdLevel::SCALAR) == SimdLevel::SCALAR);
+    ASSERT_EQ(kernels::simd_width(), 1u);
+
+    // Asking for the widest level never selects more than the CPU offers
+    ASSERT(kernels::set_simd_level(SimdLevel::AVX512) == kernels::detected_simd_level());
+    ASSERT(kernels::simd_width() >= 1u);
+
+    kernels::set_simd_level(original);
+    return true;
+}
+
 // ============================================================================
 // Inference Engine Tests
 // ============================================================================
@@ -282,6 +438,417 @@ TEST(PLNEngine_backward_chain_grounded) {
     return true;
 }
 
+TEST(PLNEngine_backward_chain_proves_through_subgoals) {
+    AtomSpace space;
+    Handle a = space.add_node(AtomType::CONCEPT_NODE, "A", TruthValue{0.3f, 0.9f});
+    Handle b = space.add_node(AtomType::CONCEPT_NODE, "B", TruthValue{0.4f, 0.9f});
+    Handle c = space.add_node(AtomType::CONCEPT_NODE, "C", TruthValue{0.5f, 0.9f});
+    Handle d = space.add_node(AtomType::CONCEPT_NODE, "D", TruthValue{0.6f, 0.9f});
+    Handle ab = space.add_link(AtomType::INHERITANCE_LINK, {a, b}, TruthValue{0.9f, 0.9f});
+    Handle bc = space.add_link(AtomType::INHERITANCE_LINK, {b, c}, TruthValue{0.8f, 0.9f});
+    Handle cd = space.add_link(AtomType::INHERITANCE_LINK, {c, d}, TruthValue{0.7f, 0.9f});
+    // Unknown conclusions: A->C is a subgoal of A->D
+    Handle ac = space.add_link(AtomType::INHERITANCE_LINK, {a, c}, TruthValue{});
+    Handle ad = space.add_link(AtomType::INHERITANCE_LINK, {a, d}, TruthValue{});
+
+    PLNEngine engine(space);
+    engine.add_rule(rules::make_deduction_rule());
+    auto result = engine.backward_chain(ad);
+
+    ASSERT(result.has_value());
+    TruthValue tv_ac = deduction(space.get_tv(ab), space.get_tv(bc), 0.4f, 0.5f);
+    TruthValue tv_ad = deduction(tv_ac, space.get_tv(cd), 0.5f, 0.6f);
+    ASSERT_NEAR(result->truth_value.strength, tv_ad.strength, 1e-5f);
+    ASSERT_NEAR(result->truth_value.confidence, tv_ad.confidence, 1e-5f);
+
+    // Proof: A->C from (A->B, B->C), then A->D from (A->C, C->D)
+    ASSERT_EQ(result->proof.size(), 2u);
+    ASSERT_EQ(result->proof.steps()[0].conclusion.id(), ac.id());
+    ASSERT_EQ(result->proof.steps()[1].conclusion.id(), ad.id());
+
+    // Backward chaining does not write its conclusions
+    ASSERT_NEAR(space.get_tv(ad).confidence, 0.0f, 1e-6f);
+    return true;
+}
+
+TEST(ProofStore_shares_subproofs) {
+    AtomSpace space;
+    std::vector<Handle> n;
+    for (const char* name : {"A", "B", "C", "D", "E"}) {
+        n.push_back(space.add_node(AtomType::CONCEPT_NODE, name, TruthValue{0.4f, 0.9f}));
+    }
+    for (auto [from, to] : {std::pair{0, 1}, {1, 2}, {2, 3}, {2, 4}}) {
+        (void)space.add_link(AtomType::INHERITANCE_LINK, {n[from], n[to]}, TruthValue{0.9f, 0.9f});
+    }
+    Handle ac = space.add_link(AtomType::INHERITANCE_LINK, {n[0], n[2]}, TruthValue{});
+    Handle ad = space.add_link(AtomType::INHERITANCE_LINK, {n[0], n[3]}, TruthValue{});
+    Handle ae = space.add_link(AtomType::INHERITANCE_LINK, {n[0], n[4]}, TruthValue{});
+
+    std::optional<InferenceResult> via_d, via_e;
+    std::shared_ptr<ProofStore> store;
+    {
+        PLNEngine engine(space);
+        engine.add_rule(rules::make_deduction_rule());
+        store = engine.cache()->proofs();
+        via_d = engine.backward_chain(ad);
+        via_e = engine.backward_chain(ae);
+    }
+    ASSERT(via_d && via_e);
+
+    // A->C is recorded once and referenced by both conclusions
+    ASSERT_EQ(store->size(), 3u);
+    const ProofNode* root_d = via_d->proof.root();
+    const ProofNode* root_e = via_e->proof.root();
+    ASSERT_EQ(root_d->children.size(), 1u);
+    ASSERT_EQ(root_d->children[0], root_e->children[0]);
+    ASSERT_EQ(root_d->children[0]->conclusion, ac.id());
+    ASSERT_EQ(store->rule_name(root_e->rule), std::string_view("deduction"));
+
+    // Steps are extracted on demand, after the engine is gone
+    auto steps = via_e->proof.steps();
+    ASSERT_EQ(steps.size(), 2u);
+    ASSERT_EQ(steps[0].conclusion.id(), ac.id());
+    ASSERT_EQ(steps[1].conclusion.id(), ae.id());
+    ASSERT_EQ(steps[1].premises.size(), 2u);
+    ASSERT_EQ(steps[1].premises[0].id(), ac.id());
+    return true;
+}
+
+TEST(ProofStore_generations_free_old_proofs) {
+    AtomSpace space;
+    Handle a = space.add_node(AtomType::CONCEPT_NODE, "A", TruthValue{0.3f, 0.9f});
+    Handle b = space.add_node(AtomType::CONCEPT_NODE, "B", TruthValue{0.4f, 0.9f});
+    Handle c = space.add_node(AtomType::CONCEPT_NODE, "C", TruthValue{0.5f, 0.9f});
+    (void)space.add_link(AtomType::INHERITANCE_LINK, {a, b}, TruthValue{0.9f, 0.9f});
+    (void)space.add_link(AtomType::INHERITANCE_LINK, {b, c}, TruthValue{0.8f, 0.9f});
+    Handle ac = space.add_link(AtomType::INHERITANCE_LINK, {a, c}, TruthValue{});
+
+    // Any recorded step fills the store
+    InferenceConfig config;
+    config.proof_bytes = 1;
+    PLNEngine engine(space, config);
+    engine.add_rule(rules::make_deduction_rule());
+
+    auto first = engine.backward_chain(ac);
+    ASSERT(first.has_value());
+    std::weak_ptr<ProofStore> old_store = engine.cache()->proofs();
+    ASSERT(old_store.lock()->size() > 0);
+
+    // The next query starts a new store and drops the answers recorded in
+    // the old one, while the earlier result still reads its proof
+    auto second = engine.backward_chain(ac);
+    ASSERT(second.has_value());
+    ASSERT_EQ(engine.cache_hits(), 0u);
+    ASSERT_EQ(engine.cache()->stats().generations, 1u);
+    ASSERT(engine.cache()->proofs() != old_store.lock());
+    ASSERT_EQ(first->proof.steps().size(), 1u);
+    ASSERT_EQ(second->proof.steps()[0].rule_name, std::string("deduction"));
+
+    // The old store goes with the last result referring to it
+    first.reset();
+    ASSERT(old_store.expired());
+
+    // clear() starts a new store too
+    std::weak_ptr<ProofStore> cleared = engine.cache()->proofs();
+    engine.clear_cache();
+    second.reset();
+    ASSERT(cleared.expired());
+    return true;
+}
+
+TEST(PLNEngine_backward_chain_tables_subgoals) {
+    AtomSpace space;
+    Handle a = space.add_node(AtomType::CONCEPT_NODE, "A", TruthValue{0.3f, 0.9f});
+    Handle b = space.add_node(AtomType::CONCEPT_NODE, "B", TruthValue{0.4f, 0.9f});
+    Handle c = space.add_node(AtomType::CONCEPT_NODE, "C", TruthValue{0.5f, 0.9f});
+    Handle ab = space.add_link(AtomType::INHERITANCE_LINK, {a, b}, TruthValue{0.9f, 0.9f});
+    Handle bc = space.add_link(AtomType::INHERITANCE_LINK, {b, c}, TruthValue{0.8f, 0.9f});
+    Handle ac = space.add_link(AtomType::INHERITANCE_LINK, {a, c}, TruthValue{});
+
+    PLNEngine engine(space);
+    engine.add_rule(rules::make_deduction_rule());
+
+    auto first = engine.backward_chain(ac);
+    ASSERT(first.has_value());
+    ASSERT_EQ(engine.cache_hits(), 0u);
+    const size_t inferences = engine.total_inferences();
+
+    // The repeated query is answered from the table
+    auto second = engine.backward_chain(ac);
+    ASSERT(second.has_value());
+    ASSERT_EQ(engine.cache_hits(), 1u);
+    ASSERT_EQ(engine.total_inferences(), inferences);
+    ASSERT_NEAR(second->truth_value.strength, first->truth_value.strength, 1e-6f);
+
+    // A premise's truth value changed: the answer is re-derived
+    space.set_tv(ab, TruthValue{0.2f, 0.9f});
+    auto third = engine.backward_chain(ac);
+    ASSERT(third.has_value());
+    ASSERT_EQ(engine.cache_hits(), 1u);
+    TruthValue expected = deduction(space.get_tv(ab), space.get_tv(bc), 0.4f, 0.5f);
+    ASSERT_NEAR(third->truth_value.strength, expected.strength, 1e-5f);
+
+    // Atoms of types no premise matches leave it valid
+    Handle d = space.add_node(AtomType::CONCEPT_NODE, "D", TruthValue{0.6f, 0.9f});
+    auto fourth = engine.backward_chain(ac);
+    ASSERT(fourth.has_value());
+    ASSERT_EQ(engine.cache_hits(), 2u);
+
+    // A new link of a premise type may add a derivation: re-derived
+    (void)space.add_link(AtomType::INHERITANCE_LINK, {a, d}, TruthValue{0.7f, 0.9f});
+    auto fifth = engine.backward_chain(ac);
+    ASSERT(fifth.has_value());
+    ASSERT_EQ(engine.cache_hits(), 2u);
+    ASSERT_NEAR(fifth->truth_value.strength, expected.strength, 1e-5f);
+
+    engine.clear_cache();
+    ASSERT_EQ(engine.cache_size(), 0u);
+    return true;
+}
+
+TEST(PLNEngine_backward_chain_cycles_terminate) {
+    AtomSpace space;
+    Handle a = space.add_node(AtomType::CONCEPT_NODE, "A", TruthValue{0.3f, 0.9f});
+    Handle b = space.add_node(AtomType::CONCEPT_NODE, "B", TruthValue{0.4f, 0.9f});
+    // Each link is only derivable from the other by inversion
+    Handle ab = space.add_link(AtomType::INHERITANCE_LINK, {a, b}, TruthValue{});
+    Handle ba = space.add_link(AtomType::INHERITANCE_LINK, {b, a}, TruthValue{});
+
+    PLNEngine engine(space);
+    engine.add_rule(rules::make_inversion_rule());
+    engine.add_rule(rules::make_deduction_rule());
+
+    ASSERT(!engine.backward_chain(ab).has_value());
+    ASSERT(!engine.backward_chain(ba).has_value());
+
+    // Failures are tabled too, and stay valid until the evidence changes
+    const size_t hits = engine.cache_hits();
+    ASSERT(!engine.backward_chain(ab).has_value());
+    ASSERT(engine.cache_hits() > hits);
+
+    // Grounding one side makes the other provable
+    space.set_tv(ab, TruthValue{0.9f, 0.9f});
+    auto result = engine.backward_chain(ba);
+    ASSERT(result.has_value());
+    ASSERT_EQ(result->proof.size(), 1u);
+    ASSERT_EQ(result->proof.steps()[0].rule_name, std::string("inversion"));
+    return true;
+}
+
+TEST(PLNEngine_backward_chain_modus_ponens) {
+    AtomSpace space;
+    Handle rain = space.add_node(AtomType::CONCEPT_NODE, "Rain", TruthValue{0.8f, 0.9f});
+    Handle wet = space.add_node(AtomType::CONCEPT_NODE, "Wet", TruthValue{});
+    Handle rule = space.add_link(AtomType::IMPLICATION_LINK, {rain, wet}, TruthValue{0.9f, 0.9f});
+
+    PLNEngine engine(space);
+    engine.add_rule(rules::make_modus_ponens_rule());
+    auto result = engine.backward_chain(wet);
+
+    ASSERT(result.has_value());
+    TruthValue expected = modus_ponens(space.get_tv(rain), space.get_tv(rule));
+    ASSERT_NEAR(result->truth_value.strength, expected.strength, 1e-5f);
+    return true;
+}
+
+TEST(InferenceCache_clock_eviction) {
+    AtomSpace space;
+    Handle a = space.add_node(AtomType::CONCEPT_NODE, "A");
+    InferenceCache cache(4, 1);
+
+    auto entry = [&](uint64_t context) {
+        InferenceCache::Entry e;
+        e.goal = a.id();
+        e.context = context;
+        e.version = space.version();
+        return e;
+    };
+    for (uint64_t key = 1; key <= 4; ++key) cache.store(key, entry(key));
+    ASSERT_EQ(cache.size(), 4u);
+
+    // Key 1 is referenced, so the hand passes it and evicts key 2
+    ASSERT(cache.lookup(space, 1, a.id(), 1).has_value());
+    cache.store(5, entry(5));
+    ASSERT_EQ(cache.size(), 4u);
+    ASSERT(cache.lookup(space, 1, a.id(), 1).has_value());
+    ASSERT(!cache.lookup(space, 2, a.id(), 2).has_value());
+    ASSERT(cache.lookup(space, 5, a.id(), 5).has_value());
+
+    // Another context under the same key misses
+    ASSERT(!cache.lookup(space, 5, a.id(), 6).has_value());
+
+    auto stats = cache.stats();
+    ASSERT_EQ(stats.hits, 3u);
+    ASSERT_EQ(stats.misses, 2u);
+    ASSERT_EQ(stats.evictions, 1u);
+
+    // Entries go stale with the AtomSpace
+    (void)space.add_node(AtomType::CONCEPT_NODE, "B");
+    ASSERT(!cache.lookup(space, 1, a.id(), 1).has_value());
+    ASSERT_EQ(cache.stats().invalidations, 1u);
+    ASSERT_EQ(cache.size(), 3u);
+    return true;
+}
+
+TEST(PLNEngine_shared_cache_across_threads) {
+    AtomSpace space;
+    std::vector<Handle> chain;
+    for (int i = 0; i < 12; ++i) {
+        chain.push_back(space.add_node(AtomType::CONCEPT_NODE, "C" + std::to_string(i),
+                                       TruthValue{0.5f, 0.9f}));
+    }
+    std::vector<Handle> goals;
+    for (size_t i = 1; i < chain.size(); ++i) {
+        (void)space.add_link(AtomType::INHERITANCE_LINK, {chain[i - 1], chain[i]},
+                             TruthValue{0.9f, 0.99f});
+        goals.push_back(space.add_link(AtomType::INHERITANCE_LINK, {chain[0], chain[i]},
+                                       TruthValue{}));
+    }
+
+    InferenceConfig config;
+    config.min_confidence = 0.01f;
+    auto cache = std::make_shared<InferenceCache>(64);
+
+    std::vector<std::unique_ptr<PLNEngine>> engines;
+    std::vector<int> proven(4, 0);
+    for (size_t t = 0; t < proven.size(); ++t) {
+        engines.push_back(std::make_unique<PLNEngine>(space, config, cache));
+        engines.back()->add_rule(rules::make_deduction_rule());
+    }
+
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < engines.size(); ++t) {
+        threads.emplace_back([&, t] {
+            for (int round = 0; round < 20; ++round) {
+                for (Handle goal : goals) {
+                    if (engines[t]->backward_chain(goal)) ++proven[t];
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    for (int count : proven) ASSERT_EQ(count, static_cast<int>(20 * goals.size()));
+    auto stats = cache->stats();
+    ASSERT(stats.hits > 0);
+    ASSERT(cache->size() <= cache->capacity());
+    return true;
+}
+
+TEST(WeightedSampler_draws_by_weight) {
+    const float weights[] = {1.0f, 0.0f, 3.0f, -2.0f};
+    WeightedSampler sampler(weights);
+    ASSERT_EQ(sampler.live(), 2u);
+    ASSERT_NEAR(sampler.total(), 4.0, 1e-9);
+
+    std::mt19937_64 rng(1);
+    size_t counts[4] = {};
+    for (int i = 0; i < 40000; ++i) ++counts[sampler.sample(rng)];
+    ASSERT_EQ(counts[1], 0u);
+    ASSERT_EQ(counts[3], 0u);
+    ASSERT_NEAR(static_cast<double>(counts[2]) / static_cast<double>(counts[0]), 3.0, 0.2);
+
+    // Without replacement: removed indices are never drawn again
+    sampler.remove(2);
+    ASSERT_EQ(sampler.live(), 1u);
+    for (int i = 0; i < 100; ++i) ASSERT_EQ(sampler.sample(rng), 0u);
+
+    // All-zero weights fall back to uniform
+    const float zeros[] = {0.0f, 0.0f, 0.0f};
+    WeightedSampler uniform(zeros);
+    ASSERT_EQ(uniform.live(), 3u);
+    return true;
+}
+
+TEST(PLNEngine_sample_forward_follows_attention) {
+    AtomSpace space;
+    auto chain = [&](const char* x, const char* y, const char* z) {
+        Handle a = space.add_node(AtomType::CONCEPT_NODE, x, TruthValue{0.3f, 0.9f});
+        Handle b = space.add_node(AtomType::CONCEPT_NODE, y, TruthValue{0.4f, 0.9f});
+        Handle c = space.add_node(AtomType::CONCEPT_NODE, z, TruthValue{0.5f, 0.9f});
+        (void)space.add_link(AtomType::INHERITANCE_LINK, {a, b}, TruthValue{0.9f, 0.9f});
+        (void)space.add_link(AtomType::INHERITANCE_LINK, {b, c}, TruthValue{0.8f, 0.9f});
+        return std::pair{a, c};
+    };
+    auto [a, c] = chain("A", "B", "C");
+    auto [x, z] = chain("X", "Y", "Z");
+
+    AttentionBank bank(space);
+    bank.stimulate(a.id(), 50.0f);
+
+    PLNEngine engine(space);
+    engine.add_rule(rules::make_deduction_rule());
+
+    // Only the focused chain is expanded
+    auto results = engine.sample_forward(bank);
+    ASSERT_EQ(results.size(), 1u);
+    ASSERT_EQ(results[0].conclusion.id(), space.get_link(AtomType::INHERITANCE_LINK, {a, c}).id());
+    ASSERT(!space.get_link(AtomType::INHERITANCE_LINK, {x, z}).valid());
+
+    // The evaluation budget is a hard cap
+    bank.stimulate(x.id(), 50.0f);
+    engine.reset_stats();
+    SamplingBudget budget;
+    budget.max_evaluations = 1;
+    (void)engine.sample_forward(bank, budget);
+    ASSERT_EQ(engine.total_inferences(), 1u);
+    return true;
+}
+
+TEST(PLNEngine_find_proofs_lists_derivations) {
+    AtomSpace space;
+    Handle a = space.add_node(AtomType::CONCEPT_NODE, "A", TruthValue{0.3f, 0.9f});
+    Handle c = space.add_node(AtomType::CONCEPT_NODE, "C", TruthValue{0.5f, 0.9f});
+    Handle ac = space.add_link(AtomType::INHERITANCE_LINK, {a, c}, TruthValue{});
+    for (const char* name : {"B1", "B2", "B3"}) {
+        Handle b = space.add_node(AtomType::CONCEPT_NODE, name, TruthValue{0.4f, 0.9f});
+        (void)space.add_link(AtomType::INHERITANCE_LINK, {a, b}, TruthValue{0.9f, 0.9f});
+        (void)space.add_link(AtomType::INHERITANCE_LINK, {b, c}, TruthValue{0.8f, 0.9f});
+    }
+
+    PLNEngine engine(space);
+    engine.add_rule(rules::make_deduction_rule());
+
+    // One proof per middle term
+    auto proofs = engine.find_proofs(ac);
+    ASSERT_EQ(proofs.size(), 3u);
+    for (const auto& proof : proofs) {
+        ASSERT_EQ(proof.conclusion.id(), ac.id());
+        ASSERT_EQ(proof.proof.size(), 1u);
+    }
+
+    // backward_chain merges them
+    auto merged = engine.backward_chain(ac);
+    ASSERT(merged.has_value());
+    ASSERT(merged->truth_value.confidence > proofs[0].truth_value.confidence);
+    return true;
+}
+
+TEST(FiringSet_compares_colliding_firings_in_full) {
+    FiringSet fired;
+    const AtomId a[] = {AtomId{1000}};
+
+    // A firing of rule 0 whose hash equals that of rule 1 on a
+    const AtomId b[] = {AtomId{hash_combine(1, a[0].value) - 0x9e3779b97f4a7c15ULL}};
+    ASSERT_EQ(hash_combine(0, b[0].value), hash_combine(1, a[0].value));
+
+    ASSERT(fired.insert(1, a));
+    ASSERT(fired.insert(0, b));
+    ASSERT(!fired.insert(1, a));
+    ASSERT(!fired.insert(0, b));
+
+    // Premise order matters
+    const AtomId ab[] = {AtomId{1}, AtomId{2}};
+    const AtomId ba[] = {AtomId{2}, AtomId{1}};
+    ASSERT(fired.insert(0, ab));
+    ASSERT(fired.insert(0, ba));
+    ASSERT_EQ(fired.size(), 4u);
+
+    fired.clear();
+    ASSERT(fired.insert(1, a));
+    return true;
+}
+
 TEST(PLNEngine_reset_stats) {
     AtomSpace space;
     PLNEngine engine(space);
@@ -293,6 +860,354 @@ TEST(PLNEngine_reset_stats) {
     return true;
 }
 
+TEST(PLNEngine_deduction_rule_is_complete) {
+    auto rule = rules::make_deduction_rule();
+
+    ASSERT(rule.formula);
+    ASSERT(rule.conclusion_template);
+    ASSERT_EQ(rule.premise_pattern.variables.size(), 3u);
+
+    TruthValue expected = deduction({0.9f, 0.8f}, {0.8f, 0.9f}, 0.5f, 0.4f);
+    TruthValue tv = rule.formula({{0.9f, 0.8f}, {0.8f, 0.9f}, {0.3f, 0.9f}, {0.5f, 0.9f}, {0.4f, 0.9f}});
+    ASSERT_NEAR(tv.strength, expected.strength, 1e-6f);
+    return true;
+}
+
+TEST(StaticRule_kernel_matches_formula) {
+    static_assert(StaticRule<rules::Deduction> && StaticRule<rules::ModusPonens>);
+    constexpr TruthValue folded = rules::Deduction::formula(
+        PremiseTVs<rules::Deduction>{{{0.9f, 0.8f}, {0.8f, 0.9f}, {0.3f, 0.9f}, {0.5f, 0.9f}, {0.4f, 0.9f}}});
+    static_assert(folded.confidence > 0.0f);
+
+    auto rule = rules::make_deduction_rule();
+    ASSERT(rule.kernel != nullptr);
+    ASSERT_EQ(rule.arity, rules::Deduction::arity);
+
+    std::vector<PremiseTVs<rules::Abduction>> premises;
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> unit(0.05f, 0.95f);
+    for (int i = 0; i < 64; ++i) {
+        auto& tvs = premises.emplace_back();
+        for (auto& tv : tvs) tv = TruthValue{unit(rng), unit(rng)};
+    }
+    std::vector<TruthValue> batch(premises.size());
+    ASSERT_EQ((apply_batch<rules::Abduction>(premises, batch)), premises.size());
+
+    auto abduction_rule = rules::make_abduction_rule();
+    for (size_t i = 0; i < premises.size(); ++i) {
+        std::vector<TruthValue> dynamic(premises[i].begin(), premises[i].end());
+        TruthValue expected = abduction_rule.formula(dynamic);
+        TruthValue tv = abduction_rule.kernel(premises[i]);
+        ASSERT_EQ(tv, expected);
+        ASSERT_EQ(batch[i], expected);
+    }
+    return true;
+}
+
+namespace {
+
+// User-defined static rule: Inh(A,B) => Inh(B,A) at half strength
+struct Converse {
+    static constexpr std::string_view name = "converse";
+    static constexpr float priority = 1.0f;
+    static constexpr size_t arity = 3;
+
+    static constexpr TruthValue formula(std::span<const TruthValue, arity> tvs) noexcept {
+        return TruthValue{tvs[0].strength * 0.5f, tvs[0].confidence};
+    }
+    static Pattern premises() {
+        Pattern pattern;
+        pattern.variables = {"A", "B"};
+        pattern.body = link(AtomType::INHERITANCE_LINK, {var("A"), var("B")});
+        return pattern;
+    }
+    static Handle conclude(AtomSpace& space, const BindingSet& bindings, bool* created) {
+        AtomId out[2] = {bindings.get("B"), bindings.get("A")};
+        return space.add_link(AtomType::INHERITANCE_LINK, std::span<const AtomId>(out),
+                              TruthValue::default_tv(), created);
+    }
+};
+
+} // namespace
+
+TEST(StaticRule_user_rule_drives_engine) {
+    AtomSpace space;
+    Handle a = space.add_node(AtomType::CONCEPT_NODE, "A");
+    Handle b = space.add_node(AtomType::CONCEPT_NODE, "B");
+    Handle ab = space.add_link(AtomType::INHERITANCE_LINK, {a, b}, TruthValue{0.8f, 0.9f});
+
+    PLNEngine engine(space);
+    engine.add_rule(make_rule<Converse>());
+    auto results = engine.forward_chain(ab);
+
+    Handle ba = space.get_link(AtomType::INHERITANCE_LINK, {b, a});
+    ASSERT(ba.valid());
+    ASSERT(!results.empty());
+    ASSERT_NEAR(space.get_tv(ba).strength, 0.4f, 1e-6f);
+    ASSERT_EQ(results[0].proof.steps()[0].rule_name, std::string("converse"));
+    return true;
+}
+
+TEST(PLNEngine_forward_chain_from_source) {
+    AtomSpace space;
+    Handle a = space.add_node(AtomType::CONCEPT_NODE, "A", TruthValue{0.3f, 0.9f});
+    Handle b = space.add_node(AtomType::CONCEPT_NODE, "B", TruthValue{0.4f, 0.9f});
+    Handle c = space.add_node(AtomType::CONCEPT_NODE, "C", TruthValue{0.5f, 0.9f});
+    Handle d = space.add_node(AtomType::CONCEPT_NODE, "D", TruthValue{0.6f, 0.9f});
+    (void)space.add_link(AtomType::INHERITANCE_LINK, {a, b}, TruthValue{0.9f, 0.9f});
+    (void)space.add_link(AtomType::INHERITANCE_LINK, {b, c}, TruthValue{0.8f, 0.9f});
+    (void)space.add_link(AtomType::INHERITANCE_LINK, {c, d}, TruthValue{0.7f, 0.9f});
+
+    PLNEngine engine(space);
+    engine.add_rule(rules::make_deduction_rule());
+    auto results = engine.forward_chain(a);
+
+    // Round 1 derives A->C from the seed A->B; round 2 derives A->D from
+    // the new A->C; B->D is never reached from A
+    ASSERT_EQ(results.size(), 2u);
+    Handle ac = space.get_link(AtomType::INHERITANCE_LINK, {a, c});
+    Handle ad = space.get_link(AtomType::INHERITANCE_LINK, {a, d});
+    ASSERT_EQ(results[0].conclusion.id(), ac.id());
+    ASSERT_EQ(results[0].iterations_used, 1u);
+    ASSERT_EQ(results[1].conclusion.id(), ad.id());
+    ASSERT_EQ(results[1].iterations_used, 2u);
+    ASSERT(!space.get_link(AtomType::INHERITANCE_LINK, {b, d}).valid());
+
+    TruthValue expected = deduction({0.9f, 0.9f}, {0.8f, 0.9f}, 0.4f, 0.5f);
+    ASSERT_NEAR(space.get_tv(ac).strength, expected.strength, 1e-5f);
+    ASSERT_EQ(results[0].proof.size(), 1u);
+    ASSERT_EQ(results[0].proof.steps()[0].rule_name, std::string("deduction"));
+    return true;
+}
+
+TEST(PLNEngine_forward_chain_all_merges_by_revision) {
+    AtomSpace space;
+    Handle a = space.add_node(AtomType::CONCEPT_NODE, "A", TruthValue{0.3f, 0.9f});
+    Handle b = space.add_node(AtomType::CONCEPT_NODE, "B", TruthValue{0.4f, 0.9f});
+    Handle c = space.add_node(AtomType::CONCEPT_NODE, "C", TruthValue{0.5f, 0.9f});
+    Handle d = space.add_node(AtomType::CONCEPT_NODE, "D", TruthValue{0.6f, 0.9f});
+    (void)space.add_link(AtomType::INHERITANCE_LINK, {a, b}, TruthValue{0.9f, 0.9f});
+    (void)space.add_link(AtomType::INHERITANCE_LINK, {b, c}, TruthValue{0.8f, 0.9f});
+    (void)space.add_link(AtomType::INHERITANCE_LINK, {c, d}, TruthValue{0.7f, 0.9f});
+
+    PLNEngine engine(space);
+    engine.add_rule(rules::make_deduction_rule());
+    auto results = engine.forward_chain_all();
+
+    // Round 1: A->C, B->D. Round 2: A->D twice (via C and via B), merged.
+    ASSERT_EQ(results.size(), 3u);
+    ASSERT_EQ(space.link_count(), 6u);
+
+    Handle ac = space.get_link(AtomType::INHERITANCE_LINK, {a, c});
+    Handle bd = space.get_link(AtomType::INHERITANCE_LINK, {b, d});
+    Handle ad = space.get_link(AtomType::INHERITANCE_LINK, {a, d});
+    ASSERT(ad.valid());
+    ASSERT_EQ(results[2].conclusion.id(), ad.id());
+    ASSERT_EQ(results[2].proof.size(), 2u);
+
+    TruthValue via_c = deduction(space.get_tv(ac), {0.7f, 0.9f}, 0.5f, 0.6f);
+    TruthValue via_b = deduction({0.9f, 0.9f}, space.get_tv(bd), 0.4f, 0.6f);
+    TruthValue merged = revision(via_c, via_b);
+    ASSERT_NEAR(space.get_tv(ad).strength, merged.strength, 1e-4f);
+    ASSERT_NEAR(space.get_tv(ad).confidence, merged.confidence, 1e-4f);
+    return true;
+}
+
+TEST(PLNEngine_forward_chain_revises_existing) {
+    AtomSpace space;
+    Handle a = space.add_node(AtomType::CONCEPT_NODE, "A", TruthValue{0.3f, 0.9f});
+    Handle b = space.add_node(AtomType::CONCEPT_NODE, "B", TruthValue{0.4f, 0.9f});
+    Handle c = space.add_node(AtomType::CONCEPT_NODE, "C", TruthValue{0.5f, 0.9f});
+    (void)space.add_link(AtomType::INHERITANCE_LINK, {a, b}, TruthValue{0.9f, 0.9f});
+    (void)space.add_link(AtomType::INHERITANCE_LINK, {b, c}, TruthValue{0.8f, 0.9f});
+    TruthValue prior{0.2f, 0.5f};
+    Handle ac = space.add_link(AtomType::INHERITANCE_LINK, {a, c}, prior);
+
+    PLNEngine engine(space);
+    engine.add_rule(rules::make_deduction_rule());
+    auto results = engine.forward_chain_all();
+
+    // Existing conclusion is revised, not duplicated, and is not new
+    // work for another round
+    ASSERT_EQ(results.size(), 1u);
+    ASSERT_EQ(space.link_count(), 3u);
+    TruthValue expected = revision(prior, deduction({0.9f, 0.9f}, {0.8f, 0.9f}, 0.4f, 0.5f));
+    ASSERT_NEAR(space.get_tv(ac).strength, expected.strength, 1e-4f);
+    ASSERT_GT(space.get_tv(ac).confidence, prior.confidence);
+    return true;
+}
+
+TEST(PLNEngine_forward_chain_limits) {
+    AtomSpace space;
+    std::vector<Handle> nodes;
+    for (int i = 0; i < 8; ++i) {
+        nodes.push_back(space.add_node(AtomType::CONCEPT_NODE, "N" + std::to_string(i),
+                                       TruthValue{0.5f, 0.9f}));
+    }
+    for (int i = 0; i + 1 < 8; ++i) {
+        (void)space.add_link(AtomType::INHERITANCE_LINK, {nodes[i], nodes[i + 1]}, TruthValue{0.9f, 0.9f});
+    }
+
+    InferenceConfig config;
+    config.max_results = 3;
+    PLNEngine engine(space, config);
+    engine.add_rule(rules::make_deduction_rule());
+    ASSERT_EQ(engine.forward_chain_all().size(), 3u);
+
+    // Stops at the goal
+    Handle goal = space.add_node(AtomType::CONCEPT_NODE, "N7");
+    config.max_results = 100;
+    config.target_reached = [&](const Handle& h) {
+        auto out = space.get_outgoing(h);
+        return out.size() == 2 && out[1].id() == goal.id();
+    };
+    engine.set_config(config);
+    auto results = engine.forward_chain(nodes[0]);
+    ASSERT(!results.empty());
+    ASSERT_EQ(space.get_outgoing(results.back().conclusion)[1].id(), goal.id());
+    return true;
+}
+
+TEST(PLNEngine_limits_leave_no_unreported_conclusions) {
+    AtomSpace space;
+    std::vector<Handle> nodes;
+    for (int i = 0; i < 8; ++i) {
+        nodes.push_back(space.add_node(AtomType::CONCEPT_NODE, "N" + std::to_string(i),
+                                       TruthValue{0.5f, 0.9f}));
+    }
+    for (int i = 0; i + 1 < 8; ++i) {
+        (void)space.add_link(AtomType::INHERITANCE_LINK, {nodes[i], nodes[i + 1]},
+                             TruthValue{0.9f, 0.9f});
+    }
+    // One conclusion already exists and must be revised, not overwritten
+    TruthValue prior{0.2f, 0.6f};
+    Handle existing = space.add_link(AtomType::INHERITANCE_LINK, {nodes[0], nodes[2]}, prior);
+
+    AttentionBank bank(space);
+    for (Handle n : nodes) bank.stimulate(n.id(), 10.0f);
+
+    InferenceConfig config;
+    config.max_results = 2;
+    PLNEngine engine(space, config);
+    engine.add_rule(rules::make_deduction_rule());
+
+    const size_t before = space.get_atoms_by_type(AtomType::INHERITANCE_LINK).size();
+    auto results = engine.sample_forward(bank);
+    ASSERT_EQ(results.size(), 2u);
+
+    // Every link the round created was written back and reported
+    size_t reported_new = 0;
+    for (const auto& r : results) {
+        if (r.conclusion.id() != existing.id()) ++reported_new;
+    }
+    ASSERT_EQ(space.get_atoms_by_type(AtomType::INHERITANCE_LINK).size(), before + reported_new);
+
+    // Creation is reported per call
+    bool created = true;
+    (void)space.add_link(AtomType::INHERITANCE_LINK, {nodes[0], nodes[1]},
+                         TruthValue::default_tv(), &created);
+    ASSERT(!created);
+    (void)space.add_link(AtomType::INHERITANCE_LINK, {nodes[7], nodes[0]},
+                         TruthValue::default_tv(), &created);
+    ASSERT(created);
+
+    engine.set_config(InferenceConfig{});
+    (void)engine.forward_chain_all();
+    ASSERT_GT(space.get_tv(existing).confidence, prior.confidence);
+    return true;
+}
+
+TEST(PLNEngine_deduce_all_chain) {
+    AtomSpace space;
+    Handle a = space.add_node(AtomType::CONCEPT_NODE, "A", TruthValue{0.3f, 0.9f});
+    Handle b = space.add_node(AtomType::CONCEPT_NODE, "B", TruthValue{0.4f, 0.9f});
+    Handle c = space.add_node(AtomType::CONCEPT_NODE, "C", TruthValue{0.5f, 0.9f});
+    Handle d = space.add_node(AtomType::CONCEPT_NODE, "D", TruthValue{0.6f, 0.9f});
+
+    TruthValue ab_tv{0.9f, 0.8f}, bc_tv{0.8f, 0.9f}, cd_tv{0.7f, 0.9f};
+    (void)space.add_link(AtomType::INHERITANCE_LINK, {a, b}, ab_tv);
+    (void)space.add_link(AtomType::INHERITANCE_LINK, {b, c}, bc_tv);
+    (void)space.add_link(AtomType::INHERITANCE_LINK, {c, d}, cd_tv);
+
+    PLNEngine engine(space);
+    auto result = engine.deduce_all();
+
+    ASSERT_EQ(result.premise_pairs, 2u);
+    ASSERT_EQ(result.created, 2u);
+    ASSERT_EQ(result.revised, 0u);
+
+    Handle ac = space.get_link(AtomType::INHERITANCE_LINK, {a, c});
+    ASSERT(ac.valid());
+    TruthValue expected = deduction(ab_tv, bc_tv, 0.4f, 0.5f);
+    ASSERT_NEAR(space.get_tv(ac).strength, expected.strength, 1e-5f);
+    ASSERT_NEAR(space.get_tv(ac).confidence, expected.confidence, 1e-5f);
+
+    // One hop only: A->D needs a second pass
+    ASSERT(!space.get_link(AtomType::INHERITANCE_LINK, {a, d}).valid());
+    return true;
+}
+
+TEST(PLNEngine_deduce_all_revises_and_merges) {
+    AtomSpace space;
+    Handle a = space.add_node(AtomType::CONCEPT_NODE, "A", TruthValue{0.3f, 0.9f});
+    Handle b1 = space.add_node(AtomType::CONCEPT_NODE, "B1", TruthValue{0.4f, 0.9f});
+    Handle b2 = space.add_node(AtomType::CONCEPT_NODE, "B2", TruthValue{0.2f, 0.9f});
+    Handle c = space.add_node(AtomType::CONCEPT_NODE, "C", TruthValue{0.5f, 0.9f});
+
+    TruthValue ab{0.9f, 0.8f}, bc{0.8f, 0.9f};
+    (void)space.add_link(AtomType::INHERITANCE_LINK, {a, b1}, ab);
+    (void)space.add_link(AtomType::INHERITANCE_LINK, {b1, c}, bc);
+    (void)space.add_link(AtomType::INHERITANCE_LINK, {a, b2}, ab);
+    (void)space.add_link(AtomType::INHERITANCE_LINK, {b2, c}, bc);
+
+    TruthValue prior{0.1f, 0.5f};
+    Handle ac = space.add_link(AtomType::INHERITANCE_LINK, {a, c}, prior);
+
+    PLNEngine engine(space);
+    auto result = engine.deduce_all();
+
+    // Two middle terms merge into a single revision of the existing link
+    ASSERT_EQ(result.premise_pairs, 2u);
+    ASSERT_EQ(result.revised, 1u);
+    ASSERT_EQ(result.created, 0u);
+
+    TruthValue merged = revision(deduction(ab, bc, 0.4f, 0.5f), deduction(ab, bc, 0.2f, 0.5f));
+    TruthValue expected = revision(prior, merged);
+    ASSERT_NEAR(space.get_tv(ac).strength, expected.strength, 1e-3f);
+    ASSERT_NEAR(space.get_tv(ac).confidence, expected.confidence, 1e-3f);
+    return true;
+}
+
+TEST(PLNEngine_deduce_all_spans_blocks) {
+    AtomSpace space;
+    Handle hub = space.add_node(AtomType::CONCEPT_NODE, "Hub", TruthValue{0.5f, 0.9f});
+
+    // 90 x 50 = 4500 pairs through one middle term: more than one block
+    // and a tail that is not a multiple of 8
+    for (int i = 0; i < 90; ++i) {
+        Handle a = space.add_node(AtomType::CONCEPT_NODE, "A" + std::to_string(i));
+        (void)space.add_link(AtomType::INHERITANCE_LINK, {a, hub}, TruthValue{0.9f, 0.9f});
+    }
+    for (int i = 0; i < 50; ++i) {
+        Handle c = space.add_node(AtomType::CONCEPT_NODE, "C" + std::to_string(i),
+                                  TruthValue{0.01f * i, 0.9f});
+        (void)space.add_link(AtomType::INHERITANCE_LINK, {hub, c}, TruthValue{0.8f, 0.9f});
+    }
+
+    PLNEngine engine(space);
+    auto result = engine.deduce_all();
+    ASSERT_EQ(result.premise_pairs, 4500u);
+    ASSERT_EQ(result.created, 4500u);
+
+    Handle a = space.get_node(AtomType::CONCEPT_NODE, "A89");
+    Handle c = space.get_node(AtomType::CONCEPT_NODE, "C49");
+    Handle ac = space.get_link(AtomType::INHERITANCE_LINK, {a, c});
+    ASSERT(ac.valid());
+    TruthValue expected = deduction({0.9f, 0.9f}, {0.8f, 0.9f}, 0.5f, 0.49f);
+    ASSERT_NEAR(space.get_tv(ac).strength, expected.strength, 1e-5f);
+    return true;
+}
+
 // ============================================================================
 // Incremental Inference Tests
 // ============================================================================
@@ -333,6 +1248,112 @@ TEST(IncrementalInference_step) {
     return true;
 }
 
+TEST(IncrementalInference_step_derives) {
+    AtomSpace space;
+    Handle a = space.add_node(AtomType::CONCEPT_NODE, "A", TruthValue{0.3f, 0.9f});
+    Handle b = space.add_node(AtomType::CONCEPT_NODE, "B", TruthValue{0.4f, 0.9f});
+    Handle c = space.add_node(AtomType::CONCEPT_NODE, "C", TruthValue{0.5f, 0.9f});
+    Handle ab = space.add_link(AtomType::INHERITANCE_LINK, {a, b}, TruthValue{0.9f, 0.9f});
+    (void)space.add_link(AtomType::INHERITANCE_LINK, {b, c}, TruthValue{0.8f, 0.9f});
+
+    PLNEngine engine(space);
+    engine.add_rule(rules::make_deduction_rule());
+    IncrementalInference incr(engine);
+
+    incr.add_stimulus(ab);
+    auto results = incr.step();
+    ASSERT_EQ(results.size(), 1u);
+    ASSERT(space.get_link(AtomType::INHERITANCE_LINK, {a, c}).valid());
+
+    // The conclusion is queued for further inference
+    ASSERT(incr.has_pending());
+    return true;
+}
+
+namespace {
+
+// Layered DAG: each concept links to three of the next layer
+std::vector<Handle> build_layers(AtomSpace& space, size_t layers, size_t width) {
+    std::vector<Handle> nodes;
+    for (size_t l = 0; l < layers; ++l) {
+        for (size_t i = 0; i < width; ++i) {
+            nodes.push_back(space.add_node(AtomType::CONCEPT_NODE,
+                "L" + std::to_string(l) + "_" + std::to_string(i), TruthValue{0.4f, 0.9f}));
+        }
+    }
+    std::vector<Handle> links;
+    for (size_t l = 0; l + 1 < layers; ++l) {
+        for (size_t i = 0; i < width; ++i) {
+            for (size_t k = 0; k < 3; ++k) {
+                links.push_back(space.add_link(AtomType::INHERITANCE_LINK,
+                    {nodes[l * width + i], nodes[(l + 1) * width + (i * 7 + k * 3) % width]},
+                    TruthValue{0.9f, 0.9f}));
+            }
+        }
+    }
+    return links;
+}
+
+} // namespace
+
+TEST(IncrementalInference_threads_match_serial) {
+    std::vector<std::vector<InferenceResult>> runs;
+    for (size_t threads : {1u, 4u}) {
+        AtomSpace space;
+        auto links = build_layers(space, 4, 12);
+
+        InferenceConfig config;
+        config.max_results = SIZE_MAX;
+        PLNEngine engine(space, config);
+        engine.add_rule(rules::make_deduction_rule());
+
+        IncrementalInference incr(engine, threads);
+        ASSERT_EQ(incr.threads(), threads);
+        incr.set_batch_size(16);
+        for (Handle link : links) incr.add_stimulus(link);
+        runs.push_back(incr.run(1000));
+        ASSERT(!incr.has_pending());
+    }
+
+    // Same conclusions, in the same order, with the same values
+    ASSERT(!runs[0].empty());
+    ASSERT_EQ(runs[0].size(), runs[1].size());
+    for (size_t i = 0; i < runs[0].size(); ++i) {
+        ASSERT_EQ(runs[0][i].conclusion.id(), runs[1][i].conclusion.id());
+        ASSERT_EQ(runs[0][i].truth_value, runs[1][i].truth_value);
+    }
+    return true;
+}
+
+TEST(IncrementalInference_stimuli_processed_once) {
+    AtomSpace space;
+    Handle a = space.add_node(AtomType::CONCEPT_NODE, "A", TruthValue{0.3f, 0.9f});
+    Handle b = space.add_node(AtomType::CONCEPT_NODE, "B", TruthValue{0.4f, 0.9f});
+    Handle c = space.add_node(AtomType::CONCEPT_NODE, "C", TruthValue{0.5f, 0.9f});
+    Handle ab = space.add_link(AtomType::INHERITANCE_LINK, {a, b}, TruthValue{0.9f, 0.9f});
+    Handle bc = space.add_link(AtomType::INHERITANCE_LINK, {b, c}, TruthValue{0.8f, 0.9f});
+
+    PLNEngine engine(space);
+    engine.add_rule(rules::make_deduction_rule());
+    IncrementalInference incr(engine, 2);
+
+    // Both premises and a repeat in one batch: A->C is derived once
+    incr.add_stimulus(ab);
+    incr.add_stimulus(bc);
+    incr.add_stimulus(ab);
+    auto results = incr.step();
+    ASSERT_EQ(results.size(), 1u);
+    TruthValue expected = deduction(space.get_tv(ab), space.get_tv(bc), 0.4f, 0.5f);
+    ASSERT_NEAR(results[0].truth_value.strength, expected.strength, 1e-6f);
+    ASSERT_NEAR(results[0].truth_value.confidence, expected.confidence, 1e-6f);
+
+    // Processed atoms are not queued again
+    incr.add_stimulus(ab);
+    (void)incr.run(10);
+    ASSERT(!incr.has_pending());
+    return true;
+}
+
 TEST(IncrementalInference_run) {
     AtomSpace space;
 
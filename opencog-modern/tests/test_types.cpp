@@ -5,6 +5,8 @@
 
 #include <opencog/core/types.hpp>
 #include <cmath>
+#include <functional>
+#include <string>
 
 namespace test {
 extern bool register_test(const std::string& name, std::function<bool()> func);
@@ -0,0 +1,971 @@
+/**
+ * @file test_ure.cpp
+ * @brief Tests for the Unified Rule Engine
+ */
+
+#include <opencog/ure/engine.hpp>
+#include <opencog/ure/frontier.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <unordered_map>
+
+namespace test {
+extern bool register_test(const std::string& name, std::function<bool()> func);
+}
+
+#define TEST(name) \
+    bool test_##name(); \
+    static bool _registered_##name = test::register_test(#name, test_##name); \
+    bool test_##name()
+
+#define ASSERT(expr) if (!(expr)) { return false; }
+#define ASSERT_EQ(a, b) if ((a) != (b)) { return false; }
+#define ASSERT_GT(a, b) if (!((a) > (b))) { return false; }
+#define ASSERT_LT(a, b) if (!((a) < (b))) { return false; }
+
+using namespace opencog;
+using namespace opencog::ure;
+
+namespace {
+
+std::vector<Handle> make_concepts(AtomSpace& space, size_t n) {
+    std::vector<Handle> atoms;
+    for (size_t i = 0; i < n; ++i) {
+        atoms.push_back(space.add_node(AtomType::CONCEPT_NODE, "C" + std::to_string(i)));
+    }
+    return atoms;
+}
+
+} // namespace
+
+// ============================================================================
+// Frontier Tests
+// ============================================================================
+
+TEST(Frontier_bfs_and_dfs_order) {
+    AtomSpace space;
+    auto atoms = make_concepts(space, 40);
+
+    // Interleave pushes and pops so the ring wraps and grows
+    Frontier bfs(SearchStrategy::BFS);
+    std::vector<Handle> popped;
+    for (size_t i = 0; i < atoms.size(); ++i) {
+        bfs.push(atoms[i]);
+        if (i % 3 == 2) popped.push_back(bfs.pop()->atom);
+    }
+    while (auto next = bfs.pop()) popped.push_back(next->atom);
+    ASSERT(popped == atoms);
+    ASSERT(bfs.empty());
+
+    Frontier dfs(SearchStrategy::DFS);
+    for (Handle h : atoms) dfs.push(h);
+    ASSERT_EQ(dfs.size(), atoms.size());
+    for (size_t i = atoms.size(); i-- > 0;) {
+        ASSERT_EQ(dfs.pop()->atom, atoms[i]);
+    }
+    ASSERT(!dfs.pop());
+    return true;
+}
+
+TEST(Frontier_heap_update_key) {
+    AtomSpace space;
+    auto atoms = make_concepts(space, 100);
+    std::unordered_map<AtomId, float> key;
+    for (size_t i = 0; i < atoms.size(); ++i) {
+        key[atoms[i].id()] = static_cast<float>((i * 37) % 100);
+    }
+
+    Frontier heap(SearchStrategy::BEST_FIRST, [&](Handle h) { return key.at(h.id()); });
+    for (Handle h : atoms) heap.push(h);
+    heap.push(atoms[0]);   // Already queued: re-keyed, not duplicated
+    ASSERT_EQ(heap.size(), atoms.size());
+
+    // Raise one key explicitly, lower the current best without telling
+    key[atoms[5].id()] = 500.0f;
+    ASSERT(heap.update(atoms[5]));
+    ASSERT_EQ(heap.pop()->atom, atoms[5]);
+
+    auto best = std::ranges::max_element(atoms, {}, [&](Handle h) {
+        return h == atoms[5] ? -1.0f : key.at(h.id());
+    });
+    key[best->id()] = -10.0f;
+
+    float last = 1e9f;
+    size_t count = 0;
+    while (auto next = heap.pop()) {
+        ASSERT(next->atom != *best || heap.empty());
+        ASSERT(!(next->priority > last));
+        last = next->priority;
+        ++count;
+    }
+    ASSERT_EQ(count, atoms.size() - 1);
+    ASSERT(!heap.update(atoms[5]));
+    return true;
+}
+
+TEST(Frontier_random_pops_each_once) {
+    AtomSpace space;
+    auto atoms = make_concepts(space, 64);
+
+    auto drain = [&](uint64_t seed) {
+        Frontier random(SearchStrategy::RANDOM, {}, seed);
+        for (Handle h : atoms) random.push(h);
+        std::vector<Handle> order;
+        while (auto next = random.pop()) order.push_back(next->atom);
+        return order;
+    };
+
+    auto order = drain(42);
+    ASSERT(order != atoms);
+    ASSERT(order == drain(42));
+    std::ranges::sort(order);
+    auto sorted = atoms;
+    std::ranges::sort(sorted);
+    ASSERT(order == sorted);
+    return true;
+}
+
+TEST(Frontier_iterative_deepening_limits_depth) {
+    AtomSpace space;
+    auto atoms = make_concepts(space, 6);
+
+    Frontier frontier(SearchStrategy::ITERATIVE_DEEPENING, {}, 0, 2);
+    frontier.push(atoms[0], 0);
+
+    // Expanding each atom yields one child, plus a second for the root
+    std::vector<size_t> depths;
+    size_t next_child = 1;
+    while (auto entry = frontier.pop()) {
+        depths.push_back(entry->depth);
+        const size_t children = entry->depth == 0 ? 2 : 1;
+        for (size_t c = 0; c < children && next_child < atoms.size(); ++c) {
+            frontier.push(atoms[next_child++], entry->depth + 1);
+        }
+    }
+
+    // Depth 1 is finished before the limit rises to 2; depth 3 is cut off
+    ASSERT((depths == std::vector<size_t>{0, 1, 1, 2, 2}));
+    ASSERT_EQ(frontier.depth_limit(), 2u);
+    return true;
+}
+
+// ============================================================================
+// RuleBase Tests
+// ============================================================================
+
+TEST(RuleBase_index_selects_unifiable_rules) {
+    AtomSpace space;
+    Handle a = space.add_node(AtomType::CONCEPT_NODE, "A");
+    Handle b = space.add_node(AtomType::CONCEPT_NODE, "B");
+    Handle x = space.add_node(AtomType::VARIABLE_NODE, "$X");
+    Handle y = space.add_node(AtomType::VARIABLE_NODE, "$Y");
+    Handle z = space.add_node(AtomType::VARIABLE_NODE, "$Z");
+
+    auto rule = [&](std::string name, Handle premise, float priority) {
+        Rule r;
+        r.name = std::move(name);
+        r.premise = premise;
+        r.conclusion = premise;
+        r.priority = priority;
+        return r;
+    };
+
+    RuleBase rules(space);
+    rules.add_rule(rule("any", space.add_link(AtomType::INHERITANCE_LINK, {x, y}), 1.0f));
+    rules.add_rule(rule("from-a", space.add_link(AtomType::INHERITANCE_LINK, {a, y}), 3.0f));
+    rules.add_rule(rule("similar", space.add_link(AtomType::SIMILARITY_LINK, {x, y}), 2.0f));
+    rules.add_rule(rule("reflexive", space.add_link(AtomType::INHERITANCE_LINK, {x, x}), 5.0f));
+    rules.add_rule(rule("conjunction", space.add_link(AtomType::AND_LINK, {
+        space.add_link(AtomType::INHERITANCE_LINK, {x, b}),
+        space.add_link(AtomType::IMPLICATION_LINK, {x, z})}), 4.0f));
+
+    auto names = [](const RuleView& found) {
+        std::vector<std::string> out;
+        for (const Rule* r : found) out.push_back(r->name);
+        return out;
+    };
+
+    // Pre-sorted by priority; the non-linear premise passes the index but
+    // not unification
+    Handle ab = space.add_link(AtomType::INHERITANCE_LINK, {a, b});
+    ASSERT((names(rules.get_rules_for_atom(ab)) ==
+            std::vector<std::string>{"reflexive", "conjunction", "from-a", "any"}));
+    ASSERT(!rules.could_apply(*rules.get_rules_for_atom(ab).front(), ab));
+    ASSERT((names(rules.get_rules_by_priority()) ==
+            std::vector<std::string>{"reflexive", "conjunction", "from-a", "similar", "any"}));
+
+    Handle ba = space.add_link(AtomType::INHERITANCE_LINK, {b, a});
+    ASSERT((names(rules.get_rules_for_atom(ba)) ==
+            std::vector<std::string>{"reflexive", "any"}));
+    ASSERT(rules.get_rules_for_atom(a).empty());
+
+    // A nested source is consumed whole by a variable
+    Handle nested = space.add_link(AtomType::INHERITANCE_LINK, {ab, b});
+    ASSERT((names(rules.get_rules_for_atom(nested)) ==
+            std::vector<std::string>{"reflexive", "conjunction", "any"}));
+
+    ASSERT(rules.remove_rule("conjunction"));
+    ASSERT((names(rules.get_rules_for_atom(ab)) ==
+            std::vector<std::string>{"reflexive", "from-a", "any"}));
+    return true;
+}
+
+TEST(RuleSet_snapshots_are_immutable_and_shared) {
+    AtomSpace space;
+    auto concepts = make_concepts(space, 8);
+    Handle x = space.add_node(AtomType::VARIABLE_NODE, "$X");
+    Handle y = space.add_node(AtomType::VARIABLE_NODE, "$Y");
+
+    auto rule = [&](std::string name, AtomType from, AtomType to) {
+        Rule r;
+        r.name = std::move(name);
+        r.premise = space.add_link(from, {x, y});
+        r.conclusion = space.add_link(to, {y, x});
+        return r;
+    };
+
+    RuleBase rules(space);
+    rules.add_rule(rule("flip", AtomType::INHERITANCE_LINK, AtomType::SIMILARITY_LINK));
+    rules.add_rule(rule("back", AtomType::SIMILARITY_LINK, AtomType::INHERITANCE_LINK));
+    auto first = rules.snapshot();
+    ASSERT_EQ(first->size(), 2u);
+    ASSERT_EQ(rules.snapshot(), first);    // No edits, no recompilation
+    ASSERT_EQ(first->version(), rules.version());
+
+    // Edits publish a new snapshot; the old one is untouched
+    const Rule* flip = first->find("flip");
+    rules.add_rule(rule("subset", AtomType::INHERITANCE_LINK, AtomType::SUBSET_LINK));
+    ASSERT(rules.remove_rule("back"));
+    auto second = rules.snapshot();
+    ASSERT(second != first);
+    ASSERT_EQ(first->size(), 2u);
+    ASSERT_EQ(first->find("flip"), flip);
+    ASSERT(first->find("subset") == nullptr);
+    ASSERT_EQ(second->size(), 2u);
+    ASSERT(second->find("back") == nullptr);
+    ASSERT_EQ(second->find("flip")->program, flip->program);    // Compiled once
+
+    // Readers on other threads match against a snapshot while rules change
+    Handle ab = space.add_link(AtomType::INHERITANCE_LINK, {concepts[0], concepts[1]});
+    std::atomic<size_t> mismatches{0};
+    std::vector<std::jthread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&] {
+            for (int i = 0; i < 200; ++i) {
+                auto set = rules.snapshot();
+                std::vector<const Rule*> found;
+                set->for_atom(space, ab, found);
+                std::vector<AtomId> slots;
+                for (const Rule* r : found) {
+                    slots.assign(r->program->slots(), ATOM_NULL);
+                    if (!r->program->match(space, 0, ab.id(), slots)) ++mismatches;
+                }
+                if (found.size() != set->for_type(AtomType::INHERITANCE_LINK).size()) ++mismatches;
+            }
+        });
+    }
+    for (int i = 0; i < 50; ++i) {
+        rules.add_rule(rule("extra-" + std::to_string(i), AtomType::INHERITANCE_LINK,
+                            AtomType::SIMILARITY_LINK));
+        std::vector<RuleCost> costs{{"flip", static_cast<float>(i), 1.0f}};
+        rules.set_costs(costs);
+    }
+    readers.clear();
+    ASSERT_EQ(mismatches.load(), 0u);
+    ASSERT_EQ(rules.snapshot()->size(), 52u);
+    ASSERT_EQ(rules.get_rules_by_priority().front()->name, std::string("flip"));
+
+    // Lookups hold their snapshot, so the rules they name survive edits
+    RuleView by_priority = rules.get_rules_by_priority();
+    RuleView for_ab = rules.get_rules_for_atom(ab);
+    rules.clear();
+    ASSERT(rules.snapshot()->empty());
+    ASSERT_EQ(by_priority.size(), 52u);
+    ASSERT_EQ(by_priority.front()->name, std::string("flip"));
+    ASSERT_EQ(for_ab.size(), 52u);
+    ASSERT_EQ(for_ab.snapshot(), by_priority.snapshot());
+
+    // A proof keeps the rules it used alive after they are cleared
+    UREConfig config;
+    config.strategy = SearchStrategy::BFS;
+    config.min_result_confidence = 0.0f;
+    UREngine engine(space, config);
+    engine.rules().add_rule(rule("flip", AtomType::INHERITANCE_LINK, AtomType::SIMILARITY_LINK));
+    auto results = engine.forward_chain(ab);
+    ASSERT_EQ(results.size(), 1u);
+    engine.rules().clear();
+    ASSERT(engine.forward_chain(ab).empty());
+    ASSERT_EQ(results[0].proof.root().rule_used->name, std::string("flip"));
+    return true;
+}
+
+TEST(GoalIndex_finds_goals_an_atom_instantiates) {
+    AtomSpace space;
+    Handle a = space.add_node(AtomType::CONCEPT_NODE, "A");
+    Handle b = space.add_node(AtomType::CONCEPT_NODE, "B");
+    Handle x = space.add_node(AtomType::VARIABLE_NODE, "$X");
+
+    GoalIndex goals;
+    goals.insert(space, space.add_link(AtomType::INHERITANCE_LINK, {a, x}), 0);
+    goals.insert(space, space.add_link(AtomType::INHERITANCE_LINK, {x, x}), 1);
+    goals.insert(space, space.add_link(AtomType::SIMILARITY_LINK, {a, b}), 2);
+    ASSERT_EQ(goals.size(), 3u);
+
+    std::vector<uint32_t> found;
+    goals.find(space, space.add_link(AtomType::INHERITANCE_LINK, {a, b}), found);
+    std::ranges::sort(found);
+    ASSERT((found == std::vector<uint32_t>{0, 1}));
+
+    found.clear();
+    ASSERT_EQ(goals.find(space, space.add_link(AtomType::SIMILARITY_LINK, {a, b}), found), 1u);
+    ASSERT_EQ(found[0], 2u);
+    ASSERT_EQ(goals.find(space, space.add_link(AtomType::SIMILARITY_LINK, {b, a}), found), 0u);
+
+    // Substitution keeps unbound variables
+    BindingSet bindings;
+    bindings.bind("$X", b.id());
+    Handle xx = space.add_link(AtomType::INHERITANCE_LINK, {x, a});
+    ASSERT_EQ(substitute(space, xx, bindings), space.add_link(AtomType::INHERITANCE_LINK, {b, a}));
+    ASSERT(has_variables(space, xx));
+    ASSERT(!has_variables(space, space.add_link(AtomType::INHERITANCE_LINK, {b, a})));
+    ASSERT(!find_instance(space, space.add_link(AtomType::SUBSET_LINK, {x, a}), bindings).valid());
+    return true;
+}
+
+TEST(RuleProgram_matches_and_instantiates) {
+    AtomSpace space;
+    Handle a = space.add_node(AtomType::CONCEPT_NODE, "A");
+    Handle b = space.add_node(AtomType::CONCEPT_NODE, "B");
+    Handle x = space.add_node(AtomType::VARIABLE_NODE, "$X");
+    Handle y = space.add_node(AtomType::VARIABLE_NODE, "$Y");
+
+    // (Inheritance $X $Y) => (Implication (Inheritance $X $Y) (Similarity $Y $X $Y))
+    Handle premise = space.add_link(AtomType::INHERITANCE_LINK, {x, y});
+    Handle conclusion = space.add_link(AtomType::IMPLICATION_LINK, {
+        premise, space.add_link(AtomType::SIMILARITY_LINK, {y, x, y})});
+    auto program = RuleProgram::compile(space, premise, conclusion);
+    ASSERT_EQ(program.slots(), 2u);
+    ASSERT_EQ(program.clauses(), 1u);
+
+    Handle ab = space.add_link(AtomType::INHERITANCE_LINK, {a, b});
+    std::vector<AtomId> slots(program.slots());
+    ASSERT(program.match(space, 0, ab.id(), slots));
+    ASSERT(!program.match(space, 0, a.id(), slots));
+
+    Handle expected = space.add_link(AtomType::IMPLICATION_LINK, {
+        ab, space.add_link(AtomType::SIMILARITY_LINK, {b, a, b})});
+    const size_t before = space.size();
+    ASSERT_EQ(program.instantiate(space, slots, 0, ab.id()), expected);
+    ASSERT_EQ(program.instantiate(space, slots), expected);
+    ASSERT_EQ(space.size(), before);   // Existing atoms are found, not re-added
+
+    // Name-keyed bindings round-trip through the slots
+    BindingSet bindings;
+    program.to_bindings(slots, bindings);
+    ASSERT_EQ(bindings.get("$X"), a.id());
+    ASSERT_EQ(bindings.get("$Y"), b.id());
+    std::vector<AtomId> unbound(program.slots());
+    ASSERT(!program.instantiate(space, unbound).valid());
+    program.from_bindings(bindings, unbound);
+    ASSERT(unbound == slots);
+
+    // The conclusion unifies with goals; clauses are found, not created
+    std::vector<AtomId> goal_slots(program.slots());
+    ASSERT(program.match_conclusion(space, expected.id(), goal_slots));
+    ASSERT(goal_slots == slots);
+    ASSERT(!program.match_conclusion(space, ab.id(), goal_slots));
+    ASSERT_EQ(program.lookup_clause(space, 0, slots), ab.id());
+    std::vector<AtomId> swapped{b.id(), a.id()};
+    const size_t atoms = space.size();
+    ASSERT(!program.lookup_clause(space, 0, swapped).valid());
+    ASSERT_EQ(space.size(), atoms);
+
+    // A rule applied directly is compiled on demand
+    Rule rule;
+    rule.name = "swap";
+    rule.premise = premise;
+    rule.conclusion = space.add_link(AtomType::INHERITANCE_LINK, {y, x});
+    RuleBase rules(space);
+    RuleApplicator applicator(space, rules);
+    auto applied = applicator.apply(rule, bindings);
+    ASSERT(applied.has_value());
+    ASSERT_EQ(applied->result, space.add_link(AtomType::INHERITANCE_LINK, {b, a}));
+    return true;
+}
+
+// ============================================================================
+// UREngine Tests
+// ============================================================================
+
+TEST(UREngine_forward_chain_applies_indexed_rules) {
+    AtomSpace space;
+    Handle a = space.add_node(AtomType::CONCEPT_NODE, "A");
+    Handle b = space.add_node(AtomType::CONCEPT_NODE, "B");
+    Handle x = space.add_node(AtomType::VARIABLE_NODE, "$X");
+    Handle y = space.add_node(AtomType::VARIABLE_NODE, "$Y");
+
+    // Rules without a formula conclude with zero confidence
+    UREConfig config;
+    config.min_result_confidence = 0.0f;
+
+    UREngine engine(space, config);
+    Rule symmetry;
+    symmetry.name = "inheritance-to-similarity";
+    symmetry.premise = space.add_link(AtomType::INHERITANCE_LINK, {x, y});
+    symmetry.conclusion = space.add_link(AtomType::SIMILARITY_LINK, {y, x});
+    engine.rules().add_rule(symmetry);
+
+    Handle ab = space.add_link(AtomType::INHERITANCE_LINK, {a, b});
+    auto results = engine.forward_chain(std::span<const Handle>(&ab, 1));
+    ASSERT_EQ(results.size(), 1u);
+    ASSERT_EQ(results[0].conclusion, space.add_link(AtomType::SIMILARITY_LINK, {b, a}));
+    ASSERT_EQ(engine.stats().rules_applied, 1u);
+    return true;
+}
+
+TEST(UREngine_forward_chain_proofs_share_one_log) {
+    AtomSpace space;
+    Handle a = space.add_node(AtomType::CONCEPT_NODE, "A");
+    Handle b = space.add_node(AtomType::CONCEPT_NODE, "B");
+    Handle x = space.add_node(AtomType::VARIABLE_NODE, "$X");
+    Handle y = space.add_node(AtomType::VARIABLE_NODE, "$Y");
+
+    UREConfig config;
+    config.strategy = SearchStrategy::BFS;
+    config.min_result_confidence = 0.0f;
+    UREngine engine(space, config);
+
+    Rule flip;
+    flip.name = "flip";
+    flip.premise = space.add_link(AtomType::INHERITANCE_LINK, {x, y});
+    flip.conclusion = space.add_link(AtomType::SIMILARITY_LINK, {y, x});
+    engine.rules().add_rule(flip);
+    Rule back;
+    back.name = "back";
+    back.premise = space.add_link(AtomType::SIMILARITY_LINK, {x, y});
+    back.conclusion = space.add_link(AtomType::INHERITANCE_LINK, {x, y});
+    engine.rules().add_rule(back);
+
+    // Inh(A,B) -> Sim(B,A) -> Inh(B,A) -> Sim(A,B) -> Inh(A,B) again
+    Handle ab = space.add_link(AtomType::INHERITANCE_LINK, {a, b});
+    auto results = engine.forward_chain(ab);
+    ASSERT_EQ(results.size(), 4u);
+
+    // Each proof is only the chain behind its own conclusion
+    const ProofRef& first = results[0].proof;
+    ASSERT(!first.empty());
+    ASSERT_EQ(first.size(), 2u);
+    ASSERT_EQ(first.depth(), 1u);
+    ASSERT_EQ(first.root().rule_used->name, std::string("flip"));
+
+    const ProofRef& last = results[2].proof;
+    ASSERT_EQ(last.size(), 4u);
+    ASSERT_EQ(last.depth(), 3u);
+    ASSERT_EQ(last.root().atom, results[2].conclusion);
+
+    std::vector<Handle> order;
+    last.for_each_node([&](const InferenceNode& node) { order.push_back(node.atom); });
+    ASSERT_EQ(order.size(), 4u);
+    ASSERT_EQ(order[0], ab);
+    ASSERT_EQ(order[3], results[2].conclusion);
+
+    // Extraction renumbers premises within the copied tree
+    InferenceTree tree = last.tree();
+    ASSERT_EQ(tree.nodes.size(), 4u);
+    ASSERT_EQ(tree.root().atom, results[2].conclusion);
+    ASSERT_EQ(tree.root().premise_indices.size(), 1u);
+    ASSERT_EQ(tree.nodes[tree.root().premise_indices[0]].atom, results[1].conclusion);
+    ASSERT(tree.nodes[0].rule_used == nullptr);
+    ASSERT_EQ(tree.depth(), 3u);
+    return true;
+}
+
+TEST(UREngine_forward_chain_stream_and_cancellation) {
+    AtomSpace space;
+    auto concepts = make_concepts(space, 30);
+    Handle x = space.add_node(AtomType::VARIABLE_NODE, "$X");
+    Handle y = space.add_node(AtomType::VARIABLE_NODE, "$Y");
+
+    UREConfig config;
+    config.strategy = SearchStrategy::BFS;
+    config.min_result_confidence = 0.0f;
+    config.batch_size = 4;
+    config.max_results = 1000;
+    UREngine engine(space, config);
+
+    Rule flip;
+    flip.name = "flip";
+    flip.premise = space.add_link(AtomType::INHERITANCE_LINK, {x, y});
+    flip.conclusion = space.add_link(AtomType::SIMILARITY_LINK, {y, x});
+    engine.rules().add_rule(flip);
+    Rule back;
+    back.name = "back";
+    back.premise = space.add_link(AtomType::SIMILARITY_LINK, {x, y});
+    back.conclusion = space.add_link(AtomType::INHERITANCE_LINK, {x, y});
+    engine.rules().add_rule(back);
+
+    std::vector<Handle> sources;
+    for (size_t i = 0; i + 1 < concepts.size(); ++i) {
+        sources.push_back(space.add_link(AtomType::INHERITANCE_LINK,
+                                         {concepts[i], concepts[i + 1]}));
+    }
+    auto all = engine.forward_chain(std::span<const Handle>(sources));
+    ASSERT_EQ(all.size(), 29u * 4u);
+
+    // The stream yields the same results, in order
+    size_t n = 0;
+    for (const UREResult& result : engine.forward_chain_stream(sources)) {
+        ASSERT_EQ(result.conclusion, all[n].conclusion);
+        ++n;
+    }
+    ASSERT_EQ(n, all.size());
+
+    // Destroying the stream early is fine
+    {
+        auto stream = engine.forward_chain_stream(sources);
+        ASSERT(stream.next().has_value());
+    }
+
+    // A stop request is noticed before the next firing, sequential or not
+    for (size_t threads : {size_t{1}, size_t{3}}) {
+        std::stop_source stop;
+        size_t seen = 0;
+        UREConfig cancelling = config;
+        cancelling.threads = threads;
+        cancelling.on_result = [&](const RuleApplicationResult&) {
+            if (++seen == 10) stop.request_stop();
+        };
+        engine.set_config(cancelling);
+        ASSERT_EQ(engine.forward_chain(std::span<const Handle>(sources), stop.get_token()).size(),
+                  10u);
+
+        std::stop_source stream_stop;
+        n = 0;
+        for ([[maybe_unused]] const UREResult& result :
+             engine.forward_chain_stream(sources, stream_stop.get_token())) {
+            if (++n == 7) stream_stop.request_stop();
+        }
+        ASSERT_LT(n, 7u + cancelling.batch_size * 4);
+    }
+    return true;
+}
+
+TEST(UREngine_rule_profiler_reports_and_tunes) {
+    // Profiles one goal query; each run gets its own AtomSpace
+    auto run = [](AtomSpace& space, size_t threads) {
+        auto concepts = make_concepts(space, 12);
+        Handle x = space.add_node(AtomType::VARIABLE_NODE, "$X");
+        Handle y = space.add_node(AtomType::VARIABLE_NODE, "$Y");
+
+        UREConfig config;
+        config.strategy = SearchStrategy::BFS;
+        config.min_result_confidence = 0.0f;
+        config.profile_rules = true;
+        config.threads = threads;
+        auto engine = std::make_unique<UREngine>(space, config);
+
+        Rule flip;
+        flip.name = "flip";
+        flip.premise = space.add_link(AtomType::INHERITANCE_LINK, {x, y});
+        flip.conclusion = space.add_link(AtomType::SIMILARITY_LINK, {y, x});
+        engine->rules().add_rule(flip);
+        Rule subset;
+        subset.name = "subset";
+        subset.premise = space.add_link(AtomType::SIMILARITY_LINK, {x, y});
+        subset.conclusion = space.add_link(AtomType::SUBSET_LINK, {x, y});
+        engine->rules().add_rule(subset);
+        Rule reflexive;   // Reaches every InheritanceLink, unifies with none
+        reflexive.name = "reflexive";
+        reflexive.premise = space.add_link(AtomType::INHERITANCE_LINK, {x, x});
+        reflexive.conclusion = space.add_link(AtomType::SUBSET_LINK, {x, x});
+        engine->rules().add_rule(reflexive);
+
+        std::vector<Handle> sources;
+        for (size_t i = 0; i + 1 < concepts.size(); ++i) {
+            sources.push_back(space.add_link(AtomType::INHERITANCE_LINK,
+                                             {concepts[i], concepts[i + 1]}));
+        }
+        Handle target = space.add_link(AtomType::SUBSET_LINK, {concepts[4], concepts[3]});
+        if (!engine->forward_chain_to(sources, target)) engine.reset();
+        return engine;
+    };
+    auto by_name = [](const UREngine& engine) {
+        std::unordered_map<std::string, RuleProfile> profiles;
+        for (const RuleProfile& p : engine.profiler().report()) profiles[p.name] = p;
+        return profiles;
+    };
+
+    AtomSpace space;
+    auto engine = run(space, 1);
+    ASSERT(engine);
+    auto profile = by_name(*engine);
+    ASSERT_EQ(profile.size(), 3u);
+
+    const RuleProfile& flip = profile["flip"];
+    ASSERT_EQ(flip.calls, 11u);
+    ASSERT_EQ(flip.applications, 11u);
+    ASSERT_EQ(flip.atoms_created, 11u);
+    ASSERT_EQ(flip.success_rate(), 1.0);
+    ASSERT_EQ(flip.proof_uses, 1u);
+    ASSERT_GT(flip.total_ns, 0u);
+    ASSERT(flip.p99_ns > 0 && static_cast<double>(flip.p99_ns) >= flip.mean_ns() * 0.5);
+
+    const RuleProfile& reflexive = profile["reflexive"];
+    ASSERT_EQ(reflexive.calls, 11u);
+    ASSERT_EQ(reflexive.matches, 0u);
+    ASSERT_EQ(reflexive.applications, 0u);
+    ASSERT_EQ(profile["subset"].proof_uses, 1u);
+
+    // Matching on helper threads feeds the same counts
+    AtomSpace parallel_space;
+    auto parallel_engine = run(parallel_space, 3);
+    ASSERT(parallel_engine);
+    auto parallel = by_name(*parallel_engine);
+    for (const char* name : {"flip", "subset", "reflexive"}) {
+        ASSERT_EQ(parallel[name].calls, profile[name].calls);
+        ASSERT_EQ(parallel[name].applications, profile[name].applications);
+        ASSERT_EQ(parallel[name].proof_uses, profile[name].proof_uses);
+    }
+
+    ASSERT(engine->profiler().to_string().find("reflexive") != std::string::npos);
+    ASSERT_EQ(engine->tune_rules(), 3u);
+
+    // Tuning on fixed timings: proof steps per call, then per unit of cost
+    Rule useful_rule, useless_rule, slow_rule;
+    useful_rule.name = "flip";
+    useless_rule.name = "reflexive";
+    slow_rule.name = "subset";
+    const Rule* useful = &useful_rule;
+    const Rule* useless = &useless_rule;
+    const Rule* slow = &slow_rule;
+    RuleProfiler profiler;
+    for (int i = 0; i < 20; ++i) {
+        profiler.record_call({useful, 1, 1, 1000});
+        profiler.record_call({useless, 1, 0, 1000});
+        profiler.record_call({slow, 1, 1, 10000});
+    }
+    for (int i = 0; i < 10; ++i) {
+        profiler.credit(useful);
+        profiler.credit(slow);
+    }
+    auto costs = profiler.tune();
+    ASSERT_EQ(costs.size(), 3u);
+    std::unordered_map<std::string, RuleCost> cost;
+    for (const RuleCost& c : costs) cost[c.name] = c;
+    ASSERT_GT(cost["flip"].priority, cost["subset"].priority);
+    ASSERT_GT(cost["flip"].priority, cost["reflexive"].priority);
+    ASSERT_GT(cost["subset"].complexity, cost["flip"].complexity);
+    ASSERT_EQ(cost["flip"].complexity, cost["reflexive"].complexity);
+    return true;
+}
+
+TEST(UREngine_bidirectional_meets_goals_by_unification) {
+    AtomSpace space;
+    auto concepts = make_concepts(space, 20);
+    Handle x = space.add_node(AtomType::VARIABLE_NODE, "$X");
+    Handle y = space.add_node(AtomType::VARIABLE_NODE, "$Y");
+    Handle w = space.add_node(AtomType::VARIABLE_NODE, "$W");
+
+    UREConfig config;
+    config.strategy = SearchStrategy::BFS;
+    config.min_result_confidence = 0.0f;
+    UREngine engine(space, config);
+
+    Rule flip;
+    flip.name = "flip";
+    flip.premise = space.add_link(AtomType::INHERITANCE_LINK, {x, y});
+    flip.conclusion = space.add_link(AtomType::SIMILARITY_LINK, {y, x});
+    engine.rules().add_rule(flip);
+    Rule subset;
+    subset.name = "subset";
+    subset.premise = space.add_link(AtomType::SIMILARITY_LINK, {x, y});
+    subset.conclusion = space.add_link(AtomType::SUBSET_LINK, {x, y});
+    engine.rules().add_rule(subset);
+
+    std::vector<Handle> sources;
+    for (size_t i = 0; i + 1 < concepts.size(); ++i) {
+        sources.push_back(space.add_link(AtomType::INHERITANCE_LINK,
+                                         {concepts[i], concepts[i + 1]}));
+    }
+
+    // Subset(C8, $W) is reached through the subgoal Similarity(C8, $W),
+    // which no forward conclusion equals, only instantiates
+    Handle target = space.add_link(AtomType::SUBSET_LINK, {concepts[8], w});
+    auto result = engine.bidirectional_chain(sources, target);
+    ASSERT(result.has_value());
+    ASSERT_EQ(result->conclusion, space.add_link(AtomType::SUBSET_LINK, {concepts[8], concepts[7]}));
+    ASSERT_EQ(result->proof.size(), 3u);
+    ASSERT_EQ(result->proof.root().rule_used->name, std::string("subset"));
+
+    // A ground target whose premises are sources meets them at once
+    engine.reset_stats();
+    Handle ground = space.add_link(AtomType::SUBSET_LINK, {concepts[15], concepts[14]});
+    result = engine.bidirectional_chain(sources, ground);
+    ASSERT(result.has_value());
+    ASSERT_EQ(result->conclusion, ground);
+    ASSERT_LT(engine.stats().total_iterations, 3u);
+
+    Handle unreachable = space.add_link(AtomType::SUBSET_LINK, {concepts[0], concepts[19]});
+    ASSERT(!engine.bidirectional_chain(sources, unreachable).has_value());
+
+    // Subgoals leave nothing behind: neither their atoms nor renamed variables
+    ASSERT(!space.get_link(AtomType::SIMILARITY_LINK, {concepts[0], concepts[19]}).valid());
+    ASSERT(!space.get_link(AtomType::INHERITANCE_LINK, {concepts[19], concepts[0]}).valid());
+    ASSERT(!space.get_link(AtomType::SIMILARITY_LINK, {concepts[8], w}).valid());
+    ASSERT_EQ(space.count_atoms(AtomType::VARIABLE_NODE), 3u);
+
+    // Conclusions the search derived are kept
+    ASSERT(space.get_link(AtomType::SIMILARITY_LINK, {concepts[8], concepts[7]}).valid());
+    return true;
+}
+
+TEST(UREngine_goal_table_reuses_expansions_and_proofs) {
+    AtomSpace space;
+    Handle a = space.add_node(AtomType::CONCEPT_NODE, "A");
+    Handle b = space.add_node(AtomType::CONCEPT_NODE, "B");
+    Handle c = space.add_node(AtomType::CONCEPT_NODE, "C");
+    Handle x = space.add_node(AtomType::VARIABLE_NODE, "$X");
+    Handle y = space.add_node(AtomType::VARIABLE_NODE, "$Y");
+
+    UREConfig config;
+    config.min_result_confidence = 0.5f;
+    UREngine engine(space, config);
+
+    // Similarity follows from Inheritance either way round
+    Rule forward;
+    forward.name = "forward";
+    forward.premise = space.add_link(AtomType::INHERITANCE_LINK, {x, y});
+    forward.conclusion = space.add_link(AtomType::SIMILARITY_LINK, {x, y});
+    engine.rules().add_rule(forward);
+    Rule backward;
+    backward.name = "backward";
+    backward.premise = space.add_link(AtomType::INHERITANCE_LINK, {y, x});
+    backward.conclusion = forward.conclusion;
+    engine.rules().add_rule(backward);
+
+    (void)space.add_link(AtomType::INHERITANCE_LINK, {a, b});
+    (void)space.add_link(AtomType::INHERITANCE_LINK, {b, a});
+    Handle target = space.add_link(AtomType::SIMILARITY_LINK, {a, b});
+
+    auto proofs = engine.find_all_proofs(target);
+    ASSERT_EQ(proofs.size(), 2u);
+    ASSERT_EQ(proofs[0].conclusion, target);
+    ASSERT_EQ(proofs[0].proof.size(), 2u);
+    ASSERT_EQ(proofs[0].proof.root().premise_indices.size(), 1u);
+    const auto computed = engine.stats();
+    ASSERT_EQ(computed.answer_hits, 0u);
+    ASSERT_GT(computed.answer_misses, 0u);
+
+    // Nothing changed: the whole list is reused, and its first proof
+    auto again = engine.find_all_proofs(target);
+    ASSERT_EQ(again.size(), 2u);
+    ASSERT_EQ(again[1].proof.root().rule_used->name, proofs[1].proof.root().rule_used->name);
+    ASSERT_EQ(engine.stats().answer_hits, 1u);
+    ASSERT(engine.backward_chain(target).has_value());
+    ASSERT_EQ(engine.stats().answer_hits, 2u);
+    ASSERT_EQ(engine.stats().answer_misses, computed.answer_misses);
+
+    // Bidirectional search starts from the proof already known
+    auto met = engine.bidirectional_chain(std::span<const Handle>(), target);
+    ASSERT(met.has_value());
+    ASSERT_EQ(met->conclusion, target);
+    ASSERT_EQ(engine.stats().answer_hits, 3u);
+
+    // A premise's truth value changed without moving the version: the
+    // proofs are found again, with the value it has now
+    Handle ab = space.get_link(AtomType::INHERITANCE_LINK, {a, b});
+    space.set_tv(ab, TruthValue{0.2f, 0.7f});
+    const size_t invalidations = engine.goal_table().stats().invalidations;
+    auto revised = engine.find_all_proofs(target);
+    ASSERT_EQ(revised.size(), 2u);
+    ASSERT_GT(engine.goal_table().stats().invalidations, invalidations);
+    UREngine fresh(space, config);
+    fresh.rules().add_rule(forward);
+    fresh.rules().add_rule(backward);
+    auto expected = fresh.find_all_proofs(target);
+    ASSERT_EQ(expected.size(), 2u);
+    ASSERT_EQ(revised[0].tv, expected[0].tv);
+    ASSERT_EQ(revised[1].tv, expected[1].tv);
+    const size_t reused = engine.goal_table().stats().invalidations;
+    ASSERT_EQ(engine.find_all_proofs(target).size(), 2u);
+    ASSERT_EQ(engine.goal_table().stats().invalidations, reused);
+
+    // Goals that differ only in variable names share one expansion
+    Handle p = space.add_node(AtomType::VARIABLE_NODE, "$P");
+    Handle q = space.add_node(AtomType::VARIABLE_NODE, "$Q");
+    Handle r = space.add_node(AtomType::VARIABLE_NODE, "$R");
+    Handle s = space.add_node(AtomType::VARIABLE_NODE, "$S");
+    auto first = engine.backward_step(space.add_link(AtomType::SIMILARITY_LINK, {p, q}));
+    const size_t hits = engine.stats().expansion_hits;
+    auto second = engine.backward_step(space.add_link(AtomType::SIMILARITY_LINK, {r, s}));
+    ASSERT_EQ(engine.stats().expansion_hits, hits + 1);
+    ASSERT_EQ(second.size(), 2u);
+    ASSERT_EQ(second[0].first, first[0].first);
+    ASSERT_EQ(second[0].second.get("$X"), r.id());
+    ASSERT_EQ(second[0].second.get("$Y"), s.id());
+    auto repeated = engine.backward_step(space.add_link(AtomType::SIMILARITY_LINK, {r, r}));
+    ASSERT_EQ(repeated[0].second.get("$Y"), r.id());   // Different shape, own entry
+
+    // No proof is remembered until the AtomSpace changes
+    Handle ac = space.add_link(AtomType::SIMILARITY_LINK, {a, c});
+    ASSERT(engine.find_all_proofs(ac).empty());
+    const size_t misses = engine.stats().answer_misses;
+    ASSERT(engine.find_all_proofs(ac).empty());
+    ASSERT_EQ(engine.stats().answer_misses, misses);
+    (void)space.add_link(AtomType::INHERITANCE_LINK, {c, a});
+    ASSERT_EQ(engine.find_all_proofs(ac).size(), 1u);
+
+    // Bounded, and emptied when the rules change
+    config.goal_table_capacity = 2;
+    engine.set_config(config);
+    ASSERT(engine.goal_table().size() <= 2u);
+    ASSERT_GT(engine.goal_table().stats().evictions, 0u);
+    Rule extra = forward;
+    extra.name = "extra";
+    engine.rules().add_rule(extra);
+    ASSERT_EQ(engine.backward_step(target).size(), 3u);
+    ASSERT_EQ(engine.goal_table().size(), 1u);
+    return true;
+}
+
+TEST(UREngine_backward_chain_proves_missing_premises) {
+    AtomSpace space;
+    Handle a = space.add_node(AtomType::CONCEPT_NODE, "A");
+    Handle b = space.add_node(AtomType::CONCEPT_NODE, "B");
+    Handle c = space.add_node(AtomType::CONCEPT_NODE, "C");
+    Handle x = space.add_node(AtomType::VARIABLE_NODE, "$X");
+    Handle y = space.add_node(AtomType::VARIABLE_NODE, "$Y");
+
+    UREConfig config;
+    config.min_result_confidence = 0.5f;
+    UREngine engine(space, config);
+
+    // Subset gives Inheritance, which gives Similarity; symmetry is
+    // tried first and only leads round in a cycle
+    Rule lift;
+    lift.name = "lift";
+    lift.premise = space.add_link(AtomType::SUBSET_LINK, {x, y});
+    lift.conclusion = space.add_link(AtomType::INHERITANCE_LINK, {x, y});
+    engine.rules().add_rule(lift);
+    Rule symmetric;
+    symmetric.name = "symmetric";
+    symmetric.premise = space.add_link(AtomType::INHERITANCE_LINK, {y, x});
+    symmetric.conclusion = lift.conclusion;
+    symmetric.priority = 2.0f;
+    engine.rules().add_rule(symmetric);
+    Rule similar;
+    similar.name = "similar";
+    similar.premise = lift.conclusion;
+    similar.conclusion = space.add_link(AtomType::SIMILARITY_LINK, {x, y});
+    engine.rules().add_rule(similar);
+
+    (void)space.add_link(AtomType::SUBSET_LINK, {a, b});
+    Handle target = space.add_link(AtomType::SIMILARITY_LINK, {a, b});
+
+    // The missing Inheritance is proven as a subgoal and kept
+    auto result = engine.backward_chain(target);
+    ASSERT(result.has_value());
+    ASSERT_EQ(result->conclusion, target);
+    ASSERT_EQ(result->proof.depth(), 2u);
+    ASSERT_EQ(result->proof.size(), 3u);
+    ASSERT_EQ(result->proof.root().rule_used->name, std::string("similar"));
+    InferenceTree tree = result->proof.tree();
+    const InferenceNode& lifted = tree.nodes[tree.root().premise_indices[0]];
+    ASSERT_EQ(lifted.rule_used->name, std::string("lift"));
+    ASSERT(space.get_link(AtomType::INHERITANCE_LINK, {a, b}).valid());
+    ASSERT(!space.get_link(AtomType::INHERITANCE_LINK, {b, a}).valid());
+
+    // The subgoal's answer is tabled with the target's
+    const size_t hits = engine.stats().answer_hits;
+    ASSERT_EQ(engine.find_all_proofs(target).size(), 1u);
+    ASSERT_EQ(engine.stats().answer_hits, hits + 1);
+
+    // Unprovable through the cycle: nothing is left behind
+    Handle unreachable = space.add_link(AtomType::SIMILARITY_LINK, {c, a});
+    const size_t atoms = space.size();
+    ASSERT(engine.find_all_proofs(unreachable).empty());
+    ASSERT_EQ(space.size(), atoms);
+
+    // A depth bound stops the chain before its premise
+    config.max_proof_depth = 1;
+    UREngine shallow(space, config);
+    shallow.rules().add_rule(lift);
+    shallow.rules().add_rule(similar);
+    Handle ba = space.add_link(AtomType::SIMILARITY_LINK, {b, a});
+    (void)space.add_link(AtomType::SUBSET_LINK, {b, a});
+    ASSERT(!shallow.backward_chain(ba).has_value());
+    ASSERT(engine.backward_chain(ba).has_value());
+    return true;
+}
+
+TEST(UREngine_attention_strategy_without_bank) {
+    AtomSpace space;
+    auto atoms = make_concepts(space, 10);
+
+    UREConfig config;
+    config.strategy = SearchStrategy::ATTENTION;
+    size_t iterations = 0;
+    config.on_iteration = [&](size_t i) { iterations = i; };
+
+    UREngine engine(space, config);
+    auto results = engine.forward_chain(std::span<const Handle>(atoms));
+    ASSERT(results.empty());
+    ASSERT_EQ(iterations, atoms.size());
+    return true;
+}
+
+TEST(UREngine_parallel_forward_chain_is_deterministic) {
+    // Runs in its own AtomSpace so created atoms get the same ids
+    auto run = [](size_t threads, size_t max_results, size_t max_iterations) {
+        AtomSpace space;
+        auto concepts = make_concepts(space, 40);
+        Handle x = space.add_node(AtomType::VARIABLE_NODE, "$X");
+        Handle y = space.add_node(AtomType::VARIABLE_NODE, "$Y");
+
+        UREConfig config;
+        config.strategy = SearchStrategy::BFS;
+        config.min_result_confidence = 0.0f;
+        config.record_proofs = false;
+        config.threads = threads;
+        config.batch_size = 7;
+        config.max_results = max_results;
+        config.max_iterations = max_iterations;
+        UREngine engine(space, config);
+
+        Rule flip;
+        flip.name = "flip";
+        flip.premise = space.add_link(AtomType::INHERITANCE_LINK, {x, y});
+        flip.conclusion = space.add_link(AtomType::SIMILARITY_LINK, {y, x});
+        engine.rules().add_rule(flip);
+        Rule back;
+        back.name = "back";
+        back.premise = space.add_link(AtomType::SIMILARITY_LINK, {x, y});
+        back.conclusion = space.add_link(AtomType::INHERITANCE_LINK, {x, y});
+        engine.rules().add_rule(back);
+
+        std::vector<Handle> sources;
+        for (size_t i = 0; i + 1 < concepts.size(); ++i) {
+            sources.push_back(space.add_link(AtomType::INHERITANCE_LINK,
+                                             {concepts[i], concepts[i + 1]}));
+        }
+        std::vector<uint64_t> conclusions;
+        for (const auto& r : engine.forward_chain(std::span<const Handle>(sources))) {
+            conclusions.push_back(r.conclusion.id().value);
+        }
+        return std::pair{conclusions, engine.stats().total_iterations};
+    };
+
+    auto sequential = run(1, 1000, 1000);
+    ASSERT_EQ(sequential.first.size(), 39u * 4u);
+    ASSERT(run(3, 1000, 1000) == sequential);
+    ASSERT(run(4, 1000, 1000) == sequential);
+
+    // Limits stop the parallel chainer where the sequential one stops
+    ASSERT(run(3, 25, 1000) == run(1, 25, 1000));
+    auto capped = run(3, 1000, 30);
+    ASSERT(capped == run(1, 1000, 30));
+    ASSERT_EQ(capped.second, 30u);
+    return true;
+}